@@ -465,6 +465,53 @@ void ULyraGameplayAbility::TryActivateAbilityOnSpawn(const FGameplayAbilityActor
 	}
 }
 
+bool ULyraGameplayAbility::CanBeGrantedLazily() const
+{
+	// On spawn abilities need to exist as soon as the avatar is set.
+	if (ActivationPolicy == ELyraAbilityActivationPolicy::OnSpawn)
+	{
+		return false;
+	}
+
+	// Abilities triggered by owned tags are activated by the ASC without anyone asking for them.
+	for (const FAbilityTriggerData& TriggerData : AbilityTriggers)
+	{
+		if (TriggerData.TriggerSource != EGameplayAbilityTriggerSource::GameplayEvent)
+		{
+			return false;
+		}
+	}
+
+	// Abilities that do work when they are granted or when the avatar changes have to be granted up front.
+	const UClass* AbilityClass = GetClass();
+	if (AbilityClass->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(ULyraGameplayAbility, K2_OnAbilityAdded)) ||
+		AbilityClass->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(ULyraGameplayAbility, K2_OnPawnAvatarSet)))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool ULyraGameplayAbility::IsTriggeredByGameplayEvent(const FGameplayTag& EventTag) const
+{
+	// Matches the way UAbilitySystemComponent::HandleGameplayEvent walks up the parents of the event tag.
+	for (const FAbilityTriggerData& TriggerData : AbilityTriggers)
+	{
+		if ((TriggerData.TriggerSource == EGameplayAbilityTriggerSource::GameplayEvent) && EventTag.MatchesTag(TriggerData.TriggerTag))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool ULyraGameplayAbility::HasAllAbilityTags(const FGameplayTagContainer& Tags) const
+{
+	return AbilityTags.HasAll(Tags);
+}
+
 bool ULyraGameplayAbility::CanChangeActivationGroup(ELyraAbilityActivationGroup NewGroup) const
 {
 	if (!IsInstantiated() || !IsActive())
@@ -121,6 +121,16 @@ public:
 
 	void TryActivateAbilityOnSpawn(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) const;
 
+	// Returns true if the ability only ever activates when explicitly asked to (by input, ability tag or gameplay event),
+	// so granting it can be deferred until then. See FLyraAbilitySet_GameplayAbility::bGrantLazily.
+	bool CanBeGrantedLazily() const;
+
+	// Returns true if a gameplay event with the given tag would trigger this ability.
+	bool IsTriggeredByGameplayEvent(const FGameplayTag& EventTag) const;
+
+	// Returns true if this ability has all of the given ability tags.
+	bool HasAllAbilityTags(const FGameplayTagContainer& Tags) const;
+
 	// Returns true if the requested activation group is a valid transition.
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Lyra|Ability", Meta = (ExpandBoolAsExecs = "ReturnValue"))
 	bool CanChangeActivationGroup(ELyraAbilityActivationGroup NewGroup) const;
@@ -0,0 +1,51 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraAttributeDefaults.h"
+
+#include "AbilitySystemComponent.h"
+
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAttributeDefaults)
+
+#define LOCTEXT_NAMESPACE "LyraAttributeDefaults"
+
+int32 ULyraAttributeDefaults::ApplyToAbilitySystem(UAbilitySystemComponent* ASC) const
+{
+	check(ASC);
+
+	int32 NumApplied = 0;
+
+	for (const FLyraAttributeDefaultValue& DefaultValue : DefaultValues)
+	{
+		if (DefaultValue.Attribute.IsValid() && ASC->HasAttributeSetForAttribute(DefaultValue.Attribute))
+		{
+			ASC->SetNumericAttributeBase(DefaultValue.Attribute, DefaultValue.BaseValue);
+			++NumApplied;
+		}
+	}
+
+	return NumApplied;
+}
+
+#if WITH_EDITOR
+EDataValidationResult ULyraAttributeDefaults::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = CombineDataValidationResults(Super::IsDataValid(Context), EDataValidationResult::Valid);
+
+	for (int32 Index = 0; Index < DefaultValues.Num(); ++Index)
+	{
+		if (!DefaultValues[Index].Attribute.IsValid())
+		{
+			Result = EDataValidationResult::Invalid;
+			Context.AddError(FText::Format(LOCTEXT("InvalidAttribute", "DefaultValues[{0}] does not reference an attribute."), FText::AsNumber(Index)));
+		}
+	}
+
+	return Result;
+}
+#endif
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,58 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "AttributeSet.h"
+#include "Engine/DataAsset.h"
+
+#include "LyraAttributeDefaults.generated.h"
+
+class UAbilitySystemComponent;
+class UObject;
+
+
+/**
+ * FLyraAttributeDefaultValue
+ *
+ *	Base value for a single attribute.
+ */
+USTRUCT(BlueprintType)
+struct FLyraAttributeDefaultValue
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditDefaultsOnly, Category = "Attributes")
+	FGameplayAttribute Attribute;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Attributes")
+	float BaseValue = 0.0f;
+};
+
+
+/**
+ * ULyraAttributeDefaults
+ *
+ *	Non-mutable table of attribute base values shared by every pawn that references it (see ULyraPawnData).
+ *	Applying it only writes base values on the pawn's own attribute sets, so nothing is copied per pawn.
+ */
+UCLASS(BlueprintType, Const, Meta = (DisplayName = "Lyra Attribute Defaults", ShortTooltip = "Data asset used to define the starting attribute values of a pawn."))
+class LYRAGAME_API ULyraAttributeDefaults : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	// Sets the base value of every listed attribute that exists on the ability system. Returns the number of attributes set.
+	int32 ApplyToAbilitySystem(UAbilitySystemComponent* ASC) const;
+
+#if WITH_EDITOR
+	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+#endif
+
+protected:
+
+	UPROPERTY(EditDefaultsOnly, Category = "Attributes", Meta = (TitleProperty = Attribute))
+	TArray<FLyraAttributeDefaultValue> DefaultValues;
+};
@@ -8,6 +8,11 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAbilitySet)
 
+namespace LyraAbilitySetStats
+{
+	static FLyraAbilitySetGrantStats GrantStats;
+}
+
 void FLyraAbilitySet_GrantedHandles::AddAbilitySpecHandle(const FGameplayAbilitySpecHandle& Handle)
 {
 	if (Handle.IsValid())
@@ -43,7 +48,11 @@ void FLyraAbilitySet_GrantedHandles::TakeFromAbilitySystem(ULyraAbilitySystemCom
 	{
 		if (Handle.IsValid())
 		{
-			LyraASC->ClearAbility(Handle);
+			// Abilities that were granted lazily and never used only exist as a descriptor.
+			if (!LyraASC->RemoveLazyAbility(Handle))
+			{
+				LyraASC->ClearAbility(Handle);
+			}
 		}
 	}
 
@@ -63,6 +72,84 @@ void FLyraAbilitySet_GrantedHandles::TakeFromAbilitySystem(ULyraAbilitySystemCom
 	AbilitySpecHandles.Reset();
 	GameplayEffectHandles.Reset();
 	GrantedAttributeSets.Reset();
+	DisabledAbilityTags.Reset();
+	bAbilitiesDisabled = false;
+}
+
+void FLyraAbilitySet_GrantedHandles::SetAbilitiesEnabled(ULyraAbilitySystemComponent* LyraASC, bool bEnabled)
+{
+	check(LyraASC);
+
+	if (!LyraASC->IsOwnerActorAuthoritative())
+	{
+		// Must be authoritative to change granted abilities, the spec changes replicate.
+		return;
+	}
+
+	if (bEnabled != bAbilitiesDisabled)
+	{
+		// Already in the requested state.
+		return;
+	}
+
+	bAbilitiesDisabled = !bEnabled;
+
+	if (bEnabled)
+	{
+		for (const TPair<FGameplayAbilitySpecHandle, FGameplayTagContainer>& Pair : DisabledAbilityTags)
+		{
+			if (FGameplayAbilitySpec* AbilitySpec = LyraASC->FindAbilitySpecFromHandle(Pair.Key))
+			{
+				AbilitySpec->DynamicAbilityTags.AppendTags(Pair.Value);
+				LyraASC->NotifyAbilitySpecDynamicTagsChanged(*AbilitySpec);
+			}
+			else
+			{
+				LyraASC->SetLazyAbilityEnabled(Pair.Key, true);
+			}
+		}
+
+		DisabledAbilityTags.Reset();
+
+		// Abilities that activate on spawn were cancelled when disabled, start them again. This only covers the ones the
+		// server executes, owning clients restart their locally executed ones through TryActivateAbilitiesOnSpawnFromSource.
+		for (const FGameplayAbilitySpecHandle& Handle : AbilitySpecHandles)
+		{
+			if (const FGameplayAbilitySpec* AbilitySpec = LyraASC->FindAbilitySpecFromHandle(Handle))
+			{
+				if (const ULyraGameplayAbility* LyraAbilityCDO = Cast<ULyraGameplayAbility>(AbilitySpec->Ability))
+				{
+					LyraAbilityCDO->TryActivateAbilityOnSpawn(LyraASC->AbilityActorInfo.Get(), *AbilitySpec);
+				}
+			}
+		}
+		return;
+	}
+
+	for (const FGameplayAbilitySpecHandle& Handle : AbilitySpecHandles)
+	{
+		if (!Handle.IsValid())
+		{
+			continue;
+		}
+
+		// Lazily granted abilities have no spec yet, keep them from being granted by input or events while disabled
+		if (LyraASC->SetLazyAbilityEnabled(Handle, false))
+		{
+			DisabledAbilityTags.Add(Handle, FGameplayTagContainer());
+			continue;
+		}
+
+		LyraASC->CancelAbilityHandle(Handle);
+
+		FGameplayAbilitySpec* AbilitySpec = LyraASC->FindAbilitySpecFromHandle(Handle);
+		if (AbilitySpec && !AbilitySpec->DynamicAbilityTags.IsEmpty())
+		{
+			DisabledAbilityTags.Add(Handle, AbilitySpec->DynamicAbilityTags);
+			AbilitySpec->DynamicAbilityTags.Reset();
+			LyraASC->NotifyAbilitySpecDynamicTagsChanged(*AbilitySpec);
+		}
+	}
 }
 
 ULyraAbilitySet::ULyraAbilitySet(const FObjectInitializer& ObjectInitializer)
@@ -70,6 +157,35 @@ ULyraAbilitySet::ULyraAbilitySet(const FObjectInitializer& ObjectInitializer)
 {
 }
 
+const FLyraAbilitySetGrantStats& ULyraAbilitySet::GetGrantStats()
+{
+	return LyraAbilitySetStats::GrantStats;
+}
+
+void ULyraAbilitySet::ResetGrantStats()
+{
+	LyraAbilitySetStats::GrantStats = FLyraAbilitySetGrantStats();
+}
+
+void ULyraAbilitySet::GetGrantedClasses(TArray<const UClass*>& OutClasses) const
+{
+	for (const FLyraAbilitySet_GameplayAbility& AbilityToGrant : GrantedGameplayAbilities)
+	{
+		if (AbilityToGrant.Ability)
+		{
+			OutClasses.Add(AbilityToGrant.Ability);
+		}
+	}
+
+	for (const FLyraAbilitySet_GameplayEffect& EffectToGrant : GrantedGameplayEffects)
+	{
+		if (EffectToGrant.GameplayEffect)
+		{
+			OutClasses.Add(EffectToGrant.GameplayEffect);
+		}
+	}
+}
+
 void ULyraAbilitySet::GiveToAbilitySystem(ULyraAbilitySystemComponent* LyraASC, FLyraAbilitySet_GrantedHandles* OutGrantedHandles, UObject* SourceObject) const
 {
 	check(LyraASC);
@@ -80,6 +196,10 @@ void ULyraAbilitySet::GiveToAbilitySystem(ULyraAbilitySystemComponent* LyraASC,
 		return;
 	}
 
+	const double GiveStartTime = FPlatformTime::Seconds();
+	FLyraAbilitySetGrantStats& GrantStats = LyraAbilitySetStats::GrantStats;
+	const bool bCanGrantLazily = LyraASC->CanGrantAbilitiesLazily();
+
 	// Grant the gameplay abilities.
 	for (int32 AbilityIndex = 0; AbilityIndex < GrantedGameplayAbilities.Num(); ++AbilityIndex)
 	{
@@ -93,11 +213,24 @@ void ULyraAbilitySet::GiveToAbilitySystem(ULyraAbilitySystemComponent* LyraASC,
 
 		ULyraGameplayAbility* AbilityCDO = AbilityToGrant.Ability->GetDefaultObject<ULyraGameplayAbility>();
 
+		if (AbilityToGrant.bGrantLazily && bCanGrantLazily && AbilityCDO->CanBeGrantedLazily())
+		{
+			const FGameplayAbilitySpecHandle LazyHandle = LyraASC->AddLazyAbility(AbilityToGrant.Ability, AbilityToGrant.AbilityLevel, AbilityToGrant.InputTag, SourceObject);
+			++GrantStats.NumAbilitiesGrantedLazily;
+
+			if (OutGrantedHandles)
+			{
+				OutGrantedHandles->AddAbilitySpecHandle(LazyHandle);
+			}
+			continue;
+		}
+
 		FGameplayAbilitySpec AbilitySpec(AbilityCDO, AbilityToGrant.AbilityLevel);
 		AbilitySpec.SourceObject = SourceObject;
 		AbilitySpec.DynamicAbilityTags.AddTag(AbilityToGrant.InputTag);
 
 		const FGameplayAbilitySpecHandle AbilitySpecHandle = LyraASC->GiveAbility(AbilitySpec);
+		++GrantStats.NumAbilitiesGranted;
 
 		if (OutGrantedHandles)
 		{
@@ -144,5 +277,9 @@ void ULyraAbilitySet::GiveToAbilitySystem(ULyraAbilitySystemComponent* LyraASC,
 			OutGrantedHandles->AddAttributeSet(NewSet);
 		}
 	}
-}
 
+	const double GiveTime = FPlatformTime::Seconds() - GiveStartTime;
+	++GrantStats.NumSetsGiven;
+	GrantStats.GiveTimeSeconds += GiveTime;
+	GrantStats.MaxGiveTimeSeconds = FMath::Max(GrantStats.MaxGiveTimeSeconds, GiveTime);
+}
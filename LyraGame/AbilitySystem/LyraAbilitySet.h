@@ -40,6 +40,15 @@ public:
 	// Tag used to process input for the ability.
 	UPROPERTY(EditDefaultsOnly, Meta = (Categories = "InputTag"))
 	FGameplayTag InputTag;
+
+	// If set, AI-owned ability systems only register a lightweight descriptor for the ability and create the real
+	// ability spec the first time it is activated by input tag or gameplay event, or through
+	// ULyraAbilitySystemComponent::TryActivateAbilitiesByTagIncludingLazy / TryActivateAbilityByClassIncludingLazy.
+	// UAbilitySystemComponent's own tag and class activation do not see the ability until then, so only flag
+	// abilities that are not activated that way. Ignored for abilities that activate on spawn or from owned tags,
+	// and for player-owned ability systems.
+	UPROPERTY(EditDefaultsOnly)
+	bool bGrantLazily = false;
 };
 
 
@@ -99,6 +108,11 @@ public:
 
 	void TakeFromAbilitySystem(ULyraAbilitySystemComponent* LyraASC);
 
+	// Enables or disables the granted abilities without removing them: disabling cancels them and strips their input tags
+	// so input no longer reaches them, enabling puts the input tags back and restarts abilities that activate on spawn.
+	// Used to stow equipment cheaply.
+	void SetAbilitiesEnabled(ULyraAbilitySystemComponent* LyraASC, bool bEnabled);
+
 protected:
 
 	// Handles to the granted abilities.
@@ -112,6 +126,27 @@ protected:
 	// Pointers to the granted attribute sets
 	UPROPERTY()
 	TArray<TObjectPtr<UAttributeSet>> GrantedAttributeSets;
+
+	// Dynamic (input) tags of the granted abilities while they are disabled.
+	TMap<FGameplayAbilitySpecHandle, FGameplayTagContainer> DisabledAbilityTags;
+
+	// True between SetAbilitiesEnabled(false) and SetAbilitiesEnabled(true).
+	bool bAbilitiesDisabled = false;
+};
+
+
+/**
+ * FLyraAbilitySetGrantStats
+ *
+ *	Counters gathered by ULyraAbilitySet::GiveToAbilitySystem, reported by Lyra.AbilitySystem.DumpGrantStats.
+ */
+struct FLyraAbilitySetGrantStats
+{
+	int32 NumSetsGiven = 0;
+	int32 NumAbilitiesGranted = 0;
+	int32 NumAbilitiesGrantedLazily = 0;
+	double GiveTimeSeconds = 0.0;
+	double MaxGiveTimeSeconds = 0.0;
 };
 
 
@@ -133,6 +168,13 @@ public:
 	// The returned handles can be used later to take away anything that was granted.
 	void GiveToAbilitySystem(ULyraAbilitySystemComponent* LyraASC, FLyraAbilitySet_GrantedHandles* OutGrantedHandles, UObject* SourceObject = nullptr) const;
 
+	// Returns the grant counters accumulated since startup (or the last ResetGrantStats).
+	static const FLyraAbilitySetGrantStats& GetGrantStats();
+	static void ResetGrantStats();
+
+	// Appends the gameplay ability and gameplay effect classes granted by this set.
+	void GetGrantedClasses(TArray<const UClass*>& OutClasses) const;
+
 protected:
 
 	// Gameplay abilities to grant when this ability set is granted.
@@ -3,19 +3,42 @@
 #include "LyraAbilitySystemComponent.h"
 
 #include "AbilitySystem/Abilities/LyraGameplayAbility.h"
+#include "AbilitySystem/Abilities/LyraGameplayAbility_Reset.h"
 #include "AbilitySystem/LyraAbilityTagRelationshipMapping.h"
 #include "Animation/LyraAnimInstance.h"
 #include "Engine/World.h"
+#include "GameFramework/Controller.h"
 #include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerState.h"
+#include "LyraAbilitySet.h"
+#include "LyraGameplayTags.h"
 #include "LyraGlobalAbilitySystem.h"
 #include "LyraLogChannels.h"
 #include "System/LyraAssetManager.h"
 #include "System/LyraGameData.h"
+#include "UObject/UObjectIterator.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAbilitySystemComponent)
 
 UE_DEFINE_GAMEPLAY_TAG(TAG_Gameplay_AbilityInputBlocked, "Gameplay.AbilityInputBlocked");
 
+namespace LyraAbilitySystemCvars
+{
+	static bool bLazyAbilityGrants = true;
+	static FAutoConsoleVariableRef CVarLazyAbilityGrants(
+		TEXT("Lyra.AbilitySystem.LazyAbilityGrants"),
+		bLazyAbilityGrants,
+		TEXT("If true, abilities flagged with bGrantLazily in an ability set are only granted to AI-owned ability systems when first activated."),
+		ECVF_Default);
+
+	static bool bIndexedAbilityInput = true;
+	static FAutoConsoleVariableRef CVarIndexedAbilityInput(
+		TEXT("Lyra.AbilitySystem.IndexedAbilityInput"),
+		bIndexedAbilityInput,
+		TEXT("If true, ability input presses and releases look up the abilities bound to the input tag in an index instead of checking every granted ability."),
+		ECVF_Default);
+}
+
 ULyraAbilitySystemComponent::ULyraAbilitySystemComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -103,6 +126,23 @@ void ULyraAbilitySystemComponent::TryActivateAbilitiesOnSpawn()
 	}
 }
 
+void ULyraAbilitySystemComponent::TryActivateAbilitiesOnSpawnFromSource(const UObject* SourceObject)
+{
+	ABILITYLIST_SCOPE_LOCK();
+	for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
+	{
+		if (AbilitySpec.SourceObject.Get() != SourceObject)
+		{
+			continue;
+		}
+
+		if (const ULyraGameplayAbility* LyraAbilityCDO = Cast<ULyraGameplayAbility>(AbilitySpec.Ability))
+		{
+			LyraAbilityCDO->TryActivateAbilityOnSpawn(AbilityActorInfo.Get(), AbilitySpec);
+		}
+	}
+}
+
 void ULyraAbilitySystemComponent::CancelAbilitiesByFunc(TShouldCancelAbilityFunc ShouldCancelFunc, bool bReplicateCancelAbility)
 {
 	ABILITYLIST_SCOPE_LOCK();
@@ -195,6 +235,35 @@ void ULyraAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& Inp
 {
 	if (InputTag.IsValid())
 	{
+		if (LazyAbilityGrants.Num() > 0)
+		{
+			TArray<FGameplayAbilitySpecHandle> DeferredHandles;
+			MaterializeLazyAbilities([&InputTag](const ULyraGameplayAbility* LyraAbilityCDO, const FLyraLazyAbilityGrant& LazyGrant)
+			{
+				return (LazyGrant.InputTag == InputTag);
+			}, &DeferredHandles);
+
+			// Grants deferred by the ability list lock are not indexed yet, but will be granted by the time ProcessAbilityInput looks them up
+			for (const FGameplayAbilitySpecHandle& DeferredHandle : DeferredHandles)
+			{
+				InputPressedSpecHandles.AddUnique(DeferredHandle);
+				InputHeldSpecHandles.AddUnique(DeferredHandle);
+			}
+		}
+
+		if (LyraAbilitySystemCvars::bIndexedAbilityInput)
+		{
+			if (const TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>>* SpecHandles = InputTagSpecHandles.Find(InputTag))
+			{
+				for (const FGameplayAbilitySpecHandle& SpecHandle : *SpecHandles)
+				{
+					InputPressedSpecHandles.AddUnique(SpecHandle);
+					InputHeldSpecHandles.AddUnique(SpecHandle);
+				}
+			}
+			return;
+		}
+
 		for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
 		{
 			if (AbilitySpec.Ability && (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag)))
@@ -210,6 +279,19 @@ void ULyraAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag& In
 {
 	if (InputTag.IsValid())
 	{
+		if (LyraAbilitySystemCvars::bIndexedAbilityInput)
+		{
+			if (const TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>>* SpecHandles = InputTagSpecHandles.Find(InputTag))
+			{
+				for (const FGameplayAbilitySpecHandle& SpecHandle : *SpecHandles)
+				{
+					InputReleasedSpecHandles.AddUnique(SpecHandle);
+					InputHeldSpecHandles.Remove(SpecHandle);
+				}
+			}
+			return;
+		}
+
 		for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
 		{
 			if (AbilitySpec.Ability && (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag)))
@@ -221,6 +303,152 @@ void ULyraAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag& In
 	}
 }
 
+void ULyraAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnGiveAbility(AbilitySpec);
+
+	IndexAbilitySpecInputTags(AbilitySpec);
+
+	const int32 DeferredIndex = DeferredLazyActivations.IndexOfByPredicate([&AbilitySpec](const FDeferredLazyActivation& Deferred) { return Deferred.Handle == AbilitySpec.Handle; });
+	if (DeferredIndex != INDEX_NONE)
+	{
+		const FDeferredLazyActivation Deferred = DeferredLazyActivations[DeferredIndex];
+		DeferredLazyActivations.RemoveAtSwap(DeferredIndex);
+
+		if (Deferred.EventTag.IsValid())
+		{
+			TriggerAbilityFromGameplayEvent(AbilitySpec.Handle, AbilityActorInfo.Get(), Deferred.EventTag, &Deferred.EventData, *this);
+		}
+		else
+		{
+			TryActivateAbility(AbilitySpec.Handle);
+		}
+	}
+}
+
+void ULyraAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	UnindexAbilitySpecInputTags(AbilitySpec.Handle);
+
+	Super::OnRemoveAbility(AbilitySpec);
+}
+
+void ULyraAbilitySystemComponent::OnRep_ActivateAbilities()
+{
+	Super::OnRep_ActivateAbilities();
+
+	// Replicated specs may have had their dynamic tags changed without being added or removed
+	SyncAbilityInputTagIndex();
+}
+
+void ULyraAbilitySystemComponent::NotifyAbilitySpecDynamicTagsChanged(FGameplayAbilitySpec& AbilitySpec)
+{
+	IndexAbilitySpecInputTags(AbilitySpec);
+	MarkAbilitySpecDirty(AbilitySpec);
+}
+
+void ULyraAbilitySystemComponent::IndexAbilitySpecInputTags(const FGameplayAbilitySpec& AbilitySpec)
+{
+	UnindexAbilitySpecInputTags(AbilitySpec.Handle);
+
+	if (!AbilitySpec.Ability || AbilitySpec.DynamicAbilityTags.IsEmpty())
+	{
+		return;
+	}
+
+	for (const FGameplayTag& Tag : AbilitySpec.DynamicAbilityTags)
+	{
+		TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>>& SpecHandles = InputTagSpecHandles.FindOrAdd(Tag);
+		SpecHandles.AddUnique(AbilitySpec.Handle);
+
+		if (SpecHandles.Num() > 1)
+		{
+			// A re-indexed spec must not jump behind specs granted after it: keep the handles in the order of
+			// ActivatableAbilities, which is the order a scan of the specs would activate them in
+			TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>> OrderedHandles;
+			for (const FGameplayAbilitySpec& OtherSpec : ActivatableAbilities.Items)
+			{
+				if (SpecHandles.Contains(OtherSpec.Handle))
+				{
+					OrderedHandles.Add(OtherSpec.Handle);
+				}
+			}
+
+			if (OrderedHandles.Num() == SpecHandles.Num())
+			{
+				SpecHandles = MoveTemp(OrderedHandles);
+			}
+		}
+	}
+
+	IndexedSpecInputTags.Add(AbilitySpec.Handle, AbilitySpec.DynamicAbilityTags);
+}
+
+void ULyraAbilitySystemComponent::UnindexAbilitySpecInputTags(FGameplayAbilitySpecHandle Handle)
+{
+	FGameplayTagContainer IndexedTags;
+	if (!IndexedSpecInputTags.RemoveAndCopyValue(Handle, IndexedTags))
+	{
+		return;
+	}
+
+	for (const FGameplayTag& Tag : IndexedTags)
+	{
+		if (TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>>* SpecHandles = InputTagSpecHandles.Find(Tag))
+		{
+			// Keep the grant order, it is the order abilities are activated in
+			SpecHandles->RemoveSingle(Handle);
+			if (SpecHandles->Num() == 0)
+			{
+				InputTagSpecHandles.Remove(Tag);
+			}
+		}
+	}
+}
+
+void ULyraAbilitySystemComponent::SyncAbilityInputTagIndex()
+{
+	int32 NumIndexedSpecs = 0;
+
+	for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
+	{
+		const bool bShouldBeIndexed = AbilitySpec.Ability && !AbilitySpec.DynamicAbilityTags.IsEmpty();
+		const FGameplayTagContainer* IndexedTags = IndexedSpecInputTags.Find(AbilitySpec.Handle);
+
+		if (bShouldBeIndexed ? (!IndexedTags || (*IndexedTags != AbilitySpec.DynamicAbilityTags)) : (IndexedTags != nullptr))
+		{
+			IndexAbilitySpecInputTags(AbilitySpec);
+		}
+
+		NumIndexedSpecs += bShouldBeIndexed ? 1 : 0;
+	}
+
+	// Only look for removed specs when some are left in the index
+	if (IndexedSpecInputTags.Num() > NumIndexedSpecs)
+	{
+		TSet<FGameplayAbilitySpecHandle> SpecHandles;
+		SpecHandles.Reserve(ActivatableAbilities.Items.Num());
+		for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
+		{
+			SpecHandles.Add(AbilitySpec.Handle);
+		}
+
+		TArray<FGameplayAbilitySpecHandle, TInlineAllocator<4>> RemovedHandles;
+		for (const TPair<FGameplayAbilitySpecHandle, FGameplayTagContainer>& IndexedSpec : IndexedSpecInputTags)
+		{
+			if (!SpecHandles.Contains(IndexedSpec.Key))
+			{
+				RemovedHandles.Add(IndexedSpec.Key);
+			}
+		}
+
+		for (const FGameplayAbilitySpecHandle& Handle : RemovedHandles)
+		{
+			UnindexAbilitySpecInputTags(Handle);
+		}
+	}
+}
+
 void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGamePaused)
 {
 	if (HasMatchingGameplayTag(TAG_Gameplay_AbilityInputBlocked))
@@ -415,6 +643,234 @@ TArray<UGameplayAbility*> ULyraAbilitySystemComponent::GetAbilitiesOfClass(UAbil
 	return AbilitiesOfClass;
 }
 
+bool ULyraAbilitySystemComponent::CanGrantAbilitiesLazily() const
+{
+	if (!LyraAbilitySystemCvars::bLazyAbilityGrants)
+	{
+		return false;
+	}
+
+	// Players need their abilities replicated up front for prediction and UI, so only AI gets lazy grants.
+	if (bOwnerIsAlwaysAI)
+	{
+		return true;
+	}
+
+	if (const APlayerState* PlayerState = Cast<APlayerState>(GetOwner()))
+	{
+		return PlayerState->IsABot();
+	}
+
+	// A pawn that is not possessed yet may still end up with a player, so it needs a controller that is known to be AI
+	if (const APawn* Pawn = Cast<APawn>(GetOwner()))
+	{
+		const AController* Controller = Pawn->GetController();
+		return (Controller != nullptr) && !Controller->IsPlayerController();
+	}
+
+	return false;
+}
+
+FGameplayAbilitySpecHandle ULyraAbilitySystemComponent::AddLazyAbility(TSubclassOf<ULyraGameplayAbility> AbilityClass, int32 AbilityLevel, const FGameplayTag& InputTag, UObject* SourceObject)
+{
+	check(AbilityClass);
+
+	FLyraLazyAbilityGrant& LazyGrant = LazyAbilityGrants.AddDefaulted_GetRef();
+	LazyGrant.Handle.GenerateNewHandle();
+	LazyGrant.Ability = AbilityClass;
+	LazyGrant.SourceObject = SourceObject;
+	LazyGrant.InputTag = InputTag;
+	LazyGrant.AbilityLevel = AbilityLevel;
+
+	return LazyGrant.Handle;
+}
+
+bool ULyraAbilitySystemComponent::RemoveLazyAbility(FGameplayAbilitySpecHandle Handle)
+{
+	return (LazyAbilityGrants.RemoveAll([Handle](const FLyraLazyAbilityGrant& LazyGrant) { return LazyGrant.Handle == Handle; }) > 0);
+}
+
+bool ULyraAbilitySystemComponent::SetLazyAbilityEnabled(FGameplayAbilitySpecHandle Handle, bool bEnabled)
+{
+	if (FLyraLazyAbilityGrant* LazyGrant = LazyAbilityGrants.FindByPredicate([Handle](const FLyraLazyAbilityGrant& Test) { return Test.Handle == Handle; }))
+	{
+		LazyGrant->bEnabled = bEnabled;
+		return true;
+	}
+
+	return false;
+}
+
+int32 ULyraAbilitySystemComponent::MaterializeLazyAbilitiesByTag(const FGameplayTagContainer& AbilityTags)
+{
+	return MaterializeLazyAbilities([&AbilityTags](const ULyraGameplayAbility* LyraAbilityCDO, const FLyraLazyAbilityGrant& LazyGrant)
+	{
+		return LyraAbilityCDO->HasAllAbilityTags(AbilityTags);
+	});
+}
+
+int32 ULyraAbilitySystemComponent::MaterializeAllLazyAbilities()
+{
+	return MaterializeLazyAbilities([](const ULyraGameplayAbility* LyraAbilityCDO, const FLyraLazyAbilityGrant& LazyGrant) { return true; });
+}
+
+int32 ULyraAbilitySystemComponent::MaterializeLazyAbilities(TShouldMaterializeAbilityFunc ShouldMaterializeFunc, TArray<FGameplayAbilitySpecHandle>* OutDeferredHandles)
+{
+	if ((LazyAbilityGrants.Num() == 0) || !IsOwnerActorAuthoritative())
+	{
+		return 0;
+	}
+
+	// Pull the matching descriptors out first, granting may end up back in here through OnGiveAbility.
+	TArray<FLyraLazyAbilityGrant, TInlineAllocator<4>> GrantsToMaterialize;
+	for (int32 GrantIndex = LazyAbilityGrants.Num() - 1; GrantIndex >= 0; --GrantIndex)
+	{
+		const FLyraLazyAbilityGrant& LazyGrant = LazyAbilityGrants[GrantIndex];
+		const ULyraGameplayAbility* LyraAbilityCDO = LazyGrant.Ability ? LazyGrant.Ability->GetDefaultObject<ULyraGameplayAbility>() : nullptr;
+
+		if (!LyraAbilityCDO)
+		{
+			LazyAbilityGrants.RemoveAtSwap(GrantIndex);
+		}
+		else if (LazyGrant.bEnabled && ShouldMaterializeFunc(LyraAbilityCDO, LazyGrant))
+		{
+			GrantsToMaterialize.Add(LazyGrant);
+			LazyAbilityGrants.RemoveAtSwap(GrantIndex);
+		}
+	}
+
+	for (const FLyraLazyAbilityGrant& LazyGrant : GrantsToMaterialize)
+	{
+		FGameplayAbilitySpec AbilitySpec(LazyGrant.Ability->GetDefaultObject<ULyraGameplayAbility>(), LazyGrant.AbilityLevel, INDEX_NONE, LazyGrant.SourceObject.Get());
+		AbilitySpec.Handle = LazyGrant.Handle;
+		AbilitySpec.DynamicAbilityTags.AddTag(LazyGrant.InputTag);
+
+		// While the ability list is locked the grant is deferred, so anything activating right now will not see it yet.
+		if ((AbilityScopeLockCount > 0) && OutDeferredHandles)
+		{
+			OutDeferredHandles->Add(LazyGrant.Handle);
+		}
+
+		GiveAbility(AbilitySpec);
+		++NumLazyAbilitiesMaterialized;
+	}
+
+	return GrantsToMaterialize.Num();
+}
+
+void ULyraAbilitySystemComponent::DeferLazyActivations(const TArray<FGameplayAbilitySpecHandle>& DeferredHandles, const FGameplayTag& EventTag, const FGameplayEventData* Payload)
+{
+	for (const FGameplayAbilitySpecHandle& DeferredHandle : DeferredHandles)
+	{
+		FDeferredLazyActivation& Deferred = DeferredLazyActivations.AddDefaulted_GetRef();
+		Deferred.Handle = DeferredHandle;
+		Deferred.EventTag = EventTag;
+
+		if (Payload)
+		{
+			Deferred.EventData = *Payload;
+		}
+	}
+}
+
+bool ULyraAbilitySystemComponent::TryActivateAbilitiesByTagIncludingLazy(const FGameplayTagContainer& GameplayTagContainer, bool bAllowRemoteActivation)
+{
+	TArray<FGameplayAbilitySpecHandle> DeferredHandles;
+
+	if (LazyAbilityGrants.Num() > 0)
+	{
+		MaterializeLazyAbilities([&GameplayTagContainer](const ULyraGameplayAbility* LyraAbilityCDO, const FLyraLazyAbilityGrant& LazyGrant)
+		{
+			return LyraAbilityCDO->HasAllAbilityTags(GameplayTagContainer);
+		}, &DeferredHandles);
+
+		DeferLazyActivations(DeferredHandles, FGameplayTag(), nullptr);
+	}
+
+	const bool bActivated = TryActivateAbilitiesByTag(GameplayTagContainer, bAllowRemoteActivation);
+	return bActivated || (DeferredHandles.Num() > 0);
+}
+
+bool ULyraAbilitySystemComponent::TryActivateAbilityByClassIncludingLazy(TSubclassOf<UGameplayAbility> InAbilityToActivate, bool bAllowRemoteActivation)
+{
+	TArray<FGameplayAbilitySpecHandle> DeferredHandles;
+
+	// Only the first spec of the class is activated, so a lazy one is only needed if none has been granted yet.
+	if ((LazyAbilityGrants.Num() > 0) && InAbilityToActivate && !FindAbilitySpecFromClass(InAbilityToActivate))
+	{
+		MaterializeLazyAbilities([&InAbilityToActivate](const ULyraGameplayAbility* LyraAbilityCDO, const FLyraLazyAbilityGrant& LazyGrant)
+		{
+			return (LazyGrant.Ability.Get() == InAbilityToActivate.Get());
+		}, &DeferredHandles);
+
+		DeferLazyActivations(DeferredHandles, FGameplayTag(), nullptr);
+	}
+
+	const bool bActivated = TryActivateAbilityByClass(InAbilityToActivate, bAllowRemoteActivation);
+	return bActivated || (DeferredHandles.Num() > 0);
+}
+
+int32 ULyraAbilitySystemComponent::HandleGameplayEvent(FGameplayTag EventTag, const FGameplayEventData* Payload)
+{
+	if ((LazyAbilityGrants.Num() > 0) && EventTag.IsValid())
+	{
+		TArray<FGameplayAbilitySpecHandle> DeferredHandles;
+
+		MaterializeLazyAbilities([&EventTag](const ULyraGameplayAbility* LyraAbilityCDO, const FLyraLazyAbilityGrant& LazyGrant)
+		{
+			return LyraAbilityCDO->IsTriggeredByGameplayEvent(EventTag);
+		}, &DeferredHandles);
+
+		// The event would reach these abilities before they exist, so it is sent to them again once they are granted.
+		DeferLazyActivations(DeferredHandles, EventTag, Payload);
+	}
+
+	return Super::HandleGameplayEvent(EventTag, Payload);
+}
+
+void ULyraAbilitySystemComponent::AccumulateMemoryReport(FLyraAbilitySystemMemoryReport& InOutReport) const
+{
+	++InOutReport.NumAbilitySystems;
+	InOutReport.NumLazyAbilities += LazyAbilityGrants.Num();
+	InOutReport.NumLazyAbilitiesMaterialized += NumLazyAbilitiesMaterialized;
+	InOutReport.EstimatedBytes += LazyAbilityGrants.Num() * sizeof(FLyraLazyAbilityGrant);
+
+	for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
+	{
+		++InOutReport.NumAbilitySpecs;
+		InOutReport.EstimatedBytes += sizeof(FGameplayAbilitySpec);
+
+		for (const UGameplayAbility* AbilityInstance : AbilitySpec.GetAbilityInstances())
+		{
+			++InOutReport.NumAbilityInstances;
+			InOutReport.EstimatedBytes += AbilityInstance->GetClass()->GetStructureSize();
+		}
+	}
+
+	for (const UAttributeSet* AttributeSet : GetSpawnedAttributes())
+	{
+		if (AttributeSet)
+		{
+			++InOutReport.NumAttributeSets;
+			InOutReport.EstimatedBytes += AttributeSet->GetClass()->GetStructureSize();
+		}
+	}
+}
+
+void ULyraAbilitySystemComponent::GatherMemoryReport(const UWorld* World, FLyraAbilitySystemMemoryReport& OutReport)
+{
+	OutReport = FLyraAbilitySystemMemoryReport();
+
+	for (TObjectIterator<ULyraAbilitySystemComponent> It; It; ++It)
+	{
+		const ULyraAbilitySystemComponent* LyraASC = *It;
+		if (!LyraASC->IsTemplate() && (LyraASC->GetWorld() == World))
+		{
+			LyraASC->AccumulateMemoryReport(OutReport);
+		}
+	}
+}
+
 void ULyraAbilitySystemComponent::SetTagRelationshipMapping(ULyraAbilityTagRelationshipMapping* NewMapping)
 {
 	TagRelationshipMapping = NewMapping;
@@ -557,3 +1013,106 @@ void ULyraAbilitySystemComponent::GetAbilityTargetData(const FGameplayAbilitySpe
 	}
 }
 
+//////////////////////////////////////////////////////////////////////
+
+static FAutoConsoleCommandWithWorldAndArgs DumpAbilityGrantStatsCommand(
+	TEXT("Lyra.AbilitySystem.DumpGrantStats"),
+	TEXT("Prints the ability system footprint of the current world and the cost of granting ability sets. Pass 'reset' to clear the grant counters."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if ((Args.Num() > 0) && (Args[0] == TEXT("reset")))
+		{
+			ULyraAbilitySet::ResetGrantStats();
+			return;
+		}
+
+		FLyraAbilitySystemMemoryReport Report;
+		ULyraAbilitySystemComponent::GatherMemoryReport(World, Report);
+
+		const int32 NumASCs = FMath::Max(Report.NumAbilitySystems, 1);
+		GLog->Logf(TEXT("Ability systems: %d"), Report.NumAbilitySystems);
+		GLog->Logf(TEXT("  Ability specs: %d (%.1f per ASC), ability instances: %d, attribute sets: %d"),
+			Report.NumAbilitySpecs, (float)Report.NumAbilitySpecs / NumASCs, Report.NumAbilityInstances, Report.NumAttributeSets);
+		GLog->Logf(TEXT("  Lazy abilities pending: %d, materialized: %d"), Report.NumLazyAbilities, Report.NumLazyAbilitiesMaterialized);
+		GLog->Logf(TEXT("  Estimated memory: %.1f KB (%.2f KB per ASC)"), Report.EstimatedBytes / 1024.0, Report.EstimatedBytes / 1024.0 / NumASCs);
+
+		const FLyraAbilitySetGrantStats& GrantStats = ULyraAbilitySet::GetGrantStats();
+		GLog->Logf(TEXT("Ability sets given: %d, abilities granted: %d, granted lazily: %d"),
+			GrantStats.NumSetsGiven, GrantStats.NumAbilitiesGranted, GrantStats.NumAbilitiesGrantedLazily);
+		GLog->Logf(TEXT("  Give time: %.2f ms total, %.1f us average, %.1f us max"),
+			GrantStats.GiveTimeSeconds * 1000.0, GrantStats.GiveTimeSeconds * 1000000.0 / FMath::Max(GrantStats.NumSetsGiven, 1), GrantStats.MaxGiveTimeSeconds * 1000000.0);
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkAbilityInputRoutingCommand(
+	TEXT("Lyra.AbilitySystem.BenchmarkInputRouting"),
+	TEXT("Usage: Lyra.AbilitySystem.BenchmarkInputRouting [NumAbilities=100] [NumPresses=10000]. Grants the abilities, spread over the native input tags, to a temporary ability system and times input presses and releases with the input tag index and with a scan of every granted ability."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		const int32 NumAbilities = (Args.Num() > 0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100;
+		const int32 NumPresses = (Args.Num() > 1) ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 10000;
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		AActor* BenchmarkActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		if (!BenchmarkActor)
+		{
+			return;
+		}
+
+		ULyraAbilitySystemComponent* LyraASC = NewObject<ULyraAbilitySystemComponent>(BenchmarkActor);
+		LyraASC->RegisterComponent();
+		LyraASC->InitAbilityActorInfo(BenchmarkActor, BenchmarkActor);
+
+		const FGameplayTag InputTags[] =
+		{
+			LyraGameplayTags::InputTag_Move,
+			LyraGameplayTags::InputTag_Look_Mouse,
+			LyraGameplayTags::InputTag_Look_Stick,
+			LyraGameplayTags::InputTag_Crouch,
+			LyraGameplayTags::InputTag_AutoRun,
+			LyraGameplayTags::InputTag_Confirm,
+			LyraGameplayTags::InputTag_Cancel,
+		};
+		const int32 NumInputTags = UE_ARRAY_COUNT(InputTags);
+
+		for (int32 AbilityIndex = 0; AbilityIndex < NumAbilities; ++AbilityIndex)
+		{
+			FGameplayAbilitySpec AbilitySpec(ULyraGameplayAbility_Reset::StaticClass(), 1);
+			AbilitySpec.DynamicAbilityTags.AddTag(InputTags[AbilityIndex % NumInputTags]);
+			LyraASC->GiveAbility(AbilitySpec);
+		}
+
+		auto TimeInputRouting = [&](bool bIndexed)
+		{
+			const bool bWasIndexed = LyraAbilitySystemCvars::bIndexedAbilityInput;
+			LyraAbilitySystemCvars::bIndexedAbilityInput = bIndexed;
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 PressIndex = 0; PressIndex < NumPresses; ++PressIndex)
+			{
+				const FGameplayTag& InputTag = InputTags[PressIndex % NumInputTags];
+				LyraASC->AbilityInputTagPressed(InputTag);
+				LyraASC->AbilityInputTagReleased(InputTag);
+				LyraASC->ClearAbilityInput();
+			}
+			const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+			LyraAbilitySystemCvars::bIndexedAbilityInput = bWasIndexed;
+			return ElapsedSeconds;
+		};
+
+		const double ScanSeconds = TimeInputRouting(false);
+		const double IndexSeconds = TimeInputRouting(true);
+
+		GLog->Logf(TEXT("Ability input routing, %d abilities over %d input tags, %d presses and releases:"), LyraASC->GetActivatableAbilities().Num(), NumInputTags, NumPresses);
+		GLog->Logf(TEXT("  Scan:  %.3f us per press and release"), ScanSeconds * 1000000.0 / NumPresses);
+		GLog->Logf(TEXT("  Index: %.3f us per press and release (%.1fx)"), IndexSeconds * 1000000.0 / NumPresses, ScanSeconds / FMath::Max(IndexSeconds, UE_SMALL_NUMBER));
+
+		LyraASC->ClearAllAbilities();
+		BenchmarkActor->Destroy();
+	}));
@@ -12,11 +12,62 @@ class AActor;
 class UGameplayAbility;
 class ULyraAbilityTagRelationshipMapping;
 class UObject;
+class UWorld;
 struct FFrame;
 struct FGameplayAbilityTargetDataHandle;
 
 LYRAGAME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Gameplay_AbilityInputBlocked);
 
+/**
+ * FLyraLazyAbilityGrant
+ *
+ *	Descriptor for an ability that was granted lazily (see FLyraAbilitySet_GameplayAbility::bGrantLazily).
+ *	The real ability spec is only created, using the same handle, the first time the ability is asked to activate.
+ */
+USTRUCT()
+struct FLyraLazyAbilityGrant
+{
+	GENERATED_BODY()
+
+	// Handle the ability spec will use once it is granted.
+	UPROPERTY()
+	FGameplayAbilitySpecHandle Handle;
+
+	UPROPERTY()
+	TSubclassOf<ULyraGameplayAbility> Ability;
+
+	UPROPERTY()
+	TWeakObjectPtr<UObject> SourceObject;
+
+	UPROPERTY()
+	FGameplayTag InputTag;
+
+	UPROPERTY()
+	int32 AbilityLevel = 1;
+
+	// Disabled grants (e.g., of stowed equipment) are not granted until they are enabled again.
+	UPROPERTY()
+	bool bEnabled = true;
+};
+
+/**
+ * FLyraAbilitySystemMemoryReport
+ *
+ *	Ability system footprint of every Lyra ability system component in a world, see GatherMemoryReport.
+ */
+struct FLyraAbilitySystemMemoryReport
+{
+	int32 NumAbilitySystems = 0;
+	int32 NumAbilitySpecs = 0;
+	int32 NumAbilityInstances = 0;
+	int32 NumAttributeSets = 0;
+	int32 NumLazyAbilities = 0;
+	int32 NumLazyAbilitiesMaterialized = 0;
+
+	// Approximate size of the specs, ability instances, attribute sets and lazy descriptors (not including containers' slack)
+	int64 EstimatedBytes = 0;
+};
+
 /**
  * ULyraAbilitySystemComponent
  *
@@ -45,6 +96,9 @@ public:
 	void AbilityInputTagPressed(const FGameplayTag& InputTag);
 	void AbilityInputTagReleased(const FGameplayTag& InputTag);
 
+	// Marks the spec dirty after its DynamicAbilityTags were changed, keeping the input tag index up to date.
+	void NotifyAbilitySpecDynamicTagsChanged(FGameplayAbilitySpec& AbilitySpec);
+
 	void ProcessAbilityInput(float DeltaTime, bool bGamePaused);
 	void ClearAbilityInput();
 
@@ -71,11 +125,76 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Lyra|Abilities")
 	static TArray<UGameplayAbility*> GetAbilitiesOfClass(UAbilitySystemComponent* AbilitySystem, TSubclassOf<UGameplayAbility> AbilityClass);
 
+	// Tries to activate the abilities granted by SourceObject that activate on spawn and are not running, e.g. once stowed
+	// equipment is brought back out. Only activates what this machine executes, like the initial on spawn activation.
+	void TryActivateAbilitiesOnSpawnFromSource(const UObject* SourceObject);
+
+	// Returns true if abilities granted to this component may be granted lazily (only for AI-owned ability systems).
+	bool CanGrantAbilitiesLazily() const;
+
+	// Marks this component as belonging to an actor that only AI ever controls (e.g., enemies), so abilities can be
+	// granted lazily before the actor is possessed.
+	void SetOwnerIsAlwaysAI(bool bInOwnerIsAlwaysAI) { bOwnerIsAlwaysAI = bInOwnerIsAlwaysAI; }
+
+	// Registers a lightweight descriptor for the ability instead of granting it, returning the handle its spec will use.
+	FGameplayAbilitySpecHandle AddLazyAbility(TSubclassOf<ULyraGameplayAbility> AbilityClass, int32 AbilityLevel, const FGameplayTag& InputTag, UObject* SourceObject);
+
+	// Removes the descriptor of a lazy ability that was never granted. Returns false if there was none for the handle.
+	bool RemoveLazyAbility(FGameplayAbilitySpecHandle Handle);
+
+	// Enables or disables a lazy ability that was never granted. Returns false if there was none for the handle.
+	bool SetLazyAbilityEnabled(FGameplayAbilitySpecHandle Handle, bool bEnabled);
+
+	// Grants any lazy abilities that have all of the given ability tags, so TryActivateAbilitiesByTag can find them.
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Abilities")
+	int32 MaterializeLazyAbilitiesByTag(const FGameplayTagContainer& AbilityTags);
+
+	// Grants every lazy ability still pending on this component.
+	int32 MaterializeAllLazyAbilities();
+
+	// UAbilitySystemComponent::TryActivateAbilitiesByTag and TryActivateAbilityByClass are not virtual and only see granted
+	// specs. Use these to also reach lazy abilities; they return true if an ability was activated, or will be once its
+	// deferred grant goes through.
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Abilities")
+	bool TryActivateAbilitiesByTagIncludingLazy(const FGameplayTagContainer& GameplayTagContainer, bool bAllowRemoteActivation = true);
+
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Abilities")
+	bool TryActivateAbilityByClassIncludingLazy(TSubclassOf<UGameplayAbility> InAbilityToActivate, bool bAllowRemoteActivation = true);
+
+	int32 GetNumLazyAbilities() const { return LazyAbilityGrants.Num(); }
+
+	//~UAbilitySystemComponent interface
+	virtual int32 HandleGameplayEvent(FGameplayTag EventTag, const FGameplayEventData* Payload) override;
+	virtual void OnRep_ActivateAbilities() override;
+	//~End of UAbilitySystemComponent interface
+
+	// Adds this component's ability system footprint to the report.
+	void AccumulateMemoryReport(FLyraAbilitySystemMemoryReport& InOutReport) const;
+
+	// Sums up the ability system footprint of every Lyra ability system component in the world.
+	static void GatherMemoryReport(const UWorld* World, FLyraAbilitySystemMemoryReport& OutReport);
+
 
 protected:
 
 	void TryActivateAbilitiesOnSpawn();
 
+	typedef TFunctionRef<bool(const ULyraGameplayAbility* LyraAbilityCDO, const FLyraLazyAbilityGrant& LazyGrant)> TShouldMaterializeAbilityFunc;
+	int32 MaterializeLazyAbilities(TShouldMaterializeAbilityFunc ShouldMaterializeFunc, TArray<FGameplayAbilitySpecHandle>* OutDeferredHandles = nullptr);
+
+	// Activates the abilities (or sends them the event that asked for them) once their grant, deferred by the ability list lock, goes through.
+	void DeferLazyActivations(const TArray<FGameplayAbilitySpecHandle>& DeferredHandles, const FGameplayTag& EventTag, const FGameplayEventData* Payload);
+
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+
+	// Indexes the spec under each of its dynamic tags, replacing what it was indexed under before.
+	void IndexAbilitySpecInputTags(const FGameplayAbilitySpec& AbilitySpec);
+	void UnindexAbilitySpecInputTags(FGameplayAbilitySpecHandle Handle);
+
+	// Re-indexes only the specs whose dynamic tags no longer match their index entry, and unindexes the specs that are gone.
+	void SyncAbilityInputTagIndex();
+
 	virtual void AbilitySpecInputPressed(FGameplayAbilitySpec& Spec) override;
 	virtual void AbilitySpecInputReleased(FGameplayAbilitySpec& Spec) override;
 
@@ -105,6 +224,33 @@ protected:
 	// Handles to abilities that have their input held.
 	TArray<FGameplayAbilitySpecHandle> InputHeldSpecHandles;
 
+	// Handles of the granted abilities by dynamic tag (which holds their input tag), in the order they were granted.
+	TMap<FGameplayTag, TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>>> InputTagSpecHandles;
+
+	// Tags each spec is currently indexed under in InputTagSpecHandles.
+	TMap<FGameplayAbilitySpecHandle, FGameplayTagContainer> IndexedSpecInputTags;
+
 	// Number of abilities running in each activation group.
 	int32 ActivationGroupCounts[(uint8)ELyraAbilityActivationGroup::MAX];
+
+	// Abilities that were granted lazily and have not been asked to activate yet (server only).
+	UPROPERTY()
+	TArray<FLyraLazyAbilityGrant> LazyAbilityGrants;
+
+	// Number of lazy abilities that have been turned into real ability specs.
+	int32 NumLazyAbilitiesMaterialized = 0;
+
+	// Set for components of actors that only AI controls, see SetOwnerIsAlwaysAI.
+	bool bOwnerIsAlwaysAI = false;
+
+	// Lazy abilities granted while the ability list was locked, waiting for OnGiveAbility to activate them.
+	// Only held until the lock is released, so the event data is not tracked for garbage collection.
+	struct FDeferredLazyActivation
+	{
+		FGameplayAbilitySpecHandle Handle;
+		FGameplayTag EventTag;
+		FGameplayEventData EventData;
+	};
+
+	TArray<FDeferredLazyActivation> DeferredLazyActivations;
 };
@@ -1,16 +1,34 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "LyraGameplayCueManager.h"
+#include "AssetRegistry/AssetRegistryModule.h"
 #include "Engine/AssetManager.h"
 #include "LyraLogChannels.h"
 #include "GameplayCueSet.h"
 #include "AbilitySystemGlobals.h"
 #include "GameplayTagsManager.h"
 #include "UObject/UObjectThreadContext.h"
+#include "UObject/UnrealType.h"
 #include "Async/Async.h"
+#include "AbilitySystem/LyraAbilitySet.h"
+#include "Character/LyraPawnData.h"
+#include "GameFeatures/GameFeatureAction_AddAbilities.h"
+#include "GameModes/LyraExperienceActionSet.h"
+#include "GameModes/LyraExperienceDefinition.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "SignificanceManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraGameplayCueManager)
 
+DECLARE_STATS_GROUP(TEXT("LyraGameplayCues"), STATGROUP_LyraGameplayCues, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Executed Cues Requested"), STAT_LyraGameplayCues_Requested, STATGROUP_LyraGameplayCues);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Executed Cues Played"), STAT_LyraGameplayCues_Played, STATGROUP_LyraGameplayCues);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Executed Cues Merged"), STAT_LyraGameplayCues_Merged, STATGROUP_LyraGameplayCues);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Executed Cues Deferred"), STAT_LyraGameplayCues_Deferred, STATGROUP_LyraGameplayCues);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Executed Cues Dropped"), STAT_LyraGameplayCues_Dropped, STATGROUP_LyraGameplayCues);
+
 //////////////////////////////////////////////////////////////////////
 
 enum class ELyraEditorLoadMode
@@ -34,11 +52,155 @@ namespace LyraGameplayCueManagerCvars
 		TEXT("Shows all assets that were loaded via LyraGameplayCueManager and are currently in memory."),
 		FConsoleCommandWithArgsDelegate::CreateStatic(ULyraGameplayCueManager::DumpGameplayCues));
 
+	static FAutoConsoleCommand CVarDumpOnDemandGameplayCues(
+		TEXT("Lyra.DumpOnDemandGameplayCues"),
+		TEXT("Shows the gameplay cues that were not preloaded and had to be loaded when first triggered. Pass 'reset' to clear the list afterwards."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (ULyraGameplayCueManager* GCM = ULyraGameplayCueManager::Get())
+			{
+				GCM->DumpOnDemandLoads(*GLog);
+
+				if (Args.Contains(TEXT("reset")))
+				{
+					GCM->ResetOnDemandLoads();
+				}
+			}
+		}));
+
+	static FAutoConsoleCommand CVarDumpCueSchedulerStats(
+		TEXT("Lyra.DumpGameplayCueSchedulerStats"),
+		TEXT("Prints how many executed gameplay cues were played, merged, deferred and dropped by the cue scheduler, then restarts the measurement."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			if (ULyraGameplayCueManager* GCM = ULyraGameplayCueManager::Get())
+			{
+				GCM->DumpCueSchedulerStats(*GLog);
+			}
+		}));
+
 	static ELyraEditorLoadMode LoadMode = ELyraEditorLoadMode::LoadUpfront;
 }
 
+namespace LyraGameplayCueScheduler
+{
+	static bool bEnabled = true;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("Lyra.GameplayCues.Scheduler.Enabled"),
+		bEnabled,
+		TEXT("If true, executed gameplay cues are merged and budgeted at the end of the frame instead of playing immediately (clients only)."),
+		ECVF_Default);
+
+	static int32 MaxCuesPerFrame = 24;
+	static FAutoConsoleVariableRef CVarMaxCuesPerFrame(
+		TEXT("Lyra.GameplayCues.Scheduler.MaxPerFrame"),
+		MaxCuesPerFrame,
+		TEXT("Maximum number of executed gameplay cues played per frame, the closest and most significant targets first. 0 means no limit."),
+		ECVF_Default);
+
+	static int32 MaxCuesPerTagPerFrame = 8;
+	static FAutoConsoleVariableRef CVarMaxCuesPerTagPerFrame(
+		TEXT("Lyra.GameplayCues.Scheduler.MaxPerTagPerFrame"),
+		MaxCuesPerTagPerFrame,
+		TEXT("Maximum number of executed gameplay cues with the same tag played per frame. 0 means no limit."),
+		ECVF_Default);
+
+	static float MergeWindowSeconds = 0.05f;
+	static FAutoConsoleVariableRef CVarMergeWindowSeconds(
+		TEXT("Lyra.GameplayCues.Scheduler.MergeWindow"),
+		MergeWindowSeconds,
+		TEXT("An executed cue is merged into the previous one with the same tag on the same target if that one played less than this many seconds ago."),
+		ECVF_Default);
+
+	static float MaxDeferSeconds = 0.1f;
+	static FAutoConsoleVariableRef CVarMaxDeferSeconds(
+		TEXT("Lyra.GameplayCues.Scheduler.MaxDeferTime"),
+		MaxDeferSeconds,
+		TEXT("Cues over the frame budget wait for the next frames, until they are older than this many seconds and get dropped."),
+		ECVF_Default);
+
+	// True for the pawn of a local player, whose cues are never merged and play first
+	static bool IsLocalPlayerPawn(const AActor* Actor)
+	{
+		const APawn* Pawn = Cast<APawn>(Actor);
+		const APlayerController* PC = Pawn ? Cast<APlayerController>(Pawn->GetController()) : nullptr;
+		return PC && PC->IsLocalController();
+	}
+}
+
 const bool bPreloadEvenInEditor = true;
 
+namespace LyraGameplayCuePreload
+{
+	// Adds every gameplay cue tag held by a tag or tag container property of the object, including nested structs and arrays
+	static void CollectCueTags(const UStruct* Struct, const void* Data, FGameplayTagContainer& OutCueTags)
+	{
+		const FGameplayTag CueRootTag = UGameplayCueSet::BaseGameplayCueTag();
+
+		for (TPropertyValueIterator<FStructProperty> It(Struct, Data); It; ++It)
+		{
+			const UScriptStruct* PropertyStruct = It.Key()->Struct;
+			if (PropertyStruct == FGameplayTag::StaticStruct())
+			{
+				const FGameplayTag& Tag = *static_cast<const FGameplayTag*>(It.Value());
+				if (Tag.MatchesTag(CueRootTag))
+				{
+					OutCueTags.AddTag(Tag);
+				}
+			}
+			else if (PropertyStruct == FGameplayTagContainer::StaticStruct())
+			{
+				for (const FGameplayTag& Tag : *static_cast<const FGameplayTagContainer*>(It.Value()))
+				{
+					if (Tag.MatchesTag(CueRootTag))
+					{
+						OutCueTags.AddTag(Tag);
+					}
+				}
+
+				// The container's parent tags would add the cues' parents
+				It.SkipRecursiveProperty();
+			}
+		}
+	}
+
+	// Adds the gameplay cue tags the asset registry recorded as referenced by the Blueprint class or its Blueprint parents.
+	// This catches tags that only appear in a graph (e.g. on an Execute Gameplay Cue node) and are held by no property.
+	// Cooked registries may leave these references out, experiences list such cues in GameplayCuesToPreload instead.
+	static void CollectReferencedCueTags(const UClass* Class, FGameplayTagContainer& OutCueTags)
+	{
+		const FGameplayTag CueRootTag = UGameplayCueSet::BaseGameplayCueTag();
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+		for (; Class && !Class->HasAnyClassFlags(CLASS_Native); Class = Class->GetSuperClass())
+		{
+			TArray<FAssetIdentifier> References;
+			AssetRegistry.GetDependencies(FAssetIdentifier(Class->GetOutermost()->GetFName()), References, UE::AssetRegistry::EDependencyCategory::SearchableName);
+
+			for (const FAssetIdentifier& Reference : References)
+			{
+				if (Reference.IsValue() && (Reference.ObjectName == FGameplayTag::StaticStruct()->GetFName()))
+				{
+					const FGameplayTag Tag = FGameplayTag::RequestGameplayTag(Reference.ValueName, /*ErrorIfNotFound=*/ false);
+					if (Tag.MatchesTag(CueRootTag))
+					{
+						OutCueTags.AddTag(Tag);
+					}
+				}
+			}
+		}
+	}
+
+	static void CollectCueTags(const UClass* Class, FGameplayTagContainer& OutCueTags)
+	{
+		if (Class)
+		{
+			CollectCueTags(Class, Class->GetDefaultObject(), OutCueTags);
+			CollectReferencedCueTags(Class, OutCueTags);
+		}
+	}
+}
+
 //////////////////////////////////////////////////////////////////////
 
 struct FGameplayCueTagThreadSynchronizeGraphTask : public FAsyncGraphTaskBase
@@ -66,6 +228,12 @@ void ULyraGameplayCueManager::OnCreated()
 	Super::OnCreated();
 
 	UpdateDelayLoadDelegateListeners();
+
+	if (!IsRunningDedicatedServer())
+	{
+		SchedulerStatsStartTime = FPlatformTime::Seconds();
+		PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::FlushScheduledCues);
+	}
 }
 
 void ULyraGameplayCueManager::LoadAlwaysLoadedCues()
@@ -123,6 +291,20 @@ bool ULyraGameplayCueManager::ShouldAsyncLoadMissingGameplayCues() const
 	return true;
 }
 
+bool ULyraGameplayCueManager::HandleMissingGameplayCue(UGameplayCueSet* OwningSet, FGameplayCueNotifyData& CueData, AActor* TargetActor, EGameplayCueEvent::Type EventType, FGameplayCueParameters& Parameters)
+{
+	FOnDemandLoad& OnDemandLoad = OnDemandLoads.FindOrAdd(CueData.GameplayCueTag);
+	if (OnDemandLoad.NumTriggers++ == 0)
+	{
+		OnDemandLoad.FirstTriggerTime = FPlatformTime::Seconds();
+		OnDemandLoad.FirstTarget = GetNameSafe(TargetActor);
+
+		UE_LOG(LogLyra, Log, TEXT("Gameplay cue %s was not preloaded, loading it on demand (triggered on %s)"), *CueData.GameplayCueTag.ToString(), *OnDemandLoad.FirstTarget);
+	}
+
+	return Super::HandleMissingGameplayCue(OwningSet, CueData, TargetActor, EventType, Parameters);
+}
+
 void ULyraGameplayCueManager::DumpGameplayCues(const TArray<FString>& Args)
 {
 	ULyraGameplayCueManager* GCM = Cast<ULyraGameplayCueManager>(UAbilitySystemGlobals::Get().GetGameplayCueManager());
@@ -177,6 +359,359 @@ void ULyraGameplayCueManager::DumpGameplayCues(const TArray<FString>& Args)
 	UE_LOG(LogLyra, Log, TEXT("  ... %d cues in total"), GCM->AlwaysLoadedCues.Num() + GCM->PreloadedCues.Num() + NumMissingCuesLoaded);
 }
 
+void ULyraGameplayCueManager::HandleGameplayCue(AActor* TargetActor, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters, EGameplayCueExecutionOptions Options)
+{
+	// Only one-shot cues are scheduled, the others are stateful and must pair up
+	const bool bSchedule = LyraGameplayCueScheduler::bEnabled && PostActorTickHandle.IsValid() && (EventType == EGameplayCueEvent::Executed) && (TargetActor != nullptr)
+		&& !EnumHasAnyFlags(Options, EGameplayCueExecutionOptions::IgnoreSuppression);
+
+	if (!bSchedule)
+	{
+		Super::HandleGameplayCue(TargetActor, GameplayCueTag, EventType, Parameters, Options);
+		return;
+	}
+
+	++NumCuesRequested;
+	INC_DWORD_STAT(STAT_LyraGameplayCues_Requested);
+
+	const double Now = FPlatformTime::Seconds();
+	const FScheduledCueKey Key(TargetActor, GameplayCueTag);
+
+	// Identical to a cue already waiting this frame or played a moment ago. Cues on or from a local player are feedback
+	// for their own actions (e.g. every hit of a fast firing weapon), so they are never merged.
+	const bool bLocalPlayerCue = LyraGameplayCueScheduler::IsLocalPlayerPawn(TargetActor) || LyraGameplayCueScheduler::IsLocalPlayerPawn(Parameters.Instigator.Get());
+	const double* LastPlayedTime = RecentlyPlayedCues.Find(Key);
+	if (!bLocalPlayerCue && (ScheduledCueKeys.Contains(Key) || (LastPlayedTime && (Now - *LastPlayedTime < LyraGameplayCueScheduler::MergeWindowSeconds))))
+	{
+		++NumCuesMerged;
+		INC_DWORD_STAT(STAT_LyraGameplayCues_Merged);
+		return;
+	}
+
+	ScheduledCueKeys.Add(Key);
+
+	FScheduledCue& ScheduledCue = ScheduledCues.AddDefaulted_GetRef();
+	ScheduledCue.TargetActor = TargetActor;
+	ScheduledCue.GameplayCueTag = GameplayCueTag;
+	ScheduledCue.Parameters = Parameters;
+	ScheduledCue.Options = Options;
+	ScheduledCue.RequestTime = Now;
+}
+
+void ULyraGameplayCueManager::FlushScheduledCues(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	// Forget the cues played before the merge window
+	for (auto It = RecentlyPlayedCues.CreateIterator(); It; ++It)
+	{
+		if (Now - It->Value >= LyraGameplayCueScheduler::MergeWindowSeconds)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	if (ScheduledCues.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+	TArray<const AActor*, TInlineAllocator<4>> LocalPawns;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (PC && PC->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+
+			if (const APawn* LocalPawn = PC->GetPawn())
+			{
+				LocalPawns.Add(LocalPawn);
+			}
+		}
+	}
+
+	const USignificanceManager* SignificanceManager = USignificanceManager::Get(World);
+
+	// Pick this world's cues and rank them by distance to the closest local view, scaled down by significance
+	TArray<FScheduledCue> WorldCues;
+	for (int32 CueIndex = ScheduledCues.Num() - 1; CueIndex >= 0; --CueIndex)
+	{
+		FScheduledCue& ScheduledCue = ScheduledCues[CueIndex];
+		AActor* TargetActor = ScheduledCue.TargetActor.Get();
+		if (TargetActor && (TargetActor->GetWorld() != World))
+		{
+			continue;
+		}
+
+		if (TargetActor)
+		{
+			if (LocalPawns.Contains(TargetActor) || LocalPawns.Contains(ScheduledCue.Parameters.Instigator.Get()))
+			{
+				ScheduledCue.Priority = -1.0f;
+			}
+			else
+			{
+				float DistanceSq = ViewLocations.Num() > 0 ? UE_MAX_FLT : 0.0f;
+				for (const FVector& ViewLocation : ViewLocations)
+				{
+					DistanceSq = FMath::Min(DistanceSq, (float)FVector::DistSquared(ViewLocation, TargetActor->GetActorLocation()));
+				}
+
+				const USignificanceManager::FManagedObjectInfo* SignificanceInfo = SignificanceManager ? SignificanceManager->GetManagedObject(TargetActor) : nullptr;
+				ScheduledCue.Priority = DistanceSq / (1.0f + (SignificanceInfo ? FMath::Max(SignificanceInfo->GetSignificance(), 0.0f) : 0.0f));
+			}
+
+			WorldCues.Add(MoveTemp(ScheduledCue));
+		}
+		else
+		{
+			// The target was destroyed before the cue could play
+			++NumCuesDropped;
+			INC_DWORD_STAT(STAT_LyraGameplayCues_Dropped);
+		}
+
+		ScheduledCues.RemoveAtSwap(CueIndex, 1, EAllowShrinking::No);
+	}
+
+	ScheduledCueKeys.Reset();
+	for (const FScheduledCue& ScheduledCue : ScheduledCues)
+	{
+		ScheduledCueKeys.Add(FScheduledCueKey(ScheduledCue.TargetActor.Get(), ScheduledCue.GameplayCueTag));
+	}
+
+	if (WorldCues.Num() == 0)
+	{
+		return;
+	}
+
+	WorldCues.Sort([](const FScheduledCue& A, const FScheduledCue& B) { return A.Priority < B.Priority; });
+
+	const int32 MaxPerFrame = LyraGameplayCueScheduler::MaxCuesPerFrame;
+	const int32 MaxPerTag = LyraGameplayCueScheduler::MaxCuesPerTagPerFrame;
+
+	TMap<FGameplayTag, int32, TInlineSetAllocator<8>> NumPlayedPerTag;
+	int32 NumPlayed = 0;
+	bool bOverBudget = false;
+
+	for (FScheduledCue& ScheduledCue : WorldCues)
+	{
+		int32& NumPlayedWithTag = NumPlayedPerTag.FindOrAdd(ScheduledCue.GameplayCueTag);
+		const bool bWithinBudget = ((MaxPerFrame <= 0) || (NumPlayed < MaxPerFrame)) && ((MaxPerTag <= 0) || (NumPlayedWithTag < MaxPerTag));
+
+		if (bWithinBudget)
+		{
+			++NumPlayed;
+			++NumPlayedWithTag;
+
+			AActor* TargetActor = ScheduledCue.TargetActor.Get();
+			RecentlyPlayedCues.Add(FScheduledCueKey(TargetActor, ScheduledCue.GameplayCueTag), Now);
+			Super::HandleGameplayCue(TargetActor, ScheduledCue.GameplayCueTag, EGameplayCueEvent::Executed, ScheduledCue.Parameters, ScheduledCue.Options);
+			continue;
+		}
+
+		bOverBudget = true;
+
+		if (Now - ScheduledCue.RequestTime < LyraGameplayCueScheduler::MaxDeferSeconds)
+		{
+			++NumCuesDeferred;
+			INC_DWORD_STAT(STAT_LyraGameplayCues_Deferred);
+
+			const FScheduledCueKey Key(ScheduledCue.TargetActor.Get(), ScheduledCue.GameplayCueTag);
+			ScheduledCueKeys.Add(Key);
+			ScheduledCues.Add(MoveTemp(ScheduledCue));
+		}
+		else
+		{
+			++NumCuesDropped;
+			INC_DWORD_STAT(STAT_LyraGameplayCues_Dropped);
+		}
+	}
+
+	NumCuesPlayed += NumPlayed;
+	INC_DWORD_STAT_BY(STAT_LyraGameplayCues_Played, NumPlayed);
+
+	++NumFramesWithCues;
+	NumFramesOverBudget += bOverBudget ? 1 : 0;
+	MaxCuesPlayedInFrame = FMath::Max(MaxCuesPlayedInFrame, NumPlayed);
+}
+
+void ULyraGameplayCueManager::DumpCueSchedulerStats(FOutputDevice& Ar)
+{
+	const double Now = FPlatformTime::Seconds();
+	const double Elapsed = FMath::Max(Now - SchedulerStatsStartTime, UE_SMALL_NUMBER);
+	const int32 MaxPerFrame = LyraGameplayCueScheduler::MaxCuesPerFrame;
+	const double AveragePlayed = (double)NumCuesPlayed / FMath::Max(NumFramesWithCues, 1);
+
+	Ar.Logf(TEXT("Executed gameplay cues over %.1f s: %lld requested (%.1f/s), %lld played, %lld merged, %lld deferred, %lld dropped, %d waiting"),
+		Elapsed, NumCuesRequested, NumCuesRequested / Elapsed, NumCuesPlayed, NumCuesMerged, NumCuesDeferred, NumCuesDropped, ScheduledCues.Num());
+	Ar.Logf(TEXT("  Budget: %.1f cues per frame with cues on average (%.0f%% of %d), at most %d, %d of %d frames over budget"),
+		AveragePlayed, (MaxPerFrame > 0) ? (100.0 * AveragePlayed / MaxPerFrame) : 0.0, MaxPerFrame, MaxCuesPlayedInFrame, NumFramesOverBudget, NumFramesWithCues);
+
+	SchedulerStatsStartTime = Now;
+	NumCuesRequested = 0;
+	NumCuesPlayed = 0;
+	NumCuesMerged = 0;
+	NumCuesDeferred = 0;
+	NumCuesDropped = 0;
+	NumFramesWithCues = 0;
+	NumFramesOverBudget = 0;
+	MaxCuesPlayedInFrame = 0;
+}
+
+void ULyraGameplayCueManager::DumpOnDemandLoads(FOutputDevice& Ar) const
+{
+	const double Now = FPlatformTime::Seconds();
+
+	Ar.Logf(TEXT("=========== Gameplay cues loaded on demand ==========="));
+	for (const TPair<FGameplayTag, FOnDemandLoad>& Pair : OnDemandLoads)
+	{
+		Ar.Logf(TEXT("  %s: triggered %d times, first on %s %.1f s ago"), *Pair.Key.ToString(), Pair.Value.NumTriggers, *Pair.Value.FirstTarget, Now - Pair.Value.FirstTriggerTime);
+	}
+	Ar.Logf(TEXT("  ... %d cues loaded on demand, add their owners to a preload manifest (pawn data, ability sets) to load them up front"), OnDemandLoads.Num());
+}
+
+void ULyraGameplayCueManager::PreloadCuesForExperience(const ULyraExperienceDefinition* Experience)
+{
+	if (!Experience || !ShouldDelayLoadGameplayCues())
+	{
+		return;
+	}
+
+	// The experience's bundles are loaded by now, anything that is not is skipped
+	FGameplayTagContainer CueTags = Experience->GameplayCuesToPreload;
+	if (Experience->DefaultPawnData)
+	{
+		CueTags.AppendTags(GetCueManifest(Experience->DefaultPawnData));
+	}
+
+	auto AppendActionCueTags = [this, &CueTags](const TArray<TObjectPtr<UGameFeatureAction>>& Actions)
+	{
+		for (const UGameFeatureAction* Action : Actions)
+		{
+			if (const UGameFeatureAction_AddAbilities* AddAbilitiesAction = Cast<UGameFeatureAction_AddAbilities>(Action))
+			{
+				for (const FGameFeatureAbilitiesEntry& Entry : AddAbilitiesAction->AbilitiesList)
+				{
+					for (const TSoftObjectPtr<const ULyraAbilitySet>& AbilitySet : Entry.GrantedAbilitySets)
+					{
+						if (const ULyraAbilitySet* LoadedAbilitySet = AbilitySet.Get())
+						{
+							CueTags.AppendTags(GetCueManifest(LoadedAbilitySet));
+						}
+					}
+
+					for (const FLyraAbilityGrant& Grant : Entry.GrantedAbilities)
+					{
+						LyraGameplayCuePreload::CollectCueTags(Grant.AbilityType.Get(), CueTags);
+					}
+				}
+			}
+		}
+	};
+
+	AppendActionCueTags(Experience->Actions);
+	for (const ULyraExperienceActionSet* ActionSet : Experience->ActionSets)
+	{
+		if (ActionSet)
+		{
+			AppendActionCueTags(ActionSet->Actions);
+		}
+	}
+
+	UE_LOG(LogLyra, Log, TEXT("Preloading %d gameplay cues referenced by experience %s"), CueTags.Num(), *GetNameSafe(Experience));
+	PreloadCueManifest(CueTags, const_cast<ULyraExperienceDefinition*>(Experience));
+}
+
+void ULyraGameplayCueManager::PreloadCuesForPawnData(const TSoftObjectPtr<ULyraPawnData>& PawnData, UObject* Referencer)
+{
+	if (PawnData.IsNull() || !Referencer || !ShouldDelayLoadGameplayCues())
+	{
+		return;
+	}
+
+	if (const ULyraPawnData* LoadedPawnData = PawnData.Get())
+	{
+		PreloadCueManifest(GetCueManifest(LoadedPawnData), Referencer);
+		return;
+	}
+
+	TWeakObjectPtr<UObject> WeakReferencer = Referencer;
+	StreamableManager.RequestAsyncLoad(PawnData.ToSoftObjectPath(), FStreamableDelegate::CreateWeakLambda(this, [this, PawnData, WeakReferencer]()
+		{
+			const ULyraPawnData* LoadedPawnData = PawnData.Get();
+			if (LoadedPawnData && WeakReferencer.IsValid())
+			{
+				PreloadCueManifest(GetCueManifest(LoadedPawnData), WeakReferencer.Get());
+			}
+		}), FStreamableManager::DefaultAsyncLoadPriority, false, false, TEXT("GameplayCueManager"));
+}
+
+const FGameplayTagContainer& ULyraGameplayCueManager::GetCueManifest(const ULyraPawnData* PawnData)
+{
+	check(PawnData);
+
+	if (const FGameplayTagContainer* ExistingManifest = CueManifests.Find(PawnData))
+	{
+		return *ExistingManifest;
+	}
+
+	FGameplayTagContainer CueTags;
+	LyraGameplayCuePreload::CollectCueTags(PawnData->GetClass(), PawnData, CueTags);
+	LyraGameplayCuePreload::CollectCueTags(PawnData->PawnClass.Get(), CueTags);
+
+	for (const ULyraAbilitySet* AbilitySet : PawnData->AbilitySets)
+	{
+		if (AbilitySet)
+		{
+			CueTags.AppendTags(GetCueManifest(AbilitySet));
+		}
+	}
+
+	return CueManifests.Add(PawnData, MoveTemp(CueTags));
+}
+
+const FGameplayTagContainer& ULyraGameplayCueManager::GetCueManifest(const ULyraAbilitySet* AbilitySet)
+{
+	check(AbilitySet);
+
+	if (const FGameplayTagContainer* ExistingManifest = CueManifests.Find(AbilitySet))
+	{
+		return *ExistingManifest;
+	}
+
+	TArray<const UClass*> GrantedClasses;
+	AbilitySet->GetGrantedClasses(GrantedClasses);
+
+	FGameplayTagContainer CueTags;
+	for (const UClass* GrantedClass : GrantedClasses)
+	{
+		LyraGameplayCuePreload::CollectCueTags(GrantedClass, CueTags);
+	}
+
+	return CueManifests.Add(AbilitySet, MoveTemp(CueTags));
+}
+
+void ULyraGameplayCueManager::PreloadCueManifest(const FGameplayTagContainer& CueTags, UObject* Referencer)
+{
+	if (!RuntimeGameplayCueObjectLibrary.CueSet)
+	{
+		return;
+	}
+
+	for (const FGameplayTag& CueTag : CueTags)
+	{
+		if (RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueDataMap.Contains(CueTag))
+		{
+			ProcessTagToPreload(CueTag, Referencer);
+		}
+	}
+}
+
 void ULyraGameplayCueManager::OnGameplayTagLoaded(const FGameplayTag& Tag)
 {
 	FScopeLock ScopeLock(&LoadedGameplayTagsToProcessCS);
@@ -2,12 +2,18 @@
 
 #pragma once
 
+#include "Engine/EngineBaseTypes.h"
 #include "GameplayCueManager.h"
+#include "UObject/ObjectKey.h"
 
 #include "LyraGameplayCueManager.generated.h"
 
+class FOutputDevice;
 class FString;
 class UClass;
+class ULyraAbilitySet;
+class ULyraExperienceDefinition;
+class ULyraPawnData;
 class UObject;
 class UWorld;
 struct FObjectKey;
@@ -32,10 +38,27 @@ public:
 	virtual bool ShouldAsyncLoadRuntimeObjectLibraries() const override;
 	virtual bool ShouldSyncLoadMissingGameplayCues() const override;
 	virtual bool ShouldAsyncLoadMissingGameplayCues() const override;
+	virtual bool HandleMissingGameplayCue(UGameplayCueSet* OwningSet, struct FGameplayCueNotifyData& CueData, AActor* TargetActor, EGameplayCueEvent::Type EventType, FGameplayCueParameters& Parameters) override;
+	virtual void HandleGameplayCue(AActor* TargetActor, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters, EGameplayCueExecutionOptions Options = EGameplayCueExecutionOptions::Default) override;
 	//~End of UGameplayCueManager interface
 
 	static void DumpGameplayCues(const TArray<FString>& Args);
 
+	// Streams in the cues listed by the experience and the ones referenced by its default pawn data and by the ability sets
+	// its actions grant, either in properties or in Blueprint graphs. Called once the experience's bundles are loaded, the
+	// cues stay loaded as long as the experience does.
+	void PreloadCuesForExperience(const ULyraExperienceDefinition* Experience);
+
+	// Streams in the pawn data if needed, then the cues referenced by it. The cues stay loaded as long as Referencer does.
+	void PreloadCuesForPawnData(const TSoftObjectPtr<ULyraPawnData>& PawnData, UObject* Referencer);
+
+	// Prints the cues that were not preloaded and had to be loaded when first triggered
+	void DumpOnDemandLoads(FOutputDevice& Ar) const;
+	void ResetOnDemandLoads() { OnDemandLoads.Reset(); }
+
+	// Prints how many executed cues the scheduler played, merged, deferred and dropped, then restarts the measurement
+	void DumpCueSchedulerStats(FOutputDevice& Ar);
+
 	// When delay loading cues, this will load the cues that must be always loaded anyway
 	void LoadAlwaysLoadedCues();
 
@@ -53,6 +76,14 @@ private:
 	void UpdateDelayLoadDelegateListeners();
 	bool ShouldDelayLoadGameplayCues() const;
 
+	// Returns the cue tags referenced by the pawn data (pawn class, ability sets and the classes they grant), cached per asset
+	const FGameplayTagContainer& GetCueManifest(const ULyraPawnData* PawnData);
+	const FGameplayTagContainer& GetCueManifest(const ULyraAbilitySet* AbilitySet);
+	void PreloadCueManifest(const FGameplayTagContainer& CueTags, UObject* Referencer);
+
+	// Plays the executed cues scheduled for the world this frame, best priority first, within the frame budgets
+	void FlushScheduledCues(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
 private:
 	struct FLoadedGameplayTagToProcessData
 	{
@@ -73,6 +104,53 @@ private:
 	UPROPERTY(transient)
 	TSet<TObjectPtr<UClass>> AlwaysLoadedCues;
 
+	// Cue tags referenced by pawn data and ability sets, built the first time they are preloaded
+	TMap<FObjectKey, FGameplayTagContainer> CueManifests;
+
+	struct FOnDemandLoad
+	{
+		int32 NumTriggers = 0;
+		double FirstTriggerTime = 0.0;
+		FString FirstTarget;
+	};
+
+	// Cues triggered before they were loaded, by tag
+	TMap<FGameplayTag, FOnDemandLoad> OnDemandLoads;
+
+	// Executed cue waiting for the end of the frame to be played, merged or dropped
+	struct FScheduledCue
+	{
+		TWeakObjectPtr<AActor> TargetActor;
+		FGameplayTag GameplayCueTag;
+		FGameplayCueParameters Parameters;
+		EGameplayCueExecutionOptions Options = EGameplayCueExecutionOptions::Default;
+		double RequestTime = 0.0;
+
+		// Lower plays first
+		float Priority = 0.0f;
+	};
+
+	using FScheduledCueKey = TPair<FObjectKey, FGameplayTag>;
+
+	TArray<FScheduledCue> ScheduledCues;
+	TSet<FScheduledCueKey> ScheduledCueKeys;
+
+	// Last time each cue was played on each target, for merging within the window
+	TMap<FScheduledCueKey, double> RecentlyPlayedCues;
+
+	FDelegateHandle PostActorTickHandle;
+
+	// Scheduler stats since SchedulerStatsStartTime
+	double SchedulerStatsStartTime = 0.0;
+	int64 NumCuesRequested = 0;
+	int64 NumCuesPlayed = 0;
+	int64 NumCuesMerged = 0;
+	int64 NumCuesDeferred = 0;
+	int64 NumCuesDropped = 0;
+	int32 NumFramesWithCues = 0;
+	int32 NumFramesOverBudget = 0;
+	int32 MaxCuesPlayedInFrame = 0;
+
 	TArray<FLoadedGameplayTagToProcessData> LoadedGameplayTagsToProcess;
 	FCriticalSection LoadedGameplayTagsToProcessCS;
 	bool bProcessLoadedTagsAfterGC = false;
@@ -71,9 +71,8 @@ ALyraCharacter::ALyraCharacter(const FObjectInitializer& ObjectInitializer)
 	HealthComponent->OnDeathStarted.AddDynamic(this, &ThisClass::OnDeathStarted);
 	HealthComponent->OnDeathFinished.AddDynamic(this, &ThisClass::OnDeathFinished);
 
+	// Mana is a resource of the health component, this only exposes it to blueprints.
 	ManaComponent = CreateDefaultSubobject<ULyraManaComponent>(TEXT("ManaComponent"));
-	ManaComponent->OnDeathStarted.AddDynamic(this, &ThisClass::OnDeathStarted);
-	ManaComponent->OnDeathFinished.AddDynamic(this, &ThisClass::OnDeathFinished);
 
 	CameraComponent = CreateDefaultSubobject<ULyraCameraComponent>(TEXT("CameraComponent"));
 	CameraComponent->SetRelativeLocation(FVector(-300.0f, 0.0f, 75.0f));
@@ -344,7 +343,6 @@ bool ALyraCharacter::HasAnyMatchingGameplayTags(const FGameplayTagContainer& Tag
 void ALyraCharacter::FellOutOfWorld(const class UDamageType& dmgType)
 {
 	HealthComponent->DamageSelfDestruct(/*bFellOutOfWorld=*/ true);
-	ManaComponent->DamageSelfDestruct(true);
 }
 
 void ALyraCharacter::OnDeathStarted(AActor*)
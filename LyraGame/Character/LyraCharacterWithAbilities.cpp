@@ -10,6 +10,8 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraCharacterWithAbilities)
 
+const FName ALyraCharacterWithAbilities::ManaSetName(TEXT("ManaSet"));
+
 ALyraCharacterWithAbilities::ALyraCharacterWithAbilities(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -19,7 +21,7 @@ ALyraCharacterWithAbilities::ALyraCharacterWithAbilities(const FObjectInitialize
 
 	// These attribute sets will be detected by AbilitySystemComponent::InitializeComponent. Keeping a reference so that the sets don't get garbage collected before that.
 	HealthSet = CreateDefaultSubobject<ULyraHealthSet>(TEXT("HealthSet"));
-	ManaSet = CreateDefaultSubobject<ULyraManaSet>(TEXT("ManaSet"));
+	ManaSet = CreateOptionalDefaultSubobject<ULyraManaSet>(ManaSetName);
 	CombatSet = CreateDefaultSubobject<ULyraCombatSet>(TEXT("CombatSet"));
 
 	// AbilitySystemComponent needs to be updated at a high frequency.
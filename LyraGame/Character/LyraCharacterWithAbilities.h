@@ -22,6 +22,9 @@ class LYRAGAME_API ALyraCharacterWithAbilities : public ALyraCharacter
 public:
 	ALyraCharacterWithAbilities(const FObjectInitializer& ObjectInitializer);
 
+	// Name of the mana set subobject, subclasses that create their attribute sets from pawn data skip it with DoNotCreateDefaultSubobject.
+	static const FName ManaSetName;
+
 	virtual void PostInitializeComponents() override;
 
 	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
@@ -35,7 +38,7 @@ private:
 	// Health attribute set used by this actor.
 	UPROPERTY()
 	TObjectPtr<const class ULyraHealthSet> HealthSet;
-	// Mana attribute set used by this actor.
+	// Mana attribute set used by this actor (optional).
 	UPROPERTY()
 	TObjectPtr<const class ULyraManaSet> ManaSet;
 	// Combat attribute set used by this actor.
@@ -4,13 +4,11 @@
 
 #include "AbilitySystem/Attributes/LyraAttributeSet.h"
 #include "LyraLogChannels.h"
-#include "System/LyraAssetManager.h"
-#include "System/LyraGameData.h"
 #include "LyraGameplayTags.h"
-#include "Net/UnrealNetwork.h"
 #include "GameplayEffectExtension.h"
 #include "AbilitySystem/LyraAbilitySystemComponent.h"
 #include "AbilitySystem/Attributes/LyraHealthSet.h"
+#include "AbilitySystem/Attributes/LyraManaSet.h"
 #include "Messages/LyraVerbMessage.h"
 #include "Messages/LyraVerbMessageHelpers.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
@@ -25,91 +23,49 @@ UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Lyra_Elimination_Message, "Lyra.Elimination.Me
 ULyraHealthComponent::ULyraHealthComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	PrimaryComponentTick.bStartWithTickEnabled = false;
-	PrimaryComponentTick.bCanEverTick = false;
-
-	SetIsReplicatedByDefault(true);
-
-	AbilitySystemComponent = nullptr;
 	HealthSet = nullptr;
-	DeathState = ELyraDeathState::NotDead;
-}
-
-void ULyraHealthComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
-{
-	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-
-	DOREPLIFETIME(ULyraHealthComponent, DeathState);
-}
 
-void ULyraHealthComponent::OnUnregister()
-{
-	UninitializeFromAbilitySystem();
+	// Health has to stay the first resource, its depletion is what kills the owner.
+	FLyraResourceDefinition& HealthResource = Resources.AddDefaulted_GetRef();
+	HealthResource.ResourceTag = TAG_Lyra_Resource_Health;
+	HealthResource.Attribute = ULyraHealthSet::GetHealthAttribute();
+	HealthResource.MaxAttribute = ULyraHealthSet::GetMaxHealthAttribute();
 
-	Super::OnUnregister();
+	// Pawns without a mana set (see ULyraPawnData::AttributeSets) simply skip this one.
+	FLyraResourceDefinition& ManaResource = Resources.AddDefaulted_GetRef();
+	ManaResource.ResourceTag = TAG_Lyra_Resource_Mana;
+	ManaResource.Attribute = ULyraManaSet::GetManaAttribute();
+	ManaResource.MaxAttribute = ULyraManaSet::GetMaxManaAttribute();
 }
 
-void ULyraHealthComponent::InitializeWithAbilitySystem(ULyraAbilitySystemComponent* InASC)
+void ULyraHealthComponent::OnAbilitySystemInitialized()
 {
-	AActor* Owner = GetOwner();
-	check(Owner);
-
-	if (AbilitySystemComponent)
-	{
-		UE_LOG(LogLyra, Error, TEXT("LyraHealthComponent: Health component for owner [%s] has already been initialized with an ability system."), *GetNameSafe(Owner));
-		return;
-	}
-
-	AbilitySystemComponent = InASC;
-	if (!AbilitySystemComponent)
-	{
-		UE_LOG(LogLyra, Error, TEXT("LyraHealthComponent: Cannot initialize health component for owner [%s] with NULL ability system."), *GetNameSafe(Owner));
-		return;
-	}
+	Super::OnAbilitySystemInitialized();
 
 	HealthSet = AbilitySystemComponent->GetSet<ULyraHealthSet>();
 	if (!HealthSet)
 	{
-		UE_LOG(LogLyra, Error, TEXT("LyraHealthComponent: Cannot initialize health component for owner [%s] with NULL health set on the ability system."), *GetNameSafe(Owner));
+		UE_LOG(LogLyra, Error, TEXT("LyraHealthComponent: Cannot initialize health component for owner [%s] with NULL health set on the ability system."), *GetNameSafe(GetOwner()));
 		return;
 	}
 
-	// Register to listen for attribute changes.
-	HealthSet->OnHealthChanged.AddUObject(this, &ThisClass::HandleHealthChanged);
-	HealthSet->OnMaxHealthChanged.AddUObject(this, &ThisClass::HandleMaxHealthChanged);
+	// Value changes come through the resource bindings, the set is only needed for the death notification (it carries the damage spec).
 	HealthSet->OnOutOfHealth.AddUObject(this, &ThisClass::HandleOutOfHealth);
 
-	// TEMP: Reset attributes to default values.  Eventually this will be driven by a spread sheet.
-	AbilitySystemComponent->SetNumericAttributeBase(ULyraHealthSet::GetHealthAttribute(), HealthSet->GetMaxHealth());
-
-	ClearGameplayTags();
-
 	OnHealthChanged.Broadcast(this, HealthSet->GetHealth(), HealthSet->GetHealth(), nullptr);
 	OnMaxHealthChanged.Broadcast(this, HealthSet->GetHealth(), HealthSet->GetHealth(), nullptr);
 }
 
-void ULyraHealthComponent::UninitializeFromAbilitySystem()
+void ULyraHealthComponent::OnAbilitySystemUninitialized()
 {
-	ClearGameplayTags();
-
 	if (HealthSet)
 	{
-		HealthSet->OnHealthChanged.RemoveAll(this);
-		HealthSet->OnMaxHealthChanged.RemoveAll(this);
 		HealthSet->OnOutOfHealth.RemoveAll(this);
 	}
 
 	HealthSet = nullptr;
-	AbilitySystemComponent = nullptr;
-}
 
-void ULyraHealthComponent::ClearGameplayTags()
-{
-	if (AbilitySystemComponent)
-	{
-		AbilitySystemComponent->SetLooseGameplayTagCount(LyraGameplayTags::Status_Death_Dying, 0);
-		AbilitySystemComponent->SetLooseGameplayTagCount(LyraGameplayTags::Status_Death_Dead, 0);
-	}
+	Super::OnAbilitySystemUninitialized();
 }
 
 float ULyraHealthComponent::GetHealth() const
@@ -135,14 +91,58 @@ float ULyraHealthComponent::GetHealthNormalized() const
 	return 0.0f;
 }
 
-void ULyraHealthComponent::HandleHealthChanged(AActor* DamageInstigator, AActor* DamageCauser, const FGameplayEffectSpec* DamageEffectSpec, float DamageMagnitude, float OldValue, float NewValue)
+void ULyraHealthComponent::HandleResourceChanged(int32 ResourceIndex, bool bMaxValue, float OldValue, float NewValue, const FOnAttributeChangeData& ChangeData)
 {
-	OnHealthChanged.Broadcast(this, OldValue, NewValue, DamageInstigator);
+	Super::HandleResourceChanged(ResourceIndex, bMaxValue, OldValue, NewValue, ChangeData);
+
+	if (bCoalesceHealthChangedEvents || (Resources[ResourceIndex].ResourceTag != TAG_Lyra_Resource_Health))
+	{
+		return;
+	}
+
+	// The instigator is only known on the server, for changes made by a gameplay effect.
+	AActor* Instigator = ChangeData.GEModData ? ChangeData.GEModData->EffectSpec.GetEffectContext().GetOriginalInstigator() : nullptr;
+
+	if (bMaxValue)
+	{
+		OnMaxHealthChanged.Broadcast(this, OldValue, NewValue, Instigator);
+	}
+	else
+	{
+		OnHealthChanged.Broadcast(this, OldValue, NewValue, Instigator);
+	}
 }
 
-void ULyraHealthComponent::HandleMaxHealthChanged(AActor* DamageInstigator, AActor* DamageCauser, const FGameplayEffectSpec* DamageEffectSpec, float DamageMagnitude, float OldValue, float NewValue)
+void ULyraHealthComponent::HandleResourcesChanged(const TArray<FLyraResourceChange>& Changes)
 {
-	OnMaxHealthChanged.Broadcast(this, OldValue, NewValue, DamageInstigator);
+	Super::HandleResourcesChanged(Changes);
+
+	if (!bCoalesceHealthChangedEvents)
+	{
+		return;
+	}
+
+	// Health listeners hear about the whole frame at once, like OnResourcesChanged listeners.
+	for (const FLyraResourceChange& Change : Changes)
+	{
+		if (Change.ResourceTag != TAG_Lyra_Resource_Health)
+		{
+			continue;
+		}
+
+		// The instigator is only known on the server, for changes made by a gameplay effect.
+		AActor* Instigator = (Change.Instigators.Num() > 0) ? Change.Instigators.Last().Get() : nullptr;
+
+		if (Change.MaxValueChanged())
+		{
+			OnMaxHealthChanged.Broadcast(this, Change.OldMaxValue, Change.NewMaxValue, Instigator);
+		}
+
+		if (Change.ValueChanged())
+		{
+			OnHealthChanged.Broadcast(this, Change.OldValue, Change.NewValue, Instigator);
+		}
+	}
 }
 
 void ULyraHealthComponent::HandleOutOfHealth(AActor* DamageInstigator, AActor* DamageCauser, const FGameplayEffectSpec* DamageEffectSpec, float DamageMagnitude, float OldValue, float NewValue)
@@ -202,127 +202,3 @@ void ULyraHealthComponent::HandleOutOfHealth(AActor* DamageInstigator, AActor* D
 
 #endif // #if WITH_SERVER_CODE
 }
-
-void ULyraHealthComponent::OnRep_DeathState(ELyraDeathState OldDeathState)
-{
-	const ELyraDeathState NewDeathState = DeathState;
-
-	// Revert the death state for now since we rely on StartDeath and FinishDeath to change it.
-	DeathState = OldDeathState;
-
-	if (OldDeathState > NewDeathState)
-	{
-		// The server is trying to set us back but we've already predicted past the server state.
-		UE_LOG(LogLyra, Warning, TEXT("LyraHealthComponent: Predicted past server death state [%d] -> [%d] for owner [%s]."), (uint8)OldDeathState, (uint8)NewDeathState, *GetNameSafe(GetOwner()));
-		return;
-	}
-
-	if (OldDeathState == ELyraDeathState::NotDead)
-	{
-		if (NewDeathState == ELyraDeathState::DeathStarted)
-		{
-			StartDeath();
-		}
-		else if (NewDeathState == ELyraDeathState::DeathFinished)
-		{
-			StartDeath();
-			FinishDeath();
-		}
-		else
-		{
-			UE_LOG(LogLyra, Error, TEXT("LyraHealthComponent: Invalid death transition [%d] -> [%d] for owner [%s]."), (uint8)OldDeathState, (uint8)NewDeathState, *GetNameSafe(GetOwner()));
-		}
-	}
-	else if (OldDeathState == ELyraDeathState::DeathStarted)
-	{
-		if (NewDeathState == ELyraDeathState::DeathFinished)
-		{
-			FinishDeath();
-		}
-		else
-		{
-			UE_LOG(LogLyra, Error, TEXT("LyraHealthComponent: Invalid death transition [%d] -> [%d] for owner [%s]."), (uint8)OldDeathState, (uint8)NewDeathState, *GetNameSafe(GetOwner()));
-		}
-	}
-
-	ensureMsgf((DeathState == NewDeathState), TEXT("LyraHealthComponent: Death transition failed [%d] -> [%d] for owner [%s]."), (uint8)OldDeathState, (uint8)NewDeathState, *GetNameSafe(GetOwner()));
-}
-
-void ULyraHealthComponent::StartDeath()
-{
-	if (DeathState != ELyraDeathState::NotDead)
-	{
-		return;
-	}
-
-	DeathState = ELyraDeathState::DeathStarted;
-
-	if (AbilitySystemComponent)
-	{
-		AbilitySystemComponent->SetLooseGameplayTagCount(LyraGameplayTags::Status_Death_Dying, 1);
-	}
-
-	AActor* Owner = GetOwner();
-	check(Owner);
-
-	OnDeathStarted.Broadcast(Owner);
-
-	Owner->ForceNetUpdate();
-}
-
-void ULyraHealthComponent::FinishDeath()
-{
-	if (DeathState != ELyraDeathState::DeathStarted)
-	{
-		return;
-	}
-
-	DeathState = ELyraDeathState::DeathFinished;
-
-	if (AbilitySystemComponent)
-	{
-		AbilitySystemComponent->SetLooseGameplayTagCount(LyraGameplayTags::Status_Death_Dead, 1);
-	}
-
-	AActor* Owner = GetOwner();
-	check(Owner);
-
-	OnDeathFinished.Broadcast(Owner);
-
-	Owner->ForceNetUpdate();
-}
-
-void ULyraHealthComponent::DamageSelfDestruct(bool bFellOutOfWorld)
-{
-	if ((DeathState == ELyraDeathState::NotDead) && AbilitySystemComponent)
-	{
-		const TSubclassOf<UGameplayEffect> DamageGE = ULyraAssetManager::GetSubclass(ULyraGameData::Get().DamageGameplayEffect_SetByCaller);
-		if (!DamageGE)
-		{
-			UE_LOG(LogLyra, Error, TEXT("LyraHealthComponent: DamageSelfDestruct failed for owner [%s]. Unable to find gameplay effect [%s]."), *GetNameSafe(GetOwner()), *ULyraGameData::Get().DamageGameplayEffect_SetByCaller.GetAssetName());
-			return;
-		}
-
-		FGameplayEffectSpecHandle SpecHandle = AbilitySystemComponent->MakeOutgoingSpec(DamageGE, 1.0f, AbilitySystemComponent->MakeEffectContext());
-		FGameplayEffectSpec* Spec = SpecHandle.Data.Get();
-
-		if (!Spec)
-		{
-			UE_LOG(LogLyra, Error, TEXT("LyraHealthComponent: DamageSelfDestruct failed for owner [%s]. Unable to make outgoing spec for [%s]."), *GetNameSafe(GetOwner()), *GetNameSafe(DamageGE));
-			return;
-		}
-
-		Spec->AddDynamicAssetTag(TAG_Gameplay_DamageSelfDestruct);
-
-		if (bFellOutOfWorld)
-		{
-			Spec->AddDynamicAssetTag(TAG_Gameplay_FellOutOfWorld);
-		}
-
-		const float DamageAmount = GetMaxHealth();
-
-		Spec->SetSetByCallerMagnitude(LyraGameplayTags::SetByCaller_Damage, DamageAmount);
-		AbilitySystemComponent->ApplyGameplayEffectSpecToSelf(*Spec);
-	}
-}
-
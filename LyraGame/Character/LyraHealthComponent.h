@@ -2,7 +2,7 @@
 
 #pragma once
 
-#include "Components/GameFrameworkComponent.h"
+#include "Character/LyraResourceComponent.h"
 
 #include "LyraHealthComponent.generated.h"
 
@@ -14,30 +14,19 @@ class UObject;
 struct FFrame;
 struct FGameplayEffectSpec;
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FLyraHealth_DeathEvent, AActor*, OwningActor);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FLyraHealth_AttributeChanged, ULyraHealthComponent*, HealthComponent, float, OldValue, float, NewValue, AActor*, Instigator);
 
-/**
- * ELyraDeathState
- *
- *	Defines current state of death.
- */
-UENUM(BlueprintType)
-enum class ELyraDeathState : uint8
-{
-	NotDead = 0,
-	DeathStarted,
-	DeathFinished
-};
-
 
 /**
  * ULyraHealthComponent
  *
  *	An actor component used to handle anything related to health.
+ *
+ *	This is the character's resource component, configured by default with health and mana (see ULyraResourceComponent).
+ *	Other resources such as stamina or shields can be added to Resources without adding another replicated component.
  */
 UCLASS(Blueprintable, Meta=(BlueprintSpawnableComponent))
-class LYRAGAME_API ULyraHealthComponent : public UGameFrameworkComponent
+class LYRAGAME_API ULyraHealthComponent : public ULyraResourceComponent
 {
 	GENERATED_BODY()
 
@@ -49,14 +38,6 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Lyra|Health")
 	static ULyraHealthComponent* FindHealthComponent(const AActor* Actor) { return (Actor ? Actor->FindComponentByClass<ULyraHealthComponent>() : nullptr); }
 
-	// Initialize the component using an ability system component.
-	UFUNCTION(BlueprintCallable, Category = "Lyra|Health")
-	void InitializeWithAbilitySystem(ULyraAbilitySystemComponent* InASC);
-
-	// Uninitialize the component, clearing any references to the ability system.
-	UFUNCTION(BlueprintCallable, Category = "Lyra|Health")
-	void UninitializeFromAbilitySystem();
-
 	// Returns the current health value.
 	UFUNCTION(BlueprintCallable, Category = "Lyra|Health")
 	float GetHealth() const;
@@ -69,24 +50,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Lyra|Health")
 	float GetHealthNormalized() const;
 
-	UFUNCTION(BlueprintCallable, Category = "Lyra|Health")
-	ELyraDeathState GetDeathState() const { return DeathState; }
-
-	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Lyra|Health", Meta = (ExpandBoolAsExecs = "ReturnValue"))
-	bool IsDeadOrDying() const { return (DeathState > ELyraDeathState::NotDead); }
-
-	// Begins the death sequence for the owner.
-	virtual void StartDeath();
-
-	// Ends the death sequence for the owner.
-	virtual void FinishDeath();
-
-	// Applies enough damage to kill the owner.
-	virtual void DamageSelfDestruct(bool bFellOutOfWorld = false);
-
 public:
 
 	// Delegate fired when the health value has changed. This is called on the client but the instigator may not be valid
+	// With bCoalesceHealthChangedEvents, fired at most once per frame instead, with the value at the start of the frame and the latest instigator
 	UPROPERTY(BlueprintAssignable)
 	FLyraHealth_AttributeChanged OnHealthChanged;
 
@@ -94,38 +61,25 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FLyraHealth_AttributeChanged OnMaxHealthChanged;
 
-	// Delegate fired when the death sequence has started.
-	UPROPERTY(BlueprintAssignable)
-	FLyraHealth_DeathEvent OnDeathStarted;
-
-	// Delegate fired when the death sequence has finished.
-	UPROPERTY(BlueprintAssignable)
-	FLyraHealth_DeathEvent OnDeathFinished;
-
 protected:
 
-	virtual void OnUnregister() override;
-
-	void ClearGameplayTags();
+	//~ULyraResourceComponent interface
+	virtual void OnAbilitySystemInitialized() override;
+	virtual void OnAbilitySystemUninitialized() override;
+	virtual void HandleResourceChanged(int32 ResourceIndex, bool bMaxValue, float OldValue, float NewValue, const FOnAttributeChangeData& ChangeData) override;
+	virtual void HandleResourcesChanged(const TArray<FLyraResourceChange>& Changes) override;
+	//~End of ULyraResourceComponent interface
 
-	virtual void HandleHealthChanged(AActor* DamageInstigator, AActor* DamageCauser, const FGameplayEffectSpec* DamageEffectSpec, float DamageMagnitude, float OldValue, float NewValue);
-	virtual void HandleMaxHealthChanged(AActor* DamageInstigator, AActor* DamageCauser, const FGameplayEffectSpec* DamageEffectSpec, float DamageMagnitude, float OldValue, float NewValue);
 	virtual void HandleOutOfHealth(AActor* DamageInstigator, AActor* DamageCauser, const FGameplayEffectSpec* DamageEffectSpec, float DamageMagnitude, float OldValue, float NewValue);
 
-	UFUNCTION()
-	virtual void OnRep_DeathState(ELyraDeathState OldDeathState);
-
 protected:
 
-	// Ability system used by this component.
-	UPROPERTY()
-	TObjectPtr<ULyraAbilitySystemComponent> AbilitySystemComponent;
+	// If set, OnHealthChanged and OnMaxHealthChanged fold all changes of a frame into one broadcast at the end of it (e.g., for
+	// crowds of AI whose listeners do not need every tick of a DoT), like OnResourcesChanged.
+	UPROPERTY(EditDefaultsOnly, Category = "Lyra|Health")
+	bool bCoalesceHealthChangedEvents = false;
 
 	// Health set used by this component.
 	UPROPERTY()
 	TObjectPtr<const ULyraHealthSet> HealthSet;
-
-	// Replicated state used to handle dying.
-	UPROPERTY(ReplicatedUsing = OnRep_DeathState)
-	ELyraDeathState DeathState;
 };
@@ -248,6 +248,9 @@ void ULyraHeroComponent::InitializePlayerInput(UInputComponent* PlayerInputCompo
 
 	Subsystem->ClearAllMappings();
 
+	// Bindings of additional configs belonged to the previous input component
+	AdditionalInputConfigBinds.Reset();
+
 	if (const ULyraPawnExtensionComponent* PawnExtComp = ULyraPawnExtensionComponent::FindPawnExtensionComponent(Pawn))
 	{
 		if (const ULyraPawnData* PawnData = PawnExtComp->GetPawnData<ULyraPawnData>())
@@ -311,7 +314,17 @@ void ULyraHeroComponent::InitializePlayerInput(UInputComponent* PlayerInputCompo
 
 void ULyraHeroComponent::AddAdditionalInputConfig(const ULyraInputConfig* InputConfig)
 {
-	TArray<uint32> BindHandles;
+	if (!InputConfig)
+	{
+		return;
+	}
+
+	// Each config is only bound once, however many times game features ask for it
+	if (FAdditionalInputConfigBinds* ExistingBinds = AdditionalInputConfigBinds.Find(FObjectKey(InputConfig)))
+	{
+		++ExistingBinds->NumReferences;
+		return;
+	}
 
 	const APawn* Pawn = GetPawn<APawn>();
 	if (!Pawn)
@@ -333,14 +346,32 @@ void ULyraHeroComponent::AddAdditionalInputConfig(const ULyraInputConfig* InputC
 		ULyraInputComponent* LyraIC = Pawn->FindComponentByClass<ULyraInputComponent>();
 		if (ensureMsgf(LyraIC, TEXT("Unexpected Input Component class! The Gameplay Abilities will not be bound to their inputs. Change the input component to ULyraInputComponent or a subclass of it.")))
 		{
-			LyraIC->BindAbilityActions(InputConfig, this, &ThisClass::Input_AbilityInputTagPressed, &ThisClass::Input_AbilityInputTagReleased, /*out*/ BindHandles);
+			FAdditionalInputConfigBinds& Binds = AdditionalInputConfigBinds.Add(FObjectKey(InputConfig));
+			Binds.NumReferences = 1;
+			LyraIC->BindAbilityActions(InputConfig, this, &ThisClass::Input_AbilityInputTagPressed, &ThisClass::Input_AbilityInputTagReleased, /*out*/ Binds.BindHandles);
 		}
 	}
 }
 
 void ULyraHeroComponent::RemoveAdditionalInputConfig(const ULyraInputConfig* InputConfig)
 {
-	//@TODO: Implement me!
+	FAdditionalInputConfigBinds* Binds = AdditionalInputConfigBinds.Find(FObjectKey(InputConfig));
+	if (!Binds || (--Binds->NumReferences > 0))
+	{
+		// Still wanted by another game feature
+		return;
+	}
+
+	const TArray<uint32> BindHandles = MoveTemp(Binds->BindHandles);
+	AdditionalInputConfigBinds.Remove(FObjectKey(InputConfig));
+
+	if (const APawn* Pawn = GetPawn<APawn>())
+	{
+		if (ULyraInputComponent* LyraIC = Pawn->FindComponentByClass<ULyraInputComponent>())
+		{
+			LyraIC->RemoveBinds(BindHandles);
+		}
+	}
 }
 
 bool ULyraHeroComponent::IsReadyToBindInputs() const
@@ -7,6 +7,7 @@
 #include "GameFeatures/GameFeatureAction_AddInputContextMapping.h"
 #include "GameplayAbilitySpecHandle.h"
 #include "InputActionValue.h"
+#include "UObject/ObjectKey.h"
 #include "LyraHeroComponent.generated.h"
 
 class ULyraAbilitySystemComponent;
@@ -49,10 +50,10 @@ public:
 	/** Clears the camera override if it is set */
 	void ClearAbilityCameraMode(const FGameplayAbilitySpecHandle& OwningSpecHandle);
 
-	/** Adds mode-specific input config */
+	/** Adds mode-specific input config, each add must be paired with a RemoveAdditionalInputConfig */
 	void AddAdditionalInputConfig(const ULyraInputConfig* InputConfig);
 
-	/** Removes a mode-specific input config if it has been added */
+	/** Removes a mode-specific input config if it has been added, its binds go once every add has been removed */
 	void RemoveAdditionalInputConfig(const ULyraInputConfig* InputConfig);
 
 	/** True if this is controlled by a real player and has progressed far enough in initialization where additional input bindings can be added */
@@ -124,6 +125,17 @@ protected:
 	/** True when player input bindings have been applied, will never be true for non - players */
 	bool bReadyToBindInputs;
 
+	struct FAdditionalInputConfigBinds
+	{
+		TArray<uint32> BindHandles;
+
+		/** Number of AddAdditionalInputConfig calls not removed yet */
+		int32 NumReferences = 0;
+	};
+
+	/** Binds of each additional input config bound to the current input component */
+	TMap<FObjectKey, FAdditionalInputConfigBinds> AdditionalInputConfigBinds;
+
 private:
 	TObjectPtr<ULockOnTargetComponent> LockOnTarget;
 
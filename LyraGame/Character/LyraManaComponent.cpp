@@ -2,21 +2,16 @@
 
 #include "Character/LyraManaComponent.h"
 
-#include "AbilitySystem/Attributes/LyraAttributeSet.h"
-#include "LyraLogChannels.h"
-#include "System/LyraAssetManager.h"
-#include "System/LyraGameData.h"
-#include "LyraGameplayTags.h"
-#include "Net/UnrealNetwork.h"
-#include "GameplayEffectExtension.h"
 #include "AbilitySystem/LyraAbilitySystemComponent.h"
-#include "AbilitySystem/Attributes/LyraHealthSet.h"
 #include "AbilitySystem/Attributes/LyraManaSet.h"
+#include "Character/LyraPawnData.h"
+#include "Character/LyraPawnExtensionComponent.h"
+#include "Character/LyraResourceComponent.h"
+#include "GameFramework/GameplayMessageSubsystem.h"
+#include "GameplayEffect.h"
+#include "LyraLogChannels.h"
 #include "Messages/LyraVerbMessage.h"
 #include "Messages/LyraVerbMessageHelpers.h"
-#include "GameFramework/GameplayMessageSubsystem.h"
-#include "GameFramework/PlayerState.h"
-#include "Engine/World.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraManaComponent)
 
@@ -29,18 +24,8 @@ ULyraManaComponent::ULyraManaComponent(const FObjectInitializer& ObjectInitializ
 	PrimaryComponentTick.bStartWithTickEnabled = false;
 	PrimaryComponentTick.bCanEverTick = false;
 
-	SetIsReplicatedByDefault(true);
-
-	AbilitySystemComponent = nullptr;
+	ResourceComponent = nullptr;
 	ManaSet = nullptr;
-	DeathState = ELyraDeathState::NotDead;
-}
-
-void ULyraManaComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
-{
-	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-
-	DOREPLIFETIME(ULyraManaComponent, DeathState);
 }
 
 void ULyraManaComponent::OnUnregister()
@@ -55,244 +40,188 @@ void ULyraManaComponent::InitializeWithAbilitySystem(ULyraAbilitySystemComponent
 	AActor* Owner = GetOwner();
 	check(Owner);
 
-	if (AbilitySystemComponent)
+	if (ResourceComponent)
 	{
-		UE_LOG(LogLyra, Error, TEXT("LyraManaComponent: Mana component for owner [%s] has already been initialized with an ability system."), *GetNameSafe(Owner));
+		UE_LOG(LogLyra, Error, TEXT("LyraManaComponent: Mana component for owner [%s] has already been initialized."), *GetNameSafe(Owner));
 		return;
 	}
 
-	AbilitySystemComponent = InASC;
-	if (!AbilitySystemComponent)
+	ResourceComponent = ULyraResourceComponent::FindResourceComponent(Owner);
+	if (!ResourceComponent)
 	{
-		UE_LOG(LogLyra, Error, TEXT("LyraManaComponent: Cannot initialize health component for owner [%s] with NULL ability system."), *GetNameSafe(Owner));
+		UE_LOG(LogLyra, Error, TEXT("LyraManaComponent: Owner [%s] has no resource component to read mana from."), *GetNameSafe(Owner));
 		return;
 	}
 
-	ManaSet = AbilitySystemComponent->GetSet<ULyraManaSet>();
-	if (!ManaSet)
+	if (!ResourceComponent->HasResource(TAG_Lyra_Resource_Mana))
 	{
-		UE_LOG(LogLyra, Error, TEXT("LyraManaComponent: Cannot initialize health component for owner [%s] with NULL health set on the ability system."), *GetNameSafe(Owner));
-		return;
+		// Pawns whose pawn data leaves out the mana set (e.g. AI that never cast anything) simply have no mana,
+		// but a pawn whose pawn data lists it should have it by now.
+		const ULyraPawnExtensionComponent* PawnExtComp = ULyraPawnExtensionComponent::FindPawnExtensionComponent(Owner);
+		const ULyraPawnData* PawnData = PawnExtComp ? PawnExtComp->GetPawnData<ULyraPawnData>() : nullptr;
+		if (!PawnData || PawnData->AttributeSets.Contains(ULyraManaSet::StaticClass()))
+		{
+			UE_LOG(LogLyra, Error, TEXT("LyraManaComponent: Cannot initialize mana component for owner [%s] with NULL mana set on the ability system."), *GetNameSafe(Owner));
+		}
+		else
+		{
+			UE_LOG(LogLyra, Verbose, TEXT("LyraManaComponent: Owner [%s] has no mana set in its pawn data, mana is disabled."), *GetNameSafe(Owner));
+		}
 	}
 
-	// Register to listen for attribute changes.
-	ManaSet->OnManaChanged.AddUObject(this, &ThisClass::HandleManaChanged);
-	ManaSet->OnMaxManaChanged.AddUObject(this, &ThisClass::HandleMaxManaChanged);
-	ManaSet->OnOutOfMana.AddUObject(this, &ThisClass::HandleOutOfMana);
-
-	// TEMP: Reset attributes to default values.  Eventually this will be driven by a spread sheet.
-	AbilitySystemComponent->SetNumericAttributeBase(ULyraManaSet::GetManaAttribute(), ManaSet->GetMaxMana());
+	if (bCoalesceManaChangedEvents)
+	{
+		ResourceComponent->OnResourcesChanged.AddDynamic(this, &ThisClass::HandleResourcesChanged);
+	}
+	else
+	{
+		ResourceComponent->OnResourceChangedImmediate.AddUObject(this, &ThisClass::HandleResourceChangedImmediate);
+	}
+	ResourceComponent->OnDeathStarted.AddDynamic(this, &ThisClass::HandleDeathStarted);
+	ResourceComponent->OnDeathFinished.AddDynamic(this, &ThisClass::HandleDeathFinished);
 
-	ClearGameplayTags();
+	// Value changes come through the resource component, the set is only needed for the out of mana notification.
+	ManaSet = InASC ? InASC->GetSet<ULyraManaSet>() : nullptr;
+	if (ManaSet)
+	{
+		ManaSet->OnOutOfMana.AddUObject(this, &ThisClass::HandleOutOfMana);
+	}
 
-	OnManaChanged.Broadcast(this, ManaSet->GetMana(), ManaSet->GetMana(), nullptr);
-	OnMaxManaChanged.Broadcast(this, ManaSet->GetMana(), ManaSet->GetMana(), nullptr);
+	OnManaChanged.Broadcast(this, GetMana(), GetMana(), nullptr);
+	OnMaxManaChanged.Broadcast(this, GetMaxMana(), GetMaxMana(), nullptr);
 }
 
 void ULyraManaComponent::UninitializeFromAbilitySystem()
 {
-	ClearGameplayTags();
+	if (ResourceComponent)
+	{
+		ResourceComponent->OnResourcesChanged.RemoveAll(this);
+		ResourceComponent->OnResourceChangedImmediate.RemoveAll(this);
+		ResourceComponent->OnDeathStarted.RemoveAll(this);
+		ResourceComponent->OnDeathFinished.RemoveAll(this);
+	}
 
 	if (ManaSet)
 	{
-		ManaSet->OnManaChanged.RemoveAll(this);
-		ManaSet->OnMaxManaChanged.RemoveAll(this);
 		ManaSet->OnOutOfMana.RemoveAll(this);
 	}
 
+	ResourceComponent = nullptr;
 	ManaSet = nullptr;
-	AbilitySystemComponent = nullptr;
-}
-
-void ULyraManaComponent::ClearGameplayTags()
-{
-	if (AbilitySystemComponent)
-	{
-		// Health Component already takes care of this and we don't want to clear when mana is out, only health.
-		//AbilitySystemComponent->SetLooseGameplayTagCount(LyraGameplayTags::Status_Death_Dying, 0);
-		//AbilitySystemComponent->SetLooseGameplayTagCount(LyraGameplayTags::Status_Death_Dead, 0);
-	}
 }
 
 float ULyraManaComponent::GetMana() const
 {
-	return (ManaSet ? ManaSet->GetMana() : 0.0f);
+	return (ResourceComponent ? ResourceComponent->GetResourceValue(TAG_Lyra_Resource_Mana) : 0.0f);
 }
 
 float ULyraManaComponent::GetMaxMana() const
 {
-	return (ManaSet ? ManaSet->GetMaxMana() : 0.0f);
+	return (ResourceComponent ? ResourceComponent->GetResourceMaxValue(TAG_Lyra_Resource_Mana) : 0.0f);
 }
 
 float ULyraManaComponent::GetManaNormalized() const
 {
-	if (ManaSet)
-	{
-		const float Mana = ManaSet->GetMana();
-		const float MaxMana = ManaSet->GetMaxMana();
-
-		return ((MaxMana > 0.0f) ? (Mana / MaxMana) : 0.0f);
-	}
-
-	return 0.0f;
-}
-
-void ULyraManaComponent::HandleManaChanged(AActor* DamageInstigator, AActor* DamageCauser, const FGameplayEffectSpec* DamageEffectSpec, float DamageMagnitude, float OldValue, float NewValue)
-{
-	OnManaChanged.Broadcast(this, OldValue, NewValue, DamageInstigator);
+	return (ResourceComponent ? ResourceComponent->GetResourceNormalized(TAG_Lyra_Resource_Mana) : 0.0f);
 }
 
-void ULyraManaComponent::HandleMaxManaChanged(AActor* DamageInstigator, AActor* DamageCauser, const FGameplayEffectSpec* DamageEffectSpec, float DamageMagnitude, float OldValue, float NewValue)
+ELyraDeathState ULyraManaComponent::GetDeathState() const
 {
-	OnMaxManaChanged.Broadcast(this, OldValue, NewValue, DamageInstigator);
+	return (ResourceComponent ? ResourceComponent->GetDeathState() : ELyraDeathState::NotDead);
 }
 
-void ULyraManaComponent::HandleOutOfMana(AActor* DamageInstigator, AActor* DamageCauser, const FGameplayEffectSpec* DamageEffectSpec, float DamageMagnitude, float OldValue, float NewValue)
+void ULyraManaComponent::StartDeath()
 {
-#if WITH_SERVER_CODE
-	if (AbilitySystemComponent && DamageEffectSpec)
+	if (ResourceComponent)
 	{
-		// Send a standardized verb message that other systems can observe
-		{
-			FLyraVerbMessage Message;
-			Message.Verb = TAG_Lyra_OutOfMana_Message;
-			Message.Instigator = DamageInstigator;
-			Message.InstigatorTags = *DamageEffectSpec->CapturedSourceTags.GetAggregatedTags();
-			Message.Target = ULyraVerbMessageHelpers::GetPlayerStateFromObject(AbilitySystemComponent->GetAvatarActor());
-			Message.TargetTags = *DamageEffectSpec->CapturedTargetTags.GetAggregatedTags();
-			//@TODO: Fill out context tags, and any non-ability-system source/instigator tags
-			//@TODO: Determine if it's an opposing team kill, self-own, team kill, etc...
-
-			UGameplayMessageSubsystem& MessageSystem = UGameplayMessageSubsystem::Get(GetWorld());
-			MessageSystem.BroadcastMessage(Message.Verb, Message);
-		}
-
-		//@TODO: assist messages (could compute from damage dealt elsewhere)?
+		ResourceComponent->StartDeath();
 	}
-
-#endif // #if WITH_SERVER_CODE
 }
 
-void ULyraManaComponent::OnRep_DeathState(ELyraDeathState OldDeathState)
+void ULyraManaComponent::FinishDeath()
 {
-	const ELyraDeathState NewDeathState = DeathState;
-
-	// Revert the death state for now since we rely on StartDeath and FinishDeath to change it.
-	DeathState = OldDeathState;
-
-	if (OldDeathState > NewDeathState)
+	if (ResourceComponent)
 	{
-		// The server is trying to set us back but we've already predicted past the server state.
-		UE_LOG(LogLyra, Warning, TEXT("LyraManaComponent: Predicted past server death state [%d] -> [%d] for owner [%s]."), (uint8)OldDeathState, (uint8)NewDeathState, *GetNameSafe(GetOwner()));
-		return;
+		ResourceComponent->FinishDeath();
 	}
-
-	if (OldDeathState == ELyraDeathState::NotDead)
-	{
-		if (NewDeathState == ELyraDeathState::DeathStarted)
-		{
-			StartDeath();
-		}
-		else if (NewDeathState == ELyraDeathState::DeathFinished)
-		{
-			StartDeath();
-			FinishDeath();
-		}
-		else
-		{
-			UE_LOG(LogLyra, Error, TEXT("LyraManaComponent: Invalid death transition [%d] -> [%d] for owner [%s]."), (uint8)OldDeathState, (uint8)NewDeathState, *GetNameSafe(GetOwner()));
-		}
-	}
-	else if (OldDeathState == ELyraDeathState::DeathStarted)
-	{
-		if (NewDeathState == ELyraDeathState::DeathFinished)
-		{
-			FinishDeath();
-		}
-		else
-		{
-			UE_LOG(LogLyra, Error, TEXT("LyraManaComponent: Invalid death transition [%d] -> [%d] for owner [%s]."), (uint8)OldDeathState, (uint8)NewDeathState, *GetNameSafe(GetOwner()));
-		}
-	}
-
-	ensureMsgf((DeathState == NewDeathState), TEXT("LyraManaComponent: Death transition failed [%d] -> [%d] for owner [%s]."), (uint8)OldDeathState, (uint8)NewDeathState, *GetNameSafe(GetOwner()));
 }
 
-void ULyraManaComponent::StartDeath()
+void ULyraManaComponent::DamageSelfDestruct(bool bFellOutOfWorld)
 {
-	if (DeathState != ELyraDeathState::NotDead)
-	{
-		return;
-	}
-
-	DeathState = ELyraDeathState::DeathStarted;
-
-	if (AbilitySystemComponent)
+	if (ResourceComponent)
 	{
-		AbilitySystemComponent->SetLooseGameplayTagCount(LyraGameplayTags::Status_Death_Dying, 1);
+		ResourceComponent->DamageSelfDestruct(bFellOutOfWorld);
 	}
-
-	AActor* Owner = GetOwner();
-	check(Owner);
-
-	OnDeathStarted.Broadcast(Owner);
-
-	Owner->ForceNetUpdate();
 }
 
-void ULyraManaComponent::FinishDeath()
+void ULyraManaComponent::HandleResourceChangedImmediate(ULyraResourceComponent* InResourceComponent, const FGameplayTag& ResourceTag, bool bMaxValue, float OldValue, float NewValue, AActor* Instigator)
 {
-	if (DeathState != ELyraDeathState::DeathStarted)
+	if (ResourceTag != TAG_Lyra_Resource_Mana)
 	{
 		return;
 	}
 
-	DeathState = ELyraDeathState::DeathFinished;
-
-	if (AbilitySystemComponent)
+	if (bMaxValue)
 	{
-		AbilitySystemComponent->SetLooseGameplayTagCount(LyraGameplayTags::Status_Death_Dead, 1);
+		OnMaxManaChanged.Broadcast(this, OldValue, NewValue, Instigator);
+	}
+	else
+	{
+		OnManaChanged.Broadcast(this, OldValue, NewValue, Instigator);
 	}
-
-	AActor* Owner = GetOwner();
-	check(Owner);
-
-	OnDeathFinished.Broadcast(Owner);
-
-	Owner->ForceNetUpdate();
 }
 
-void ULyraManaComponent::DamageSelfDestruct(bool bFellOutOfWorld)
+void ULyraManaComponent::HandleResourcesChanged(ULyraResourceComponent* InResourceComponent, const TArray<FLyraResourceChange>& Changes)
 {
-	if ((DeathState == ELyraDeathState::NotDead) && AbilitySystemComponent)
+	for (const FLyraResourceChange& Change : Changes)
 	{
-		const TSubclassOf<UGameplayEffect> DamageGE = ULyraAssetManager::GetSubclass(ULyraGameData::Get().DamageGameplayEffect_SetByCaller);
-		if (!DamageGE)
+		if (Change.ResourceTag != TAG_Lyra_Resource_Mana)
 		{
-			UE_LOG(LogLyra, Error, TEXT("LyraManaComponent: DamageSelfDestruct failed for owner [%s]. Unable to find gameplay effect [%s]."), *GetNameSafe(GetOwner()), *ULyraGameData::Get().DamageGameplayEffect_SetByCaller.GetAssetName());
-			return;
+			continue;
 		}
 
-		FGameplayEffectSpecHandle SpecHandle = AbilitySystemComponent->MakeOutgoingSpec(DamageGE, 1.0f, AbilitySystemComponent->MakeEffectContext());
-		FGameplayEffectSpec* Spec = SpecHandle.Data.Get();
+		AActor* Instigator = (Change.Instigators.Num() > 0) ? Change.Instigators.Last().Get() : nullptr;
 
-		if (!Spec)
+		if (Change.MaxValueChanged())
 		{
-			UE_LOG(LogLyra, Error, TEXT("LyraManaComponent: DamageSelfDestruct failed for owner [%s]. Unable to make outgoing spec for [%s]."), *GetNameSafe(GetOwner()), *GetNameSafe(DamageGE));
-			return;
+			OnMaxManaChanged.Broadcast(this, Change.OldMaxValue, Change.NewMaxValue, Instigator);
 		}
 
-		Spec->AddDynamicAssetTag(TAG_Gameplay_DamageSelfDestruct);
-
-		if (bFellOutOfWorld)
+		if (Change.ValueChanged())
 		{
-			Spec->AddDynamicAssetTag(TAG_Gameplay_FellOutOfWorld);
+			OnManaChanged.Broadcast(this, Change.OldValue, Change.NewValue, Instigator);
 		}
+	}
+}
 
-		const float DamageAmount = GetMaxMana();
+void ULyraManaComponent::HandleOutOfMana(AActor* DamageInstigator, AActor* DamageCauser, const FGameplayEffectSpec* DamageEffectSpec, float DamageMagnitude, float OldValue, float NewValue)
+{
+#if WITH_SERVER_CODE
+	if (ManaSet && DamageEffectSpec)
+	{
+		// Send a standardized verb message that other systems can observe
+		{
+			FLyraVerbMessage Message;
+			Message.Verb = TAG_Lyra_OutOfMana_Message;
+			Message.Instigator = DamageInstigator;
+			Message.InstigatorTags = *DamageEffectSpec->CapturedSourceTags.GetAggregatedTags();
+			Message.Target = ULyraVerbMessageHelpers::GetPlayerStateFromObject(GetOwner());
+			Message.TargetTags = *DamageEffectSpec->CapturedTargetTags.GetAggregatedTags();
 
-		Spec->SetSetByCallerMagnitude(LyraGameplayTags::SetByCaller_Damage, DamageAmount);
-		AbilitySystemComponent->ApplyGameplayEffectSpecToSelf(*Spec);
+			UGameplayMessageSubsystem& MessageSystem = UGameplayMessageSubsystem::Get(GetWorld());
+			MessageSystem.BroadcastMessage(Message.Verb, Message);
+		}
 	}
+
+#endif // #if WITH_SERVER_CODE
 }
 
+void ULyraManaComponent::HandleDeathStarted(AActor* OwningActor)
+{
+	OnDeathStarted.Broadcast(OwningActor);
+}
+
+void ULyraManaComponent::HandleDeathFinished(AActor* OwningActor)
+{
+	OnDeathFinished.Broadcast(OwningActor);
+}
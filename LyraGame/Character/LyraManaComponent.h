@@ -11,9 +11,9 @@ class ULyraManaComponent;
 
 class ULyraAbilitySystemComponent;
 class ULyraManaSet;
+class ULyraResourceComponent;
 class UObject;
 struct FFrame;
-struct FGameplayEffectSpec;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FLyraMana_DeathEvent, AActor*, OwningActor);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FLyraMana_AttributeChanged, ULyraManaComponent*, ManaComponent, float, OldValue, float, NewValue, AActor*, Instigator);
@@ -21,7 +21,12 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FLyraMana_AttributeChanged, ULyraM
 /**
  * ULyraManaComponent
  *
- *	An actor component used to handle anything related to health.
+ *	Blueprint-facing view of the mana resource of the owner's ULyraResourceComponent (the health component on characters).
+ *
+ *	Mana used to carry its own replicated death state and attribute bindings; it now has no state of its own and is not
+ *	replicated, everything is read from and forwarded by the owner's resource component. Running out of mana still sends
+ *	the "Lyra.OutOfMana.Message" verb message, but it no longer has a death sequence of its own: the death state and
+ *	events below are the owner's single death state, driven by the health component.
  */
 UCLASS(Blueprintable, Meta=(BlueprintSpawnableComponent))
 class LYRAGAME_API ULyraManaComponent : public UGameFrameworkComponent
@@ -32,60 +37,65 @@ public:
 
 	ULyraManaComponent(const FObjectInitializer& ObjectInitializer);
 
-	// Returns the health component if one exists on the specified actor.
+	// Returns the mana component if one exists on the specified actor.
 	UFUNCTION(BlueprintPure, Category = "Lyra|Mana")
 	static ULyraManaComponent* FindManaComponent(const AActor* Actor) { return (Actor ? Actor->FindComponentByClass<ULyraManaComponent>() : nullptr); }
 
-	// Initialize the component using an ability system component.
+	// Starts forwarding the mana resource of the owner's resource component. The ability system is owned by the resource component.
 	UFUNCTION(BlueprintCallable, Category = "Lyra|Mana")
 	void InitializeWithAbilitySystem(ULyraAbilitySystemComponent* InASC);
 
-	// Uninitialize the component, clearing any references to the ability system.
+	// Stops forwarding the owner's resource component.
 	UFUNCTION(BlueprintCallable, Category = "Lyra|Mana")
 	void UninitializeFromAbilitySystem();
 
-	// Returns the current health value.
+	// Returns the current mana value.
 	UFUNCTION(BlueprintCallable, Category = "Lyra|Mana")
 	float GetMana() const;
 
-	// Returns the current maximum health value.
+	// Returns the current maximum mana value.
 	UFUNCTION(BlueprintCallable, Category = "Lyra|Mana")
 	float GetMaxMana() const;
 
-	// Returns the current health in the range [0.0, 1.0].
+	// Returns the current mana in the range [0.0, 1.0].
 	UFUNCTION(BlueprintCallable, Category = "Lyra|Mana")
 	float GetManaNormalized() const;
 
+	// Returns the death state of the owner (mana has no death state of its own).
 	UFUNCTION(BlueprintCallable, Category = "Lyra|Mana")
-	ELyraDeathState GetDeathState() const { return DeathState; }
+	ELyraDeathState GetDeathState() const;
 
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Lyra|Mana", Meta = (ExpandBoolAsExecs = "ReturnValue"))
-	bool IsDeadOrDying() const { return (DeathState > ELyraDeathState::NotDead); }
+	bool IsDeadOrDying() const { return (GetDeathState() > ELyraDeathState::NotDead); }
 
-	// Begins the death sequence for the owner.
+	// Begins the death sequence for the owner. This used to start a death sequence private to mana.
+	UE_DEPRECATED(5.3, "Mana no longer has its own death state. Call StartDeath on ULyraHealthComponent instead.")
 	virtual void StartDeath();
 
-	// Ends the death sequence for the owner.
+	// Ends the death sequence for the owner. This used to finish a death sequence private to mana.
+	UE_DEPRECATED(5.3, "Mana no longer has its own death state. Call FinishDeath on ULyraHealthComponent instead.")
 	virtual void FinishDeath();
 
-	// Applies enough damage to kill the owner.
+	// Applies enough damage to kill the owner (max health rather than max mana).
+	UE_DEPRECATED(5.3, "Mana no longer has its own death state. Call DamageSelfDestruct on ULyraHealthComponent instead.")
 	virtual void DamageSelfDestruct(bool bFellOutOfWorld = false);
 
 public:
 
-	// Delegate fired when the health value has changed. This is called on the client but the instigator may not be valid
+	// Delegate fired when the mana value has changed. This is called on the client but the instigator may not be valid
+	// With bCoalesceManaChangedEvents, fired at most once per frame instead, with the value at the start of the frame and the latest instigator
 	UPROPERTY(BlueprintAssignable)
 	FLyraMana_AttributeChanged OnManaChanged;
 
-	// Delegate fired when the max health value has changed. This is called on the client but the instigator may not be valid
+	// Delegate fired when the max mana value has changed. This is called on the client but the instigator may not be valid
 	UPROPERTY(BlueprintAssignable)
 	FLyraMana_AttributeChanged OnMaxManaChanged;
 
-	// Delegate fired when the death sequence has started.
+	// Delegate fired when the owner's death sequence has started.
 	UPROPERTY(BlueprintAssignable)
 	FLyraMana_DeathEvent OnDeathStarted;
 
-	// Delegate fired when the death sequence has finished.
+	// Delegate fired when the owner's death sequence has finished.
 	UPROPERTY(BlueprintAssignable)
 	FLyraMana_DeathEvent OnDeathFinished;
 
@@ -93,26 +103,31 @@ protected:
 
 	virtual void OnUnregister() override;
 
-	void ClearGameplayTags();
+	void HandleResourceChangedImmediate(ULyraResourceComponent* InResourceComponent, const FGameplayTag& ResourceTag, bool bMaxValue, float OldValue, float NewValue, AActor* Instigator);
+
+	UFUNCTION()
+	void HandleResourcesChanged(ULyraResourceComponent* InResourceComponent, const TArray<FLyraResourceChange>& Changes);
 
-	virtual void HandleManaChanged(AActor* DamageInstigator, AActor* DamageCauser, const FGameplayEffectSpec* DamageEffectSpec, float DamageMagnitude, float OldValue, float NewValue);
-	virtual void HandleMaxManaChanged(AActor* DamageInstigator, AActor* DamageCauser, const FGameplayEffectSpec* DamageEffectSpec, float DamageMagnitude, float OldValue, float NewValue);
 	virtual void HandleOutOfMana(AActor* DamageInstigator, AActor* DamageCauser, const FGameplayEffectSpec* DamageEffectSpec, float DamageMagnitude, float OldValue, float NewValue);
 
 	UFUNCTION()
-	virtual void OnRep_DeathState(ELyraDeathState OldDeathState);
+	void HandleDeathStarted(AActor* OwningActor);
+
+	UFUNCTION()
+	void HandleDeathFinished(AActor* OwningActor);
 
 protected:
 
-	// Ability system used by this component.
+	// If set, OnManaChanged and OnMaxManaChanged fold all changes of a frame into one broadcast at the end of it (e.g., for
+	// regeneration ticks nobody needs one by one), like ULyraResourceComponent::OnResourcesChanged.
+	UPROPERTY(EditDefaultsOnly, Category = "Lyra|Mana")
+	bool bCoalesceManaChangedEvents = false;
+
+	// Resource component providing the mana resource.
 	UPROPERTY()
-	TObjectPtr<ULyraAbilitySystemComponent> AbilitySystemComponent;
+	TObjectPtr<ULyraResourceComponent> ResourceComponent;
 
-	// Mana set used by this component.
+	// Mana set of the ability system, only bound for the out of mana notification (it carries the damage spec).
 	UPROPERTY()
 	TObjectPtr<const ULyraManaSet> ManaSet;
-
-	// Replicated state used to handle dying.
-	UPROPERTY(ReplicatedUsing = OnRep_DeathState)
-	ELyraDeathState DeathState;
 };
@@ -2,6 +2,8 @@
 
 #include "LyraPawnData.h"
 
+#include "AbilitySystem/Attributes/LyraManaSet.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraPawnData)
 
 ULyraPawnData::ULyraPawnData(const FObjectInitializer& ObjectInitializer)
@@ -11,5 +13,9 @@ ULyraPawnData::ULyraPawnData(const FObjectInitializer& ObjectInitializer)
 	PawnClass = nullptr;
 	InputConfig = nullptr;
 	DefaultCameraMode = nullptr;
+	AttributeDefaults = nullptr;
+
+	// Pawns used to always get a mana set, keep that for pawn data that doesn't say otherwise.
+	AttributeSets.Add(ULyraManaSet::StaticClass());
 }
 
@@ -7,8 +7,10 @@
 #include "LyraPawnData.generated.h"
 
 class APawn;
+class UAttributeSet;
 class ULyraAbilitySet;
 class ULyraAbilityTagRelationshipMapping;
+class ULyraAttributeDefaults;
 class ULyraCameraMode;
 class ULyraInputConfig;
 class UObject;
@@ -42,6 +44,15 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Lyra|Abilities")
 	TArray<TObjectPtr<ULyraAbilitySet>> AbilitySets;
 
+	// Attribute sets created for pawns that own their ability system (AI), on top of the ones the pawn class always has.
+	// AI that never use mana can leave ULyraManaSet out, so it is neither created nor tracked by the pawn's resource component.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Lyra|Attributes")
+	TArray<TSubclassOf<UAttributeSet>> AttributeSets;
+
+	// Shared base values applied to this pawn's attributes when its ability system is initialized.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Lyra|Attributes")
+	TObjectPtr<ULyraAttributeDefaults> AttributeDefaults;
+
 	// What mapping of ability tags to use for actions taking by this pawn
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Lyra|Abilities")
 	TObjectPtr<ULyraAbilityTagRelationshipMapping> TagRelationshipMapping;
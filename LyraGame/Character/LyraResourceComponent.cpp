@@ -0,0 +1,457 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Character/LyraResourceComponent.h"
+
+#include "AbilitySystem/Attributes/LyraHealthSet.h"
+#include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "Character/LyraResourceEventSubsystem.h"
+#include "Engine/World.h"
+#include "GameplayEffectExtension.h"
+#include "LyraGameplayTags.h"
+#include "LyraLogChannels.h"
+#include "Net/UnrealNetwork.h"
+#include "System/LyraAssetManager.h"
+#include "System/LyraGameData.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraResourceComponent)
+
+UE_DEFINE_GAMEPLAY_TAG(TAG_Lyra_Resource_Health, "Lyra.Resource.Health");
+UE_DEFINE_GAMEPLAY_TAG(TAG_Lyra_Resource_Mana, "Lyra.Resource.Mana");
+
+
+ULyraResourceComponent::ULyraResourceComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.bCanEverTick = false;
+
+	SetIsReplicatedByDefault(true);
+
+	AbilitySystemComponent = nullptr;
+	PackedState = (uint32)ELyraDeathState::NotDead;
+}
+
+void ULyraResourceComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ULyraResourceComponent, PackedState);
+}
+
+void ULyraResourceComponent::OnUnregister()
+{
+	UninitializeFromAbilitySystem();
+
+	Super::OnUnregister();
+}
+
+void ULyraResourceComponent::InitializeWithAbilitySystem(ULyraAbilitySystemComponent* InASC)
+{
+	AActor* Owner = GetOwner();
+	check(Owner);
+
+	if (AbilitySystemComponent)
+	{
+		UE_LOG(LogLyra, Error, TEXT("LyraResourceComponent: Resource component [%s] for owner [%s] has already been initialized with an ability system."), *GetName(), *GetNameSafe(Owner));
+		return;
+	}
+
+	AbilitySystemComponent = InASC;
+	if (!AbilitySystemComponent)
+	{
+		UE_LOG(LogLyra, Error, TEXT("LyraResourceComponent: Cannot initialize resource component [%s] for owner [%s] with NULL ability system."), *GetName(), *GetNameSafe(Owner));
+		return;
+	}
+
+	ensureMsgf(Resources.Num() <= MaxResources, TEXT("LyraResourceComponent: [%s] defines %d resources, only the first %d are tracked."), *GetPathName(), Resources.Num(), MaxResources);
+
+	// Register to listen for attribute changes of every resource the ability system actually has.
+	BoundResourceMask = 0;
+	for (int32 ResourceIndex = 0; ResourceIndex < FMath::Min(Resources.Num(), MaxResources); ++ResourceIndex)
+	{
+		const FLyraResourceDefinition& Resource = Resources[ResourceIndex];
+		if (!Resource.Attribute.IsValid() || !AbilitySystemComponent->HasAttributeSetForAttribute(Resource.Attribute))
+		{
+			continue;
+		}
+
+		BoundResourceMask |= (1u << ResourceIndex);
+
+		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Resource.Attribute).AddUObject(this, &ThisClass::HandleAttributeChanged, ResourceIndex, false);
+		if (Resource.MaxAttribute.IsValid() && AbilitySystemComponent->HasAttributeSetForAttribute(Resource.MaxAttribute))
+		{
+			AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Resource.MaxAttribute).AddUObject(this, &ThisClass::HandleAttributeChanged, ResourceIndex, true);
+
+			if (Resource.bFillOnInitialize)
+			{
+				AbilitySystemComponent->SetNumericAttributeBase(Resource.Attribute, AbilitySystemComponent->GetNumericAttribute(Resource.MaxAttribute));
+			}
+		}
+	}
+
+	ClearGameplayTags();
+
+	OnAbilitySystemInitialized();
+
+	// Report the starting values of every bound resource right away rather than at the end of the frame.
+	PendingChanges.Reset();
+	for (int32 ResourceIndex = 0; ResourceIndex < FMath::Min(Resources.Num(), MaxResources); ++ResourceIndex)
+	{
+		if (BoundResourceMask & (1u << ResourceIndex))
+		{
+			const FLyraResourceDefinition& Resource = Resources[ResourceIndex];
+
+			FPendingResourceChange& PendingChange = PendingChanges.AddDefaulted_GetRef();
+			PendingChange.ResourceIndex = ResourceIndex;
+			PendingChange.OldValue = PendingChange.NewValue = AbilitySystemComponent->GetNumericAttribute(Resource.Attribute);
+			PendingChange.OldMaxValue = PendingChange.NewMaxValue = Resource.MaxAttribute.IsValid() ? AbilitySystemComponent->GetNumericAttribute(Resource.MaxAttribute) : 0.0f;
+		}
+	}
+
+	BroadcastPendingResourceChanges();
+}
+
+void ULyraResourceComponent::UninitializeFromAbilitySystem()
+{
+	ClearGameplayTags();
+
+	if (AbilitySystemComponent)
+	{
+		OnAbilitySystemUninitialized();
+
+		for (int32 ResourceIndex = 0; ResourceIndex < FMath::Min(Resources.Num(), MaxResources); ++ResourceIndex)
+		{
+			if (BoundResourceMask & (1u << ResourceIndex))
+			{
+				const FLyraResourceDefinition& Resource = Resources[ResourceIndex];
+				AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Resource.Attribute).RemoveAll(this);
+				if (Resource.MaxAttribute.IsValid())
+				{
+					AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Resource.MaxAttribute).RemoveAll(this);
+				}
+			}
+		}
+	}
+
+	// A queued flush finds nothing left to deliver.
+	BoundResourceMask = 0;
+	PendingChanges.Reset();
+	AbilitySystemComponent = nullptr;
+}
+
+void ULyraResourceComponent::ClearGameplayTags()
+{
+	if (AbilitySystemComponent)
+	{
+		AbilitySystemComponent->SetLooseGameplayTagCount(LyraGameplayTags::Status_Death_Dying, 0);
+		AbilitySystemComponent->SetLooseGameplayTagCount(LyraGameplayTags::Status_Death_Dead, 0);
+	}
+}
+
+int32 ULyraResourceComponent::GetResourceIndex(FGameplayTag ResourceTag) const
+{
+	return Resources.IndexOfByPredicate([&ResourceTag](const FLyraResourceDefinition& Resource) { return Resource.ResourceTag == ResourceTag; });
+}
+
+bool ULyraResourceComponent::HasResource(FGameplayTag ResourceTag) const
+{
+	const int32 ResourceIndex = GetResourceIndex(ResourceTag);
+	return (ResourceIndex != INDEX_NONE) && (ResourceIndex < MaxResources) && (BoundResourceMask & (1u << ResourceIndex));
+}
+
+float ULyraResourceComponent::GetResourceValue(FGameplayTag ResourceTag) const
+{
+	return HasResource(ResourceTag) ? AbilitySystemComponent->GetNumericAttribute(Resources[GetResourceIndex(ResourceTag)].Attribute) : 0.0f;
+}
+
+float ULyraResourceComponent::GetResourceMaxValue(FGameplayTag ResourceTag) const
+{
+	if (HasResource(ResourceTag))
+	{
+		const FGameplayAttribute& MaxAttribute = Resources[GetResourceIndex(ResourceTag)].MaxAttribute;
+		return MaxAttribute.IsValid() ? AbilitySystemComponent->GetNumericAttribute(MaxAttribute) : 0.0f;
+	}
+
+	return 0.0f;
+}
+
+float ULyraResourceComponent::GetResourceNormalized(FGameplayTag ResourceTag) const
+{
+	const float MaxValue = GetResourceMaxValue(ResourceTag);
+	return ((MaxValue > 0.0f) ? (GetResourceValue(ResourceTag) / MaxValue) : 0.0f);
+}
+
+bool ULyraResourceComponent::IsResourceDepleted(FGameplayTag ResourceTag) const
+{
+	const int32 ResourceIndex = GetResourceIndex(ResourceTag);
+	return (ResourceIndex != INDEX_NONE) && (ResourceIndex < MaxResources) && (PackedState & (1u << (DepletedShift + ResourceIndex)));
+}
+
+void ULyraResourceComponent::HandleAttributeChanged(const FOnAttributeChangeData& ChangeData, int32 ResourceIndex, bool bMaxValue)
+{
+	if (ChangeData.OldValue == ChangeData.NewValue)
+	{
+		return;
+	}
+
+	// The depleted flags are owned by the server and replicated with the death state.
+	AActor* Owner = GetOwner();
+	if (!bMaxValue && Owner && Owner->HasAuthority())
+	{
+		const uint32 DepletedBit = (1u << (DepletedShift + ResourceIndex));
+		const uint32 NewPackedState = (ChangeData.NewValue <= 0.0f) ? (PackedState | DepletedBit) : (PackedState & ~DepletedBit);
+		if (NewPackedState != PackedState)
+		{
+			PackedState = NewPackedState;
+			Owner->ForceNetUpdate();
+		}
+	}
+
+	HandleResourceChanged(ResourceIndex, bMaxValue, ChangeData.OldValue, ChangeData.NewValue, ChangeData);
+
+	// The instigator is only known on the server, for changes made by a gameplay effect.
+	AActor* Instigator = ChangeData.GEModData ? ChangeData.GEModData->EffectSpec.GetEffectContext().GetOriginalInstigator() : nullptr;
+
+	OnResourceChangedImmediate.Broadcast(this, Resources[ResourceIndex].ResourceTag, bMaxValue, ChangeData.OldValue, ChangeData.NewValue, Instigator);
+
+	AddPendingChange(ResourceIndex, bMaxValue, ChangeData.OldValue, ChangeData.NewValue, Instigator);
+}
+
+void ULyraResourceComponent::HandleResourceChanged(int32 ResourceIndex, bool bMaxValue, float OldValue, float NewValue, const FOnAttributeChangeData& ChangeData)
+{
+}
+
+void ULyraResourceComponent::AddPendingChange(int32 ResourceIndex, bool bMaxValue, float OldValue, float NewValue, AActor* Instigator)
+{
+	FPendingResourceChange* PendingChange = PendingChanges.FindByPredicate([ResourceIndex](const FPendingResourceChange& Change) { return Change.ResourceIndex == ResourceIndex; });
+	if (!PendingChange)
+	{
+		// First change of the frame: the other half of the pair has not moved, so its current value is its old value.
+		const FLyraResourceDefinition& Resource = Resources[ResourceIndex];
+
+		PendingChange = &PendingChanges.AddDefaulted_GetRef();
+		PendingChange->ResourceIndex = ResourceIndex;
+		PendingChange->OldValue = PendingChange->NewValue = AbilitySystemComponent->GetNumericAttribute(Resource.Attribute);
+		PendingChange->OldMaxValue = PendingChange->NewMaxValue = Resource.MaxAttribute.IsValid() ? AbilitySystemComponent->GetNumericAttribute(Resource.MaxAttribute) : 0.0f;
+
+		if (bMaxValue)
+		{
+			PendingChange->OldMaxValue = OldValue;
+		}
+		else
+		{
+			PendingChange->OldValue = OldValue;
+		}
+	}
+
+	if (bMaxValue)
+	{
+		PendingChange->NewMaxValue = NewValue;
+	}
+	else
+	{
+		PendingChange->NewValue = NewValue;
+		PendingChange->SummedDelta += (NewValue - OldValue);
+	}
+
+	++PendingChange->NumChanges;
+
+	if (Instigator)
+	{
+		PendingChange->Instigators.AddUnique(Instigator);
+	}
+
+	// Gather everything that changes this frame into one notification, delivered after all actors have ticked.
+	ULyraResourceEventSubsystem* EventSubsystem = UWorld::GetSubsystem<ULyraResourceEventSubsystem>(GetWorld());
+	if (!EventSubsystem)
+	{
+		BroadcastPendingResourceChanges();
+		return;
+	}
+
+	EventSubsystem->NotifyRawChange();
+
+	if (!bPendingBroadcast)
+	{
+		bPendingBroadcast = true;
+		EventSubsystem->MarkDirty(this);
+	}
+}
+
+bool ULyraResourceComponent::BroadcastPendingResourceChanges(int32* OutNumFolded)
+{
+	bPendingBroadcast = false;
+
+	if (OutNumFolded)
+	{
+		*OutNumFolded = 0;
+	}
+
+	if (PendingChanges.Num() == 0)
+	{
+		return false;
+	}
+
+	TArray<FLyraResourceChange> Changes;
+	Changes.Reserve(PendingChanges.Num());
+
+	for (const FPendingResourceChange& PendingChange : PendingChanges)
+	{
+		FLyraResourceChange& Change = Changes.AddDefaulted_GetRef();
+		Change.ResourceTag = Resources[PendingChange.ResourceIndex].ResourceTag;
+		Change.OldValue = PendingChange.OldValue;
+		Change.NewValue = PendingChange.NewValue;
+		Change.SummedDelta = PendingChange.SummedDelta;
+		Change.OldMaxValue = PendingChange.OldMaxValue;
+		Change.NewMaxValue = PendingChange.NewMaxValue;
+		Change.NumChanges = PendingChange.NumChanges;
+
+		if (OutNumFolded)
+		{
+			*OutNumFolded += FMath::Max(PendingChange.NumChanges - 1, 0);
+		}
+
+		for (const TWeakObjectPtr<AActor>& Instigator : PendingChange.Instigators)
+		{
+			if (AActor* InstigatorActor = Instigator.Get())
+			{
+				Change.Instigators.Add(InstigatorActor);
+			}
+		}
+	}
+
+	// Listeners may change resources again, those changes go into the next notification.
+	PendingChanges.Reset();
+
+	HandleResourcesChanged(Changes);
+
+	OnResourcesChanged.Broadcast(this, Changes);
+
+	return true;
+}
+
+void ULyraResourceComponent::SetDeathState(ELyraDeathState NewDeathState)
+{
+	PackedState = (PackedState & ~DeathStateMask) | ((uint32)NewDeathState & DeathStateMask);
+}
+
+void ULyraResourceComponent::OnRep_PackedState(uint32 OldPackedState)
+{
+	const ELyraDeathState OldDeathState = (ELyraDeathState)(OldPackedState & DeathStateMask);
+	const ELyraDeathState NewDeathState = GetDeathState();
+
+	// Revert the death state for now since we rely on StartDeath and FinishDeath to change it.
+	SetDeathState(OldDeathState);
+
+	if (OldDeathState > NewDeathState)
+	{
+		// The server is trying to set us back but we've already predicted past the server state.
+		UE_LOG(LogLyra, Warning, TEXT("LyraResourceComponent: Predicted past server death state [%d] -> [%d] for owner [%s]."), (uint8)OldDeathState, (uint8)NewDeathState, *GetNameSafe(GetOwner()));
+		return;
+	}
+
+	if (OldDeathState == ELyraDeathState::NotDead)
+	{
+		if (NewDeathState == ELyraDeathState::DeathStarted)
+		{
+			StartDeath();
+		}
+		else if (NewDeathState == ELyraDeathState::DeathFinished)
+		{
+			StartDeath();
+			FinishDeath();
+		}
+	}
+	else if (OldDeathState == ELyraDeathState::DeathStarted)
+	{
+		if (NewDeathState == ELyraDeathState::DeathFinished)
+		{
+			FinishDeath();
+		}
+		else
+		{
+			UE_LOG(LogLyra, Error, TEXT("LyraResourceComponent: Invalid death transition [%d] -> [%d] for owner [%s]."), (uint8)OldDeathState, (uint8)NewDeathState, *GetNameSafe(GetOwner()));
+		}
+	}
+
+	ensureMsgf((GetDeathState() == NewDeathState), TEXT("LyraResourceComponent: Death transition failed [%d] -> [%d] for owner [%s]."), (uint8)OldDeathState, (uint8)NewDeathState, *GetNameSafe(GetOwner()));
+}
+
+void ULyraResourceComponent::StartDeath()
+{
+	if (GetDeathState() != ELyraDeathState::NotDead)
+	{
+		return;
+	}
+
+	SetDeathState(ELyraDeathState::DeathStarted);
+
+	if (AbilitySystemComponent)
+	{
+		AbilitySystemComponent->SetLooseGameplayTagCount(LyraGameplayTags::Status_Death_Dying, 1);
+	}
+
+	AActor* Owner = GetOwner();
+	check(Owner);
+
+	OnDeathStarted.Broadcast(Owner);
+
+	Owner->ForceNetUpdate();
+}
+
+void ULyraResourceComponent::FinishDeath()
+{
+	if (GetDeathState() != ELyraDeathState::DeathStarted)
+	{
+		return;
+	}
+
+	SetDeathState(ELyraDeathState::DeathFinished);
+
+	if (AbilitySystemComponent)
+	{
+		AbilitySystemComponent->SetLooseGameplayTagCount(LyraGameplayTags::Status_Death_Dead, 1);
+	}
+
+	AActor* Owner = GetOwner();
+	check(Owner);
+
+	OnDeathFinished.Broadcast(Owner);
+
+	Owner->ForceNetUpdate();
+}
+
+void ULyraResourceComponent::DamageSelfDestruct(bool bFellOutOfWorld)
+{
+	if ((GetDeathState() == ELyraDeathState::NotDead) && AbilitySystemComponent)
+	{
+		const TSubclassOf<UGameplayEffect> DamageGE = ULyraAssetManager::GetSubclass(ULyraGameData::Get().DamageGameplayEffect_SetByCaller);
+		if (!DamageGE)
+		{
+			UE_LOG(LogLyra, Error, TEXT("LyraResourceComponent: DamageSelfDestruct failed for owner [%s]. Unable to find gameplay effect [%s]."), *GetNameSafe(GetOwner()), *ULyraGameData::Get().DamageGameplayEffect_SetByCaller.GetAssetName());
+			return;
+		}
+
+		FGameplayEffectSpecHandle SpecHandle = AbilitySystemComponent->MakeOutgoingSpec(DamageGE, 1.0f, AbilitySystemComponent->MakeEffectContext());
+		FGameplayEffectSpec* Spec = SpecHandle.Data.Get();
+
+		if (!Spec)
+		{
+			UE_LOG(LogLyra, Error, TEXT("LyraResourceComponent: DamageSelfDestruct failed for owner [%s]. Unable to make outgoing spec for [%s]."), *GetNameSafe(GetOwner()), *GetNameSafe(DamageGE));
+			return;
+		}
+
+		Spec->AddDynamicAssetTag(TAG_Gameplay_DamageSelfDestruct);
+
+		if (bFellOutOfWorld)
+		{
+			Spec->AddDynamicAssetTag(TAG_Gameplay_FellOutOfWorld);
+		}
+
+		// The first resource is the one whose depletion kills the owner (health).
+		const float DamageAmount = (Resources.Num() > 0) ? GetResourceMaxValue(Resources[0].ResourceTag) : 0.0f;
+
+		Spec->SetSetByCallerMagnitude(LyraGameplayTags::SetByCaller_Damage, DamageAmount);
+		AbilitySystemComponent->ApplyGameplayEffectSpecToSelf(*Spec);
+	}
+}
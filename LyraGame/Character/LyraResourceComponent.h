@@ -0,0 +1,277 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "AttributeSet.h"
+#include "Components/GameFrameworkComponent.h"
+#include "GameplayTagContainer.h"
+#include "NativeGameplayTags.h"
+
+#include "LyraResourceComponent.generated.h"
+
+class ULyraAbilitySystemComponent;
+class ULyraResourceComponent;
+class UObject;
+struct FFrame;
+struct FOnAttributeChangeData;
+
+LYRAGAME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Lyra_Resource_Health);
+LYRAGAME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Lyra_Resource_Mana);
+
+struct FLyraResourceChange;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FLyraHealth_DeathEvent, AActor*, OwningActor);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FLyraResource_ResourcesChanged, ULyraResourceComponent*, ResourceComponent, const TArray<FLyraResourceChange>&, Changes);
+DECLARE_MULTICAST_DELEGATE_SixParams(FLyraResource_ResourceChangedImmediate, ULyraResourceComponent* /*ResourceComponent*/, const FGameplayTag& /*ResourceTag*/, bool /*bMaxValue*/, float /*OldValue*/, float /*NewValue*/, AActor* /*Instigator*/);
+
+/**
+ * ELyraDeathState
+ *
+ *	Defines current state of death.
+ */
+UENUM(BlueprintType)
+enum class ELyraDeathState : uint8
+{
+	NotDead = 0,
+	DeathStarted,
+	DeathFinished
+};
+
+
+/**
+ * FLyraResourceDefinition
+ *
+ *	A pair of attributes (current and maximum value) tracked by a resource component, e.g. health or mana.
+ */
+USTRUCT(BlueprintType)
+struct FLyraResourceDefinition
+{
+	GENERATED_BODY()
+
+public:
+
+	// Tag used to look the resource up.
+	UPROPERTY(EditDefaultsOnly, Category = "Resource", Meta = (Categories = "Lyra.Resource"))
+	FGameplayTag ResourceTag;
+
+	// Attribute holding the current value.
+	UPROPERTY(EditDefaultsOnly, Category = "Resource")
+	FGameplayAttribute Attribute;
+
+	// Attribute holding the maximum value.
+	UPROPERTY(EditDefaultsOnly, Category = "Resource")
+	FGameplayAttribute MaxAttribute;
+
+	// If set, the resource is refilled to its maximum when the component is initialized with an ability system.
+	UPROPERTY(EditDefaultsOnly, Category = "Resource")
+	bool bFillOnInitialize = true;
+};
+
+
+/**
+ * FLyraResourceChange
+ *
+ *	Everything that happened to one resource during a frame, delivered at the end of the frame.
+ */
+USTRUCT(BlueprintType)
+struct FLyraResourceChange
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly, Category = "Resource")
+	FGameplayTag ResourceTag;
+
+	// Value at the start of the frame and after the last change.
+	UPROPERTY(BlueprintReadOnly, Category = "Resource")
+	float OldValue = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Resource")
+	float NewValue = 0.0f;
+
+	// Sum of the individual changes (differs from NewValue - OldValue when clamping kicked in).
+	UPROPERTY(BlueprintReadOnly, Category = "Resource")
+	float SummedDelta = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Resource")
+	float OldMaxValue = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Resource")
+	float NewMaxValue = 0.0f;
+
+	// Number of attribute changes folded into this one.
+	UPROPERTY(BlueprintReadOnly, Category = "Resource")
+	int32 NumChanges = 0;
+
+	// Distinct instigators of the changes, when known (server only).
+	UPROPERTY(BlueprintReadOnly, Category = "Resource")
+	TArray<TObjectPtr<AActor>> Instigators;
+
+	bool ValueChanged() const { return (OldValue != NewValue); }
+	bool MaxValueChanged() const { return (OldMaxValue != NewMaxValue); }
+};
+
+
+/**
+ * ULyraResourceComponent
+ *
+ *	Tracks any number of attribute pairs (health, mana, stamina, shields...) of the owner's ability system from a single component.
+ *
+ *	Resources whose attribute set is missing from the ability system are skipped, so pawns only pay for what they have.
+ *	Listeners choose how they hear about changes: OnResourceChangedImmediate fires for every single attribute change,
+ *	while OnResourcesChanged folds all changes of a frame (regen ticks, DoTs, multi-hit attacks) into one notification
+ *	per component, delivered after actors have ticked by ULyraResourceEventSubsystem. UI should prefer the latter.
+ *	The death state and the depleted flag of every resource share a single replicated field. Adding a resource only
+ *	means adding a definition.
+ */
+UCLASS(Blueprintable, Meta=(BlueprintSpawnableComponent))
+class LYRAGAME_API ULyraResourceComponent : public UGameFrameworkComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	ULyraResourceComponent(const FObjectInitializer& ObjectInitializer);
+
+	// Returns the resource component if one exists on the specified actor.
+	UFUNCTION(BlueprintPure, Category = "Lyra|Resource")
+	static ULyraResourceComponent* FindResourceComponent(const AActor* Actor) { return (Actor ? Actor->FindComponentByClass<ULyraResourceComponent>() : nullptr); }
+
+	// Initialize the component using an ability system component.
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Resource")
+	void InitializeWithAbilitySystem(ULyraAbilitySystemComponent* InASC);
+
+	// Uninitialize the component, clearing any references to the ability system.
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Resource")
+	void UninitializeFromAbilitySystem();
+
+	// Returns true if the resource is defined on this component and present on the ability system.
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Resource")
+	bool HasResource(FGameplayTag ResourceTag) const;
+
+	// Returns the current value of the resource, or 0 if there is no such resource.
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Resource")
+	float GetResourceValue(FGameplayTag ResourceTag) const;
+
+	// Returns the maximum value of the resource, or 0 if there is no such resource.
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Resource")
+	float GetResourceMaxValue(FGameplayTag ResourceTag) const;
+
+	// Returns the current value of the resource in the range [0.0, 1.0].
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Resource")
+	float GetResourceNormalized(FGameplayTag ResourceTag) const;
+
+	// Returns true if the resource reached zero and has not been refilled since (replicated).
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Resource")
+	bool IsResourceDepleted(FGameplayTag ResourceTag) const;
+
+	// Returns the index of the resource in the component's definitions, or INDEX_NONE.
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Resource")
+	int32 GetResourceIndex(FGameplayTag ResourceTag) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Resource")
+	ELyraDeathState GetDeathState() const { return (ELyraDeathState)(PackedState & DeathStateMask); }
+
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Lyra|Resource", Meta = (ExpandBoolAsExecs = "ReturnValue"))
+	bool IsDeadOrDying() const { return (GetDeathState() > ELyraDeathState::NotDead); }
+
+	// Begins the death sequence for the owner.
+	virtual void StartDeath();
+
+	// Ends the death sequence for the owner.
+	virtual void FinishDeath();
+
+	// Applies enough damage to kill the owner.
+	virtual void DamageSelfDestruct(bool bFellOutOfWorld = false);
+
+	// Delivers the pending changes gathered this frame. Returns true if anything was broadcast.
+	// OutNumFolded receives the number of attribute changes that were folded into another one instead of being broadcast.
+	bool BroadcastPendingResourceChanges(int32* OutNumFolded = nullptr);
+
+public:
+
+	// Delegate fired at most once per frame, at the end of it, with the aggregated changes of every resource that changed.
+	UPROPERTY(BlueprintAssignable)
+	FLyraResource_ResourcesChanged OnResourcesChanged;
+
+	// Delegate fired for every individual change of a resource value or maximum, as it happens.
+	FLyraResource_ResourceChangedImmediate OnResourceChangedImmediate;
+
+	// Delegate fired when the death sequence has started.
+	UPROPERTY(BlueprintAssignable)
+	FLyraHealth_DeathEvent OnDeathStarted;
+
+	// Delegate fired when the death sequence has finished.
+	UPROPERTY(BlueprintAssignable)
+	FLyraHealth_DeathEvent OnDeathFinished;
+
+protected:
+
+	virtual void OnUnregister() override;
+
+	// Called once the resources have been bound to the new ability system.
+	virtual void OnAbilitySystemInitialized() {}
+
+	// Called before the resources are unbound from the ability system.
+	virtual void OnAbilitySystemUninitialized() {}
+
+	// Called immediately whenever the value (or maximum value) of a resource changes, on the server and on clients.
+	virtual void HandleResourceChanged(int32 ResourceIndex, bool bMaxValue, float OldValue, float NewValue, const FOnAttributeChangeData& ChangeData);
+
+	// Called with the aggregated changes of the frame, right before OnResourcesChanged is broadcast.
+	virtual void HandleResourcesChanged(const TArray<FLyraResourceChange>& Changes) {}
+
+	void ClearGameplayTags();
+
+	void SetDeathState(ELyraDeathState NewDeathState);
+
+	UFUNCTION()
+	virtual void OnRep_PackedState(uint32 OldPackedState);
+
+private:
+
+	void HandleAttributeChanged(const FOnAttributeChangeData& ChangeData, int32 ResourceIndex, bool bMaxValue);
+	void AddPendingChange(int32 ResourceIndex, bool bMaxValue, float OldValue, float NewValue, AActor* Instigator);
+
+protected:
+
+	// Resources tracked by this component. At most MaxResources are supported, the first one is the resource whose depletion kills the owner.
+	UPROPERTY(EditDefaultsOnly, Category = "Lyra|Resource", Meta = (TitleProperty = ResourceTag))
+	TArray<FLyraResourceDefinition> Resources;
+
+	// Ability system used by this component.
+	UPROPERTY()
+	TObjectPtr<ULyraAbilitySystemComponent> AbilitySystemComponent;
+
+	// Replicated state: the death state in the low bits, followed by one depleted bit per resource.
+	UPROPERTY(ReplicatedUsing = OnRep_PackedState)
+	uint32 PackedState;
+
+	static constexpr uint32 DeathStateMask = 0x3;
+	static constexpr int32 DepletedShift = 8;
+	static constexpr int32 MaxResources = 24;
+
+private:
+
+	// Bit per resource that exists on the current ability system.
+	uint32 BoundResourceMask = 0;
+
+	// Changes gathered since the last OnResourcesChanged broadcast.
+	struct FPendingResourceChange
+	{
+		int32 ResourceIndex = INDEX_NONE;
+		float OldValue = 0.0f;
+		float NewValue = 0.0f;
+		float SummedDelta = 0.0f;
+		float OldMaxValue = 0.0f;
+		float NewMaxValue = 0.0f;
+		int32 NumChanges = 0;
+		TArray<TWeakObjectPtr<AActor>, TInlineAllocator<2>> Instigators;
+	};
+
+	TArray<FPendingResourceChange, TInlineAllocator<2>> PendingChanges;
+
+	// Set while this component is queued with ULyraResourceEventSubsystem.
+	bool bPendingBroadcast = false;
+};
@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Character/LyraResourceEventSubsystem.h"
+
+#include "Character/LyraResourceComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraResourceEventSubsystem)
+
+void ULyraResourceEventSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	StatsStartTime = FPlatformTime::Seconds();
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::HandlePostActorTick);
+}
+
+void ULyraResourceEventSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	DirtyComponents.Reset();
+
+	Super::Deinitialize();
+}
+
+void ULyraResourceEventSubsystem::MarkDirty(ULyraResourceComponent* ResourceComponent)
+{
+	DirtyComponents.Add(ResourceComponent);
+}
+
+void ULyraResourceEventSubsystem::HandlePostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if ((InWorld != GetWorld()) || (DirtyComponents.Num() == 0))
+	{
+		return;
+	}
+
+	// Listeners may change attributes again, those changes are queued for the next frame.
+	TArray<TWeakObjectPtr<ULyraResourceComponent>> ComponentsToFlush = MoveTemp(DirtyComponents);
+	DirtyComponents.Reset();
+
+	for (const TWeakObjectPtr<ULyraResourceComponent>& ComponentPtr : ComponentsToFlush)
+	{
+		if (ULyraResourceComponent* ResourceComponent = ComponentPtr.Get())
+		{
+			int32 NumFolded = 0;
+			if (ResourceComponent->BroadcastPendingResourceChanges(&NumFolded))
+			{
+				++NumCoalescedBroadcasts;
+				NumSuppressedBroadcasts += NumFolded;
+			}
+		}
+	}
+}
+
+void ULyraResourceEventSubsystem::DumpStats(FOutputDevice& Ar)
+{
+	const double Now = FPlatformTime::Seconds();
+	const double Elapsed = FMath::Max(Now - StatsStartTime, UE_SMALL_NUMBER);
+
+	Ar.Logf(TEXT("Resource change events over %.1f s: %lld raw changes (%.1f/s), %lld coalesced broadcasts (%.1f/s), %lld broadcasts suppressed (%.1f/s)"),
+		Elapsed, NumRawChanges, NumRawChanges / Elapsed, NumCoalescedBroadcasts, NumCoalescedBroadcasts / Elapsed, NumSuppressedBroadcasts, NumSuppressedBroadcasts / Elapsed);
+
+	StatsStartTime = Now;
+	NumRawChanges = 0;
+	NumCoalescedBroadcasts = 0;
+	NumSuppressedBroadcasts = 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+static FAutoConsoleCommandWithWorldAndArgs DumpResourceEventStatsCommand(
+	TEXT("Lyra.Resources.DumpEventStats"),
+	TEXT("Prints how many resource change broadcasts per second were suppressed by coalescing them per frame, then restarts the measurement."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (ULyraResourceEventSubsystem* EventSubsystem = UWorld::GetSubsystem<ULyraResourceEventSubsystem>(World))
+		{
+			EventSubsystem->DumpStats(*GLog);
+		}
+	}));
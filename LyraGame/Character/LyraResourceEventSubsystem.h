@@ -0,0 +1,56 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+
+#include "LyraResourceEventSubsystem.generated.h"
+
+class FOutputDevice;
+class ULyraResourceComponent;
+
+/**
+ * ULyraResourceEventSubsystem
+ *
+ *	Delivers the coalesced resource change notifications of every ULyraResourceComponent in the world once per frame,
+ *	after all actors have ticked, and counts how many per-change broadcasts that saved.
+ */
+UCLASS()
+class ULyraResourceEventSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	// Queues the component's pending changes for delivery at the end of this frame.
+	void MarkDirty(ULyraResourceComponent* ResourceComponent);
+
+	// Counts a raw attribute change.
+	void NotifyRawChange() { ++NumRawChanges; }
+
+	// Prints the raw changes, coalesced broadcasts and suppressed broadcasts per second since the last call, then restarts the measurement.
+	void DumpStats(FOutputDevice& Ar);
+
+private:
+
+	void HandlePostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+private:
+
+	TArray<TWeakObjectPtr<ULyraResourceComponent>> DirtyComponents;
+
+	FDelegateHandle PostActorTickHandle;
+
+	// Stats since StatsStartTime
+	double StatsStartTime = 0.0;
+	int64 NumRawChanges = 0;
+	int64 NumCoalescedBroadcasts = 0;
+
+	// Changes folded into another change of the same resource, i.e. broadcasts that did not happen.
+	int64 NumSuppressedBroadcasts = 0;
+};
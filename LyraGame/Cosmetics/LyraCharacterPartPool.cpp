@@ -0,0 +1,491 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Cosmetics/LyraCharacterPartPool.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Cosmetics/LyraCharacterPartTypes.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameplayTagAssetInterface.h"
+#include "HAL/IConsoleManager.h"
+#include "LyraLogChannels.h"
+#include "Misc/OutputDevice.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraCharacterPartPool)
+
+//////////////////////////////////////////////////////////////////////
+
+namespace LyraCharacterPartPoolCvars
+{
+	static bool bPoolCharacterParts = true;
+	static FAutoConsoleVariableRef CVarPoolCharacterParts(
+		TEXT("Lyra.Cosmetics.PoolCharacterParts"),
+		bPoolCharacterParts,
+		TEXT("Should removed character parts be kept hidden and reused by the next pawn instead of being destroyed?"),
+		ECVF_Default);
+
+	static int32 MaxPooledPartsPerClass = 32;
+	static FAutoConsoleVariableRef CVarMaxPooledPartsPerClass(
+		TEXT("Lyra.Cosmetics.MaxPooledPartsPerClass"),
+		MaxPooledPartsPerClass,
+		TEXT("Maximum number of hidden part actors (per part class) or mesh components (per mesh) kept around for reuse."),
+		ECVF_Default);
+
+	static bool bLightweightMeshParts = true;
+	static FAutoConsoleVariableRef CVarLightweightMeshParts(
+		TEXT("Lyra.Cosmetics.LightweightMeshParts"),
+		bLightweightMeshParts,
+		TEXT("Should character parts that are just a mesh be attached as a pooled mesh component instead of a part actor?\n")
+		TEXT("These parts are not returned by GetCharacterPartActors, styling that walks part actors has to use GetCharacterPartMeshes instead."),
+		ECVF_Default);
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdDumpPartPools(
+		TEXT("Lyra.Cosmetics.DumpPartPools"),
+		TEXT("Prints the character part pools of the current world and how often parts were reused."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (ULyraCharacterPartPoolSubsystem* PartPool = UWorld::GetSubsystem<ULyraCharacterPartPoolSubsystem>(World))
+			{
+				PartPool->DumpPoolStats(*GLog);
+			}
+		}));
+
+	// Does this class (or any Blueprint parent) have event graph logic that a bare mesh component could not reproduce?
+	static bool HasBlueprintEventGraph(const UClass* Class)
+	{
+		for (const UClass* TestClass = Class; TestClass != nullptr; TestClass = TestClass->GetSuperClass())
+		{
+			if (const UBlueprintGeneratedClass* BPClass = Cast<UBlueprintGeneratedClass>(TestClass))
+			{
+				if (BPClass->UberGraphFunction != nullptr)
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	static void SetComponentTicksEnabled(AActor* Actor, bool bEnabled)
+	{
+		TInlineComponentArray<UActorComponent*> Components(Actor);
+		for (UActorComponent* Component : Components)
+		{
+			Component->SetComponentTickEnabled(bEnabled && Component->PrimaryComponentTick.bStartWithTickEnabled);
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void ULyraCharacterPartPoolSubsystem::Deinitialize()
+{
+	// The world is going away and takes the pooled actors and components with it
+	ClassPools.Reset();
+	MeshPools.Reset();
+
+	Super::Deinitialize();
+}
+
+bool ULyraCharacterPartPoolSubsystem::AcquirePart(const FLyraCharacterPart& Part, USceneComponent* AttachTo, AActor* NewOwner, AActor*& OutPartActor, UMeshComponent*& OutPartMesh)
+{
+	OutPartActor = nullptr;
+	OutPartMesh = nullptr;
+
+	UClass* PartClass = Part.PartClass;
+	if ((PartClass == nullptr) || (AttachTo == nullptr))
+	{
+		return false;
+	}
+
+	// The first time a class is seen we have to spawn it to find out what it is
+	AActor* SpawnedActor = nullptr;
+	FLyraCharacterPartClassPool& ClassPool = FindOrAnalyzeClassPool(PartClass, NewOwner, /*out*/ SpawnedActor);
+
+	if (ClassPool.bMeshOnly && LyraCharacterPartPoolCvars::bLightweightMeshParts)
+	{
+		if (SpawnedActor != nullptr)
+		{
+			// Keep the inspected instance in case lightweight parts get turned off later
+			ReleasePartActor(SpawnedActor);
+		}
+
+		OutPartMesh = AcquirePartMesh(ClassPool, Part, AttachTo);
+		++ClassPool.NumMeshesAcquired;
+	}
+	else
+	{
+		OutPartActor = AcquirePartActor(ClassPool, PartClass, SpawnedActor, Part, AttachTo, NewOwner);
+	}
+
+	return (OutPartActor != nullptr) || (OutPartMesh != nullptr);
+}
+
+void ULyraCharacterPartPoolSubsystem::ReleasePart(AActor* PartActor, UMeshComponent* PartMesh)
+{
+	if (PartActor != nullptr)
+	{
+		ReleasePartActor(PartActor);
+	}
+
+	if (PartMesh != nullptr)
+	{
+		ReleasePartMesh(PartMesh);
+	}
+}
+
+const FGameplayTagContainer* ULyraCharacterPartPoolSubsystem::FindPartTags(TSubclassOf<AActor> PartClass) const
+{
+	const FLyraCharacterPartClassPool* ClassPool = ClassPools.Find(PartClass.Get());
+	return ((ClassPool != nullptr) && ClassPool->bAnalyzed) ? &ClassPool->PartTags : nullptr;
+}
+
+FLyraCharacterPartClassPool& ULyraCharacterPartPoolSubsystem::FindOrAnalyzeClassPool(UClass* PartClass, AActor* NewOwner, AActor*& OutSpawnedActor)
+{
+	FLyraCharacterPartClassPool& ClassPool = ClassPools.FindOrAdd(PartClass);
+
+	if (!ClassPool.bAnalyzed)
+	{
+		OutSpawnedActor = SpawnPartActor(PartClass, NewOwner);
+		if (OutSpawnedActor != nullptr)
+		{
+			++ClassPool.NumActorsSpawned;
+			AnalyzePartActor(OutSpawnedActor, ClassPool);
+		}
+	}
+
+	return ClassPool;
+}
+
+void ULyraCharacterPartPoolSubsystem::AnalyzePartActor(AActor* PartActor, FLyraCharacterPartClassPool& ClassPool) const
+{
+	ClassPool.bAnalyzed = true;
+	ClassPool.bActorEnableCollision = PartActor->GetActorEnableCollision();
+
+	if (IGameplayTagAssetInterface* TagInterface = Cast<IGameplayTagAssetInterface>(PartActor))
+	{
+		TagInterface->GetOwnedGameplayTags(/*inout*/ ClassPool.PartTags);
+	}
+
+	// A part is mesh-only if it has no logic of its own and exactly one mesh component (plus bare scene components)
+	ClassPool.bMeshOnly = false;
+
+	if (PartActor->PrimaryActorTick.bCanEverTick || LyraCharacterPartPoolCvars::HasBlueprintEventGraph(PartActor->GetClass()))
+	{
+		return;
+	}
+
+	UMeshComponent* OnlyMesh = nullptr;
+	TInlineComponentArray<UActorComponent*> Components(PartActor);
+	for (UActorComponent* Component : Components)
+	{
+		if (Component->GetClass() == USceneComponent::StaticClass())
+		{
+			continue;
+		}
+
+		const bool bIsPlainMesh = (Component->GetClass() == USkeletalMeshComponent::StaticClass()) || (Component->GetClass() == UStaticMeshComponent::StaticClass());
+		if (!bIsPlainMesh || (OnlyMesh != nullptr))
+		{
+			return;
+		}
+
+		OnlyMesh = CastChecked<UMeshComponent>(Component);
+	}
+
+	if (USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(OnlyMesh))
+	{
+		// Meshes driven by their own animation blueprint need the full actor
+		if ((SkeletalMeshComponent->GetAnimationMode() == EAnimationMode::AnimationBlueprint) && (SkeletalMeshComponent->GetAnimClass() != nullptr))
+		{
+			return;
+		}
+
+		ClassPool.SkeletalMesh = SkeletalMeshComponent->GetSkeletalMeshAsset();
+		ClassPool.bMeshOnly = (ClassPool.SkeletalMesh != nullptr);
+	}
+	else if (UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(OnlyMesh))
+	{
+		ClassPool.StaticMesh = StaticMeshComponent->GetStaticMesh();
+		ClassPool.bMeshOnly = (ClassPool.StaticMesh != nullptr);
+	}
+
+	if (ClassPool.bMeshOnly)
+	{
+		ClassPool.OverrideMaterials = OnlyMesh->OverrideMaterials;
+		ClassPool.MeshRelativeTransform = OnlyMesh->GetComponentTransform().GetRelativeTransform(PartActor->GetActorTransform());
+		ClassPool.CollisionProfileName = OnlyMesh->GetCollisionProfileName();
+		ClassPool.CollisionEnabled = OnlyMesh->GetCollisionEnabled();
+		ClassPool.bCastShadow = OnlyMesh->CastShadow;
+		ClassPool.bOwnerNoSee = OnlyMesh->bOwnerNoSee;
+		ClassPool.bOnlyOwnerSee = OnlyMesh->bOnlyOwnerSee;
+	}
+}
+
+AActor* ULyraCharacterPartPoolSubsystem::AcquirePartActor(FLyraCharacterPartClassPool& ClassPool, UClass* PartClass, AActor* SpawnedActor, const FLyraCharacterPart& Part, USceneComponent* AttachTo, AActor* NewOwner)
+{
+	AActor* PartActor = SpawnedActor;
+
+	while ((PartActor == nullptr) && (ClassPool.FreeActors.Num() > 0))
+	{
+		PartActor = ClassPool.FreeActors.Pop(/*bAllowShrinking=*/ false);
+		if (IsValid(PartActor))
+		{
+			++ClassPool.NumActorsReused;
+		}
+		else
+		{
+			PartActor = nullptr;
+		}
+	}
+
+	if (PartActor == nullptr)
+	{
+		PartActor = SpawnPartActor(PartClass, NewOwner);
+		if (PartActor == nullptr)
+		{
+			return nullptr;
+		}
+		++ClassPool.NumActorsSpawned;
+	}
+
+	PartActor->SetOwner(NewOwner);
+	PartActor->AttachToComponent(AttachTo, FAttachmentTransformRules::SnapToTargetIncludingScale, Part.SocketName);
+	PartActor->SetActorHiddenInGame(false);
+	PartActor->SetActorTickEnabled(PartActor->PrimaryActorTick.bStartWithTickEnabled);
+	LyraCharacterPartPoolCvars::SetComponentTicksEnabled(PartActor, true);
+
+	switch (Part.CollisionMode)
+	{
+	case ECharacterCustomizationCollisionMode::UseCollisionFromCharacterPart:
+		PartActor->SetActorEnableCollision(ClassPool.bActorEnableCollision);
+		break;
+
+	case ECharacterCustomizationCollisionMode::NoCollision:
+		PartActor->SetActorEnableCollision(false);
+		break;
+	}
+
+	// Set up a direct tick dependency so the part is posed after the mesh it is attached to
+	if (USceneComponent* PartRootComponent = PartActor->GetRootComponent())
+	{
+		PartRootComponent->AddTickPrerequisiteComponent(AttachTo);
+	}
+
+	return PartActor;
+}
+
+UMeshComponent* ULyraCharacterPartPoolSubsystem::AcquirePartMesh(const FLyraCharacterPartClassPool& ClassPool, const FLyraCharacterPart& Part, USceneComponent* AttachTo)
+{
+	// The component belongs to the pawn while it is in use, so the pawn's visibility, owner-only rendering and lifetime apply to it
+	AActor* PawnOwner = AttachTo->GetOwner();
+	if (PawnOwner == nullptr)
+	{
+		return nullptr;
+	}
+
+	UObject* MeshAsset = (ClassPool.SkeletalMesh != nullptr) ? static_cast<UObject*>(ClassPool.SkeletalMesh) : static_cast<UObject*>(ClassPool.StaticMesh);
+	FLyraCharacterPartMeshPool& MeshPool = MeshPools.FindOrAdd(MeshAsset);
+
+	UMeshComponent* PartMesh = nullptr;
+	while ((PartMesh == nullptr) && (MeshPool.FreeComponents.Num() > 0))
+	{
+		PartMesh = MeshPool.FreeComponents.Pop(/*bAllowShrinking=*/ false);
+		if (IsValid(PartMesh))
+		{
+			++MeshPool.NumComponentsReused;
+		}
+		else
+		{
+			PartMesh = nullptr;
+		}
+	}
+
+	if (PartMesh == nullptr)
+	{
+		if (ClassPool.SkeletalMesh != nullptr)
+		{
+			USkeletalMeshComponent* NewSkeletalMesh = NewObject<USkeletalMeshComponent>(PawnOwner, NAME_None, RF_Transient);
+			NewSkeletalMesh->SetSkeletalMesh(ClassPool.SkeletalMesh);
+			PartMesh = NewSkeletalMesh;
+		}
+		else
+		{
+			UStaticMeshComponent* NewStaticMesh = NewObject<UStaticMeshComponent>(PawnOwner, NAME_None, RF_Transient);
+			NewStaticMesh->SetStaticMesh(ClassPool.StaticMesh);
+			PartMesh = NewStaticMesh;
+		}
+
+		++MeshPool.NumComponentsCreated;
+	}
+	else
+	{
+		PartMesh->Rename(nullptr, PawnOwner, REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional);
+	}
+
+	PartMesh->SetRelativeTransform(ClassPool.MeshRelativeTransform);
+	PartMesh->SetupAttachment(AttachTo, Part.SocketName);
+	PartMesh->SetOwnerNoSee(ClassPool.bOwnerNoSee);
+	PartMesh->SetOnlyOwnerSee(ClassPool.bOnlyOwnerSee);
+	PartMesh->RegisterComponent();
+
+	// Reset anything a previous user may have changed (e.g., team coloring)
+	PartMesh->EmptyOverrideMaterials();
+	for (int32 MaterialIndex = 0; MaterialIndex < ClassPool.OverrideMaterials.Num(); ++MaterialIndex)
+	{
+		if (UMaterialInterface* Material = ClassPool.OverrideMaterials[MaterialIndex])
+		{
+			PartMesh->SetMaterial(MaterialIndex, Material);
+		}
+	}
+	PartMesh->SetCastShadow(ClassPool.bCastShadow);
+
+	switch (Part.CollisionMode)
+	{
+	case ECharacterCustomizationCollisionMode::UseCollisionFromCharacterPart:
+		PartMesh->SetCollisionProfileName(ClassPool.CollisionProfileName);
+		PartMesh->SetCollisionEnabled(ClassPool.CollisionEnabled);
+		break;
+
+	case ECharacterCustomizationCollisionMode::NoCollision:
+		PartMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		break;
+	}
+
+	// Parts on the root of a mesh with the same skeleton follow its pose instead of animating on their own
+	USkeletalMeshComponent* PartSkeletalMesh = Cast<USkeletalMeshComponent>(PartMesh);
+	USkeletalMeshComponent* ParentSkeletalMesh = Cast<USkeletalMeshComponent>(AttachTo);
+	const USkeletalMesh* ParentMeshAsset = (ParentSkeletalMesh != nullptr) ? ParentSkeletalMesh->GetSkeletalMeshAsset() : nullptr;
+
+	if ((PartSkeletalMesh != nullptr) && (ParentMeshAsset != nullptr) && (Part.SocketName == NAME_None) && (ParentMeshAsset->GetSkeleton() == ClassPool.SkeletalMesh->GetSkeleton()))
+	{
+		PartSkeletalMesh->SetLeaderPoseComponent(ParentSkeletalMesh);
+	}
+	else
+	{
+		PartMesh->AddTickPrerequisiteComponent(AttachTo);
+	}
+
+	return PartMesh;
+}
+
+void ULyraCharacterPartPoolSubsystem::ReleasePartActor(AActor* PartActor)
+{
+	if (!IsValid(PartActor))
+	{
+		return;
+	}
+
+	if (USceneComponent* PartRootComponent = PartActor->GetRootComponent())
+	{
+		if (USceneComponent* AttachParent = PartRootComponent->GetAttachParent())
+		{
+			PartRootComponent->RemoveTickPrerequisiteComponent(AttachParent);
+		}
+	}
+
+	FLyraCharacterPartClassPool* ClassPool = ClassPools.Find(PartActor->GetClass());
+	if ((ClassPool == nullptr) || !CanReturnToPool(ClassPool->FreeActors.Num()))
+	{
+		PartActor->Destroy();
+		return;
+	}
+
+	PartActor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	PartActor->SetOwner(nullptr);
+	PartActor->SetActorHiddenInGame(true);
+	PartActor->SetActorEnableCollision(false);
+	PartActor->SetActorTickEnabled(false);
+	LyraCharacterPartPoolCvars::SetComponentTicksEnabled(PartActor, false);
+
+	ClassPool->FreeActors.Add(PartActor);
+}
+
+void ULyraCharacterPartPoolSubsystem::ReleasePartMesh(UMeshComponent* PartMesh)
+{
+	if (!IsValid(PartMesh))
+	{
+		return;
+	}
+
+	USkeletalMeshComponent* PartSkeletalMesh = Cast<USkeletalMeshComponent>(PartMesh);
+	if ((PartSkeletalMesh != nullptr) && PartSkeletalMesh->LeaderPoseComponent.IsValid())
+	{
+		PartSkeletalMesh->SetLeaderPoseComponent(nullptr);
+	}
+	else if (USceneComponent* AttachParent = PartMesh->GetAttachParent())
+	{
+		PartMesh->RemoveTickPrerequisiteComponent(AttachParent);
+	}
+
+	UObject* MeshAsset = (PartSkeletalMesh != nullptr) ? static_cast<UObject*>(PartSkeletalMesh->GetSkeletalMeshAsset()) : static_cast<UObject*>(CastChecked<UStaticMeshComponent>(PartMesh)->GetStaticMesh());
+	FLyraCharacterPartMeshPool* MeshPool = MeshPools.Find(MeshAsset);
+	if ((MeshPool == nullptr) || !CanReturnToPool(MeshPool->FreeComponents.Num()))
+	{
+		PartMesh->DestroyComponent();
+		return;
+	}
+
+	// Take the component off the pawn entirely so it neither renders nor dies with it while it waits in the pool
+	PartMesh->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+	PartMesh->UnregisterComponent();
+	PartMesh->Rename(nullptr, this, REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional);
+
+	MeshPool->FreeComponents.Add(PartMesh);
+}
+
+AActor* ULyraCharacterPartPoolSubsystem::SpawnPartActor(UClass* PartClass, AActor* NewOwner)
+{
+	UWorld* World = GetWorld();
+
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.Owner = NewOwner;
+	SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnInfo.ObjectFlags |= RF_Transient;
+
+	AActor* PartActor = World->SpawnActor<AActor>(PartClass, FTransform::Identity, SpawnInfo);
+	if (PartActor == nullptr)
+	{
+		UE_LOG(LogLyra, Warning, TEXT("Failed to spawn character part %s"), *GetPathNameSafe(PartClass));
+	}
+
+	return PartActor;
+}
+
+bool ULyraCharacterPartPoolSubsystem::CanReturnToPool(int32 NumAlreadyPooled) const
+{
+	const UWorld* World = GetWorld();
+	return LyraCharacterPartPoolCvars::bPoolCharacterParts
+		&& (NumAlreadyPooled < LyraCharacterPartPoolCvars::MaxPooledPartsPerClass)
+		&& (World != nullptr) && !World->bIsTearingDown;
+}
+
+void ULyraCharacterPartPoolSubsystem::DumpPoolStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Character part pools for %s:"), *GetPathNameSafe(GetWorld()));
+
+	for (const auto& KVP : ClassPools)
+	{
+		const FLyraCharacterPartClassPool& ClassPool = KVP.Value;
+		Ar.Logf(TEXT("  %s: %s, %d actors spawned, %d reused, %d pooled, %d mesh parts attached"),
+			*GetNameSafe(KVP.Key),
+			ClassPool.bMeshOnly ? TEXT("mesh-only") : TEXT("actor"),
+			ClassPool.NumActorsSpawned,
+			ClassPool.NumActorsReused,
+			ClassPool.FreeActors.Num(),
+			ClassPool.NumMeshesAcquired);
+	}
+
+	for (const auto& KVP : MeshPools)
+	{
+		const FLyraCharacterPartMeshPool& MeshPool = KVP.Value;
+		Ar.Logf(TEXT("  Mesh %s: %d components created, %d reused, %d pooled"),
+			*GetNameSafe(KVP.Key),
+			MeshPool.NumComponentsCreated,
+			MeshPool.NumComponentsReused,
+			MeshPool.FreeComponents.Num());
+	}
+}
@@ -0,0 +1,159 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/EngineTypes.h"
+#include "GameplayTagContainer.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "LyraCharacterPartPool.generated.h"
+
+class AActor;
+class FOutputDevice;
+class UMaterialInterface;
+class UMeshComponent;
+class USceneComponent;
+class USkeletalMesh;
+class UStaticMesh;
+struct FLyraCharacterPart;
+
+//////////////////////////////////////////////////////////////////////
+
+// Everything we know about a character part class, plus the hidden part actors that are waiting to be reused
+USTRUCT()
+struct FLyraCharacterPartClassPool
+{
+	GENERATED_BODY()
+
+	// Has a part actor of this class been spawned and inspected yet?
+	UPROPERTY()
+	bool bAnalyzed = false;
+
+	// Is the part nothing more than a single skeletal or static mesh (no event graph, no ticking, no other components)?
+	// If so it can be represented by a pooled mesh component instead of an actor
+	UPROPERTY()
+	bool bMeshOnly = false;
+
+	// Whether collision was enabled on a freshly spawned part actor, restored when a pooled actor is reused
+	UPROPERTY()
+	bool bActorEnableCollision = true;
+
+	// Gameplay tags reported by the part actor, cached so mesh-only parts still drive body style selection
+	UPROPERTY()
+	FGameplayTagContainer PartTags;
+
+	// Mesh-only parts: the mesh to display (exactly one of these is set)
+	UPROPERTY()
+	TObjectPtr<USkeletalMesh> SkeletalMesh;
+
+	UPROPERTY()
+	TObjectPtr<UStaticMesh> StaticMesh;
+
+	// Mesh-only parts: settings copied from the mesh component of the inspected part actor
+	UPROPERTY()
+	TArray<TObjectPtr<UMaterialInterface>> OverrideMaterials;
+
+	UPROPERTY()
+	FTransform MeshRelativeTransform;
+
+	UPROPERTY()
+	FName CollisionProfileName;
+
+	UPROPERTY()
+	TEnumAsByte<ECollisionEnabled::Type> CollisionEnabled = ECollisionEnabled::NoCollision;
+
+	UPROPERTY()
+	bool bCastShadow = true;
+
+	UPROPERTY()
+	bool bOwnerNoSee = false;
+
+	UPROPERTY()
+	bool bOnlyOwnerSee = false;
+
+	// Hidden, detached part actors ready to be reused
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> FreeActors;
+
+	// Stats
+	int32 NumActorsSpawned = 0;
+	int32 NumActorsReused = 0;
+	int32 NumMeshesAcquired = 0;
+};
+
+// Unregistered, detached mesh components showing one mesh asset, ready to be reused
+USTRUCT()
+struct FLyraCharacterPartMeshPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UMeshComponent>> FreeComponents;
+
+	// Stats
+	int32 NumComponentsCreated = 0;
+	int32 NumComponentsReused = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+/**
+ * ULyraCharacterPartPoolSubsystem
+ *
+ * Recycles the cosmetic parts spawned by ULyraPawnComponent_CharacterParts so that respawning pawns do not pay for
+ * constructing hats, weapons and body parts every time.
+ *
+ * Part actors are pooled per part class and reattached to the next pawn that asks for the same class. Parts that turn
+ * out to be nothing but a single mesh skip the actor entirely (see Lyra.Cosmetics.LightweightMeshParts): a pooled
+ * skeletal or static mesh component is moved onto the pawn and attached to its mesh, following it with a leader pose
+ * when it shares its skeleton. Those parts are only returned by GetCharacterPartMeshes, not by GetCharacterPartActors.
+ * ULyraPawnComponent_CharacterParts applies the pawn's team colors to them itself, any other styling that walks the
+ * part actors has to handle the meshes as well.
+ *
+ * Pooled parts are not re-constructed, so part actors should not rely on BeginPlay running once per pawn; listen to
+ * ULyraPawnComponent_CharacterParts::OnCharacterPartsChanged instead.
+ */
+UCLASS()
+class ULyraCharacterPartPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	// Spawns or reuses the representation of a part attached to AttachTo, returning either a part actor or a mesh component
+	bool AcquirePart(const FLyraCharacterPart& Part, USceneComponent* AttachTo, AActor* NewOwner, AActor*& OutPartActor, UMeshComponent*& OutPartMesh);
+
+	// Detaches a part returned by AcquirePart and hides it in the pool (or destroys it if the pool is full)
+	void ReleasePart(AActor* PartActor, UMeshComponent* PartMesh);
+
+	// Returns the gameplay tags of a part class that has already been spawned at least once, or nullptr
+	const FGameplayTagContainer* FindPartTags(TSubclassOf<AActor> PartClass) const;
+
+	// Prints the pool sizes and hit rates
+	void DumpPoolStats(FOutputDevice& Ar) const;
+
+private:
+	FLyraCharacterPartClassPool& FindOrAnalyzeClassPool(UClass* PartClass, AActor* NewOwner, AActor*& OutSpawnedActor);
+	void AnalyzePartActor(AActor* PartActor, FLyraCharacterPartClassPool& ClassPool) const;
+
+	AActor* AcquirePartActor(FLyraCharacterPartClassPool& ClassPool, UClass* PartClass, AActor* SpawnedActor, const FLyraCharacterPart& Part, USceneComponent* AttachTo, AActor* NewOwner);
+	UMeshComponent* AcquirePartMesh(const FLyraCharacterPartClassPool& ClassPool, const FLyraCharacterPart& Part, USceneComponent* AttachTo);
+
+	void ReleasePartActor(AActor* PartActor);
+	void ReleasePartMesh(UMeshComponent* PartMesh);
+
+	AActor* SpawnPartActor(UClass* PartClass, AActor* NewOwner);
+
+	bool CanReturnToPool(int32 NumAlreadyPooled) const;
+
+private:
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, FLyraCharacterPartClassPool> ClassPools;
+
+	// Keyed by the skeletal or static mesh asset shown by the components
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UObject>, FLyraCharacterPartMeshPool> MeshPools;
+};
@@ -3,10 +3,15 @@
 #include "Cosmetics/LyraPawnComponent_CharacterParts.h"
 
 #include "Components/SkeletalMeshComponent.h"
+#include "Cosmetics/LyraCharacterPartPool.h"
 #include "Cosmetics/LyraCharacterPartTypes.h"
+#include "Engine/World.h"
 #include "GameFramework/Character.h"
 #include "GameplayTagAssetInterface.h"
 #include "Net/UnrealNetwork.h"
+#include "Teams/LyraTeamAgentInterface.h"
+#include "Teams/LyraTeamDisplayAsset.h"
+#include "Teams/LyraTeamSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraPawnComponent_CharacterParts)
 
@@ -19,7 +24,7 @@ class UWorld;
 
 FString FLyraAppliedCharacterPartEntry::GetDebugString() const
 {
-	return FString::Printf(TEXT("(PartClass: %s, Socket: %s, Instance: %s)"), *GetPathNameSafe(Part.PartClass), *Part.SocketName.ToString(), *GetPathNameSafe(SpawnedComponent));
+	return FString::Printf(TEXT("(PartClass: %s, Socket: %s, Instance: %s)"), *GetPathNameSafe(Part.PartClass), *Part.SocketName.ToString(), (SpawnedMesh != nullptr) ? *GetPathNameSafe(SpawnedMesh) : *GetPathNameSafe(SpawnedActor));
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -136,15 +141,25 @@ FGameplayTagContainer FLyraCharacterPartList::CollectCombinedTags() const
 {
 	FGameplayTagContainer Result;
 
+	const ULyraCharacterPartPoolSubsystem* PartPool = (OwnerComponent != nullptr) ? UWorld::GetSubsystem<ULyraCharacterPartPoolSubsystem>(OwnerComponent->GetWorld()) : nullptr;
+
 	for (const FLyraAppliedCharacterPartEntry& Entry : Entries)
 	{
-		if (Entry.SpawnedComponent != nullptr)
+		if (Entry.SpawnedActor != nullptr)
 		{
-			if (IGameplayTagAssetInterface* TagInterface = Cast<IGameplayTagAssetInterface>(Entry.SpawnedComponent->GetChildActor()))
+			if (IGameplayTagAssetInterface* TagInterface = Cast<IGameplayTagAssetInterface>(Entry.SpawnedActor))
 			{
 				TagInterface->GetOwnedGameplayTags(/*inout*/ Result);
 			}
 		}
+		else if ((Entry.SpawnedMesh != nullptr) && (PartPool != nullptr))
+		{
+			// Mesh-only parts have no actor to ask, use the tags the pool cached when it inspected the part class
+			if (const FGameplayTagContainer* PartTags = PartPool->FindPartTags(Entry.Part.PartClass))
+			{
+				Result.AppendTags(*PartTags);
+			}
+		}
 	}
 
 	return Result;
@@ -158,40 +173,13 @@ bool FLyraCharacterPartList::SpawnActorForEntry(FLyraAppliedCharacterPartEntry&
 	{
 		if (Entry.Part.PartClass != nullptr)
 		{
-			UWorld* World = OwnerComponent->GetWorld();
-
 			if (USceneComponent* ComponentToAttachTo = OwnerComponent->GetSceneComponentToAttachTo())
 			{
-				const FTransform SpawnTransform = ComponentToAttachTo->GetSocketTransform(Entry.Part.SocketName);
-
-				UChildActorComponent* PartComponent = NewObject<UChildActorComponent>(OwnerComponent->GetOwner());
-
-				PartComponent->SetupAttachment(ComponentToAttachTo, Entry.Part.SocketName);
-				PartComponent->SetChildActorClass(Entry.Part.PartClass);
-				PartComponent->RegisterComponent();
-
-				if (AActor* SpawnedActor = PartComponent->GetChildActor())
+				// Parts are recycled across pawns, and mesh-only parts come back as a bare mesh component instead of an actor
+				if (ULyraCharacterPartPoolSubsystem* PartPool = UWorld::GetSubsystem<ULyraCharacterPartPoolSubsystem>(OwnerComponent->GetWorld()))
 				{
-					switch (Entry.Part.CollisionMode)
-					{
-					case ECharacterCustomizationCollisionMode::UseCollisionFromCharacterPart:
-						// Do nothing
-						break;
-
-					case ECharacterCustomizationCollisionMode::NoCollision:
-						SpawnedActor->SetActorEnableCollision(false);
-						break;
-					}
-
-					// Set up a direct tick dependency to work around the child actor component not providing one
-					if (USceneComponent* SpawnedRootComponent = SpawnedActor->GetRootComponent())
-					{
-						SpawnedRootComponent->AddTickPrerequisiteComponent(ComponentToAttachTo);
-					}
+					bCreatedAnyActors = PartPool->AcquirePart(Entry.Part, ComponentToAttachTo, OwnerComponent->GetOwner(), /*out*/ Entry.SpawnedActor, /*out*/ Entry.SpawnedMesh);
 				}
-
-				Entry.SpawnedComponent = PartComponent;
-				bCreatedAnyActors = true;
 			}
 		}
 	}
@@ -203,10 +191,26 @@ bool FLyraCharacterPartList::DestroyActorForEntry(FLyraAppliedCharacterPartEntry
 {
 	bool bDestroyedAnyActors = false;
 
-	if (Entry.SpawnedComponent != nullptr)
+	if ((Entry.SpawnedActor != nullptr) || (Entry.SpawnedMesh != nullptr))
 	{
-		Entry.SpawnedComponent->DestroyComponent();
-		Entry.SpawnedComponent = nullptr;
+		if (ULyraCharacterPartPoolSubsystem* PartPool = (OwnerComponent != nullptr) ? UWorld::GetSubsystem<ULyraCharacterPartPoolSubsystem>(OwnerComponent->GetWorld()) : nullptr)
+		{
+			PartPool->ReleasePart(Entry.SpawnedActor, Entry.SpawnedMesh);
+		}
+		else
+		{
+			if (IsValid(Entry.SpawnedActor))
+			{
+				Entry.SpawnedActor->Destroy();
+			}
+			if (IsValid(Entry.SpawnedMesh))
+			{
+				Entry.SpawnedMesh->DestroyComponent();
+			}
+		}
+
+		Entry.SpawnedActor = nullptr;
+		Entry.SpawnedMesh = nullptr;
 		bDestroyedAnyActors = true;
 	}
 
@@ -246,10 +250,26 @@ void ULyraPawnComponent_CharacterParts::RemoveAllCharacterParts()
 void ULyraPawnComponent_CharacterParts::BeginPlay()
 {
 	Super::BeginPlay();
+
+	if (ILyraTeamAgentInterface* TeamAgent = Cast<ILyraTeamAgentInterface>(GetOwner()))
+	{
+		if (FOnLyraTeamIndexChangedDelegate* TeamChangedDelegate = TeamAgent->GetOnTeamIndexChangedDelegate())
+		{
+			TeamChangedDelegate->AddDynamic(this, &ThisClass::OnOwnerTeamChanged);
+		}
+	}
 }
 
 void ULyraPawnComponent_CharacterParts::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	if (ILyraTeamAgentInterface* TeamAgent = Cast<ILyraTeamAgentInterface>(GetOwner()))
+	{
+		if (FOnLyraTeamIndexChangedDelegate* TeamChangedDelegate = TeamAgent->GetOnTeamIndexChangedDelegate())
+		{
+			TeamChangedDelegate->RemoveAll(this);
+		}
+	}
+
 	CharacterPartList.ClearAllEntries(/*bBroadcastChangeDelegate=*/ false);
 
 	Super::EndPlay(EndPlayReason);
@@ -272,12 +292,30 @@ TArray<AActor*> ULyraPawnComponent_CharacterParts::GetCharacterPartActors() cons
 
 	for (const FLyraAppliedCharacterPartEntry& Entry : CharacterPartList.Entries)
 	{
-		if (UChildActorComponent* PartComponent = Entry.SpawnedComponent)
+		if (AActor* SpawnedActor = Entry.SpawnedActor)
 		{
-			if (AActor* SpawnedActor = PartComponent->GetChildActor())
-			{
-				Result.Add(SpawnedActor);
-			}
+			Result.Add(SpawnedActor);
+		}
+	}
+
+	return Result;
+}
+
+TArray<UMeshComponent*> ULyraPawnComponent_CharacterParts::GetCharacterPartMeshes() const
+{
+	TArray<UMeshComponent*> Result;
+	Result.Reserve(CharacterPartList.Entries.Num());
+
+	for (const FLyraAppliedCharacterPartEntry& Entry : CharacterPartList.Entries)
+	{
+		if (UMeshComponent* SpawnedMesh = Entry.SpawnedMesh)
+		{
+			Result.Add(SpawnedMesh);
+		}
+		else if (AActor* SpawnedActor = Entry.SpawnedActor)
+		{
+			TInlineComponentArray<UMeshComponent*> ActorMeshes(SpawnedActor);
+			Result.Append(ActorMeshes);
 		}
 	}
 
@@ -350,8 +388,46 @@ void ULyraPawnComponent_CharacterParts::BroadcastChanged()
 		}
 	}
 
+	ApplyTeamColorsToMeshParts();
+
 	// Let observers know, e.g., if they need to apply team coloring or similar
 	OnCharacterPartsChanged.Broadcast(this);
 }
 
+void ULyraPawnComponent_CharacterParts::ApplyTeamColorsToMeshParts()
+{
+	if (IsNetMode(NM_DedicatedServer))
+	{
+		return;
+	}
+
+	ULyraTeamSubsystem* TeamSubsystem = UWorld::GetSubsystem<ULyraTeamSubsystem>(GetWorld());
+	if (TeamSubsystem == nullptr)
+	{
+		return;
+	}
+
+	const int32 TeamId = TeamSubsystem->FindTeamFromObject(GetOwner());
+	if (TeamId == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (ULyraTeamDisplayAsset* DisplayAsset = TeamSubsystem->GetTeamDisplayAsset(TeamId, TeamId))
+	{
+		for (const FLyraAppliedCharacterPartEntry& Entry : CharacterPartList.Entries)
+		{
+			if (Entry.SpawnedMesh != nullptr)
+			{
+				DisplayAsset->ApplyToMeshComponent(Entry.SpawnedMesh);
+			}
+		}
+	}
+}
+
+void ULyraPawnComponent_CharacterParts::OnOwnerTeamChanged(UObject* ObjectChangingTeam, int32 OldTeamID, int32 NewTeamID)
+{
+	ApplyTeamColorsToMeshParts();
+}
+
 
@@ -15,7 +15,7 @@ struct FGameplayTag;
 struct FLyraCharacterPartList;
 
 class AActor;
-class UChildActorComponent;
+class UMeshComponent;
 class UObject;
 class USceneComponent;
 class USkeletalMeshComponent;
@@ -50,9 +50,13 @@ private:
 	UPROPERTY(NotReplicated)
 	int32 PartHandle = INDEX_NONE;
 
-	// The spawned actor instance (client only)
+	// The spawned (or pooled) part actor instance (client only)
 	UPROPERTY(NotReplicated)
-	TObjectPtr<UChildActorComponent> SpawnedComponent = nullptr;
+	TObjectPtr<AActor> SpawnedActor = nullptr;
+
+	// The pooled mesh component used instead of an actor for mesh-only parts (client only)
+	UPROPERTY(NotReplicated)
+	TObjectPtr<UMeshComponent> SpawnedMesh = nullptr;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -149,6 +153,10 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure=false, BlueprintCosmetic, Category=Cosmetics)
 	TArray<AActor*> GetCharacterPartActors() const;
 
+	// Gets the mesh components of all spawned character parts, including mesh-only parts that have no actor
+	UFUNCTION(BlueprintCallable, BlueprintPure=false, BlueprintCosmetic, Category=Cosmetics)
+	TArray<UMeshComponent*> GetCharacterPartMeshes() const;
+
 	// If the parent actor is derived from ACharacter, returns the Mesh component, otherwise nullptr
 	USkeletalMeshComponent* GetParentMeshComponent() const;
 
@@ -162,6 +170,13 @@ public:
 
 	void BroadcastChanged();
 
+private:
+	// Mesh-only parts are invisible to styling that walks GetCharacterPartActors, so team colors are applied to them here
+	void ApplyTeamColorsToMeshParts();
+
+	UFUNCTION()
+	void OnOwnerTeamChanged(UObject* ObjectChangingTeam, int32 OldTeamID, int32 NewTeamID);
+
 public:
 	// Delegate that will be called when the list of spawned character parts has changed
 	UPROPERTY(BlueprintAssignable, Category=Cosmetics, BlueprintCallable)
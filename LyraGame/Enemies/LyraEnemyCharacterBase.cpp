@@ -4,7 +4,9 @@
 #include "LyraEnemyCharacterBase.h"
 
 #include "AIController.h"
+#include "AbilitySystem/Attributes/LyraAttributeDefaults.h"
 #include "AbilitySystem/LyraAbilitySet.h" 
+#include "AbilitySystem/LyraAbilitySystemComponent.h"
 #include "Character/LyraPawnData.h"
 #include "Character/LyraPawnExtensionComponent.h"
 #include "Components/GameFrameworkComponentManager.h"
@@ -13,11 +15,33 @@
 
 const FName ALyraEnemyCharacterBase::NAME_LyraAbilityReady("LyraAbilitiesReady");
 
+ALyraEnemyCharacterBase::ALyraEnemyCharacterBase(const FObjectInitializer& ObjectInitializer)
+	// Enemies create their optional attribute sets from their pawn data, see InitializeAttributeSets.
+	: Super(ObjectInitializer.DoNotCreateDefaultSubobject(ALyraCharacterWithAbilities::ManaSetName))
+{
+	// Enemies are only ever AI controlled, and are granted their abilities before their controller possesses them
+	AbilitySystemComponent->SetOwnerIsAlwaysAI(true);
+}
+
 void ALyraEnemyCharacterBase::BeginPlay()
 {
 	Super::BeginPlay();
 }
 
+void ALyraEnemyCharacterBase::PostNetInit()
+{
+	Super::PostNetInit();
+
+	// The spawner initializes the ability system on the server, clients do it once the pawn data has replicated
+	if (ULyraPawnExtensionComponent* PawnExtComp = ULyraPawnExtensionComponent::FindPawnExtensionComponent(this))
+	{
+		if (PawnExtComp->GetPawnData<ULyraPawnData>() && AbilitySystemComponent)
+		{
+			PawnExtComp->InitializeAbilitySystem(AbilitySystemComponent, this);
+		}
+	}
+}
+
 void ALyraEnemyCharacterBase::SetPawnData(const ULyraPawnData* InPawnData)
 {
 	check(InPawnData);
@@ -52,10 +76,46 @@ FName ALyraEnemyCharacterBase::GetEnemyPawnName() const
 
 void ALyraEnemyCharacterBase::OnAbilitySystemInitialized()
 {
+	const ULyraPawnExtensionComponent* LyraPawnExtensionComponent = ULyraPawnExtensionComponent::FindPawnExtensionComponent(this);
+	const ULyraPawnData* InPawnData = LyraPawnExtensionComponent ? LyraPawnExtensionComponent->GetPawnData<ULyraPawnData>() : nullptr;
+
+	// The health and mana components bind to the attribute sets in Super, so they have to exist by then.
+	if (InPawnData)
+	{
+		InitializeAttributeSets(InPawnData);
+	}
+
 	Super::OnAbilitySystemInitialized();
 
-	if (const ULyraPawnExtensionComponent* LyraPawnExtensionComponent = ULyraPawnExtensionComponent::FindPawnExtensionComponent(this))
+	if (InPawnData)
+	{
+		SetPawnData(InPawnData);
+	}
+}
+
+void ALyraEnemyCharacterBase::InitializeAttributeSets(const ULyraPawnData* InPawnData)
+{
+	check(InPawnData);
+
+	if (!AbilitySystemComponent)
+	{
+		return;
+	}
+
+	// Clients create the same sets under the same names before the health and mana components bind, and the server's
+	// replicated sets resolve to them by name instead of arriving later as new objects
+	for (const TSubclassOf<UAttributeSet>& AttributeSetClass : InPawnData->AttributeSets)
+	{
+		if (AttributeSetClass && !AbilitySystemComponent->GetAttributeSet(AttributeSetClass))
+		{
+			UAttributeSet* NewSet = NewObject<UAttributeSet>(this, AttributeSetClass, AttributeSetClass->GetFName());
+			NewSet->SetNetAddressable();
+			AbilitySystemComponent->AddAttributeSetSubobject(NewSet);
+		}
+	}
+
+	if (InPawnData->AttributeDefaults && (GetLocalRole() == ROLE_Authority))
 	{
-		SetPawnData(LyraPawnExtensionComponent->GetPawnData<ULyraPawnData>());
+		InPawnData->AttributeDefaults->ApplyToAbilitySystem(AbilitySystemComponent);
 	}
 }
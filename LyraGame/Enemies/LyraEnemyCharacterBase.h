@@ -16,7 +16,10 @@ class LYRAGAME_API ALyraEnemyCharacterBase : public ALyraCharacterWithAbilities
 
 public:
 
+	ALyraEnemyCharacterBase(const FObjectInitializer& ObjectInitializer);
+
 	virtual void BeginPlay() override;
+	virtual void PostNetInit() override;
 	
 	static const FName NAME_LyraAbilityReady;
 
@@ -28,6 +31,9 @@ public:
 protected:
 	virtual void OnAbilitySystemInitialized() override;
 
+	// Creates the attribute sets listed by the pawn data (on every machine, so replicated values find them) and applies its attribute defaults (authority only).
+	void InitializeAttributeSets(const ULyraPawnData* InPawnData);
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category=PawnData)
 	const ULyraPawnData* PawnData;
 
@@ -2,12 +2,23 @@
 #include "AbilitySystemGlobals.h"
 #include "AIController.h"
 #include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "AbilitySystem/LyraGameplayCueManager.h"
 #include "Character/LyraPawnData.h"
 #include "Character/LyraPawnExtensionComponent.h"
+#include "Enemies/LyraEnemyCharacterBase.h"
+#include "EngineUtils.h"
 #include "GameFramework/PlayerState.h"
 #include "GameModes/LyraExperienceManagerComponent.h"
 #include "Teams/LyraTeamSubsystem.h"
 
+namespace LyraEnemySpawnerStats
+{
+	// Time spent in SpawnOneEnemy, from spawning the pawn to its ability system being initialized
+	static int32 NumSpawned = 0;
+	static double TotalSpawnSeconds = 0.0;
+	static double MaxSpawnSeconds = 0.0;
+}
+
 ALyraEnemySpawner::ALyraEnemySpawner(): BehaviorTree(nullptr)
 {
 	PrimaryActorTick.bCanEverTick = false;
@@ -16,6 +27,12 @@ ALyraEnemySpawner::ALyraEnemySpawner(): BehaviorTree(nullptr)
 void ALyraEnemySpawner::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Enemies spawn after the experience has loaded, make sure the cues of their abilities are in memory by then
+	if (ULyraGameplayCueManager* GameplayCueManager = ULyraGameplayCueManager::Get())
+	{
+		GameplayCueManager->PreloadCuesForPawnData(PawnData, this);
+	}
 	
 	const AGameStateBase* GameState = GetWorld()->GetGameState();
 	check(GameState);
@@ -37,16 +54,23 @@ void ALyraEnemySpawner::OnExperienceLoaded(const ULyraExperienceDefinition* Expe
 
 void ALyraEnemySpawner::ServerCreateEnemies()
 {
-	if (ControllerClass == nullptr)
+	SpawnEnemies(NumberOfEnemiesToCreate);
+}
+
+int32 ALyraEnemySpawner::SpawnEnemies(int32 Count)
+{
+	if (!HasAuthority() || ControllerClass == nullptr)
 	{
-		return;
+		return 0;
 	}
 
-	// Create them
-	for (int32 Count = 0; Count < NumberOfEnemiesToCreate; ++Count)
+	const int32 NumSpawnedBefore = SpawnedEnemyList.Num();
+	for (int32 Index = 0; Index < Count; ++Index)
 	{
 		SpawnOneEnemy();
 	}
+
+	return SpawnedEnemyList.Num() - NumSpawnedBefore;
 }
 
 // similar to UAIBlueprintHelperLibrary::SpawnAIFromClass but we use the controller class defined here instead of the one set on the pawn
@@ -129,6 +153,8 @@ void ALyraEnemySpawner::SpawnOneEnemy()
 
 	if (LoadedPawnData)
 	{
+		const double SpawnStartTime = FPlatformTime::Seconds();
+
 		if (APawn* SpawnedNPC = SpawnEnemyFromClass(GetWorld(), LoadedPawnData, BehaviorTree, GetActorLocation(), GetActorRotation(), true, this, ControllerClass))
 		{
 			bool bWantsPlayerState = true;
@@ -155,7 +181,50 @@ void ALyraEnemySpawner::SpawnOneEnemy()
 			SpawnedEnemyList.Add(Cast<AAIController>(SpawnedNPC->Controller));
 
 			SpawnedNPC->OnDestroyed.AddDynamic(this, &ThisClass::OnSpawnedPawnDestroyed);
+
+			const double SpawnTime = FPlatformTime::Seconds() - SpawnStartTime;
+			++LyraEnemySpawnerStats::NumSpawned;
+			LyraEnemySpawnerStats::TotalSpawnSeconds += SpawnTime;
+			LyraEnemySpawnerStats::MaxSpawnSeconds = FMath::Max(LyraEnemySpawnerStats::MaxSpawnSeconds, SpawnTime);
+
 			OnEnemyPawnSpawned(SpawnedNPC);
 		}
 	}
-}
\ No newline at end of file
+}
+
+//////////////////////////////////////////////////////////////////////
+
+static FAutoConsoleCommandWithWorldAndArgs DumpEnemySpawnStatsCommand(
+	TEXT("Lyra.Enemies.DumpSpawnStats"),
+	TEXT("Prints the average spawn cost and ability system footprint of the spawned enemies. Pass 'reset' to clear the spawn timings."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if ((Args.Num() > 0) && (Args[0] == TEXT("reset")))
+		{
+			LyraEnemySpawnerStats::NumSpawned = 0;
+			LyraEnemySpawnerStats::TotalSpawnSeconds = 0.0;
+			LyraEnemySpawnerStats::MaxSpawnSeconds = 0.0;
+			return;
+		}
+
+		FLyraAbilitySystemMemoryReport Report;
+		int32 NumEnemies = 0;
+		for (TActorIterator<ALyraEnemyCharacterBase> It(World); It; ++It)
+		{
+			++NumEnemies;
+			if (const ULyraAbilitySystemComponent* LyraASC = Cast<ULyraAbilitySystemComponent>(It->GetAbilitySystemComponent()))
+			{
+				LyraASC->AccumulateMemoryReport(Report);
+			}
+		}
+
+		const int32 NumSpawned = LyraEnemySpawnerStats::NumSpawned;
+		GLog->Logf(TEXT("Enemies spawned: %d, average spawn cost: %.3f ms, max: %.3f ms"),
+			NumSpawned, LyraEnemySpawnerStats::TotalSpawnSeconds * 1000.0 / FMath::Max(NumSpawned, 1), LyraEnemySpawnerStats::MaxSpawnSeconds * 1000.0);
+
+		const double PerEnemy = 1.0 / FMath::Max(NumEnemies, 1);
+		GLog->Logf(TEXT("Enemies alive: %d"), NumEnemies);
+		GLog->Logf(TEXT("  Per enemy: %.1f attribute sets, %.1f ability specs, %.1f ability instances, %.1f lazy abilities"),
+			Report.NumAttributeSets * PerEnemy, Report.NumAbilitySpecs * PerEnemy, Report.NumAbilityInstances * PerEnemy, Report.NumLazyAbilities * PerEnemy);
+		GLog->Logf(TEXT("  Estimated ability system memory per enemy: %.2f KB"), Report.EstimatedBytes / 1024.0 * PerEnemy);
+	}));
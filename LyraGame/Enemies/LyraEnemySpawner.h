@@ -28,6 +28,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay)
 	UBehaviorTree* BehaviorTree;
 	
+	/** Spawns additional enemies on top of NumberOfEnemiesToCreate (e.g., for stress tests and benchmarks). Returns the number of enemies actually spawned. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = Spawn)
+	int32 SpawnEnemies(int32 Count);
+
 
 protected:
 	// Called when the game starts or when spawned
@@ -103,6 +103,21 @@ void ULyraEquipmentInstance::DestroyEquipmentActors()
 	}
 }
 
+void ULyraEquipmentInstance::SetStowed(bool bInStowed)
+{
+	bStowed = bInStowed;
+
+	for (AActor* Actor : SpawnedActors)
+	{
+		if (Actor)
+		{
+			Actor->SetActorHiddenInGame(bInStowed);
+			Actor->SetActorEnableCollision(!bInStowed);
+			Actor->SetActorTickEnabled(!bInStowed);
+		}
+	}
+}
+
 void ULyraEquipmentInstance::OnEquipped()
 {
 	K2_OnEquipped();
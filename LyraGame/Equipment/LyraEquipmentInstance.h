@@ -50,6 +50,13 @@ public:
 	virtual void OnEquipped();
 	virtual void OnUnequipped();
 
+	/** Returns true while the equipment is kept spawned but put away (see ULyraEquipmentManagerComponent::SetItemStowed) */
+	UFUNCTION(BlueprintPure, Category=Equipment)
+	bool IsStowed() const { return bStowed; }
+
+	/** Hides (and stops ticking and colliding) or shows the spawned actors */
+	virtual void SetStowed(bool bInStowed);
+
 	UPROPERTY(BlueprintAssignable, Category=Equipment)
 	FOnUnequipped OnEquipmentUnequipped;
 
@@ -75,4 +82,7 @@ private:
 
 	UPROPERTY(Replicated)
 	TArray<TObjectPtr<AActor>> SpawnedActors;
+
+	/** Set on the server and on clients from the equipment list entry */
+	bool bStowed = false;
 };
@@ -30,7 +30,7 @@ void FLyraEquipmentList::PreReplicatedRemove(const TArrayView<int32> RemovedIndi
  	for (int32 Index : RemovedIndices)
  	{
  		const FLyraAppliedEquipmentEntry& Entry = Entries[Index];
-		if (Entry.Instance != nullptr)
+		if ((Entry.Instance != nullptr) && !Entry.bLastObservedStowed)
 		{
 			Entry.Instance->OnUnequipped();
 		}
@@ -41,21 +41,50 @@ void FLyraEquipmentList::PostReplicatedAdd(const TArrayView<int32> AddedIndices,
 {
 	for (int32 Index : AddedIndices)
 	{
-		const FLyraAppliedEquipmentEntry& Entry = Entries[Index];
+		FLyraAppliedEquipmentEntry& Entry = Entries[Index];
+		Entry.bLastObservedStowed = Entry.bStowed;
+
 		if (Entry.Instance != nullptr)
 		{
-			Entry.Instance->OnEquipped();
+			if (Entry.bStowed)
+			{
+				Entry.Instance->SetStowed(true);
+			}
+			else
+			{
+				Entry.Instance->OnEquipped();
+			}
 		}
 	}
 }
 
 void FLyraEquipmentList::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
 {
-// 	for (int32 Index : ChangedIndices)
-// 	{
-// 		const FGameplayTagStack& Stack = Stacks[Index];
-// 		TagToCountMap[Stack.Tag] = Stack.StackCount;
-// 	}
+	for (int32 Index : ChangedIndices)
+	{
+		FLyraAppliedEquipmentEntry& Entry = Entries[Index];
+		if ((Entry.Instance != nullptr) && (Entry.bStowed != Entry.bLastObservedStowed))
+		{
+			if (Entry.bStowed)
+			{
+				Entry.Instance->OnUnequipped();
+				Entry.Instance->SetStowed(true);
+			}
+			else
+			{
+				Entry.Instance->SetStowed(false);
+				Entry.Instance->OnEquipped();
+
+				// The server only restarts the on spawn abilities it executes, locally executed ones are restarted here.
+				if (ULyraAbilitySystemComponent* ASC = GetAbilitySystemComponent())
+				{
+					ASC->TryActivateAbilitiesOnSpawnFromSource(Entry.Instance);
+				}
+			}
+		}
+
+		Entry.bLastObservedStowed = Entry.bStowed;
+	}
 }
 
 ULyraAbilitySystemComponent* FLyraEquipmentList::GetAbilitySystemComponent() const
@@ -65,7 +94,7 @@ ULyraAbilitySystemComponent* FLyraEquipmentList::GetAbilitySystemComponent() con
 	return Cast<ULyraAbilitySystemComponent>(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(OwningActor));
 }
 
-ULyraEquipmentInstance* FLyraEquipmentList::AddEntry(TSubclassOf<ULyraEquipmentDefinition> EquipmentDefinition)
+ULyraEquipmentInstance* FLyraEquipmentList::AddEntry(TSubclassOf<ULyraEquipmentDefinition> EquipmentDefinition, bool bStowed)
 {
 	ULyraEquipmentInstance* Result = nullptr;
 
@@ -86,6 +115,12 @@ ULyraEquipmentInstance* FLyraEquipmentList::AddEntry(TSubclassOf<ULyraEquipmentD
 	NewEntry.Instance = NewObject<ULyraEquipmentInstance>(OwnerComponent->GetOwner(), InstanceType);  //@TODO: Using the actor instead of component as the outer due to UE-127172
 	Result = NewEntry.Instance;
 
+	if (bStowed)
+	{
+		// Stow before granting so abilities that activate on spawn are refused instead of activated and cancelled right away.
+		Result->SetStowed(true);
+	}
+
 	if (ULyraAbilitySystemComponent* ASC = GetAbilitySystemComponent())
 	{
 		for (const TObjectPtr<const ULyraAbilitySet>& AbilitySet : EquipmentCDO->AbilitySetsToGrant)
@@ -100,6 +135,15 @@ ULyraEquipmentInstance* FLyraEquipmentList::AddEntry(TSubclassOf<ULyraEquipmentD
 
 	Result->SpawnEquipmentActors(EquipmentCDO->ActorsToSpawn);
 
+	if (bStowed)
+	{
+		NewEntry.bStowed = true;
+		if (ULyraAbilitySystemComponent* ASC = GetAbilitySystemComponent())
+		{
+			NewEntry.GrantedHandles.SetAbilitiesEnabled(ASC, false);
+		}
+		Result->SetStowed(true);
+	}
 
 	MarkItemDirty(NewEntry);
 
@@ -127,6 +171,32 @@ void FLyraEquipmentList::RemoveEntry(ULyraEquipmentInstance* Instance)
 	}
 }
 
+bool FLyraEquipmentList::SetEntryStowed(ULyraEquipmentInstance* Instance, bool bStowed)
+{
+	FLyraAppliedEquipmentEntry* Entry = Entries.FindByPredicate([Instance](const FLyraAppliedEquipmentEntry& Candidate) { return Candidate.Instance == Instance; });
+	if (!Entry || (Entry->bStowed == bStowed))
+	{
+		return false;
+	}
+
+	Entry->bStowed = bStowed;
+
+	if (!bStowed)
+	{
+		// Equipment abilities refuse to activate while stowed, bring the instance out before enabling them again.
+		Instance->SetStowed(false);
+	}
+
+	if (ULyraAbilitySystemComponent* ASC = GetAbilitySystemComponent())
+	{
+		Entry->GrantedHandles.SetAbilitiesEnabled(ASC, !bStowed);
+	}
+
+	MarkItemDirty(*Entry);
+
+	return true;
+}
+
 //////////////////////////////////////////////////////////////////////
 // ULyraEquipmentManagerComponent
 
@@ -173,11 +243,51 @@ void ULyraEquipmentManagerComponent::UnequipItem(ULyraEquipmentInstance* ItemIns
 			RemoveReplicatedSubObject(ItemInstance);
 		}
 
-		ItemInstance->OnUnequipped();
+		// Stowed equipment already got its OnUnequipped when it was put away.
+		if (!ItemInstance->IsStowed())
+		{
+			ItemInstance->OnUnequipped();
+		}
 		EquipmentList.RemoveEntry(ItemInstance);
 	}
 }
 
+ULyraEquipmentInstance* ULyraEquipmentManagerComponent::EquipItemStowed(TSubclassOf<ULyraEquipmentDefinition> EquipmentClass)
+{
+	ULyraEquipmentInstance* Result = nullptr;
+	if (EquipmentClass != nullptr)
+	{
+		Result = EquipmentList.AddEntry(EquipmentClass, /*bStowed=*/ true);
+		if (Result != nullptr)
+		{
+			if (IsUsingRegisteredSubObjectList() && IsReadyForReplication())
+			{
+				AddReplicatedSubObject(Result);
+			}
+		}
+	}
+	return Result;
+}
+
+void ULyraEquipmentManagerComponent::SetItemStowed(ULyraEquipmentInstance* ItemInstance, bool bStowed)
+{
+	if ((ItemInstance == nullptr) || !EquipmentList.SetEntryStowed(ItemInstance, bStowed))
+	{
+		return;
+	}
+
+	if (bStowed)
+	{
+		ItemInstance->OnUnequipped();
+		ItemInstance->SetStowed(true);
+	}
+	else
+	{
+		// SetEntryStowed already brought the instance out.
+		ItemInstance->OnEquipped();
+	}
+}
+
 bool ULyraEquipmentManagerComponent::ReplicateSubobjects(UActorChannel* Channel, class FOutBunch* Bunch, FReplicationFlags* RepFlags)
 {
 	bool WroteSomething = Super::ReplicateSubobjects(Channel, Bunch, RepFlags);
@@ -243,7 +353,7 @@ ULyraEquipmentInstance* ULyraEquipmentManagerComponent::GetFirstInstanceOfType(T
 	{
 		if (ULyraEquipmentInstance* Instance = Entry.Instance)
 		{
-			if (Instance->IsA(InstanceType))
+			if (!Entry.bStowed && Instance->IsA(InstanceType))
 			{
 				return Instance;
 			}
@@ -260,7 +370,7 @@ TArray<ULyraEquipmentInstance*> ULyraEquipmentManagerComponent::GetEquipmentInst
 	{
 		if (ULyraEquipmentInstance* Instance = Entry.Instance)
 		{
-			if (Instance->IsA(InstanceType))
+			if (!Entry.bStowed && Instance->IsA(InstanceType))
 			{
 				Results.Add(Instance);
 			}
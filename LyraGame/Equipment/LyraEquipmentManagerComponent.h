@@ -44,6 +44,14 @@ private:
 	// Authority-only list of granted handles
 	UPROPERTY(NotReplicated)
 	FLyraAbilitySet_GrantedHandles GrantedHandles;
+
+	// Set while the equipment is spawned but put away: actors hidden, abilities disabled
+	UPROPERTY()
+	bool bStowed = false;
+
+	// Client-side copy of bStowed as of the last replication update, to detect changes
+	UPROPERTY(NotReplicated)
+	bool bLastObservedStowed = false;
 };
 
 /** List of applied equipment */
@@ -74,9 +82,12 @@ public:
 		return FFastArraySerializer::FastArrayDeltaSerialize<FLyraAppliedEquipmentEntry, FLyraEquipmentList>(Entries, DeltaParms, *this);
 	}
 
-	ULyraEquipmentInstance* AddEntry(TSubclassOf<ULyraEquipmentDefinition> EquipmentDefinition);
+	ULyraEquipmentInstance* AddEntry(TSubclassOf<ULyraEquipmentDefinition> EquipmentDefinition, bool bStowed = false);
 	void RemoveEntry(ULyraEquipmentInstance* Instance);
 
+	// Returns false if the instance is not in the list or already in that state.
+	bool SetEntryStowed(ULyraEquipmentInstance* Instance, bool bStowed);
+
 private:
 	ULyraAbilitySystemComponent* GetAbilitySystemComponent() const;
 
@@ -123,6 +134,17 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly)
 	void UnequipItem(ULyraEquipmentInstance* ItemInstance);
 
+	/**
+	 * Spawns the equipment ahead of time, stowed: its actors are hidden and its abilities are granted but disabled.
+	 * Bringing it out with SetItemStowed is then only a visibility and ability toggle, with no spawn or grant.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly)
+	ULyraEquipmentInstance* EquipItemStowed(TSubclassOf<ULyraEquipmentDefinition> EquipmentDefinition);
+
+	/** Puts equipment away (calling OnUnequipped) or brings it back out (calling OnEquipped) without destroying it */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly)
+	void SetItemStowed(ULyraEquipmentInstance* ItemInstance, bool bStowed);
+
 	//~UObject interface
 	virtual bool ReplicateSubobjects(class UActorChannel* Channel, class FOutBunch* Bunch, FReplicationFlags* RepFlags) override;
 	//~End of UObject interface
@@ -134,11 +156,11 @@ public:
 	virtual void ReadyForReplication() override;
 	//~End of UActorComponent interface
 
-	/** Returns the first equipped instance of a given type, or nullptr if none are found */
+	/** Returns the first equipped (not stowed) instance of a given type, or nullptr if none are found */
 	UFUNCTION(BlueprintCallable, BlueprintPure)
 	ULyraEquipmentInstance* GetFirstInstanceOfType(TSubclassOf<ULyraEquipmentInstance> InstanceType);
 
- 	/** Returns all equipped instances of a given type, or an empty array if none are found */
+ 	/** Returns all equipped (not stowed) instances of a given type, or an empty array if none are found */
  	UFUNCTION(BlueprintCallable, BlueprintPure)
 	TArray<ULyraEquipmentInstance*> GetEquipmentInstancesOfType(TSubclassOf<ULyraEquipmentInstance> InstanceType) const;
 
@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "LyraGameplayAbility_FromEquipment.h"
+#include "AbilitySystemComponent.h"
 #include "LyraEquipmentInstance.h"
 #include "Inventory/LyraInventoryItemInstance.h"
 
@@ -34,6 +35,27 @@ ULyraInventoryItemInstance* ULyraGameplayAbility_FromEquipment::GetAssociatedIte
 	return nullptr;
 }
 
+bool ULyraGameplayAbility_FromEquipment::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, FGameplayTagContainer* OptionalRelevantTags) const
+{
+	if (!Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags))
+	{
+		return false;
+	}
+
+	// Stowed equipment keeps its abilities granted but they must not run until it is brought back out.
+	if (UAbilitySystemComponent* ASC = ActorInfo ? ActorInfo->AbilitySystemComponent.Get() : nullptr)
+	{
+		if (const FGameplayAbilitySpec* Spec = ASC->FindAbilitySpecFromHandle(Handle))
+		{
+			if (const ULyraEquipmentInstance* Equipment = Cast<ULyraEquipmentInstance>(Spec->SourceObject.Get()))
+			{
+				return !Equipment->IsStowed();
+			}
+		}
+	}
+
+	return true;
+}
 
 #if WITH_EDITOR
 EDataValidationResult ULyraGameplayAbility_FromEquipment::IsDataValid(FDataValidationContext& Context) const
@@ -29,6 +29,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Lyra|Ability")
 	ULyraInventoryItemInstance* GetAssociatedItem() const;
 
+	//~UGameplayAbility interface
+	virtual bool CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags = nullptr, const FGameplayTagContainer* TargetTags = nullptr, OUT FGameplayTagContainer* OptionalRelevantTags = nullptr) const override;
+	//~End of UGameplayAbility interface
+
 #if WITH_EDITOR
 	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
 #endif
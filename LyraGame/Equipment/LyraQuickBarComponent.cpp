@@ -5,14 +5,27 @@
 #include "Equipment/LyraEquipmentDefinition.h"
 #include "Equipment/LyraEquipmentInstance.h"
 #include "Equipment/LyraEquipmentManagerComponent.h"
+#include "Engine/World.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
 #include "Inventory/InventoryFragment_EquippableItem.h"
 #include "NativeGameplayTags.h"
 #include "Net/UnrealNetwork.h"
+#include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraQuickBarComponent)
 
+namespace LyraQuickBar
+{
+	static bool bPreSpawnSlotEquipment = true;
+	static FAutoConsoleVariableRef CVarPreSpawnSlotEquipment(
+		TEXT("Lyra.QuickBar.PreSpawnSlotEquipment"),
+		bPreSpawnSlotEquipment,
+		TEXT("If set, the equipment of every quick bar slot is spawned ahead of time and kept stowed, so switching slots only toggles visibility and abilities."),
+		ECVF_Default);
+}
+
 class FLifetimeProperty;
 class ULyraEquipmentDefinition;
 
@@ -40,6 +53,8 @@ void ULyraQuickBarComponent::BeginPlay()
 		Slots.AddDefaulted(NumSlots - Slots.Num());
 	}
 
+	SlotEquipment.SetNum(Slots.Num());
+
 	Super::BeginPlay();
 }
 
@@ -51,6 +66,7 @@ ULyraInventoryItemInstance* ULyraQuickBarComponent::AddItemFromInventory(ULyraIn
 		// Remove from current equipped slot
 		ULyraInventoryItemInstance* RemovedItem = Slots[ActiveSlotIndex];
 		UnequipItemInSlot();
+		ReleaseSlotEquipment(ActiveSlotIndex);
 		Slots[ActiveSlotIndex] = ItemToAdd;
 		SetActiveSlotIndex(ActiveSlotIndex); 
 		EquipItemInSlot();
@@ -71,9 +87,9 @@ ULyraInventoryItemInstance* ULyraQuickBarComponent::AddItemFromInventory(ULyraIn
 
 void ULyraQuickBarComponent::HolsterWeapon()
 {
-	if (ULyraEquipmentManagerComponent* EquipmentManager = FindEquipmentManager())
+	if (FindEquipmentManager())
 	{
-		EquipmentManager->UnequipItem(EquippedItem);
+		UnequipItemInSlot();
 		ActiveSlotIndex = -1;
 		OnRep_ActiveSlotIndex();
 	}
@@ -133,10 +149,24 @@ void ULyraQuickBarComponent::EquipItemInSlot()
 			{
 				if (ULyraEquipmentManagerComponent* EquipmentManager = FindEquipmentManager())
 				{
-					EquippedItem = EquipmentManager->EquipItem(EquipDef);
-					if (EquippedItem != nullptr)
+					if (LyraQuickBar::bPreSpawnSlotEquipment)
+					{
+						// Bringing out pre-spawned equipment is a visibility and ability toggle.
+						EquippedItem = FindOrSpawnSlotEquipment(ActiveSlotIndex, EquipmentManager);
+						if (EquippedItem != nullptr)
+						{
+							EquipmentManager->SetItemStowed(EquippedItem, false);
+						}
+
+						SchedulePreSpawnSlotEquipment();
+					}
+					else
 					{
-						EquippedItem->SetInstigator(SlotItem);
+						EquippedItem = EquipmentManager->EquipItem(EquipDef);
+						if (EquippedItem != nullptr)
+						{
+							EquippedItem->SetInstigator(SlotItem);
+						}
 					}
 				}
 			}
@@ -150,12 +180,119 @@ void ULyraQuickBarComponent::UnequipItemInSlot()
 	{
 		if (EquippedItem != nullptr)
 		{
-			EquipmentManager->UnequipItem(EquippedItem);
+			if (SlotEquipment.Contains(EquippedItem))
+			{
+				EquipmentManager->SetItemStowed(EquippedItem, true);
+			}
+			else
+			{
+				EquipmentManager->UnequipItem(EquippedItem);
+			}
 			EquippedItem = nullptr;
 		}
 	}
 }
 
+ULyraEquipmentInstance* ULyraQuickBarComponent::FindOrSpawnSlotEquipment(int32 SlotIndex, ULyraEquipmentManagerComponent* EquipmentManager)
+{
+	check(EquipmentManager);
+
+	ULyraInventoryItemInstance* SlotItem = Slots.IsValidIndex(SlotIndex) ? Slots[SlotIndex].Get() : nullptr;
+	if (SlotItem == nullptr)
+	{
+		return nullptr;
+	}
+
+	SlotEquipment.SetNum(Slots.Num());
+
+	ULyraEquipmentInstance* Equipment = SlotEquipment[SlotIndex];
+	if (Equipment != nullptr)
+	{
+		// Equipment spawned on a previous pawn went away with it.
+		if (Equipment->GetPawn() == EquipmentManager->GetOwner())
+		{
+			if (Equipment->GetInstigator() == SlotItem)
+			{
+				return Equipment;
+			}
+
+			// The slot's item was replaced, its equipment is no longer needed.
+			EquipmentManager->UnequipItem(Equipment);
+		}
+
+		SlotEquipment[SlotIndex] = nullptr;
+	}
+
+	if (const UInventoryFragment_EquippableItem* EquipInfo = SlotItem->FindFragmentByClass<UInventoryFragment_EquippableItem>())
+	{
+		if (EquipInfo->EquipmentDefinition != nullptr)
+		{
+			Equipment = EquipmentManager->EquipItemStowed(EquipInfo->EquipmentDefinition);
+			if (Equipment != nullptr)
+			{
+				Equipment->SetInstigator(SlotItem);
+				SlotEquipment[SlotIndex] = Equipment;
+			}
+			return Equipment;
+		}
+	}
+
+	return nullptr;
+}
+
+void ULyraQuickBarComponent::SchedulePreSpawnSlotEquipment()
+{
+	// Spawn the other slots after the swap rather than during it.
+	if (UWorld* World = GetWorld())
+	{
+		if (!PreSpawnTimerHandle.IsValid())
+		{
+			PreSpawnTimerHandle = World->GetTimerManager().SetTimerForNextTick(this, &ThisClass::PreSpawnSlotEquipment);
+		}
+	}
+}
+
+void ULyraQuickBarComponent::PreSpawnSlotEquipment()
+{
+	PreSpawnTimerHandle.Invalidate();
+
+	if (!LyraQuickBar::bPreSpawnSlotEquipment || !GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	if (ULyraEquipmentManagerComponent* EquipmentManager = FindEquipmentManager())
+	{
+		for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+		{
+			FindOrSpawnSlotEquipment(SlotIndex, EquipmentManager);
+		}
+	}
+}
+
+void ULyraQuickBarComponent::ReleaseSlotEquipment(int32 SlotIndex)
+{
+	if (!SlotEquipment.IsValidIndex(SlotIndex) || (SlotEquipment[SlotIndex] == nullptr))
+	{
+		return;
+	}
+
+	ULyraEquipmentInstance* Equipment = SlotEquipment[SlotIndex];
+	SlotEquipment[SlotIndex] = nullptr;
+
+	if (ULyraEquipmentManagerComponent* EquipmentManager = FindEquipmentManager())
+	{
+		if (Equipment->GetPawn() == EquipmentManager->GetOwner())
+		{
+			if (Equipment == EquippedItem)
+			{
+				EquippedItem = nullptr;
+			}
+			EquipmentManager->UnequipItem(Equipment);
+		}
+	}
+}
+
 ULyraEquipmentManagerComponent* ULyraQuickBarComponent::FindEquipmentManager() const
 {
 	if (AController* OwnerController = Cast<AController>(GetOwner()))
@@ -210,6 +347,11 @@ void ULyraQuickBarComponent::AddItemToSlot(int32 SlotIndex, ULyraInventoryItemIn
 		{
 			Slots[SlotIndex] = Item;
 			OnRep_Slots();
+
+			if (LyraQuickBar::bPreSpawnSlotEquipment)
+			{
+				SchedulePreSpawnSlotEquipment();
+			}
 		}
 	}
 }
@@ -230,6 +372,7 @@ ULyraInventoryItemInstance* ULyraQuickBarComponent::RemoveItemFromSlot(int32 Slo
 
 		if (Result != nullptr)
 		{
+			ReleaseSlotEquipment(SlotIndex);
 			Slots[SlotIndex] = nullptr;
 			OnRep_Slots();
 		}
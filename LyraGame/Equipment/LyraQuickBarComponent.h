@@ -68,6 +68,17 @@ private:
 
 	ULyraEquipmentManagerComponent* FindEquipmentManager() const;
 
+	/** Returns the stowed equipment spawned for the slot's current item on the current pawn, spawning it if needed */
+	ULyraEquipmentInstance* FindOrSpawnSlotEquipment(int32 SlotIndex, ULyraEquipmentManagerComponent* EquipmentManager);
+
+	/** Spawns the stowed equipment of every slot that does not have it yet */
+	void PreSpawnSlotEquipment();
+
+	/** Destroys the equipment spawned for a slot, when its item goes away */
+	void ReleaseSlotEquipment(int32 SlotIndex);
+
+	void SchedulePreSpawnSlotEquipment();
+
 protected:
 	UPROPERTY()
 	int32 NumSlots = 3;
@@ -87,6 +98,12 @@ private:
 
 	UPROPERTY()
 	TObjectPtr<ULyraEquipmentInstance> EquippedItem;
+
+	/** Authority only: equipment spawned ahead of time for each slot, stowed unless it is the active slot */
+	UPROPERTY()
+	TArray<TObjectPtr<ULyraEquipmentInstance>> SlotEquipment;
+
+	FTimerHandle PreSpawnTimerHandle;
 };
 
 
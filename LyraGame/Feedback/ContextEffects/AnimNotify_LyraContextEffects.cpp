@@ -6,13 +6,24 @@
 #include "LyraContextEffectsInterface.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
 #include "LyraContextEffectsSubsystem.h"
+#include "LyraSurfaceProbeSubsystem.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Kismet/GameplayStatics.h"
 #include "NiagaraSystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AnimNotify_LyraContextEffects)
 
+namespace LyraContextEffectsNotify
+{
+	static bool bAsyncSurfaceProbes = true;
+	static FAutoConsoleVariableRef CVarAsyncSurfaceProbes(
+		TEXT("Lyra.ContextEffects.AsyncSurfaceProbes"),
+		bAsyncSurfaceProbes,
+		TEXT("If true, context effect notifies in game worlds trace for the surface asynchronously and play their effects when the trace completes, a frame later."),
+		ECVF_Default);
+}
 
 
 UAnimNotify_LyraContextEffects::UAnimNotify_LyraContextEffects()
@@ -55,148 +66,157 @@ void UAnimNotify_LyraContextEffects::Notify(USkeletalMeshComponent* MeshComp, UA
 			// Prepare Trace Data
 			bool bHitSuccess = false;
 			FHitResult HitResult;
-			FCollisionQueryParams QueryParams;
 
-			if (TraceProperties.bIgnoreActor)
+			if (bPerformTrace)
 			{
-				QueryParams.AddIgnoredActor(OwningActor);
-			}
+				FCollisionQueryParams QueryParams;
 
-			QueryParams.bReturnPhysicalMaterial = true;
+				if (TraceProperties.bIgnoreActor)
+				{
+					QueryParams.AddIgnoredActor(OwningActor);
+				}
+
+				QueryParams.bReturnPhysicalMaterial = true;
 
-			if (bPerformTrace)
-			{
 				// If trace is needed, set up Start Location to Attached
-				FVector TraceStart = bAttached ? MeshComp->GetSocketLocation(SocketName) : MeshComp->GetComponentLocation();
+				const FVector TraceStart = bAttached ? MeshComp->GetSocketLocation(SocketName) : MeshComp->GetComponentLocation();
+				const FVector TraceEnd = TraceStart + TraceProperties.EndTraceLocationOffset;
 
 				// Make sure World is valid
 				if (UWorld* World = OwningActor->GetWorld())
 				{
+					// In game worlds the trace is batched with the other notifies of the frame, the effects play once it completes
+					ULyraSurfaceProbeSubsystem* SurfaceProbeSubsystem = (LyraContextEffectsNotify::bAsyncSurfaceProbes && World->IsGameWorld()) ? World->GetSubsystem<ULyraSurfaceProbeSubsystem>() : nullptr;
+					if (SurfaceProbeSubsystem)
+					{
+						SurfaceProbeSubsystem->RequestSurfaceProbe(TraceStart, TraceEnd, TraceProperties.TraceChannel, QueryParams,
+							FLyraSurfaceProbeComplete::CreateWeakLambda(this, [this, WeakMeshComp = TWeakObjectPtr<USkeletalMeshComponent>(MeshComp), WeakAnimation = TWeakObjectPtr<UAnimSequenceBase>(Animation)]
+								(bool bProbeHitSuccess, const FHitResult& ProbeHitResult)
+							{
+								if (USkeletalMeshComponent* ProbedMeshComp = WeakMeshComp.Get())
+								{
+									PlayContextEffects(ProbedMeshComp, WeakAnimation.Get(), bProbeHitSuccess, ProbeHitResult);
+								}
+							}));
+
+						return;
+					}
+
 					// Call Line Trace, Pass in relevant properties
-					bHitSuccess = World->LineTraceSingleByChannel(HitResult, TraceStart, (TraceStart + TraceProperties.EndTraceLocationOffset),
+					bHitSuccess = World->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd,
 						TraceProperties.TraceChannel, QueryParams, FCollisionResponseParams::DefaultResponseParam);
 				}
 			}
 
-			// Prepare Contexts in advance
-			FGameplayTagContainer Contexts;
+			PlayContextEffects(MeshComp, Animation, bHitSuccess, HitResult);
+		}
+	}
+}
+
+void UAnimNotify_LyraContextEffects::PlayContextEffects(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, bool bHitSuccess, const FHitResult& HitResult)
+{
+	AActor* OwningActor = MeshComp->GetOwner();
+	if (!OwningActor)
+	{
+		return;
+	}
 
-			// Set up Array of Objects that implement the Context Effects Interface
-			TArray<UObject*> LyraContextEffectImplementingObjects;
+	UWorld* World = OwningActor->GetWorld();
 
-			// Determine if the Owning Actor is one of the Objects that implements the Context Effects Interface
-			if (OwningActor->Implements<ULyraContextEffectsInterface>())
-			{
-				// If so, add it to the Array
-				LyraContextEffectImplementingObjects.Add(OwningActor);
-			}
+	// Prepare Contexts in advance
+	FGameplayTagContainer Contexts;
 
-			// Cycle through Owning Actor's Components and determine if any of them is a Component implementing the Context Effect Interface
-			for (const auto Component : OwningActor->GetComponents())
+	// Get the Objects that implement the Context Effects Interface, cached per actor by the subsystem when there is one
+	ULyraContextEffectsSubsystem::FContextEffectImplementers LyraContextEffectImplementingObjects;
+	if (ULyraContextEffectsSubsystem* LyraContextEffectsSubsystem = World ? World->GetSubsystem<ULyraContextEffectsSubsystem>() : nullptr)
+	{
+		LyraContextEffectsSubsystem->GetContextEffectImplementers(OwningActor, LyraContextEffectImplementingObjects);
+	}
+	else
+	{
+		ULyraContextEffectsSubsystem::FindContextEffectImplementers(OwningActor, LyraContextEffectImplementingObjects);
+	}
+
+	// Cycle through all objects implementing the Context Effect Interface
+	for (UObject* LyraContextEffectImplementingObject : LyraContextEffectImplementingObjects)
+	{
+		if (LyraContextEffectImplementingObject)
+		{
+			// If the object is still valid, Execute the AnimMotionEffect Event on it, passing in relevant data
+			ILyraContextEffectsInterface::Execute_AnimMotionEffect(LyraContextEffectImplementingObject,
+				(bAttached ? SocketName : FName("None")),
+				Effect, MeshComp, LocationOffset, RotationOffset,
+				Animation, bHitSuccess, HitResult, Contexts, VFXProperties.Scale,
+				AudioProperties.VolumeMultiplier, AudioProperties.PitchMultiplier);
+		}
+	}
+
+#if WITH_EDITORONLY_DATA
+	// This is for Anim Editor previewing, it is a deconstruction of the calls made by the Interface and the Subsystem
+	if (bPreviewInEditor)
+	{
+		// Get the world, make sure it's an Editor Preview World
+		if (World && World->WorldType == EWorldType::EditorPreview)
+		{
+			// Add Preview contexts if necessary
+			Contexts.AppendTags(PreviewProperties.PreviewContexts);
+
+			// Convert given Surface Type to Context and Add it to the Contexts for this Preview
+			if (PreviewProperties.bPreviewPhysicalSurfaceAsContext)
 			{
-				if (Component)
+				TEnumAsByte<EPhysicalSurface> PhysicalSurfaceType = PreviewProperties.PreviewPhysicalSurface;
+
+				if (const ULyraContextEffectsSettings* LyraContextEffectsSettings = GetDefault<ULyraContextEffectsSettings>())
 				{
-					// If the Component implements the Context Effects Interface, add it to the list
-					if (Component->Implements<ULyraContextEffectsInterface>())
+					if (const FGameplayTag* SurfaceContextPtr = LyraContextEffectsSettings->SurfaceTypeToContextMap.Find(PhysicalSurfaceType))
 					{
-						LyraContextEffectImplementingObjects.Add(Component);
+						FGameplayTag SurfaceContext = *SurfaceContextPtr;
+
+						Contexts.AddTag(SurfaceContext);
 					}
 				}
 			}
 
-			// Cycle through all objects implementing the Context Effect Interface
-			for (UObject* LyraContextEffectImplementingObject : LyraContextEffectImplementingObjects)
+			// Libraries are soft referenced, so you will want to try to load them now
+			// TODO Async Asset Loading
+			if (UObject* EffectsLibrariesObj = PreviewProperties.PreviewContextEffectsLibrary.TryLoad())
 			{
-				if (LyraContextEffectImplementingObject)
+				// Check if it is in fact a ULyraContextEffectLibrary type
+				if (ULyraContextEffectsLibrary* EffectLibrary = Cast<ULyraContextEffectsLibrary>(EffectsLibrariesObj))
 				{
-					// If the object is still valid, Execute the AnimMotionEffect Event on it, passing in relevant data
-					ILyraContextEffectsInterface::Execute_AnimMotionEffect(LyraContextEffectImplementingObject,
-						(bAttached ? SocketName : FName("None")),
-						Effect, MeshComp, LocationOffset, RotationOffset,
-						Animation, bHitSuccess, HitResult, Contexts, VFXProperties.Scale,
-						AudioProperties.VolumeMultiplier, AudioProperties.PitchMultiplier);
-				}
-			}
+					// Prepare Sounds and Niagara System Arrays
+					TArray<USoundBase*> TotalSounds;
+					TArray<UNiagaraSystem*> TotalNiagaraSystems;
 
-#if WITH_EDITORONLY_DATA
-			// This is for Anim Editor previewing, it is a deconstruction of the calls made by the Interface and the Subsystem
-			if (bPreviewInEditor)
-			{
-				UWorld* World = OwningActor->GetWorld();
-
-				// Get the world, make sure it's an Editor Preview World
-				if (World && World->WorldType == EWorldType::EditorPreview)
-				{
-					// Add Preview contexts if necessary
-					Contexts.AppendTags(PreviewProperties.PreviewContexts);
+					// Attempt to load the Effect Library content (will cache in Transient data on the Effect Library Asset)
+					EffectLibrary->LoadEffects();
 
-					// Convert given Surface Type to Context and Add it to the Contexts for this Preview
-					if (PreviewProperties.bPreviewPhysicalSurfaceAsContext)
+					// If the Effect Library is valid and marked as Loaded, Get Effects from it
+					if (EffectLibrary && EffectLibrary->GetContextEffectsLibraryLoadState() == EContextEffectsLibraryLoadState::Loaded)
 					{
-						TEnumAsByte<EPhysicalSurface> PhysicalSurfaceType = PreviewProperties.PreviewPhysicalSurface;
-
-						if (const ULyraContextEffectsSettings* LyraContextEffectsSettings = GetDefault<ULyraContextEffectsSettings>())
-						{
-							if (const FGameplayTag* SurfaceContextPtr = LyraContextEffectsSettings->SurfaceTypeToContextMap.Find(PhysicalSurfaceType))
-							{
-								FGameplayTag SurfaceContext = *SurfaceContextPtr;
-
-								Contexts.AddTag(SurfaceContext);
-							}
-						}
+						// Get the Effects, appended to the accumulating arrays
+						EffectLibrary->GetEffects(Effect, Contexts, TotalSounds, TotalNiagaraSystems);
 					}
 
-					// Libraries are soft referenced, so you will want to try to load them now
-					// TODO Async Asset Loading
-					if (UObject* EffectsLibrariesObj = PreviewProperties.PreviewContextEffectsLibrary.TryLoad())
+					// Cycle through Sounds and call Spawn Sound Attached, passing in relevant data
+					for (USoundBase* Sound : TotalSounds)
 					{
-						// Check if it is in fact a ULyraContextEffectLibrary type
-						if (ULyraContextEffectsLibrary* EffectLibrary = Cast<ULyraContextEffectsLibrary>(EffectsLibrariesObj))
-						{
-							// Prepare Sounds and Niagara System Arrays
-							TArray<USoundBase*> TotalSounds;
-							TArray<UNiagaraSystem*> TotalNiagaraSystems;
-
-							// Attempt to load the Effect Library content (will cache in Transient data on the Effect Library Asset)
-							EffectLibrary->LoadEffects();
-
-							// If the Effect Library is valid and marked as Loaded, Get Effects from it
-							if (EffectLibrary && EffectLibrary->GetContextEffectsLibraryLoadState() == EContextEffectsLibraryLoadState::Loaded)
-							{
-								// Prepare local arrays
-								TArray<USoundBase*> Sounds;
-								TArray<UNiagaraSystem*> NiagaraSystems;
-
-								// Get the Effects
-								EffectLibrary->GetEffects(Effect, Contexts, Sounds, NiagaraSystems);
-
-								// Append to the accumulating arrays
-								TotalSounds.Append(Sounds);
-								TotalNiagaraSystems.Append(NiagaraSystems);
-							}
-
-							// Cycle through Sounds and call Spawn Sound Attached, passing in relevant data
-							for (USoundBase* Sound : TotalSounds)
-							{
-								UGameplayStatics::SpawnSoundAttached(Sound, MeshComp, (bAttached ? SocketName : FName("None")), LocationOffset, RotationOffset, EAttachLocation::KeepRelativeOffset,
-									false, AudioProperties.VolumeMultiplier, AudioProperties.PitchMultiplier, 0.0f, nullptr, nullptr, true);
-							}
+						UGameplayStatics::SpawnSoundAttached(Sound, MeshComp, (bAttached ? SocketName : FName("None")), LocationOffset, RotationOffset, EAttachLocation::KeepRelativeOffset,
+							false, AudioProperties.VolumeMultiplier, AudioProperties.PitchMultiplier, 0.0f, nullptr, nullptr, true);
+					}
 
-							// Cycle through Niagara Systems and call Spawn System Attached, passing in relevant data
-							for (UNiagaraSystem* NiagaraSystem : TotalNiagaraSystems)
-							{
-								UNiagaraFunctionLibrary::SpawnSystemAttached(NiagaraSystem, MeshComp, (bAttached ? SocketName : FName("None")), LocationOffset,
-									RotationOffset, VFXProperties.Scale, EAttachLocation::KeepRelativeOffset, true, ENCPoolMethod::None, true, true);
-							}
-						}
+					// Cycle through Niagara Systems and call Spawn System Attached, passing in relevant data
+					for (UNiagaraSystem* NiagaraSystem : TotalNiagaraSystems)
+					{
+						UNiagaraFunctionLibrary::SpawnSystemAttached(NiagaraSystem, MeshComp, (bAttached ? SocketName : FName("None")), LocationOffset,
+							RotationOffset, VFXProperties.Scale, EAttachLocation::KeepRelativeOffset, true, ENCPoolMethod::None, true, true);
 					}
-						
 				}
 			}
-#endif
-
+				
 		}
 	}
+#endif
 }
 
 #if WITH_EDITOR
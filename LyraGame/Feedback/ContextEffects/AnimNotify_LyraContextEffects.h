@@ -165,5 +165,7 @@ public:
 	FLyraContextEffectAnimNotifyPreviewSettings PreviewProperties;
 #endif
 
-
+private:
+	// Runs the context effects of the notify once the surface trace (if any) is done
+	void PlayContextEffects(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, bool bHitSuccess, const FHitResult& HitResult);
 };
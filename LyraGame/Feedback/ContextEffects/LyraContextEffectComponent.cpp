@@ -3,8 +3,10 @@
 
 #include "LyraContextEffectComponent.h"
 
+#include "Components/AudioComponent.h"
 #include "Engine/World.h"
 #include "LyraContextEffectsSubsystem.h"
+#include "NiagaraComponent.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraContextEffectComponent)
@@ -63,10 +65,6 @@ void ULyraContextEffectComponent::AnimMotionEffect_Implementation(const FName Bo
 	const bool bHitSuccess, const FHitResult HitResult, FGameplayTagContainer Contexts,
 	FVector VFXScale, float AudioVolume, float AudioPitch)
 {
-	// Prep Components
-	TArray<UAudioComponent*> AudioComponentsToAdd;
-	TArray<UNiagaraComponent*> NiagaraComponentsToAdd;
-
 	FGameplayTagContainer TotalContexts;
 
 	// Aggregate contexts
@@ -99,23 +97,9 @@ void ULyraContextEffectComponent::AnimMotionEffect_Implementation(const FName Bo
 		}
 	}
 
-	// Cycle through Active Audio Components and cache
-	for (UAudioComponent* ActiveAudioComponent : ActiveAudioComponents)
-	{
-		if (ActiveAudioComponent)
-		{
-			AudioComponentsToAdd.Add(ActiveAudioComponent);
-		}
-	}
-
-	// Cycle through Active Niagara Components and cache
-	for (UNiagaraComponent* ActiveNiagaraComponent : ActiveNiagaraComponents)
-	{
-		if (ActiveNiagaraComponent)
-		{
-			NiagaraComponentsToAdd.Add(ActiveNiagaraComponent);
-		}
-	}
+	// Forget the effects that finished playing
+	ActiveAudioComponents.RemoveAllSwap([](const TWeakObjectPtr<UAudioComponent>& AudioComponent) { return !AudioComponent.IsValid() || !AudioComponent->IsPlaying(); });
+	ActiveNiagaraComponents.RemoveAllSwap([](const TWeakObjectPtr<UNiagaraComponent>& NiagaraComponent) { return !NiagaraComponent.IsValid() || !NiagaraComponent->IsActive(); });
 
 	// Get World
 	if (const UWorld* World = GetWorld())
@@ -132,20 +116,11 @@ void ULyraContextEffectComponent::AnimMotionEffect_Implementation(const FName Bo
 				LocationOffset, RotationOffset, MotionEffect, TotalContexts,
 				AudioComponents, NiagaraComponents, VFXScale, AudioVolume, AudioPitch);
 
-			// Append resultant effects
-			AudioComponentsToAdd.Append(AudioComponents);
-			NiagaraComponentsToAdd.Append(NiagaraComponents);
+			// Keep the resultant effects, pooled ones are not returned and go back to the pool when they finish
+			ActiveAudioComponents.Append(AudioComponents);
+			ActiveNiagaraComponents.Append(NiagaraComponents);
 		}
 	}
-
-	// Append Active Audio Components
-	ActiveAudioComponents.Empty();
-	ActiveAudioComponents.Append(AudioComponentsToAdd);
-
-	// Append Active
-	ActiveNiagaraComponents.Empty();
-	ActiveNiagaraComponents.Append(NiagaraComponentsToAdd);
-
 }
 
 void ULyraContextEffectComponent::UpdateEffectContexts(FGameplayTagContainer NewEffectContexts)
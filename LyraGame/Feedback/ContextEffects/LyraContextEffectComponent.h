@@ -67,9 +67,8 @@ private:
 	UPROPERTY(Transient)
 	TSet<TSoftObjectPtr<ULyraContextEffectsLibrary>> CurrentContextEffectsLibraries;
 
-	UPROPERTY(Transient)
-	TArray<TObjectPtr<UAudioComponent>> ActiveAudioComponents;
-
-	UPROPERTY(Transient)
-	TArray<TObjectPtr<UNiagaraComponent>> ActiveNiagaraComponents;
+	// Effects spawned by this component that are still playing. Pooled components are not kept, they are reused by
+	// other effects once they finish.
+	TArray<TWeakObjectPtr<UAudioComponent>> ActiveAudioComponents;
+	TArray<TWeakObjectPtr<UNiagaraComponent>> ActiveNiagaraComponents;
 };
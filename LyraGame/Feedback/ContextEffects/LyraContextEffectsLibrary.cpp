@@ -8,25 +8,105 @@
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraContextEffectsLibrary)
 
 
-void ULyraContextEffectsLibrary::GetEffects(const FGameplayTag Effect, const FGameplayTagContainer Context, 
+namespace LyraContextEffectsLibrary
+{
+	// Distinct contexts cached per effect tag, the least recently used one is evicted beyond that
+	static constexpr int32 MaxCachedContextsPerEffect = 64;
+}
+
+void ULyraContextEffectsLibrary::GetEffects(const FGameplayTag& Effect, const FGameplayTagContainer& Context,
 	TArray<USoundBase*>& Sounds, TArray<UNiagaraSystem*>& NiagaraSystems)
 {
 	// Make sure Effect is valid and Library is loaded
 	if (Effect.IsValid() && Context.IsValid() && EffectsLoadState == EContextEffectsLibraryLoadState::Loaded)
 	{
-		// Loop through Context Effects
-		for (const auto& ActiveContextEffect : ActiveContextEffects)
+		// Get all Matching Sounds and Niagara Systems
+		if (const FCachedEffects* CachedEffects = FindEffects(Effect, Context))
 		{
-			// Make sure the Effect is an exact Tag Match and ensure the Context has all tags in the Effect (and neither or both are empty)
-			if (Effect.MatchesTagExact(ActiveContextEffect->EffectTag)
-				&& Context.HasAllExact(ActiveContextEffect->Context)
-				&& (ActiveContextEffect->Context.IsEmpty() == Context.IsEmpty()))
+			Sounds.Append(CachedEffects->Sounds);
+			NiagaraSystems.Append(CachedEffects->NiagaraSystems);
+		}
+	}
+}
+
+const ULyraContextEffectsLibrary::FCachedEffects* ULyraContextEffectsLibrary::FindEffects(const FGameplayTag& Effect, const FGameplayTagContainer& Context)
+{
+	// The index only holds Effect Tags with at least one entry, and they have to be an exact Tag Match
+	FEffectIndexEntry* IndexEntry = EffectIndex.Find(Effect);
+	if (!IndexEntry)
+	{
+		return nullptr;
+	}
+
+	const uint32 ContextHash = HashContext(Context);
+	const uint32 QueryIndex = ++IndexEntry->NumQueries;
+
+	if (FCachedEffects* CachedEffects = IndexEntry->CachedResults.Find(ContextHash))
+	{
+		if (CachedEffects->Context == Context)
+		{
+			CachedEffects->LastUsed = QueryIndex;
+			return CachedEffects;
+		}
+	}
+	else if (IndexEntry->CachedResults.Num() >= LyraContextEffectsLibrary::MaxCachedContextsPerEffect)
+	{
+		uint32 LeastRecentlyUsedHash = 0;
+		uint32 LeastRecentlyUsed = MAX_uint32;
+		for (const TPair<uint32, FCachedEffects>& CachedResult : IndexEntry->CachedResults)
+		{
+			if (CachedResult.Value.LastUsed < LeastRecentlyUsed)
 			{
-				// Get all Matching Sounds and Niagara Systems
-				Sounds.Append(ActiveContextEffect->Sounds);
-				NiagaraSystems.Append(ActiveContextEffect->NiagaraSystems);
+				LeastRecentlyUsed = CachedResult.Value.LastUsed;
+				LeastRecentlyUsedHash = CachedResult.Key;
 			}
 		}
+
+		IndexEntry->CachedResults.Remove(LeastRecentlyUsedHash);
+	}
+
+	FCachedEffects& NewCachedEffects = IndexEntry->CachedResults.Add(ContextHash);
+	NewCachedEffects.Context = Context;
+	NewCachedEffects.LastUsed = QueryIndex;
+
+	for (const int32 ActiveContextEffectIndex : IndexEntry->ActiveContextEffectIndices)
+	{
+		const ULyraActiveContextEffects* ActiveContextEffect = ActiveContextEffects[ActiveContextEffectIndex];
+
+		// Ensure the Context has all tags in the Effect (and neither or both are empty)
+		if (Context.HasAllExact(ActiveContextEffect->Context)
+			&& (ActiveContextEffect->Context.IsEmpty() == Context.IsEmpty()))
+		{
+			NewCachedEffects.Sounds.Append(ActiveContextEffect->Sounds);
+			NewCachedEffects.NiagaraSystems.Append(ActiveContextEffect->NiagaraSystems);
+		}
+	}
+
+	return &NewCachedEffects;
+}
+
+uint32 ULyraContextEffectsLibrary::HashContext(const FGameplayTagContainer& Context)
+{
+	// Summing scrambled tag hashes keeps the hash independent of the tag order, like container equality
+	uint32 Hash = Context.Num();
+	for (const FGameplayTag& Tag : Context)
+	{
+		Hash += MurmurFinalize32(GetTypeHash(Tag));
+	}
+
+	return Hash;
+}
+
+void ULyraContextEffectsLibrary::BuildEffectsIndex()
+{
+	EffectIndex.Reset();
+
+	for (int32 ActiveContextEffectIndex = 0; ActiveContextEffectIndex < ActiveContextEffects.Num(); ++ActiveContextEffectIndex)
+	{
+		if (const ULyraActiveContextEffects* ActiveContextEffect = ActiveContextEffects[ActiveContextEffectIndex])
+		{
+			EffectIndex.FindOrAdd(ActiveContextEffect->EffectTag).ActiveContextEffectIndices.Add(ActiveContextEffectIndex);
+		}
 	}
 }
 
@@ -40,6 +120,7 @@ void ULyraContextEffectsLibrary::LoadEffects()
 
 		// Clear out any old Active Effects
 		ActiveContextEffects.Empty();
+		EffectIndex.Reset();
 
 		// Call internal loading function
 		LoadEffectsInternal();
@@ -115,5 +196,8 @@ void ULyraContextEffectsLibrary::LyraContextEffectLibraryLoadingComplete(
 
 	// Append incoming Context Effects Array to current list of Active Context Effects
 	ActiveContextEffects.Append(LyraActiveContextEffects);
+
+	// Index them by Effect Tag for GetEffects
+	BuildEffectsIndex();
 }
 
@@ -78,8 +78,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	TArray<FLyraContextEffects> ContextEffects;
 
+	// Appends the sounds and Niagara systems of every entry for Effect whose context is contained in Context.
+	// Results are cached per (Effect, Context) pair, so repeated queries do not scan the entries again.
 	UFUNCTION(BlueprintCallable)
-	void GetEffects(const FGameplayTag Effect, const FGameplayTagContainer Context, TArray<USoundBase*>& Sounds, TArray<UNiagaraSystem*>& NiagaraSystems);
+	void GetEffects(const FGameplayTag& Effect, const FGameplayTagContainer& Context, TArray<USoundBase*>& Sounds, TArray<UNiagaraSystem*>& NiagaraSystems);
 
 	UFUNCTION(BlueprintCallable)
 	void LoadEffects();
@@ -87,13 +89,46 @@ public:
 	EContextEffectsLibraryLoadState GetContextEffectsLibraryLoadState();
 
 private:
+	// Sounds and Niagara systems matched for one query context
+	struct FCachedEffects
+	{
+		FGameplayTagContainer Context;
+		uint32 LastUsed = 0;
+		TArray<USoundBase*> Sounds;
+		TArray<UNiagaraSystem*> NiagaraSystems;
+	};
+
+	// Entries of one effect tag, and the results of the contexts queried with it so far
+	struct FEffectIndexEntry
+	{
+		TArray<int32> ActiveContextEffectIndices;
+
+		// Keyed by HashContext, a colliding context replaces the entry
+		TMap<uint32, FCachedEffects> CachedResults;
+
+		// Incremented by every query, to find the least recently used result
+		uint32 NumQueries = 0;
+	};
+
 	void LoadEffectsInternal();
 
 	void LyraContextEffectLibraryLoadingComplete(TArray<ULyraActiveContextEffects*> LyraActiveContextEffects);
 
+	// Rebuilds EffectIndex from ActiveContextEffects, dropping every cached result
+	void BuildEffectsIndex();
+
+	// Returns the cached result for the query, matching the entries on the first query. Only valid until the next call.
+	const FCachedEffects* FindEffects(const FGameplayTag& Effect, const FGameplayTagContainer& Context);
+
+	// Hash of a context that does not depend on the order of its tags
+	static uint32 HashContext(const FGameplayTagContainer& Context);
+
 	UPROPERTY(Transient)
 	TArray< TObjectPtr<ULyraActiveContextEffects>> ActiveContextEffects;
 
 	UPROPERTY(Transient)
 	EContextEffectsLibraryLoadState EffectsLoadState = EContextEffectsLibraryLoadState::Unloaded;
+
+	// Lookup index by effect tag, the assets are kept alive by ActiveContextEffects
+	TMap<FGameplayTag, FEffectIndexEntry> EffectIndex;
 };
@@ -3,11 +3,19 @@
 
 #include "LyraContextEffectsSubsystem.h"
 
+#include "Components/AudioComponent.h"
+#include "Engine/World.h"
 #include "Feedback/ContextEffects/LyraContextEffectsLibrary.h"
+#include "Feedback/ContextEffects/LyraContextEffectsInterface.h"
 #include "Feedback/ContextEffects/LyraContextEffectsSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
 #include "Kismet/GameplayStatics.h"
+#include "NiagaraComponent.h"
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraSystem.h"
+#include "Sound/SoundBase.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraContextEffectsSubsystem)
 
@@ -17,6 +25,63 @@ class UNiagaraSystem;
 class USceneComponent;
 class USoundBase;
 
+namespace LyraContextEffects
+{
+	static bool bPoolComponents = true;
+	static FAutoConsoleVariableRef CVarPoolComponents(
+		TEXT("Lyra.ContextEffects.PoolComponents"),
+		bPoolComponents,
+		TEXT("If true, context effect audio and Niagara components are reused in game worlds instead of being spawned for every effect."),
+		ECVF_Default);
+
+	static int32 MaxPooledAudioComponents = 64;
+	static FAutoConsoleVariableRef CVarMaxPooledAudioComponents(
+		TEXT("Lyra.ContextEffects.MaxPooledAudioComponents"),
+		MaxPooledAudioComponents,
+		TEXT("Maximum number of idle audio components each world keeps for context effects, extra ones are destroyed when they finish."),
+		ECVF_Default);
+
+	static int32 MaxInstancesPerAsset = 8;
+	static FAutoConsoleVariableRef CVarMaxInstancesPerAsset(
+		TEXT("Lyra.ContextEffects.MaxInstancesPerAsset"),
+		MaxInstancesPerAsset,
+		TEXT("Maximum number of instances of one context effect sound or Niagara system playing at once, further ones are not spawned. 0 means no limit."),
+		ECVF_Default);
+
+	static float CullDistance = 5000.0f;
+	static FAutoConsoleVariableRef CVarCullDistance(
+		TEXT("Lyra.ContextEffects.CullDistance"),
+		CullDistance,
+		TEXT("Context effects further than this (cm) from every local view are not spawned. Non-looping sounds are also culled beyond their attenuation distance. 0 disables the distance cull."),
+		ECVF_Default);
+}
+
+void ULyraContextEffectsSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	StatsStartTime = FPlatformTime::Seconds();
+}
+
+void ULyraContextEffectsSubsystem::Deinitialize()
+{
+	for (UAudioComponent* AudioComponent : PooledAudioComponents)
+	{
+		if (IsValid(AudioComponent))
+		{
+			AudioComponent->OnAudioFinishedNative.RemoveAll(this);
+			AudioComponent->DestroyComponent();
+		}
+	}
+
+	PooledAudioComponents.Reset();
+	FreeAudioComponents.Reset();
+	ActiveInstances.Reset();
+	CachedImplementers.Reset();
+
+	Super::Deinitialize();
+}
+
 void ULyraContextEffectsSubsystem::SpawnContextEffects(
 	const AActor* SpawningActor
 	, USceneComponent* AttachToComponent
@@ -24,7 +89,7 @@ void ULyraContextEffectsSubsystem::SpawnContextEffects(
 	, const FVector LocationOffset
 	, const FRotator RotationOffset
 	, FGameplayTag Effect
-	, FGameplayTagContainer Contexts
+	, const FGameplayTagContainer& Contexts
 	, TArray<UAudioComponent*>& AudioOut
 	, TArray<UNiagaraComponent*>& NiagaraOut
 	, FVector VFXScale
@@ -37,9 +102,9 @@ void ULyraContextEffectsSubsystem::SpawnContextEffects(
 		// Validate the pointers from the Map Find
 		if (ULyraContextEffectsSet* EffectsLibraries = *EffectsLibrariesSetPtr)
 		{
-			// Prepare Arrays for Sounds and Niagara Systems
-			TArray<USoundBase*> TotalSounds;
-			TArray<UNiagaraSystem*> TotalNiagaraSystems;
+			// Reset the scratch arrays for Sounds and Niagara Systems
+			ScratchSounds.Reset();
+			ScratchNiagaraSystems.Reset();
 
 			// Cycle through Effect Libraries
 			for (ULyraContextEffectsLibrary* EffectLibrary : EffectsLibraries->LyraContextEffectsLibraries)
@@ -47,16 +112,8 @@ void ULyraContextEffectsSubsystem::SpawnContextEffects(
 				// Check if the Effect Library is valid and data Loaded
 				if (EffectLibrary && EffectLibrary->GetContextEffectsLibraryLoadState() == EContextEffectsLibraryLoadState::Loaded)
 				{
-					// Set up local list of Sounds and Niagara Systems
-					TArray<USoundBase*> Sounds;
-					TArray<UNiagaraSystem*> NiagaraSystems;
-
-					// Get Sounds and Niagara Systems
-					EffectLibrary->GetEffects(Effect, Contexts, Sounds, NiagaraSystems);
-
-					// Append to accumulating array
-					TotalSounds.Append(Sounds);
-					TotalNiagaraSystems.Append(NiagaraSystems);
+					// Get Sounds and Niagara Systems, appended to the accumulating arrays
+					EffectLibrary->GetEffects(Effect, Contexts, ScratchSounds, ScratchNiagaraSystems);
 				}
 				else if (EffectLibrary && EffectLibrary->GetContextEffectsLibraryLoadState() == EContextEffectsLibraryLoadState::Unloaded)
 				{
@@ -65,29 +122,390 @@ void ULyraContextEffectsSubsystem::SpawnContextEffects(
 				}
 			}
 
+			if ((ScratchSounds.Num() == 0) && (ScratchNiagaraSystems.Num() == 0))
+			{
+				return;
+			}
+
+			// Pooling and culling only apply to game worlds, editor previews always spawn
+			const UWorld* World = GetWorld();
+			const bool bIsGameWorld = World && World->IsGameWorld();
+			const bool bPoolComponents = bIsGameWorld && LyraContextEffects::bPoolComponents;
+
+			const FVector EffectLocation = AttachToComponent ? AttachToComponent->GetSocketTransform(AttachPoint).TransformPosition(LocationOffset) : LocationOffset;
+
 			// Cycle through found Sounds
-			for (USoundBase* Sound : TotalSounds)
+			for (USoundBase* Sound : ScratchSounds)
 			{
-				// Spawn Sounds Attached, add Audio Component to List of ACs
-				UAudioComponent* AudioComponent = UGameplayStatics::SpawnSoundAttached(Sound, AttachToComponent, AttachPoint, LocationOffset, RotationOffset, EAttachLocation::KeepRelativeOffset,
-					false, AudioVolume, AudioPitch, 0.0f, nullptr, nullptr, true);
+				if (!Sound)
+				{
+					continue;
+				}
+
+				if (bIsGameWorld)
+				{
+					// Looping sounds may come into range later, so only one-shots use their attenuation distance
+					float MaxDistance = LyraContextEffects::CullDistance;
+					const float SoundMaxDistance = Sound->IsLooping() ? WORLD_MAX : Sound->GetMaxDistance();
+					if (SoundMaxDistance < WORLD_MAX)
+					{
+						MaxDistance = (MaxDistance > 0.0f) ? FMath::Min(MaxDistance, SoundMaxDistance) : SoundMaxDistance;
+					}
+
+					if (IsCulledByDistance(EffectLocation, MaxDistance))
+					{
+						++NumCulledByDistance;
+						continue;
+					}
+
+					if (IsOverConcurrencyLimit(Sound))
+					{
+						++NumCulledByConcurrency;
+						continue;
+					}
+				}
 
-				AudioOut.Add(AudioComponent);
+				// Spawn (or reuse) Sounds Attached, add Audio Component to List of ACs. Looping sounds never finish and have
+				// to stop with what they are attached to, so they get a component of their own.
+				UAudioComponent* AudioComponent = nullptr;
+				const bool bPooledAudio = bPoolComponents && !Sound->IsLooping();
+				if (bPooledAudio)
+				{
+					AudioComponent = AcquireAudioComponent(Sound, AttachToComponent, AttachPoint, LocationOffset, RotationOffset, AudioVolume, AudioPitch);
+				}
+				else
+				{
+					AudioComponent = UGameplayStatics::SpawnSoundAttached(Sound, AttachToComponent, AttachPoint, LocationOffset, RotationOffset, EAttachLocation::KeepRelativeOffset,
+						false, AudioVolume, AudioPitch, 0.0f, nullptr, nullptr, true);
+
+					if (AudioComponent)
+					{
+						++NumAudioSpawned;
+					}
+				}
+
+				if (AudioComponent)
+				{
+					if (bIsGameWorld)
+					{
+						AddActiveInstance(Sound, AudioComponent);
+					}
+
+					// Pooled components are reused for other effects once they finish, callers only get the ones they own
+					if (!bPooledAudio)
+					{
+						AudioOut.Add(AudioComponent);
+					}
+				}
 			}
 
 			// Cycle through found Niagara Systems
-			for (UNiagaraSystem* NiagaraSystem : TotalNiagaraSystems)
+			for (UNiagaraSystem* NiagaraSystem : ScratchNiagaraSystems)
 			{
-				// Spawn Niagara Systems Attached, add Niagara Component to List of NCs
+				if (!NiagaraSystem)
+				{
+					continue;
+				}
+
+				if (bIsGameWorld)
+				{
+					if (IsCulledByDistance(EffectLocation, LyraContextEffects::CullDistance))
+					{
+						++NumCulledByDistance;
+						continue;
+					}
+
+					if (IsOverConcurrencyLimit(NiagaraSystem))
+					{
+						++NumCulledByConcurrency;
+						continue;
+					}
+				}
+
+				// Spawn Niagara Systems Attached, add Niagara Component to List of NCs. Pooled components go back to
+				// the world's Niagara pool on their own once they complete.
+				const ENCPoolMethod PoolMethod = bPoolComponents ? ENCPoolMethod::AutoRelease : ENCPoolMethod::None;
 				UNiagaraComponent* NiagaraComponent = UNiagaraFunctionLibrary::SpawnSystemAttached(NiagaraSystem, AttachToComponent, AttachPoint, LocationOffset,
-					RotationOffset, VFXScale, EAttachLocation::KeepRelativeOffset, true, ENCPoolMethod::None, true, true);
+					RotationOffset, VFXScale, EAttachLocation::KeepRelativeOffset, true, PoolMethod, true, true);
+
+				if (NiagaraComponent)
+				{
+					++NumNiagaraSpawned;
+
+					if (bIsGameWorld)
+					{
+						AddActiveInstance(NiagaraSystem, NiagaraComponent);
+					}
+
+					if (PoolMethod == ENCPoolMethod::None)
+					{
+						NiagaraOut.Add(NiagaraComponent);
+					}
+				}
+			}
+		}
+	}
+}
+
+bool ULyraContextEffectsSubsystem::IsCulledByDistance(const FVector& Location, float MaxDistance)
+{
+	if (MaxDistance <= 0.0f)
+	{
+		return false;
+	}
+
+	if (ViewLocationsFrame != GFrameCounter)
+	{
+		ViewLocationsFrame = GFrameCounter;
+		ViewLocations.Reset();
+
+		for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+		{
+			const APlayerController* PlayerController = Iterator->Get();
+			if (PlayerController && PlayerController->IsLocalController())
+			{
+				FVector ViewLocation;
+				FRotator ViewRotation;
+				PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+				ViewLocations.Add(ViewLocation);
+			}
+		}
+	}
+
+	// Without a local view (e.g. on a server) there is nothing to measure against
+	if (ViewLocations.Num() == 0)
+	{
+		return false;
+	}
+
+	const double MaxDistanceSquared = FMath::Square(MaxDistance);
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		if (FVector::DistSquared(ViewLocation, Location) <= MaxDistanceSquared)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool ULyraContextEffectsSubsystem::IsOverConcurrencyLimit(const UObject* Asset)
+{
+	if (LyraContextEffects::MaxInstancesPerAsset <= 0)
+	{
+		return false;
+	}
+
+	TArray<TWeakObjectPtr<USceneComponent>>* Instances = ActiveInstances.Find(FObjectKey(Asset));
+	if (!Instances)
+	{
+		return false;
+	}
+
+	// Drop instances that finished, or whose pooled component has since been reused for another asset
+	Instances->RemoveAllSwap([Asset](const TWeakObjectPtr<USceneComponent>& Instance)
+	{
+		if (const UAudioComponent* AudioComponent = Cast<UAudioComponent>(Instance.Get()))
+		{
+			return (AudioComponent->Sound != Asset) || !AudioComponent->IsPlaying();
+		}
+		if (const UNiagaraComponent* NiagaraComponent = Cast<UNiagaraComponent>(Instance.Get()))
+		{
+			return (NiagaraComponent->GetAsset() != Asset) || !NiagaraComponent->IsActive();
+		}
+		return true;
+	});
+
+	return Instances->Num() >= LyraContextEffects::MaxInstancesPerAsset;
+}
+
+void ULyraContextEffectsSubsystem::AddActiveInstance(const UObject* Asset, USceneComponent* Component)
+{
+	// Only tracked while there is a limit to check them against
+	if (LyraContextEffects::MaxInstancesPerAsset > 0)
+	{
+		ActiveInstances.FindOrAdd(FObjectKey(Asset)).Add(Component);
+	}
+}
+
+UAudioComponent* ULyraContextEffectsSubsystem::AcquireAudioComponent(USoundBase* Sound, USceneComponent* AttachToComponent, FName AttachPoint,
+	const FVector& LocationOffset, const FRotator& RotationOffset, float AudioVolume, float AudioPitch)
+{
+	// Same requirements as UGameplayStatics::SpawnSoundAttached
+	UWorld* World = GetWorld();
+	if (!AttachToComponent || !World || !World->GetAudioDeviceRaw())
+	{
+		return nullptr;
+	}
+
+	UAudioComponent* AudioComponent = nullptr;
+	while (!AudioComponent && (FreeAudioComponents.Num() > 0))
+	{
+		AudioComponent = FreeAudioComponents.Pop(EAllowShrinking::No);
+		if (!IsValid(AudioComponent))
+		{
+			PooledAudioComponents.Remove(AudioComponent);
+			AudioComponent = nullptr;
+		}
+	}
+
+	if (AudioComponent)
+	{
+		++NumAudioReused;
+	}
+	else
+	{
+		AudioComponent = NewObject<UAudioComponent>(World);
+		AudioComponent->bAutoActivate = false;
+		AudioComponent->bAutoDestroy = false;
+		AudioComponent->bStopWhenOwnerDestroyed = false;
+		AudioComponent->OnAudioFinishedNative.AddUObject(this, &ThisClass::HandlePooledAudioFinished);
+		AudioComponent->RegisterComponentWithWorld(World);
+
+		PooledAudioComponents.Add(AudioComponent);
+		++NumAudioSpawned;
+	}
+
+	AudioComponent->SetSound(Sound);
+	AudioComponent->SetVolumeMultiplier(AudioVolume);
+	AudioComponent->SetPitchMultiplier(AudioPitch);
+	AudioComponent->AttachToComponent(AttachToComponent, FAttachmentTransformRules::KeepRelativeTransform, AttachPoint);
+	AudioComponent->SetRelativeLocationAndRotation(LocationOffset, RotationOffset);
+	AudioComponent->Play();
+
+	return AudioComponent;
+}
+
+void ULyraContextEffectsSubsystem::HandlePooledAudioFinished(UAudioComponent* AudioComponent)
+{
+	if (!IsValid(AudioComponent))
+	{
+		return;
+	}
+
+	AudioComponent->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+
+	// Let go of the sound so unloaded libraries can be collected
+	AudioComponent->Sound = nullptr;
+
+	if (FreeAudioComponents.Num() < LyraContextEffects::MaxPooledAudioComponents)
+	{
+		FreeAudioComponents.Add(AudioComponent);
+	}
+	else
+	{
+		PooledAudioComponents.RemoveSingleSwap(AudioComponent);
+		AudioComponent->OnAudioFinishedNative.RemoveAll(this);
+		AudioComponent->DestroyComponent();
+	}
+}
+
+void ULyraContextEffectsSubsystem::GetContextEffectImplementers(AActor* Actor, FContextEffectImplementers& OutImplementers)
+{
+	OutImplementers.Reset();
+
+	if (!Actor)
+	{
+		return;
+	}
+
+	const int32 NumComponents = Actor->GetComponents().Num();
 
-				NiagaraOut.Add(NiagaraComponent);
+	FCachedImplementers* Cached = CachedImplementers.Find(FObjectKey(Actor));
+	if (Cached && (Cached->NumComponents == NumComponents))
+	{
+		for (const TWeakObjectPtr<UObject>& Implementer : Cached->Implementers)
+		{
+			UObject* ImplementerObject = Implementer.Get();
+			if (!ImplementerObject)
+			{
+				// A component went away, scan again
+				OutImplementers.Reset();
+				break;
 			}
+
+			OutImplementers.Add(ImplementerObject);
+		}
+
+		if (OutImplementers.Num() == Cached->Implementers.Num())
+		{
+			return;
+		}
+	}
+
+	FindContextEffectImplementers(Actor, OutImplementers);
+
+	if (!Cached)
+	{
+		// Purge entries of destroyed actors before growing the map
+		if (CachedImplementers.Num() >= CachedImplementersPurgeThreshold)
+		{
+			for (auto It = CachedImplementers.CreateIterator(); It; ++It)
+			{
+				if (!It.Value().Actor.IsValid())
+				{
+					It.RemoveCurrent();
+				}
+			}
+
+			CachedImplementersPurgeThreshold = FMath::Max(64, CachedImplementers.Num() * 2);
+		}
+
+		Cached = &CachedImplementers.Add(FObjectKey(Actor));
+		Cached->Actor = Actor;
+	}
+
+	Cached->NumComponents = NumComponents;
+	Cached->Implementers.Reset();
+	for (UObject* ImplementerObject : OutImplementers)
+	{
+		Cached->Implementers.Add(ImplementerObject);
+	}
+}
+
+void ULyraContextEffectsSubsystem::FindContextEffectImplementers(AActor* Actor, FContextEffectImplementers& OutImplementers)
+{
+	OutImplementers.Reset();
+
+	if (!Actor)
+	{
+		return;
+	}
+
+	// Determine if the Actor is one of the Objects that implements the Context Effects Interface
+	if (Actor->Implements<ULyraContextEffectsInterface>())
+	{
+		OutImplementers.Add(Actor);
+	}
+
+	// Cycle through the Actor's Components and determine if any of them implements the Context Effects Interface
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (Component && Component->Implements<ULyraContextEffectsInterface>())
+		{
+			OutImplementers.Add(Component);
 		}
 	}
 }
 
+void ULyraContextEffectsSubsystem::DumpStats(FOutputDevice& Ar)
+{
+	const double Now = FPlatformTime::Seconds();
+	const double Elapsed = FMath::Max(Now - StatsStartTime, UE_SMALL_NUMBER);
+
+	Ar.Logf(TEXT("Context effects over %.1f s: %lld audio components created (%.1f/s), %lld reused (%.1f/s), %lld Niagara systems spawned (%.1f/s), %lld culled by distance (%.1f/s), %lld culled by concurrency (%.1f/s), %d/%d pooled audio components idle"),
+		Elapsed, NumAudioSpawned, NumAudioSpawned / Elapsed, NumAudioReused, NumAudioReused / Elapsed, NumNiagaraSpawned, NumNiagaraSpawned / Elapsed,
+		NumCulledByDistance, NumCulledByDistance / Elapsed, NumCulledByConcurrency, NumCulledByConcurrency / Elapsed, FreeAudioComponents.Num(), PooledAudioComponents.Num());
+
+	StatsStartTime = Now;
+	NumAudioSpawned = 0;
+	NumAudioReused = 0;
+	NumNiagaraSpawned = 0;
+	NumCulledByDistance = 0;
+	NumCulledByConcurrency = 0;
+}
+
 bool ULyraContextEffectsSubsystem::GetContextFromSurfaceType(
 	TEnumAsByte<EPhysicalSurface> PhysicalSurface, FGameplayTag& Context)
 {
@@ -148,3 +566,15 @@ void ULyraContextEffectsSubsystem::UnloadAndRemoveContextEffectsLibraries(AActor
 	ActiveActorEffectsMap.Remove(OwningActor);
 }
 
+//////////////////////////////////////////////////////////////////////
+
+static FAutoConsoleCommandWithWorldAndArgs DumpContextEffectsStatsCommand(
+	TEXT("Lyra.ContextEffects.DumpStats"),
+	TEXT("Prints how many context effect components were created, reused and culled, then restarts the measurement."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (ULyraContextEffectsSubsystem* ContextEffectsSubsystem = UWorld::GetSubsystem<ULyraContextEffectsSubsystem>(World))
+		{
+			ContextEffectsSubsystem->DumpStats(*GLog);
+		}
+	}));
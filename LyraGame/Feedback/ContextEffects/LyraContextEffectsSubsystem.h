@@ -5,16 +5,20 @@
 #include "Engine/DeveloperSettings.h"
 #include "GameplayTagContainer.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
 
 #include "LyraContextEffectsSubsystem.generated.h"
 
 enum EPhysicalSurface : int;
 
 class AActor;
+class FOutputDevice;
 class UAudioComponent;
 class ULyraContextEffectsLibrary;
 class UNiagaraComponent;
+class UNiagaraSystem;
 class USceneComponent;
+class USoundBase;
 struct FFrame;
 struct FGameplayTag;
 struct FGameplayTagContainer;
@@ -48,7 +52,11 @@ public:
 
 
 /**
- * 
+ * ULyraContextEffectsSubsystem
+ *
+ *	Spawns the sounds and Niagara systems of context effects. In game worlds the components are pooled (audio
+ *	components by this subsystem, Niagara components by the world's Niagara pool), effects too far from every local
+ *	view are culled and each sound or system only has a limited number of instances playing at once.
  */
 UCLASS()
 class LYRAGAME_API ULyraContextEffectsSubsystem : public UWorldSubsystem
@@ -56,7 +64,17 @@ class LYRAGAME_API ULyraContextEffectsSubsystem : public UWorldSubsystem
 	GENERATED_BODY()
 	
 public:
-	/** */
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	/**
+	 * Plays the sounds and Niagara systems the actor's libraries have for the effect and contexts, attached to the component.
+	 * AudioOut and NiagaraOut only receive the components spawned for this call alone, which the caller may keep, stop or
+	 * destroy. In game worlds one-shot sounds and Niagara systems are usually played on pooled components instead; those
+	 * are left out since they are handed to other effects as soon as they finish.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "ContextEffects")
 	void SpawnContextEffects(
 		const AActor* SpawningActor
@@ -65,7 +83,7 @@ public:
 		, const FVector LocationOffset
 		, const FRotator RotationOffset
 		, FGameplayTag Effect
-		, FGameplayTagContainer Contexts
+		, const FGameplayTagContainer& Contexts
 		, TArray<UAudioComponent*>& AudioOut
 		, TArray<UNiagaraComponent*>& NiagaraOut
 		, FVector VFXScale = FVector(1)
@@ -84,9 +102,72 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ContextEffects")
 	void UnloadAndRemoveContextEffectsLibraries(AActor* OwningActor);
 
+	using FContextEffectImplementers = TArray<UObject*, TInlineAllocator<4>>;
+
+	// Gets the actor and those of its components that implement ILyraContextEffectsInterface. The result is cached
+	// per actor until its number of components changes or one of them goes away.
+	void GetContextEffectImplementers(AActor* Actor, FContextEffectImplementers& OutImplementers);
+
+	// Uncached version of GetContextEffectImplementers, for worlds without this subsystem
+	static void FindContextEffectImplementers(AActor* Actor, FContextEffectImplementers& OutImplementers);
+
+	// Prints the effects spawned, reused and culled since the last call, then restarts the measurement.
+	void DumpStats(FOutputDevice& Ar);
+
+private:
+
+	// Returns true if an effect at Location is beyond MaxDistance of every local view
+	bool IsCulledByDistance(const FVector& Location, float MaxDistance);
+
+	// Returns true if the asset already has as many instances playing as allowed
+	bool IsOverConcurrencyLimit(const UObject* Asset);
+	void AddActiveInstance(const UObject* Asset, USceneComponent* Component);
+
+	UAudioComponent* AcquireAudioComponent(USoundBase* Sound, USceneComponent* AttachToComponent, FName AttachPoint,
+		const FVector& LocationOffset, const FRotator& RotationOffset, float AudioVolume, float AudioPitch);
+
+	void HandlePooledAudioFinished(UAudioComponent* AudioComponent);
+
 private:
 
 	UPROPERTY(Transient)
 	TMap<TObjectPtr<AActor>, TObjectPtr<ULyraContextEffectsSet>> ActiveActorEffectsMap;
 
+	// Pooled audio components that are not playing
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UAudioComponent>> FreeAudioComponents;
+
+	// Every audio component created by the pool, playing or not
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UAudioComponent>> PooledAudioComponents;
+
+	// Components spawned for each sound or Niagara system, pruned of finished ones when the limit is checked
+	TMap<FObjectKey, TArray<TWeakObjectPtr<USceneComponent>>> ActiveInstances;
+
+	struct FCachedImplementers
+	{
+		TWeakObjectPtr<AActor> Actor;
+		int32 NumComponents = 0;
+		TArray<TWeakObjectPtr<UObject>, TInlineAllocator<4>> Implementers;
+	};
+
+	// Context effect implementers by actor, entries of destroyed actors are purged once the map outgrows the threshold
+	TMap<FObjectKey, FCachedImplementers> CachedImplementers;
+	int32 CachedImplementersPurgeThreshold = 64;
+
+	// Lookup scratch, reused by every SpawnContextEffects call
+	TArray<USoundBase*> ScratchSounds;
+	TArray<UNiagaraSystem*> ScratchNiagaraSystems;
+
+	// Local view locations, gathered once per frame
+	TArray<FVector> ViewLocations;
+	uint64 ViewLocationsFrame = MAX_uint64;
+
+	// Stats since StatsStartTime
+	double StatsStartTime = 0.0;
+	int64 NumAudioSpawned = 0;
+	int64 NumAudioReused = 0;
+	int64 NumNiagaraSpawned = 0;
+	int64 NumCulledByDistance = 0;
+	int64 NumCulledByConcurrency = 0;
 };
@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Feedback/ContextEffects/LyraSurfaceProbeSubsystem.h"
+
+#include "Engine/HitResult.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraSurfaceProbeSubsystem)
+
+namespace LyraSurfaceProbe
+{
+	static int32 MaxProbesPerFrame = 0;
+	static FAutoConsoleVariableRef CVarMaxProbesPerFrame(
+		TEXT("Lyra.ContextEffects.MaxSurfaceProbesPerFrame"),
+		MaxProbesPerFrame,
+		TEXT("Maximum number of context effect surface traces issued per frame, the rest wait for the next frame. 0 means no limit."),
+		ECVF_Default);
+}
+
+void ULyraSurfaceProbeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	StatsStartTime = FPlatformTime::Seconds();
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::HandlePostActorTick);
+}
+
+void ULyraSurfaceProbeSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	QueuedProbes.Reset();
+	ProbesInFlight.Reset();
+
+	Super::Deinitialize();
+}
+
+void ULyraSurfaceProbeSubsystem::RequestSurfaceProbe(const FVector& Start, const FVector& End, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params, FLyraSurfaceProbeComplete OnComplete)
+{
+	FQueuedProbe& QueuedProbe = QueuedProbes.AddDefaulted_GetRef();
+	QueuedProbe.Start = Start;
+	QueuedProbe.End = End;
+	QueuedProbe.TraceChannel = TraceChannel;
+	QueuedProbe.Params = Params;
+	QueuedProbe.OnComplete = MoveTemp(OnComplete);
+}
+
+void ULyraSurfaceProbeSubsystem::HandlePostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if ((InWorld != GetWorld()) || (QueuedProbes.Num() == 0))
+	{
+		return;
+	}
+
+	const int32 NumToIssue = (LyraSurfaceProbe::MaxProbesPerFrame > 0) ? FMath::Min(QueuedProbes.Num(), LyraSurfaceProbe::MaxProbesPerFrame) : QueuedProbes.Num();
+
+	const FTraceDelegate TraceDelegate = FTraceDelegate::CreateUObject(this, &ThisClass::HandleTraceCompleted);
+	for (int32 ProbeIndex = 0; ProbeIndex < NumToIssue; ++ProbeIndex)
+	{
+		FQueuedProbe& QueuedProbe = QueuedProbes[ProbeIndex];
+
+		const uint32 ProbeId = NextProbeId++;
+		ProbesInFlight.Add(ProbeId, MoveTemp(QueuedProbe.OnComplete));
+
+		InWorld->AsyncLineTraceByChannel(EAsyncTraceType::Single, QueuedProbe.Start, QueuedProbe.End, QueuedProbe.TraceChannel, QueuedProbe.Params,
+			FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, ProbeId);
+	}
+
+	QueuedProbes.RemoveAt(0, NumToIssue, EAllowShrinking::No);
+
+	NumProbesIssued += NumToIssue;
+	MaxProbesInFrame = FMath::Max(MaxProbesInFrame, NumToIssue);
+}
+
+void ULyraSurfaceProbeSubsystem::HandleTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FLyraSurfaceProbeComplete OnComplete;
+	if (!ProbesInFlight.RemoveAndCopyValue(TraceDatum.UserData, OnComplete))
+	{
+		return;
+	}
+
+	FHitResult HitResult;
+	HitResult.TraceStart = TraceDatum.Start;
+	HitResult.TraceEnd = TraceDatum.End;
+
+	bool bHitSuccess = false;
+	if (TraceDatum.OutHits.Num() > 0)
+	{
+		HitResult = TraceDatum.OutHits[0];
+		bHitSuccess = HitResult.bBlockingHit;
+	}
+
+	OnComplete.ExecuteIfBound(bHitSuccess, HitResult);
+}
+
+void ULyraSurfaceProbeSubsystem::DumpStats(FOutputDevice& Ar)
+{
+	const double Now = FPlatformTime::Seconds();
+	const double Elapsed = FMath::Max(Now - StatsStartTime, UE_SMALL_NUMBER);
+
+	Ar.Logf(TEXT("Surface probes over %.1f s: %lld issued async (%.1f/s, at most %d in one frame), %d queued, %d in flight"),
+		Elapsed, NumProbesIssued, NumProbesIssued / Elapsed, MaxProbesInFrame, QueuedProbes.Num(), ProbesInFlight.Num());
+
+	StatsStartTime = Now;
+	NumProbesIssued = 0;
+	MaxProbesInFrame = 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+static FAutoConsoleCommandWithWorldAndArgs DumpSurfaceProbeStatsCommand(
+	TEXT("Lyra.ContextEffects.DumpSurfaceProbeStats"),
+	TEXT("Prints how many context effect surface traces were issued, then restarts the measurement."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (ULyraSurfaceProbeSubsystem* SurfaceProbeSubsystem = UWorld::GetSubsystem<ULyraSurfaceProbeSubsystem>(World))
+		{
+			SurfaceProbeSubsystem->DumpStats(*GLog);
+		}
+	}));
@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CollisionQueryParams.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+
+#include "LyraSurfaceProbeSubsystem.generated.h"
+
+class FOutputDevice;
+struct FHitResult;
+
+DECLARE_DELEGATE_TwoParams(FLyraSurfaceProbeComplete, bool /*bHitSuccess*/, const FHitResult& /*HitResult*/);
+
+/**
+ * ULyraSurfaceProbeSubsystem
+ *
+ *	Collects the surface traces context effect anim notifies request while animation is evaluated and issues them
+ *	together as async traces once all actors have ticked, so footsteps never block the game thread. Results are
+ *	delivered the next frame with the blocking hit, the same result LineTraceSingleByChannel returns.
+ */
+UCLASS()
+class ULyraSurfaceProbeSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	// Queues a line trace against TraceChannel, OnComplete is executed (if still bound) once the result is available.
+	void RequestSurfaceProbe(const FVector& Start, const FVector& End, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params, FLyraSurfaceProbeComplete OnComplete);
+
+	// Prints the probes issued since the last call, then restarts the measurement.
+	void DumpStats(FOutputDevice& Ar);
+
+private:
+
+	void HandlePostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	void HandleTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+private:
+
+	struct FQueuedProbe
+	{
+		FVector Start;
+		FVector End;
+		ECollisionChannel TraceChannel = ECC_Visibility;
+		FCollisionQueryParams Params;
+		FLyraSurfaceProbeComplete OnComplete;
+	};
+
+	TArray<FQueuedProbe> QueuedProbes;
+
+	// Completion delegates of the probes in flight, keyed by the trace's user data.
+	TMap<uint32, FLyraSurfaceProbeComplete> ProbesInFlight;
+
+	uint32 NextProbeId = 0;
+
+	FDelegateHandle PostActorTickHandle;
+
+	// Stats since StatsStartTime
+	double StatsStartTime = 0.0;
+	int64 NumProbesIssued = 0;
+	int32 MaxProbesInFrame = 0;
+};
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "Engine/DataAsset.h"
+#include "GameplayTagContainer.h"
+
 #include "LyraExperienceDefinition.generated.h"
 
 class UGameFeatureAction;
@@ -49,4 +51,9 @@ public:
 	// List of additional action sets to compose into this experience
 	UPROPERTY(EditDefaultsOnly, Category=Gameplay)
 	TArray<TObjectPtr<ULyraExperienceActionSet>> ActionSets;
+
+	// Gameplay cues to preload with this experience on top of the ones found in its pawn data and ability sets, for cues
+	// triggered by anything else (e.g. actors spawned by its game features)
+	UPROPERTY(EditDefaultsOnly, Category=Gameplay, meta=(Categories="GameplayCue"))
+	FGameplayTagContainer GameplayCuesToPreload;
 };
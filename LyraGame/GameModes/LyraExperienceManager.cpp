@@ -3,10 +3,69 @@
 #include "LyraExperienceManager.h"
 #include "GameModes/LyraExperienceManager.h"
 #include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFeaturesSubsystem.h"
+#include "GameFeaturesSubsystemSettings.h"
+#include "GameModes/LyraExperienceActionSet.h"
+#include "GameModes/LyraExperienceDefinition.h"
+#include "GameModes/LyraExperienceManagerComponent.h"
+#include "GameFramework/GameStateBase.h"
+#include "LyraLogChannels.h"
 #include "Subsystems/SubsystemCollection.h"
+#include "System/LyraAssetManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraExperienceManager)
 
+namespace LyraExperienceWarmCacheCvars
+{
+	static bool bRetainSharedPlugins = true;
+	static FAutoConsoleVariableRef CVarRetainSharedPlugins(
+		TEXT("Lyra.Experience.RetainSharedPlugins"),
+		bRetainSharedPlugins,
+		TEXT("Should game feature plugins needed by the preloaded next experience stay active across the match transition instead of being deactivated and reactivated?"),
+		ECVF_Default);
+
+	static float RetainedPluginTimeout = 60.0f;
+	static FAutoConsoleVariableRef CVarRetainedPluginTimeout(
+		TEXT("Lyra.Experience.RetainedPluginTimeout"),
+		RetainedPluginTimeout,
+		TEXT("Seconds that plugins kept active for the preloaded next experience stay active if that experience does not start loading."),
+		ECVF_Default);
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdPreloadExperience(
+		TEXT("Lyra.Experience.PreloadNext"),
+		TEXT("Starts loading the bundles and game feature plugins of an experience in the background. Usage: Lyra.Experience.PreloadNext <ExperienceName>"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if ((Args.Num() > 0) && (World != nullptr))
+			{
+				FPrimaryAssetId ExperienceId = FPrimaryAssetId::ParseTypeAndName(Args[0]);
+				if (!ExperienceId.PrimaryAssetType.IsValid())
+				{
+					ExperienceId = FPrimaryAssetId(FPrimaryAssetType(ULyraExperienceDefinition::StaticClass()->GetFName()), FName(*Args[0]));
+				}
+
+				if (AGameStateBase* GameState = World->GetGameState())
+				{
+					if (ULyraExperienceManagerComponent* ExperienceComponent = GameState->FindComponentByClass<ULyraExperienceManagerComponent>())
+					{
+						ExperienceComponent->PreloadNextExperience(ExperienceId);
+					}
+				}
+			}
+		}));
+}
+
+void ULyraExperienceManager::Deinitialize()
+{
+	// The engine is shutting down and takes the plugins with it, there is nothing to release
+	FTSTicker::GetCoreTicker().RemoveTicker(RetainedPluginsExpiryHandle);
+	RetainedPluginsExpiryHandle.Reset();
+	WarmCache.Empty();
+
+	Super::Deinitialize();
+}
+
 #if WITH_EDITOR
 
 void ULyraExperienceManager::OnPlayInEditorBegun()
@@ -52,3 +111,292 @@ bool ULyraExperienceManager::RequestToDeactivatePlugin(const FString PluginURL)
 }
 
 #endif
+
+//////////////////////////////////////////////////////////////////////
+// Warm cache
+
+void ULyraExperienceManager::GetBundlesToLoad(bool bLoadClient, bool bLoadServer, TArray<FName>& OutBundles)
+{
+	OutBundles.Add(FLyraBundles::Equipped);
+	if (bLoadClient)
+	{
+		OutBundles.Add(UGameFeaturesSubsystemSettings::LoadStateClient);
+	}
+	if (bLoadServer)
+	{
+		OutBundles.Add(UGameFeaturesSubsystemSettings::LoadStateServer);
+	}
+}
+
+void ULyraExperienceManager::GetBundleAssets(const ULyraExperienceDefinition* Experience, TArray<FPrimaryAssetId>& OutAssets)
+{
+	OutAssets.AddUnique(Experience->GetPrimaryAssetId());
+	for (const TObjectPtr<ULyraExperienceActionSet>& ActionSet : Experience->ActionSets)
+	{
+		if (ActionSet != nullptr)
+		{
+			OutAssets.AddUnique(ActionSet->GetPrimaryAssetId());
+		}
+	}
+}
+
+void ULyraExperienceManager::GetGameFeaturePluginURLs(const ULyraExperienceDefinition* Experience, TArray<FString>& OutPluginURLs)
+{
+	// find the URLs for our GameFeaturePlugins - filtering out dupes and ones that don't have a valid mapping
+	auto CollectGameFeaturePluginURLs = [&OutPluginURLs](const UPrimaryDataAsset* Context, const TArray<FString>& FeaturePluginList)
+	{
+		for (const FString& PluginName : FeaturePluginList)
+		{
+			FString PluginURL;
+			if (UGameFeaturesSubsystem::Get().GetPluginURLByName(PluginName, /*out*/ PluginURL))
+			{
+				OutPluginURLs.AddUnique(PluginURL);
+			}
+			else
+			{
+				ensureMsgf(false, TEXT("OnExperienceLoadComplete failed to find plugin URL from PluginName %s for experience %s - fix data, ignoring for this run"), *PluginName, *Context->GetPrimaryAssetId().ToString());
+			}
+		}
+	};
+
+	CollectGameFeaturePluginURLs(Experience, Experience->GameFeaturesToEnable);
+	for (const TObjectPtr<ULyraExperienceActionSet>& ActionSet : Experience->ActionSets)
+	{
+		if (ActionSet != nullptr)
+		{
+			CollectGameFeaturePluginURLs(ActionSet, ActionSet->GameFeaturesToEnable);
+		}
+	}
+}
+
+void ULyraExperienceManager::PreloadExperience(FPrimaryAssetId ExperienceId, bool bLoadClient, bool bLoadServer)
+{
+	if (!ExperienceId.IsValid())
+	{
+		return;
+	}
+
+	// A different next experience replaces the previous one, along with any plugins kept active for it
+	const FPrimaryAssetId PreviousNextExperienceId = NextExperienceId;
+	if (PreviousNextExperienceId.IsValid() && (PreviousNextExperienceId != ExperienceId) && (PreviousNextExperienceId != CurrentExperienceId))
+	{
+		EvictWarmCacheEntries([&PreviousNextExperienceId](const FLyraExperienceWarmCacheEntry& Entry) { return Entry.ExperienceId == PreviousNextExperienceId; });
+	}
+
+	NextExperienceId = ExperienceId;
+
+	if (IsExperienceWarm(ExperienceId))
+	{
+		return;
+	}
+
+	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
+	const FSoftObjectPath AssetPath = AssetManager.GetPrimaryAssetPath(ExperienceId);
+	if (!AssetPath.IsValid())
+	{
+		UE_LOG(LogLyraExperience, Warning, TEXT("EXPERIENCE: Cannot preload %s, it is not a known experience"), *ExperienceId.ToString());
+		return;
+	}
+
+	UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Preloading %s for the next match"), *ExperienceId.ToString());
+
+	FLyraExperienceWarmCacheEntry& Entry = WarmCache.AddDefaulted_GetRef();
+	Entry.ExperienceId = ExperienceId;
+	Entry.RequestTime = FPlatformTime::Seconds();
+
+	// Load the definition itself first, the bundles and plugins to load come from it
+	Entry.DefinitionHandle = AssetManager.GetStreamableManager().RequestAsyncLoad(AssetPath,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::OnPreloadDefinitionLoaded, ExperienceId, bLoadClient, bLoadServer),
+		FStreamableManager::DefaultAsyncLoadPriority);
+
+	if (!Entry.DefinitionHandle.IsValid())
+	{
+		OnPreloadDefinitionLoaded(ExperienceId, bLoadClient, bLoadServer);
+	}
+}
+
+void ULyraExperienceManager::OnPreloadDefinitionLoaded(FPrimaryAssetId ExperienceId, bool bLoadClient, bool bLoadServer)
+{
+	FLyraExperienceWarmCacheEntry* Entry = WarmCache.FindByPredicate([&ExperienceId](const FLyraExperienceWarmCacheEntry& Test) { return Test.ExperienceId == ExperienceId; });
+	if (Entry == nullptr)
+	{
+		// Evicted while the definition was loading
+		return;
+	}
+
+	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
+	TSubclassOf<ULyraExperienceDefinition> AssetClass = Cast<UClass>(AssetManager.GetPrimaryAssetPath(ExperienceId).ResolveObject());
+	if (AssetClass == nullptr)
+	{
+		UE_LOG(LogLyraExperience, Warning, TEXT("EXPERIENCE: Failed to preload the definition of %s"), *ExperienceId.ToString());
+		return;
+	}
+	const ULyraExperienceDefinition* Experience = GetDefault<ULyraExperienceDefinition>(AssetClass);
+
+	// Bundles, at low priority so the running match is not disturbed
+	TArray<FPrimaryAssetId> BundleAssetList;
+	GetBundleAssets(Experience, BundleAssetList);
+
+	TArray<FName> BundlesToLoad;
+	GetBundlesToLoad(bLoadClient, bLoadServer, BundlesToLoad);
+
+	Entry->BundleHandle = AssetManager.ChangeBundleStateForPrimaryAssets(BundleAssetList, BundlesToLoad, {}, false, FStreamableDelegate(), FStreamableManager::AsyncLoadLowPriority);
+	if (!Entry->BundleHandle.IsValid() || Entry->BundleHandle->HasLoadCompleted())
+	{
+		Entry->BundlesLoadedTime = FPlatformTime::Seconds();
+	}
+	else
+	{
+		Entry->BundleHandle->BindCompleteDelegate(FStreamableDelegate::CreateWeakLambda(this, [this, ExperienceId]()
+		{
+			if (FLyraExperienceWarmCacheEntry* LoadedEntry = WarmCache.FindByPredicate([&ExperienceId](const FLyraExperienceWarmCacheEntry& Test) { return Test.ExperienceId == ExperienceId; }))
+			{
+				LoadedEntry->BundlesLoadedTime = FPlatformTime::Seconds();
+				UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Preloaded bundles of %s in %.2f seconds"), *ExperienceId.ToString(), LoadedEntry->BundlesLoadedTime - LoadedEntry->RequestTime);
+			}
+		}));
+	}
+
+	// Plugins are loaded (registered and their content mounted) but not activated, activation stays with the experience
+	GetGameFeaturePluginURLs(Experience, Entry->GameFeaturePluginURLs);
+	Entry->NumPluginsLoading = Entry->GameFeaturePluginURLs.Num();
+
+	for (const FString& PluginURL : Entry->GameFeaturePluginURLs)
+	{
+		UGameFeaturesSubsystem::Get().LoadGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateWeakLambda(this, [this, ExperienceId, PluginURL](const UE::GameFeatures::FResult& Result)
+		{
+			if (FLyraExperienceWarmCacheEntry* LoadedEntry = WarmCache.FindByPredicate([&ExperienceId](const FLyraExperienceWarmCacheEntry& Test) { return Test.ExperienceId == ExperienceId; }))
+			{
+				--LoadedEntry->NumPluginsLoading;
+			}
+
+			if (Result.HasError())
+			{
+				UE_LOG(LogLyraExperience, Warning, TEXT("EXPERIENCE: Failed to preload plugin %s for %s"), *PluginURL, *ExperienceId.ToString());
+			}
+		}));
+	}
+}
+
+void ULyraExperienceManager::OnExperienceLoadStarted(FPrimaryAssetId ExperienceId, TSharedPtr<FStreamableHandle> BundleHandle)
+{
+	CurrentExperienceId = ExperienceId;
+
+	// An experience is loading, it takes over or releases the retained plugins once it knows its own (see OnExperiencePluginsCollected)
+	FTSTicker::GetCoreTicker().RemoveTicker(RetainedPluginsExpiryHandle);
+	RetainedPluginsExpiryHandle.Reset();
+
+	// Only the experience that is loading now and the one preloaded for the next match stay warm
+	if (NextExperienceId == ExperienceId)
+	{
+		NextExperienceId = FPrimaryAssetId();
+	}
+
+	EvictWarmCacheEntries([this, &ExperienceId](const FLyraExperienceWarmCacheEntry& Entry)
+	{
+		return (Entry.ExperienceId != ExperienceId) && (Entry.ExperienceId != NextExperienceId) && Entry.RetainedActivePluginURLs.IsEmpty();
+	});
+
+	FLyraExperienceWarmCacheEntry* Entry = WarmCache.FindByPredicate([&ExperienceId](const FLyraExperienceWarmCacheEntry& Test) { return Test.ExperienceId == ExperienceId; });
+	if (Entry == nullptr)
+	{
+		Entry = &WarmCache.AddDefaulted_GetRef();
+		Entry->ExperienceId = ExperienceId;
+		Entry->RequestTime = FPlatformTime::Seconds();
+	}
+
+	if (BundleHandle.IsValid())
+	{
+		Entry->BundleHandle = BundleHandle;
+	}
+}
+
+void ULyraExperienceManager::OnExperiencePluginsCollected(FPrimaryAssetId ExperienceId, const TArray<FString>& PluginURLs)
+{
+	if (FLyraExperienceWarmCacheEntry* Entry = WarmCache.FindByPredicate([&ExperienceId](const FLyraExperienceWarmCacheEntry& Test) { return Test.ExperienceId == ExperienceId; }))
+	{
+		Entry->GameFeaturePluginURLs = PluginURLs;
+	}
+
+	// The new experience activates (and later deactivates) the plugins it needs, anything else we kept active is released now
+	for (FLyraExperienceWarmCacheEntry& RetainingEntry : WarmCache)
+	{
+		ReleaseRetainedPlugins(RetainingEntry, PluginURLs);
+	}
+
+	// Entries that were only kept for their retained plugins can go now
+	EvictWarmCacheEntries([this, &ExperienceId](const FLyraExperienceWarmCacheEntry& Entry)
+	{
+		return (Entry.ExperienceId != ExperienceId) && (Entry.ExperienceId != NextExperienceId);
+	});
+}
+
+bool ULyraExperienceManager::RetainActivePluginForNextExperience(const FString& PluginURL)
+{
+	// PIE shares plugins between worlds and already reference counts them (see RequestToDeactivatePlugin)
+	if (GIsEditor || !LyraExperienceWarmCacheCvars::bRetainSharedPlugins || !NextExperienceId.IsValid())
+	{
+		return false;
+	}
+
+	FLyraExperienceWarmCacheEntry* NextEntry = WarmCache.FindByPredicate([this](const FLyraExperienceWarmCacheEntry& Test) { return Test.ExperienceId == NextExperienceId; });
+	if ((NextEntry != nullptr) && NextEntry->GameFeaturePluginURLs.Contains(PluginURL))
+	{
+		NextEntry->RetainedActivePluginURLs.AddUnique(PluginURL);
+
+		if (!RetainedPluginsExpiryHandle.IsValid())
+		{
+			RetainedPluginsExpiryHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::HandleRetainedPluginsExpired), LyraExperienceWarmCacheCvars::RetainedPluginTimeout);
+		}
+		return true;
+	}
+
+	return false;
+}
+
+void ULyraExperienceManager::EvictWarmCacheEntries(TFunctionRef<bool(const FLyraExperienceWarmCacheEntry&)> Predicate)
+{
+	for (int32 EntryIndex = WarmCache.Num() - 1; EntryIndex >= 0; --EntryIndex)
+	{
+		if (Predicate(WarmCache[EntryIndex]))
+		{
+			ReleaseRetainedPlugins(WarmCache[EntryIndex], TArray<FString>());
+			WarmCache.RemoveAt(EntryIndex);
+		}
+	}
+}
+
+void ULyraExperienceManager::ReleaseRetainedPlugins(FLyraExperienceWarmCacheEntry& Entry, const TArray<FString>& PluginURLsToKeep)
+{
+	for (const FString& PluginURL : Entry.RetainedActivePluginURLs)
+	{
+		if (!PluginURLsToKeep.Contains(PluginURL))
+		{
+			UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Deactivating plugin %s that was kept active for %s"), *PluginURL, *Entry.ExperienceId.ToString());
+			UGameFeaturesSubsystem::Get().DeactivateGameFeaturePlugin(PluginURL);
+		}
+	}
+	Entry.RetainedActivePluginURLs.Reset();
+}
+
+bool ULyraExperienceManager::HandleRetainedPluginsExpired(float DeltaTime)
+{
+	RetainedPluginsExpiryHandle.Reset();
+
+	// The experience the plugins were kept for never started loading, so nothing will take them over
+	for (FLyraExperienceWarmCacheEntry& Entry : WarmCache)
+	{
+		if (!Entry.RetainedActivePluginURLs.IsEmpty())
+		{
+			UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: %s did not start loading within %.0f seconds, releasing the plugins kept active for it"), *Entry.ExperienceId.ToString(), LyraExperienceWarmCacheCvars::RetainedPluginTimeout);
+			ReleaseRetainedPlugins(Entry, TArray<FString>());
+		}
+	}
+
+	return false;
+}
+
+bool ULyraExperienceManager::IsExperienceWarm(FPrimaryAssetId ExperienceId) const
+{
+	return WarmCache.ContainsByPredicate([&ExperienceId](const FLyraExperienceWarmCacheEntry& Test) { return Test.ExperienceId == ExperienceId; });
+}
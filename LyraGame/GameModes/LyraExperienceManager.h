@@ -2,9 +2,37 @@
 
 #pragma once
 
+#include "Containers/Ticker.h"
 #include "Subsystems/EngineSubsystem.h"
+#include "UObject/PrimaryAssetId.h"
 #include "LyraExperienceManager.generated.h"
 
+class ULyraExperienceDefinition;
+struct FStreamableHandle;
+
+// Bundles and game feature plugins of one experience, kept loaded across match transitions
+struct FLyraExperienceWarmCacheEntry
+{
+	FPrimaryAssetId ExperienceId;
+
+	// Keeps the experience definition class loaded
+	TSharedPtr<FStreamableHandle> DefinitionHandle;
+
+	// Keeps the experience bundles loaded
+	TSharedPtr<FStreamableHandle> BundleHandle;
+
+	TArray<FString> GameFeaturePluginURLs;
+
+	// Plugins the previous experience left active for this one, deactivated if the entry is evicted or expires before it loads
+	TArray<FString> RetainedActivePluginURLs;
+
+	// Time the preload was requested and the time its bundles finished loading (0 if not yet)
+	double RequestTime = 0.0;
+	double BundlesLoadedTime = 0.0;
+
+	int32 NumPluginsLoading = 0;
+};
+
 /**
  * Manager for experiences - primarily for arbitration between multiple PIE sessions
  */
@@ -14,6 +42,10 @@ class ULyraExperienceManager : public UEngineSubsystem
 	GENERATED_BODY()
 
 public:
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
 #if WITH_EDITOR
 	LYRAGAME_API void OnPlayInEditorBegun();
 
@@ -24,6 +56,57 @@ public:
 	static bool RequestToDeactivatePlugin(const FString PluginURL) { return true; }
 #endif
 
+	// Starts loading an experience's bundles and game feature plugins in the background (e.g., the next experience
+	// in the playlist while the current match is still running), so the following StartExperienceLoad finds them warm.
+	// Plugins are only loaded, they are activated as usual once the experience is actually used.
+	LYRAGAME_API void PreloadExperience(FPrimaryAssetId ExperienceId, bool bLoadClient, bool bLoadServer);
+
+	// Called by the experience manager component when an experience starts loading for real: keeps its bundles
+	// resident and drops the cache entries of every other experience
+	void OnExperienceLoadStarted(FPrimaryAssetId ExperienceId, TSharedPtr<FStreamableHandle> BundleHandle);
+
+	// Called once the game feature plugins of the experience that is loading are known. Plugins that were kept
+	// active for it across the transition but are not in the list are deactivated now.
+	void OnExperiencePluginsCollected(FPrimaryAssetId ExperienceId, const TArray<FString>& PluginURLs);
+
+	// Returns true if an active plugin should be kept active when the current experience ends, because the
+	// preloaded next experience needs it too (the next experience then takes over its deactivation). The plugin is
+	// deactivated if the next experience is evicted from the cache, or has not started loading within
+	// Lyra.Experience.RetainedPluginTimeout seconds.
+	bool RetainActivePluginForNextExperience(const FString& PluginURL);
+
+	// Returns true if the experience was preloaded (its bundles may still be loading)
+	bool IsExperienceWarm(FPrimaryAssetId ExperienceId) const;
+
+	// Helpers shared by the experience manager component and the warm cache
+	static void GetBundlesToLoad(bool bLoadClient, bool bLoadServer, TArray<FName>& OutBundles);
+	static void GetBundleAssets(const ULyraExperienceDefinition* Experience, TArray<FPrimaryAssetId>& OutAssets);
+	static void GetGameFeaturePluginURLs(const ULyraExperienceDefinition* Experience, TArray<FString>& OutPluginURLs);
+
+private:
+	void OnPreloadDefinitionLoaded(FPrimaryAssetId ExperienceId, bool bLoadClient, bool bLoadServer);
+
+	// Removes the cache entries matching Predicate, deactivating the plugins that were retained for them
+	void EvictWarmCacheEntries(TFunctionRef<bool(const FLyraExperienceWarmCacheEntry&)> Predicate);
+
+	// Deactivates the plugins retained for an entry, except for those in PluginURLsToKeep (which the caller takes over)
+	static void ReleaseRetainedPlugins(FLyraExperienceWarmCacheEntry& Entry, const TArray<FString>& PluginURLsToKeep);
+
+	bool HandleRetainedPluginsExpired(float DeltaTime);
+
+private:
+	// Experience that was preloaded for the next match (if any)
+	FPrimaryAssetId NextExperienceId;
+
+	// Experience that most recently started loading
+	FPrimaryAssetId CurrentExperienceId;
+
+	// Warm experiences, at most the current one and the preloaded next one
+	TArray<FLyraExperienceWarmCacheEntry> WarmCache;
+
+	// Releases retained plugins if the experience they were kept for does not start loading in time
+	FTSTicker::FDelegateHandle RetainedPluginsExpiryHandle;
+
 private:
 	// The map of requests to active count for a given game feature plugin
 	// (to allow first in, last out activation management during PIE)
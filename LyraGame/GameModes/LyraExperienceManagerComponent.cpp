@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "LyraExperienceManagerComponent.h"
+#include "AbilitySystem/LyraGameplayCueManager.h"
 #include "Engine/World.h"
 #include "Net/UnrealNetwork.h"
 #include "LyraExperienceDefinition.h"
@@ -25,6 +26,14 @@
 // (for a client moving from experience to experience we actually want to diff the requirements and only unload some, not unload everything for them to just be immediately reloaded)
 //@TODO: Handle both built-in and URL-based plugins (search for colon?)
 
+DECLARE_STATS_GROUP(TEXT("LyraExperience"), STATGROUP_LyraExperience, STATCAT_Advanced);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Load: Bundles (ms)"), STAT_LyraExperience_BundleLoadMs, STATGROUP_LyraExperience);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Load: Game Feature Plugins (ms)"), STAT_LyraExperience_GameFeatureLoadMs, STATGROUP_LyraExperience);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Load: Chaos Delay (ms)"), STAT_LyraExperience_ChaosDelayMs, STATGROUP_LyraExperience);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Load: Actions (ms)"), STAT_LyraExperience_ActionsMs, STATGROUP_LyraExperience);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Load: Total (ms)"), STAT_LyraExperience_TotalMs, STATGROUP_LyraExperience);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Warm Cache Hits"), STAT_LyraExperience_WarmCacheHits, STATGROUP_LyraExperience);
+
 namespace LyraConsoleVariables
 {
 	static float ExperienceLoadRandomDelayMin = 0.0f;
@@ -131,42 +140,32 @@ void ULyraExperienceManagerComponent::StartExperienceLoad()
 
 	LoadState = ELyraExperienceLoadState::Loading;
 
+	LoadTimings = FLyraExperienceLoadTimings();
+	LoadTimings.StartTime = FPlatformTime::Seconds();
+
 	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
+	ULyraExperienceManager* ExperienceManager = GEngine->GetEngineSubsystem<ULyraExperienceManager>();
+	LoadTimings.bWasWarm = (ExperienceManager != nullptr) && ExperienceManager->IsExperienceWarm(CurrentExperience->GetPrimaryAssetId());
 
-	TSet<FPrimaryAssetId> BundleAssetList;
+	TArray<FPrimaryAssetId> BundleAssetList;
 	TSet<FSoftObjectPath> RawAssetList;
 
-	BundleAssetList.Add(CurrentExperience->GetPrimaryAssetId());
-	for (const TObjectPtr<ULyraExperienceActionSet>& ActionSet : CurrentExperience->ActionSets)
-	{
-		if (ActionSet != nullptr)
-		{
-			BundleAssetList.Add(ActionSet->GetPrimaryAssetId());
-		}
-	}
+	ULyraExperienceManager::GetBundleAssets(CurrentExperience, BundleAssetList);
 
 	// Load assets associated with the experience
 
-	TArray<FName> BundlesToLoad;
-	BundlesToLoad.Add(FLyraBundles::Equipped);
-
 	//@TODO: Centralize this client/server stuff into the LyraAssetManager
 	const ENetMode OwnerNetMode = GetOwner()->GetNetMode();
 	const bool bLoadClient = GIsEditor || (OwnerNetMode != NM_DedicatedServer);
 	const bool bLoadServer = GIsEditor || (OwnerNetMode != NM_Client);
-	if (bLoadClient)
-	{
-		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateClient);
-	}
-	if (bLoadServer)
-	{
-		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateServer);
-	}
+
+	TArray<FName> BundlesToLoad;
+	ULyraExperienceManager::GetBundlesToLoad(bLoadClient, bLoadServer, BundlesToLoad);
 
 	TSharedPtr<FStreamableHandle> BundleLoadHandle = nullptr;
 	if (BundleAssetList.Num() > 0)
 	{
-		BundleLoadHandle = AssetManager.ChangeBundleStateForPrimaryAssets(BundleAssetList.Array(), BundlesToLoad, {}, false, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+		BundleLoadHandle = AssetManager.ChangeBundleStateForPrimaryAssets(BundleAssetList, BundlesToLoad, {}, false, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
 	}
 
 	TSharedPtr<FStreamableHandle> RawLoadHandle = nullptr;
@@ -186,6 +185,12 @@ void ULyraExperienceManagerComponent::StartExperienceLoad()
 		Handle = BundleLoadHandle.IsValid() ? BundleLoadHandle : RawLoadHandle;
 	}
 
+	// Keep the bundles warm across the next match transition (bundles shared with a preloaded experience are already in memory)
+	if (ExperienceManager != nullptr)
+	{
+		ExperienceManager->OnExperienceLoadStarted(CurrentExperience->GetPrimaryAssetId(), BundleLoadHandle);
+	}
+
 	FStreamableDelegate OnAssetsLoadedDelegate = FStreamableDelegate::CreateUObject(this, &ThisClass::OnExperienceLoadComplete);
 	if (!Handle.IsValid() || Handle->HasLoadCompleted())
 	{
@@ -220,42 +225,22 @@ void ULyraExperienceManagerComponent::OnExperienceLoadComplete()
 		*CurrentExperience->GetPrimaryAssetId().ToString(),
 		*GetClientServerContextString(this));
 
-	// find the URLs for our GameFeaturePlugins - filtering out dupes and ones that don't have a valid mapping
-	GameFeaturePluginURLs.Reset();
+	LoadTimings.BundlesLoadedTime = FPlatformTime::Seconds();
 
-	auto CollectGameFeaturePluginURLs = [This=this](const UPrimaryDataAsset* Context, const TArray<FString>& FeaturePluginList)
+	// Stream in the gameplay cues used by the experience's pawns and abilities while the game features load
+	if (ULyraGameplayCueManager* GameplayCueManager = ULyraGameplayCueManager::Get())
 	{
-		for (const FString& PluginName : FeaturePluginList)
-		{
-			FString PluginURL;
-			if (UGameFeaturesSubsystem::Get().GetPluginURLByName(PluginName, /*out*/ PluginURL))
-			{
-				This->GameFeaturePluginURLs.AddUnique(PluginURL);
-			}
-			else
-			{
-				ensureMsgf(false, TEXT("OnExperienceLoadComplete failed to find plugin URL from PluginName %s for experience %s - fix data, ignoring for this run"), *PluginName, *Context->GetPrimaryAssetId().ToString());
-			}
-		}
+		GameplayCueManager->PreloadCuesForExperience(CurrentExperience);
+	}
 
-		// 		// Add in our extra plugin
-		// 		if (!CurrentPlaylistData->GameFeaturePluginToActivateUntilDownloadedContentIsPresent.IsEmpty())
-		// 		{
-		// 			FString PluginURL;
-		// 			if (UGameFeaturesSubsystem::Get().GetPluginURLByName(CurrentPlaylistData->GameFeaturePluginToActivateUntilDownloadedContentIsPresent, PluginURL))
-		// 			{
-		// 				GameFeaturePluginURLs.AddUnique(PluginURL);
-		// 			}
-		// 		}
-	};
+	// find the URLs for our GameFeaturePlugins - filtering out dupes and ones that don't have a valid mapping
+	GameFeaturePluginURLs.Reset();
+	ULyraExperienceManager::GetGameFeaturePluginURLs(CurrentExperience, /*out*/ GameFeaturePluginURLs);
 
-	CollectGameFeaturePluginURLs(CurrentExperience, CurrentExperience->GameFeaturesToEnable);
-	for (const TObjectPtr<ULyraExperienceActionSet>& ActionSet : CurrentExperience->ActionSets)
+	// Plugins kept active across the transition but not needed by this experience are released here
+	if (ULyraExperienceManager* ExperienceManager = GEngine->GetEngineSubsystem<ULyraExperienceManager>())
 	{
-		if (ActionSet != nullptr)
-		{
-			CollectGameFeaturePluginURLs(ActionSet, ActionSet->GameFeaturesToEnable);
-		}
+		ExperienceManager->OnExperiencePluginsCollected(CurrentExperience->GetPrimaryAssetId(), GameFeaturePluginURLs);
 	}
 
 	// Load and activate the features	
@@ -293,6 +278,8 @@ void ULyraExperienceManagerComponent::OnExperienceFullLoadCompleted()
 	// Insert a random delay for testing (if configured)
 	if (LoadState != ELyraExperienceLoadState::LoadingChaosTestingDelay)
 	{
+		LoadTimings.GameFeaturesLoadedTime = FPlatformTime::Seconds();
+
 		const float DelaySecs = LyraConsoleVariables::GetExperienceLoadDelayDuration();
 		if (DelaySecs > 0.0f)
 		{
@@ -306,6 +293,7 @@ void ULyraExperienceManagerComponent::OnExperienceFullLoadCompleted()
 	}
 
 	LoadState = ELyraExperienceLoadState::ExecutingActions;
+	LoadTimings.ActionsStartTime = FPlatformTime::Seconds();
 
 	// Execute the actions
 	FGameFeatureActivatingContext Context;
@@ -343,6 +331,8 @@ void ULyraExperienceManagerComponent::OnExperienceFullLoadCompleted()
 	}
 
 	LoadState = ELyraExperienceLoadState::Loaded;
+	LoadTimings.LoadedTime = FPlatformTime::Seconds();
+	ReportLoadTimings();
 
 	OnExperienceLoaded_HighPriority.Broadcast(CurrentExperience);
 	OnExperienceLoaded_HighPriority.Clear();
@@ -359,6 +349,43 @@ void ULyraExperienceManagerComponent::OnExperienceFullLoadCompleted()
 #endif
 }
 
+void ULyraExperienceManagerComponent::ReportLoadTimings() const
+{
+	const double BundlesMs = (LoadTimings.BundlesLoadedTime - LoadTimings.StartTime) * 1000.0;
+	const double GameFeaturesMs = (LoadTimings.GameFeaturesLoadedTime - LoadTimings.BundlesLoadedTime) * 1000.0;
+	const double ChaosDelayMs = (LoadTimings.ActionsStartTime - LoadTimings.GameFeaturesLoadedTime) * 1000.0;
+	const double ActionsMs = (LoadTimings.LoadedTime - LoadTimings.ActionsStartTime) * 1000.0;
+	const double TotalMs = (LoadTimings.LoadedTime - LoadTimings.StartTime) * 1000.0;
+
+	SET_FLOAT_STAT(STAT_LyraExperience_BundleLoadMs, BundlesMs);
+	SET_FLOAT_STAT(STAT_LyraExperience_GameFeatureLoadMs, GameFeaturesMs);
+	SET_FLOAT_STAT(STAT_LyraExperience_ChaosDelayMs, ChaosDelayMs);
+	SET_FLOAT_STAT(STAT_LyraExperience_ActionsMs, ActionsMs);
+	SET_FLOAT_STAT(STAT_LyraExperience_TotalMs, TotalMs);
+	if (LoadTimings.bWasWarm)
+	{
+		INC_DWORD_STAT(STAT_LyraExperience_WarmCacheHits);
+	}
+
+	UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Load phases for %s (%s, %s): Bundles=%.1fms GameFeatures=%.1fms ChaosDelay=%.1fms Actions=%.1fms Total=%.1fms"),
+		*CurrentExperience->GetPrimaryAssetId().ToString(),
+		LoadTimings.bWasWarm ? TEXT("warm") : TEXT("cold"),
+		*GetClientServerContextString(this),
+		BundlesMs, GameFeaturesMs, ChaosDelayMs, ActionsMs, TotalMs);
+}
+
+void ULyraExperienceManagerComponent::PreloadNextExperience(FPrimaryAssetId ExperienceId)
+{
+	if (ULyraExperienceManager* ExperienceManager = GEngine->GetEngineSubsystem<ULyraExperienceManager>())
+	{
+		const ENetMode OwnerNetMode = GetOwner()->GetNetMode();
+		const bool bLoadClient = GIsEditor || (OwnerNetMode != NM_DedicatedServer);
+		const bool bLoadServer = GIsEditor || (OwnerNetMode != NM_Client);
+
+		ExperienceManager->PreloadExperience(ExperienceId, bLoadClient, bLoadServer);
+	}
+}
+
 void ULyraExperienceManagerComponent::OnActionDeactivationCompleted()
 {
 	check(IsInGameThread());
@@ -381,10 +408,16 @@ void ULyraExperienceManagerComponent::EndPlay(const EEndPlayReason::Type EndPlay
 {
 	Super::EndPlay(EndPlayReason);
 
-	// deactivate any features this experience loaded
+	// deactivate any features this experience loaded, except the ones the preloaded next experience will use too
 	//@TODO: This should be handled FILO as well
+	ULyraExperienceManager* ExperienceManager = GEngine->GetEngineSubsystem<ULyraExperienceManager>();
 	for (const FString& PluginURL : GameFeaturePluginURLs)
 	{
+		if ((ExperienceManager != nullptr) && ExperienceManager->RetainActivePluginForNextExperience(PluginURL))
+		{
+			continue;
+		}
+
 		if (ULyraExperienceManager::RequestToDeactivatePlugin(PluginURL))
 		{
 			UGameFeaturesSubsystem::Get().DeactivateGameFeaturePlugin(PluginURL);
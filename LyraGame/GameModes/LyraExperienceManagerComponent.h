@@ -24,6 +24,19 @@ enum class ELyraExperienceLoadState
 	Deactivating
 };
 
+// Timestamps (FPlatformTime::Seconds) of the load phases of an experience
+struct FLyraExperienceLoadTimings
+{
+	double StartTime = 0.0;
+	double BundlesLoadedTime = 0.0;
+	double GameFeaturesLoadedTime = 0.0;
+	double ActionsStartTime = 0.0;
+	double LoadedTime = 0.0;
+
+	// Was the experience preloaded into the warm cache before it started loading?
+	bool bWasWarm = false;
+};
+
 UCLASS()
 class ULyraExperienceManagerComponent final : public UGameStateComponent, public ILoadingProcessInterface
 {
@@ -64,6 +77,13 @@ public:
 	// Returns true if the experience is fully loaded
 	bool IsExperienceLoaded() const;
 
+	// Starts loading the bundles and game feature plugins of the experience the next match will use in the background
+	// (see ULyraExperienceManager::PreloadExperience)
+	void PreloadNextExperience(FPrimaryAssetId ExperienceId);
+
+	// Returns the load phase timestamps of the current experience
+	const FLyraExperienceLoadTimings& GetLoadTimings() const { return LoadTimings; }
+
 private:
 	UFUNCTION()
 	void OnRep_CurrentExperience();
@@ -72,6 +92,7 @@ private:
 	void OnExperienceLoadComplete();
 	void OnGameFeaturePluginLoadComplete(const UE::GameFeatures::FResult& Result);
 	void OnExperienceFullLoadCompleted();
+	void ReportLoadTimings() const;
 
 	void OnActionDeactivationCompleted();
 	void OnAllActionsDeactivated();
@@ -85,6 +106,8 @@ private:
 	int32 NumGameFeaturePluginsLoading = 0;
 	TArray<FString> GameFeaturePluginURLs;
 
+	FLyraExperienceLoadTimings LoadTimings;
+
 	int32 NumObservedPausers = 0;
 	int32 NumExpectedPausers = 0;
 
@@ -11,14 +11,54 @@ ULyraInputConfig::ULyraInputConfig(const FObjectInitializer& ObjectInitializer)
 {
 }
 
-const UInputAction* ULyraInputConfig::FindNativeInputActionForTag(const FGameplayTag& InputTag, bool bLogNotFound) const
+void ULyraInputConfig::PostLoad()
 {
-	for (const FLyraInputAction& Action : NativeInputActions)
+	Super::PostLoad();
+
+	BuildInputActionLookups();
+}
+
+#if WITH_EDITOR
+void ULyraInputConfig::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	bInputActionLookupsBuilt = false;
+}
+#endif
+
+void ULyraInputConfig::BuildInputActionLookups() const
+{
+	auto BuildLookup = [](const TArray<FLyraInputAction>& Actions, TMap<FGameplayTag, const UInputAction*>& OutLookup)
 	{
-		if (Action.InputAction && (Action.InputTag == InputTag))
+		OutLookup.Reset();
+		OutLookup.Reserve(Actions.Num());
+
+		for (const FLyraInputAction& Action : Actions)
 		{
-			return Action.InputAction;
+			if (Action.InputAction && !OutLookup.Contains(Action.InputTag))
+			{
+				OutLookup.Add(Action.InputTag, Action.InputAction);
+			}
 		}
+	};
+
+	BuildLookup(NativeInputActions, NativeInputActionsByTag);
+	BuildLookup(AbilityInputActions, AbilityInputActionsByTag);
+
+	bInputActionLookupsBuilt = true;
+}
+
+const UInputAction* ULyraInputConfig::FindNativeInputActionForTag(const FGameplayTag& InputTag, bool bLogNotFound) const
+{
+	if (!bInputActionLookupsBuilt)
+	{
+		BuildInputActionLookups();
+	}
+
+	if (const UInputAction* const* InputAction = NativeInputActionsByTag.Find(InputTag))
+	{
+		return *InputAction;
 	}
 
 	if (bLogNotFound)
@@ -31,12 +71,14 @@ const UInputAction* ULyraInputConfig::FindNativeInputActionForTag(const FGamepla
 
 const UInputAction* ULyraInputConfig::FindAbilityInputActionForTag(const FGameplayTag& InputTag, bool bLogNotFound) const
 {
-	for (const FLyraInputAction& Action : AbilityInputActions)
+	if (!bInputActionLookupsBuilt)
 	{
-		if (Action.InputAction && (Action.InputTag == InputTag))
-		{
-			return Action.InputAction;
-		}
+		BuildInputActionLookups();
+	}
+
+	if (const UInputAction* const* InputAction = AbilityInputActionsByTag.Find(InputTag))
+	{
+		return *InputAction;
 	}
 
 	if (bLogNotFound)
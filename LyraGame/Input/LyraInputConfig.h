@@ -44,12 +44,23 @@ public:
 
 	ULyraInputConfig(const FObjectInitializer& ObjectInitializer);
 
+	//~UObject interface
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	//~End of UObject interface
+
 	UFUNCTION(BlueprintCallable, Category = "Lyra|Pawn")
 	const UInputAction* FindNativeInputActionForTag(const FGameplayTag& InputTag, bool bLogNotFound = true) const;
 
 	UFUNCTION(BlueprintCallable, Category = "Lyra|Pawn")
 	const UInputAction* FindAbilityInputActionForTag(const FGameplayTag& InputTag, bool bLogNotFound = true) const;
 
+private:
+	// Builds the tag lookups from the action lists, keeping the first valid action for each tag like a scan would
+	void BuildInputActionLookups() const;
+
 public:
 	// List of input actions used by the owner.  These input actions are mapped to a gameplay tag and must be manually bound.
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Meta = (TitleProperty = "InputAction"))
@@ -58,4 +69,11 @@ public:
 	// List of input actions used by the owner.  These input actions are mapped to a gameplay tag and are automatically bound to abilities with matching input tags.
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Meta = (TitleProperty = "InputAction"))
 	TArray<FLyraInputAction> AbilityInputActions;
+
+private:
+	// Tag lookups of the lists above, built on load (or on first use for configs created at runtime).
+	// The actions are kept alive by the lists.
+	mutable TMap<FGameplayTag, const UInputAction*> NativeInputActionsByTag;
+	mutable TMap<FGameplayTag, const UInputAction*> AbilityInputActionsByTag;
+	mutable bool bInputActionLookupsBuilt = false;
 };
@@ -0,0 +1,262 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Interaction/LyraInteractionRegistry.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Interaction/IInteractableTarget.h"
+#include "Interaction/InteractionStatics.h"
+#include "Physics/LyraCollisionChannels.h"
+#include "UObject/ScriptInterface.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraInteractionRegistry)
+
+namespace LyraInteractionRegistry
+{
+	static float CellSize = 1000.0f;
+	static FAutoConsoleVariableRef CVarCellSize(
+		TEXT("Lyra.Interaction.RegistryCellSize"),
+		CellSize,
+		TEXT("Edge length (cm) of the interaction registry's spatial hash cells. Read when a world starts."),
+		ECVF_Default);
+
+	// True if an overlap on the interaction channel could return this primitive within the sphere.
+	static bool PrimitiveOverlapsSphere(const UPrimitiveComponent* Primitive, const FVector& Location, float Radius)
+	{
+		if (!Primitive || !Primitive->IsRegistered() || !Primitive->IsQueryCollisionEnabled())
+		{
+			return false;
+		}
+
+		if (Primitive->GetCollisionResponseToChannel(Lyra_TraceChannel_Interaction) == ECR_Ignore)
+		{
+			return false;
+		}
+
+		// Bounds are kept up to date as the component moves, so this also covers targets that moved since they registered.
+		return FVector::DistSquared(Primitive->Bounds.Origin, Location) <= FMath::Square(Radius + Primitive->Bounds.SphereRadius);
+	}
+}
+
+void ULyraInteractionRegistry::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	CellSize = FMath::Max(LyraInteractionRegistry::CellSize, 100.0f);
+
+	if (UWorld* World = GetWorld())
+	{
+		ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::RegisterActor));
+		ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &ThisClass::UnregisterActor));
+	}
+}
+
+void ULyraInteractionRegistry::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+	}
+
+	Entries.Reset();
+	Cells.Reset();
+	MovableEntries.Reset();
+	MaxStaticBoundsRadius = 0.0f;
+	bHasUnregisteredTargets = false;
+
+	Super::Deinitialize();
+}
+
+void ULyraInteractionRegistry::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Actors placed in the level, or spawned before the spawn handler was added, register here.
+	for (TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		RegisterActor(*It);
+	}
+}
+
+void ULyraInteractionRegistry::RegisterActor(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	if (Actor->GetClass()->ImplementsInterface(UInteractableTarget::StaticClass()))
+	{
+		RegisterInteractableTarget(TScriptInterface<IInteractableTarget>(Actor));
+	}
+
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (Component && Component->GetClass()->ImplementsInterface(UInteractableTarget::StaticClass()))
+		{
+			RegisterInteractableTarget(TScriptInterface<IInteractableTarget>(Component));
+		}
+	}
+}
+
+void ULyraInteractionRegistry::UnregisterActor(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	UnregisterInteractableTarget(TScriptInterface<IInteractableTarget>(Actor));
+
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		UnregisterInteractableTarget(TScriptInterface<IInteractableTarget>(Component));
+	}
+}
+
+FIntVector ULyraInteractionRegistry::GetCell(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void ULyraInteractionRegistry::RegisterInteractableTarget(TScriptInterface<IInteractableTarget> InteractableTarget)
+{
+	UObject* Object = InteractableTarget.GetObject();
+	AActor* Actor = UInteractionStatics::GetActorFromInteractableTarget(InteractableTarget);
+	if (!Object || !Actor)
+	{
+		return;
+	}
+
+	const FObjectKey Key(Object);
+	UnregisterInteractableTarget(InteractableTarget);
+
+	FVector Origin;
+	FVector Extent;
+	Actor->GetActorBounds(/*bOnlyCollidingComponents=*/ true, Origin, Extent);
+
+	const USceneComponent* RootComponent = Actor->GetRootComponent();
+
+	FRegisteredInteractable& Entry = Entries.Add(Key);
+	Entry.Object = Object;
+	Entry.Actor = Actor;
+	Entry.Location = Actor->GetActorLocation();
+	Entry.BoundsRadius = Extent.Size() + FVector::Dist(Origin, Entry.Location);
+	Entry.bMovable = !RootComponent || (RootComponent->Mobility != EComponentMobility::Static);
+
+	if (Entry.bMovable)
+	{
+		MovableEntries.Add(Key);
+	}
+	else
+	{
+		Entry.Cell = GetCell(Entry.Location);
+		Cells.FindOrAdd(Entry.Cell).Add(Key);
+
+		MaxStaticBoundsRadius = FMath::Max(MaxStaticBoundsRadius, Entry.BoundsRadius);
+	}
+}
+
+void ULyraInteractionRegistry::UnregisterInteractableTarget(TScriptInterface<IInteractableTarget> InteractableTarget)
+{
+	const FObjectKey Key(InteractableTarget.GetObject());
+
+	FRegisteredInteractable Entry;
+	if (!Entries.RemoveAndCopyValue(Key, Entry))
+	{
+		return;
+	}
+
+	if (Entry.bMovable)
+	{
+		MovableEntries.RemoveSingleSwap(Key);
+	}
+	else if (TArray<FObjectKey>* CellEntries = Cells.Find(Entry.Cell))
+	{
+		CellEntries->RemoveSingleSwap(Key);
+		if (CellEntries->Num() == 0)
+		{
+			Cells.Remove(Entry.Cell);
+		}
+	}
+}
+
+bool ULyraInteractionRegistry::Overlaps(const FRegisteredInteractable& Entry, const FVector& Location, float Radius) const
+{
+	const UObject* Object = Entry.Object.Get();
+	const AActor* Actor = Entry.Actor.Get();
+	if (!Object || !Actor)
+	{
+		return false;
+	}
+
+	// An overlap only returns an interactable component when that component is the one overlapping, so components have to
+	// respond to the interaction channel themselves, while an interactable actor counts if any of its primitives does.
+	if (Object != Actor)
+	{
+		return LyraInteractionRegistry::PrimitiveOverlapsSphere(Cast<UPrimitiveComponent>(Object), Location, Radius);
+	}
+
+	bool bOverlaps = false;
+	Actor->ForEachComponent<UPrimitiveComponent>(/*bIncludeFromChildActors=*/ false, [&bOverlaps, &Location, Radius](const UPrimitiveComponent* Primitive)
+	{
+		bOverlaps = bOverlaps || LyraInteractionRegistry::PrimitiveOverlapsSphere(Primitive, Location, Radius);
+	});
+
+	return bOverlaps;
+}
+
+void ULyraInteractionRegistry::AppendTarget(const FRegisteredInteractable& Entry, TArray<TScriptInterface<IInteractableTarget>>& OutInteractableTargets) const
+{
+	TScriptInterface<IInteractableTarget> InteractableTarget(Entry.Object.Get());
+	if (InteractableTarget)
+	{
+		OutInteractableTargets.AddUnique(InteractableTarget);
+	}
+}
+
+int32 ULyraInteractionRegistry::QueryInteractableTargets(const FVector& Location, float Radius, TArray<TScriptInterface<IInteractableTarget>>& OutInteractableTargets) const
+{
+	const int32 StartNum = OutInteractableTargets.Num();
+
+	// Static targets are hashed by their location, so grow the sphere by the largest static bounds to catch big ones.
+	const float CellQueryRadius = Radius + MaxStaticBoundsRadius;
+	const FIntVector MinCell = GetCell(Location - FVector(CellQueryRadius));
+	const FIntVector MaxCell = GetCell(Location + FVector(CellQueryRadius));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				if (const TArray<FObjectKey>* CellEntries = Cells.Find(FIntVector(X, Y, Z)))
+				{
+					for (const FObjectKey& Key : *CellEntries)
+					{
+						const FRegisteredInteractable& Entry = Entries.FindChecked(Key);
+						if (Overlaps(Entry, Location, Radius))
+						{
+							AppendTarget(Entry, OutInteractableTargets);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	for (const FObjectKey& Key : MovableEntries)
+	{
+		const FRegisteredInteractable& Entry = Entries.FindChecked(Key);
+		if (Overlaps(Entry, Location, Radius))
+		{
+			AppendTarget(Entry, OutInteractableTargets);
+		}
+	}
+
+	return OutInteractableTargets.Num() - StartNum;
+}
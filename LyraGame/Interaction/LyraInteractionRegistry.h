@@ -0,0 +1,109 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "LyraInteractionRegistry.generated.h"
+
+template <typename InterfaceType> class TScriptInterface;
+
+class AActor;
+class IInteractableTarget;
+class UObject;
+
+/**
+ * ULyraInteractionRegistry
+ *
+ *	World-wide list of interactable targets, bucketed in a uniform spatial hash so nearby-interaction scans only look at
+ *	the cells around the scanning pawn instead of running a physics overlap.
+ *
+ *	Every actor implementing IInteractableTarget, and every interactable component of an actor, is registered when the
+ *	world begins play or when the actor spawns, and unregistered when it is destroyed. Targets whose root component is
+ *	not static are kept out of the hash and distance-checked on every query, there should be few of them.
+ *
+ *	Candidates from the hash are checked against the current bounds of their primitives, and only primitives that respond
+ *	to Lyra_TraceChannel_Interaction count, so a query returns what the physics overlap it replaces would have.
+ *
+ *	Interactable components added to an actor after it spawned are not picked up. Worlds that have them either register
+ *	them explicitly or flag themselves with SetHasUnregisteredTargets so scans fall back to a physics overlap.
+ */
+UCLASS(BlueprintType)
+class ULyraInteractionRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~UWorldSubsystem interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~End of UWorldSubsystem interface
+
+	// Adds an interactable target (an actor or a component of one) to the registry.
+	void RegisterInteractableTarget(TScriptInterface<IInteractableTarget> InteractableTarget);
+
+	// Removes an interactable target from the registry.
+	void UnregisterInteractableTarget(TScriptInterface<IInteractableTarget> InteractableTarget);
+
+	// Appends every registered target with a primitive responding to the interaction channel whose bounds intersect the sphere. Returns the number of targets appended.
+	int32 QueryInteractableTargets(const FVector& Location, float Radius, TArray<TScriptInterface<IInteractableTarget>>& OutInteractableTargets) const;
+
+	int32 GetNumRegisteredTargets() const { return Entries.Num(); }
+
+	// Flags this world as having interactable targets the registry does not know about, nearby scans then also run a physics overlap.
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Interaction")
+	void SetHasUnregisteredTargets(bool bInHasUnregisteredTargets) { bHasUnregisteredTargets = bInHasUnregisteredTargets; }
+
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Interaction")
+	bool HasUnregisteredTargets() const { return bHasUnregisteredTargets; }
+
+private:
+
+	struct FRegisteredInteractable
+	{
+		TWeakObjectPtr<UObject> Object;
+		TWeakObjectPtr<AActor> Actor;
+		FVector Location = FVector::ZeroVector;
+		float BoundsRadius = 0.0f;
+		FIntVector Cell = FIntVector::ZeroValue;
+		bool bMovable = false;
+	};
+
+	// Registers the actor and its components if they are interactable targets.
+	void RegisterActor(AActor* Actor);
+	void UnregisterActor(AActor* Actor);
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	// True if the target's primitives responding to the interaction channel reach the sphere, using their current bounds.
+	bool Overlaps(const FRegisteredInteractable& Entry, const FVector& Location, float Radius) const;
+
+	void AppendTarget(const FRegisteredInteractable& Entry, TArray<TScriptInterface<IInteractableTarget>>& OutInteractableTargets) const;
+
+private:
+
+	// Edge length of a hash cell, fixed for the lifetime of the world.
+	float CellSize = 1000.0f;
+
+	TMap<FObjectKey, FRegisteredInteractable> Entries;
+
+	// Static targets by cell.
+	TMap<FIntVector, TArray<FObjectKey>> Cells;
+
+	// Targets that may move, checked individually.
+	TArray<FObjectKey> MovableEntries;
+
+	// Largest bounds radius of any static target registered so far, queries grow by it.
+	float MaxStaticBoundsRadius = 0.0f;
+
+	bool bHasUnregisteredTargets = false;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+};
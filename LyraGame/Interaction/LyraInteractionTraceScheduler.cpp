@@ -0,0 +1,119 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Interaction/LyraInteractionTraceScheduler.h"
+
+#include "Engine/HitResult.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraInteractionTraceScheduler)
+
+namespace LyraInteractionTraceScheduler
+{
+	static int32 MaxTracesPerFrame = 0;
+	static FAutoConsoleVariableRef CVarMaxTracesPerFrame(
+		TEXT("Lyra.Interaction.MaxTracesPerFrame"),
+		MaxTracesPerFrame,
+		TEXT("Maximum number of interaction traces issued per frame, the rest wait for the next frame. 0 means no limit."),
+		ECVF_Default);
+}
+
+void ULyraInteractionTraceScheduler::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	StatsStartTime = FPlatformTime::Seconds();
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::HandlePostActorTick);
+}
+
+void ULyraInteractionTraceScheduler::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	QueuedTraces.Reset();
+	TracesInFlight.Reset();
+
+	Super::Deinitialize();
+}
+
+void ULyraInteractionTraceScheduler::RequestLineTrace(const FVector& Start, const FVector& End, FName ProfileName, const FCollisionQueryParams& Params, FLyraInteractionTraceComplete OnComplete)
+{
+	FQueuedTrace& QueuedTrace = QueuedTraces.AddDefaulted_GetRef();
+	QueuedTrace.Start = Start;
+	QueuedTrace.End = End;
+	QueuedTrace.ProfileName = ProfileName;
+	QueuedTrace.Params = Params;
+	QueuedTrace.OnComplete = MoveTemp(OnComplete);
+}
+
+void ULyraInteractionTraceScheduler::HandlePostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if ((InWorld != GetWorld()) || (QueuedTraces.Num() == 0))
+	{
+		return;
+	}
+
+	const int32 NumToIssue = (LyraInteractionTraceScheduler::MaxTracesPerFrame > 0) ? FMath::Min(QueuedTraces.Num(), LyraInteractionTraceScheduler::MaxTracesPerFrame) : QueuedTraces.Num();
+
+	const FTraceDelegate TraceDelegate = FTraceDelegate::CreateUObject(this, &ThisClass::HandleTraceCompleted);
+	for (int32 TraceIndex = 0; TraceIndex < NumToIssue; ++TraceIndex)
+	{
+		FQueuedTrace& QueuedTrace = QueuedTraces[TraceIndex];
+
+		const uint32 TraceId = NextTraceId++;
+		TracesInFlight.Add(TraceId, MoveTemp(QueuedTrace.OnComplete));
+
+		InWorld->AsyncLineTraceByProfile(EAsyncTraceType::Multi, QueuedTrace.Start, QueuedTrace.End, QueuedTrace.ProfileName, QueuedTrace.Params, &TraceDelegate, TraceId);
+	}
+
+	QueuedTraces.RemoveAt(0, NumToIssue, EAllowShrinking::No);
+
+	NumTracesIssued += NumToIssue;
+	MaxTracesInFrame = FMath::Max(MaxTracesInFrame, NumToIssue);
+}
+
+void ULyraInteractionTraceScheduler::HandleTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FLyraInteractionTraceComplete OnComplete;
+	if (!TracesInFlight.RemoveAndCopyValue(TraceDatum.UserData, OnComplete))
+	{
+		return;
+	}
+
+	FHitResult HitResult;
+	HitResult.TraceStart = TraceDatum.Start;
+	HitResult.TraceEnd = TraceDatum.End;
+
+	if (TraceDatum.OutHits.Num() > 0)
+	{
+		HitResult = TraceDatum.OutHits[0];
+	}
+
+	OnComplete.ExecuteIfBound(HitResult);
+}
+
+void ULyraInteractionTraceScheduler::DumpStats(FOutputDevice& Ar)
+{
+	const double Now = FPlatformTime::Seconds();
+	const double Elapsed = FMath::Max(Now - StatsStartTime, UE_SMALL_NUMBER);
+
+	Ar.Logf(TEXT("Interaction traces over %.1f s: %lld issued async (%.1f/s, at most %d in one frame), %lld camera traces skipped (%.1f/s), %d queued, %d in flight"),
+		Elapsed, NumTracesIssued, NumTracesIssued / Elapsed, MaxTracesInFrame, NumCameraTracesSkipped, NumCameraTracesSkipped / Elapsed, QueuedTraces.Num(), TracesInFlight.Num());
+
+	StatsStartTime = Now;
+	NumTracesIssued = 0;
+	NumCameraTracesSkipped = 0;
+	MaxTracesInFrame = 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+static FAutoConsoleCommandWithWorldAndArgs DumpInteractionTraceStatsCommand(
+	TEXT("Lyra.Interaction.DumpTraceStats"),
+	TEXT("Prints how many interaction traces were issued and how many camera traces were skipped, then restarts the measurement."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (ULyraInteractionTraceScheduler* TraceScheduler = UWorld::GetSubsystem<ULyraInteractionTraceScheduler>(World))
+		{
+			TraceScheduler->DumpStats(*GLog);
+		}
+	}));
@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CollisionQueryParams.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+
+#include "LyraInteractionTraceScheduler.generated.h"
+
+class FOutputDevice;
+struct FHitResult;
+
+DECLARE_DELEGATE_OneParam(FLyraInteractionTraceComplete, const FHitResult& /*HitResult*/);
+
+/**
+ * ULyraInteractionTraceScheduler
+ *
+ *	Collects the interaction line traces requested during a frame and issues them together as async traces once all
+ *	actors have ticked, so interaction probes never block the game thread. Results are delivered the next frame with
+ *	the first hit, the same result the synchronous UAbilityTask_WaitForInteractableTargets::LineTrace returns.
+ */
+UCLASS()
+class ULyraInteractionTraceScheduler : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	// Queues a line trace, OnComplete is executed (if still bound) once the result is available.
+	void RequestLineTrace(const FVector& Start, const FVector& End, FName ProfileName, const FCollisionQueryParams& Params, FLyraInteractionTraceComplete OnComplete);
+
+	// Counts a camera trace the caller did not need because the view had not moved.
+	void NotifyCameraTraceSkipped() { ++NumCameraTracesSkipped; }
+
+	// Prints the traces issued and skipped since the last call, then restarts the measurement.
+	void DumpStats(FOutputDevice& Ar);
+
+private:
+
+	void HandlePostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	void HandleTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+private:
+
+	struct FQueuedTrace
+	{
+		FVector Start;
+		FVector End;
+		FName ProfileName;
+		FCollisionQueryParams Params;
+		FLyraInteractionTraceComplete OnComplete;
+	};
+
+	TArray<FQueuedTrace> QueuedTraces;
+
+	// Completion delegates of the traces in flight, keyed by the trace's user data.
+	TMap<uint32, FLyraInteractionTraceComplete> TracesInFlight;
+
+	uint32 NextTraceId = 0;
+
+	FDelegateHandle PostActorTickHandle;
+
+	// Stats since StatsStartTime
+	double StatsStartTime = 0.0;
+	int64 NumTracesIssued = 0;
+	int64 NumCameraTracesSkipped = 0;
+	int32 MaxTracesInFrame = 0;
+};
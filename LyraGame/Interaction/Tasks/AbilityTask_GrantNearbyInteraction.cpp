@@ -6,15 +6,30 @@
 #include "Engine/OverlapResult.h"
 #include "Engine/World.h"
 #include "GameFramework/Controller.h"
+#include "HAL/IConsoleManager.h"
 #include "Interaction/IInteractableTarget.h"
 #include "Interaction/InteractionOption.h"
 #include "Interaction/InteractionQuery.h"
 #include "Interaction/InteractionStatics.h"
+#include "Interaction/LyraInteractionRegistry.h"
 #include "Physics/LyraCollisionChannels.h"
 #include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AbilityTask_GrantNearbyInteraction)
 
+namespace LyraNearbyInteraction
+{
+	static int32 ScanMode = 1;
+	static FAutoConsoleVariableRef CVarScanMode(
+		TEXT("Lyra.Interaction.NearbyScanMode"),
+		ScanMode,
+		TEXT("How nearby interactables are found.\n")
+		TEXT("0: blocking physics overlap every scan (legacy)\n")
+		TEXT("1: interaction registry, plus an async physics overlap in worlds flagged with ULyraInteractionRegistry::SetHasUnregisteredTargets (default)\n")
+		TEXT("2: interaction registry only, no physics"),
+		ECVF_Default);
+}
+
 UAbilityTask_GrantNearbyInteraction::UAbilityTask_GrantNearbyInteraction(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -53,43 +68,112 @@ void UAbilityTask_GrantNearbyInteraction::QueryInteractables()
 	
 	if (World && ActorOwner)
 	{
-		FCollisionQueryParams Params(SCENE_QUERY_STAT(UAbilityTask_GrantNearbyInteraction), false);
-
-		TArray<FOverlapResult> OverlapResults;
-		World->OverlapMultiByChannel(OUT OverlapResults, ActorOwner->GetActorLocation(), FQuat::Identity, Lyra_TraceChannel_Interaction, FCollisionShape::MakeSphere(InteractionScanRange), Params);
+		const FVector ScanLocation = ActorOwner->GetActorLocation();
+		const ULyraInteractionRegistry* Registry = World->GetSubsystem<ULyraInteractionRegistry>();
 
-		if (OverlapResults.Num() > 0)
+		if ((LyraNearbyInteraction::ScanMode == 0) || !Registry)
 		{
+			FCollisionQueryParams Params(SCENE_QUERY_STAT(UAbilityTask_GrantNearbyInteraction), false);
+
+			TArray<FOverlapResult> OverlapResults;
+			World->OverlapMultiByChannel(OUT OverlapResults, ScanLocation, FQuat::Identity, Lyra_TraceChannel_Interaction, FCollisionShape::MakeSphere(InteractionScanRange), Params);
+
 			TArray<TScriptInterface<IInteractableTarget>> InteractableTargets;
 			UInteractionStatics::AppendInteractableTargetsFromOverlapResults(OverlapResults, OUT InteractableTargets);
-			
-			FInteractionQuery InteractionQuery;
-			InteractionQuery.RequestingAvatar = ActorOwner;
-			InteractionQuery.RequestingController = Cast<AController>(ActorOwner->GetOwner());
-
-			TArray<FInteractionOption> Options;
-			for (TScriptInterface<IInteractableTarget>& InteractiveTarget : InteractableTargets)
+			UpdateNearbyTargets(InteractableTargets);
+		}
+		else if ((LyraNearbyInteraction::ScanMode == 1) && Registry->HasUnregisteredTargets())
+		{
+			// The registry is read when the overlap completes, so both describe the same moment.
+			if (World->IsTraceHandleValid(PendingOverlapHandle, /*bOverlapTrace=*/ true))
 			{
-				FInteractionOptionBuilder InteractionBuilder(InteractiveTarget, Options);
-				InteractiveTarget->GatherInteractionOptions(InteractionQuery, InteractionBuilder);
+				return;
 			}
 
-			// Check if any of the options need to grant the ability to the user before they can be used.
-			for (FInteractionOption& Option : Options)
+			FCollisionQueryParams Params(SCENE_QUERY_STAT(UAbilityTask_GrantNearbyInteraction), false);
+			FOverlapDelegate OverlapDelegate = FOverlapDelegate::CreateUObject(this, &ThisClass::HandleOverlapCompleted);
+			PendingOverlapHandle = World->AsyncOverlapByChannel(ScanLocation, FQuat::Identity, Lyra_TraceChannel_Interaction, FCollisionShape::MakeSphere(InteractionScanRange), Params, FCollisionResponseParams::DefaultResponseParam, &OverlapDelegate);
+		}
+		else
+		{
+			TArray<TScriptInterface<IInteractableTarget>> InteractableTargets;
+			Registry->QueryInteractableTargets(ScanLocation, InteractionScanRange, OUT InteractableTargets);
+			UpdateNearbyTargets(InteractableTargets);
+		}
+	}
+}
+
+void UAbilityTask_GrantNearbyInteraction::HandleOverlapCompleted(const FTraceHandle& TraceHandle, FOverlapDatum& OverlapDatum)
+{
+	PendingOverlapHandle = FTraceHandle();
+
+	UWorld* World = GetWorld();
+	AActor* ActorOwner = GetAvatarActor();
+
+	if (World && ActorOwner && !IsFinished())
+	{
+		TArray<TScriptInterface<IInteractableTarget>> InteractableTargets;
+		if (const ULyraInteractionRegistry* Registry = World->GetSubsystem<ULyraInteractionRegistry>())
+		{
+			Registry->QueryInteractableTargets(OverlapDatum.Pos, InteractionScanRange, OUT InteractableTargets);
+		}
+
+		UInteractionStatics::AppendInteractableTargetsFromOverlapResults(OverlapDatum.OutOverlaps, OUT InteractableTargets);
+		UpdateNearbyTargets(InteractableTargets);
+	}
+}
+
+void UAbilityTask_GrantNearbyInteraction::UpdateNearbyTargets(const TArray<TScriptInterface<IInteractableTarget>>& InteractableTargets)
+{
+	AActor* ActorOwner = GetAvatarActor();
+
+	// Only targets that just came into range need their options gathered, the others were handled when they entered.
+	TSet<FObjectKey> NewNearbyTargets;
+	NewNearbyTargets.Reserve(InteractableTargets.Num());
+
+	TArray<TScriptInterface<IInteractableTarget>> EnteredTargets;
+	for (const TScriptInterface<IInteractableTarget>& InteractableTarget : InteractableTargets)
+	{
+		const FObjectKey TargetKey(InteractableTarget.GetObject());
+		NewNearbyTargets.Add(TargetKey);
+
+		if (!NearbyTargets.Contains(TargetKey))
+		{
+			EnteredTargets.Add(InteractableTarget);
+		}
+	}
+
+	NearbyTargets = MoveTemp(NewNearbyTargets);
+
+	if ((EnteredTargets.Num() == 0) || !ActorOwner)
+	{
+		return;
+	}
+
+	FInteractionQuery InteractionQuery;
+	InteractionQuery.RequestingAvatar = ActorOwner;
+	InteractionQuery.RequestingController = Cast<AController>(ActorOwner->GetOwner());
+
+	TArray<FInteractionOption> Options;
+	for (TScriptInterface<IInteractableTarget>& InteractiveTarget : EnteredTargets)
+	{
+		FInteractionOptionBuilder InteractionBuilder(InteractiveTarget, Options);
+		InteractiveTarget->GatherInteractionOptions(InteractionQuery, InteractionBuilder);
+	}
+
+	// Check if any of the options need to grant the ability to the user before they can be used.
+	for (FInteractionOption& Option : Options)
+	{
+		if (Option.InteractionAbilityToGrant)
+		{
+			// Grant the ability to the GAS, otherwise it won't be able to do whatever the interaction is.
+			FObjectKey ObjectKey(Option.InteractionAbilityToGrant);
+			if (!InteractionAbilityCache.Find(ObjectKey))
 			{
-				if (Option.InteractionAbilityToGrant)
-				{
-					// Grant the ability to the GAS, otherwise it won't be able to do whatever the interaction is.
-					FObjectKey ObjectKey(Option.InteractionAbilityToGrant);
-					if (!InteractionAbilityCache.Find(ObjectKey))
-					{
-						FGameplayAbilitySpec Spec(Option.InteractionAbilityToGrant, 1, INDEX_NONE, this);
-						FGameplayAbilitySpecHandle Handle = AbilitySystemComponent->GiveAbility(Spec);
-						InteractionAbilityCache.Add(ObjectKey, Handle);
-					}
-				}
+				FGameplayAbilitySpec Spec(Option.InteractionAbilityToGrant, 1, INDEX_NONE, this);
+				FGameplayAbilitySpecHandle Handle = AbilitySystemComponent->GiveAbility(Spec);
+				InteractionAbilityCache.Add(ObjectKey, Handle);
 			}
 		}
 	}
 }
-
@@ -2,14 +2,18 @@
 #pragma once
 
 #include "Abilities/Tasks/AbilityTask.h"
+#include "UObject/ObjectKey.h"
+#include "WorldCollision.h"
 
 #include "AbilityTask_GrantNearbyInteraction.generated.h"
 
+template <typename InterfaceType> class TScriptInterface;
+
+class IInteractableTarget;
 class UGameplayAbility;
 class UObject;
 struct FFrame;
 struct FGameplayAbilitySpecHandle;
-struct FObjectKey;
 
 UCLASS()
 class UAbilityTask_GrantNearbyInteraction : public UAbilityTask
@@ -28,10 +32,21 @@ private:
 
 	void QueryInteractables();
 
+	void HandleOverlapCompleted(const FTraceHandle& TraceHandle, FOverlapDatum& OverlapDatum);
+
+	/** Grants the interaction abilities of the targets that were not nearby during the previous scan. */
+	void UpdateNearbyTargets(const TArray<TScriptInterface<IInteractableTarget>>& InteractableTargets);
+
 	float InteractionScanRange = 100;
 	float InteractionScanRate = 0.100;
 
 	FTimerHandle QueryTimerHandle;
 
+	/** Async overlap in flight, scans are skipped until it completes */
+	FTraceHandle PendingOverlapHandle;
+
+	/** Targets found by the previous scan */
+	TSet<FObjectKey> NearbyTargets;
+
 	TMap<FObjectKey, FGameplayAbilitySpecHandle> InteractionAbilityCache;
 };
@@ -56,6 +56,11 @@ void UAbilityTask_WaitForInteractableTargets::AimWithPlayerController(const AAct
 	FHitResult HitResult;
 	LineTrace(HitResult, InSourceActor->GetWorld(), ViewStart, ViewEnd, TraceProfile.Name, Params);
 
+	OutTraceEnd = ComputeAimTraceEnd(HitResult, ViewDir, ViewEnd, TraceStart, MaxRange);
+}
+
+FVector UAbilityTask_WaitForInteractableTargets::ComputeAimTraceEnd(const FHitResult& HitResult, const FVector& ViewDir, const FVector& ViewEnd, const FVector& TraceStart, float MaxRange) const
+{
 	const bool bUseTraceResult = HitResult.bBlockingHit && (FVector::DistSquared(TraceStart, HitResult.Location) <= (MaxRange * MaxRange));
 
 	const FVector AdjustedEnd = (bUseTraceResult) ? HitResult.Location : ViewEnd;
@@ -82,7 +87,7 @@ void UAbilityTask_WaitForInteractableTargets::AimWithPlayerController(const AAct
 		}
 	}
 
-	OutTraceEnd = TraceStart + (AdjustedAimDir * MaxRange);
+	return TraceStart + (AdjustedAimDir * MaxRange);
 }
 
 bool UAbilityTask_WaitForInteractableTargets::ClipCameraRayToAbilityRange(FVector CameraLocation, FVector CameraDirection, FVector AbilityCenter, float AbilityRange, FVector& ClippedPosition)
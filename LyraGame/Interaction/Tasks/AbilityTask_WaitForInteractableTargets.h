@@ -33,6 +33,9 @@ protected:
 
 	void AimWithPlayerController(const AActor* InSourceActor, FCollisionQueryParams Params, const FVector& TraceStart, float MaxRange, FVector& OutTraceEnd, bool bIgnorePitch = false) const;
 
+	/** Returns the end of the interaction trace given the result of the camera trace from ViewStart to ViewEnd (second half of AimWithPlayerController) */
+	FVector ComputeAimTraceEnd(const FHitResult& HitResult, const FVector& ViewDir, const FVector& ViewEnd, const FVector& TraceStart, float MaxRange) const;
+
 	static bool ClipCameraRayToAbilityRange(FVector CameraLocation, FVector CameraDirection, FVector AbilityCenter, float AbilityRange, FVector& ClippedPosition);
 
 	void UpdateInteractableOptions(const FInteractionQuery& InteractQuery, const TArray<TScriptInterface<IInteractableTarget>>& InteractableTargets);
@@ -2,12 +2,39 @@
 
 #include "AbilityTask_WaitForInteractableTargets_SingleLineTrace.h"
 #include "Interaction/InteractionStatics.h"
+#include "Interaction/LyraInteractionTraceScheduler.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
 #include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AbilityTask_WaitForInteractableTargets_SingleLineTrace)
 
+namespace LyraInteractionTrace
+{
+	static bool bAsyncTraces = true;
+	static FAutoConsoleVariableRef CVarAsyncTraces(
+		TEXT("Lyra.Interaction.AsyncTraces"),
+		bAsyncTraces,
+		TEXT("If set, interaction scans go through the shared async trace scheduler instead of two blocking traces."),
+		ECVF_Default);
+
+	static float CameraTraceReuseDistance = 2.0f;
+	static FAutoConsoleVariableRef CVarCameraTraceReuseDistance(
+		TEXT("Lyra.Interaction.CameraTraceReuseDistance"),
+		CameraTraceReuseDistance,
+		TEXT("The camera trace is skipped while the view has moved less than this (cm) since the last one."),
+		ECVF_Default);
+
+	static float CameraTraceReuseAngle = 0.5f;
+	static FAutoConsoleVariableRef CVarCameraTraceReuseAngle(
+		TEXT("Lyra.Interaction.CameraTraceReuseAngle"),
+		CameraTraceReuseAngle,
+		TEXT("The camera trace is skipped while the view has turned less than this (degrees) since the last one."),
+		ECVF_Default);
+}
+
 UAbilityTask_WaitForInteractableTargets_SingleLineTrace::UAbilityTask_WaitForInteractableTargets_SingleLineTrace(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -44,6 +71,18 @@ void UAbilityTask_WaitForInteractableTargets_SingleLineTrace::OnDestroy(bool Abi
 	Super::OnDestroy(AbilityEnded);
 }
 
+FCollisionQueryParams UAbilityTask_WaitForInteractableTargets_SingleLineTrace::MakeQueryParams(AActor* AvatarActor) const
+{
+	TArray<AActor*> ActorsToIgnore;
+	ActorsToIgnore.Add(AvatarActor);
+
+	const bool bTraceComplex = false;
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(UAbilityTask_WaitForInteractableTargets_SingleLineTrace), bTraceComplex);
+	Params.AddIgnoredActors(ActorsToIgnore);
+
+	return Params;
+}
+
 void UAbilityTask_WaitForInteractableTargets_SingleLineTrace::PerformTrace()
 {
 	AActor* AvatarActor = Ability->GetCurrentActorInfo()->AvatarActor.Get();
@@ -52,14 +91,104 @@ void UAbilityTask_WaitForInteractableTargets_SingleLineTrace::PerformTrace()
 		return;
 	}
 
-	UWorld* World = GetWorld();
+	ULyraInteractionTraceScheduler* TraceScheduler = GetWorld()->GetSubsystem<ULyraInteractionTraceScheduler>();
+	if (!LyraInteractionTrace::bAsyncTraces || !TraceScheduler)
+	{
+		PerformTraceBlocking(AvatarActor);
+		return;
+	}
 
-	TArray<AActor*> ActorsToIgnore;
-	ActorsToIgnore.Add(AvatarActor);
+	// The previous scan's results have not arrived yet.
+	if (bTraceInFlight)
+	{
+		return;
+	}
 
-	const bool bTraceComplex = false;
-	FCollisionQueryParams Params(SCENE_QUERY_STAT(UAbilityTask_WaitForInteractableTargets_SingleLineTrace), bTraceComplex);
-	Params.AddIgnoredActors(ActorsToIgnore);
+	//@TODO: Bots?
+	APlayerController* PC = Ability->GetCurrentActorInfo()->PlayerController.Get();
+	check(PC);
+
+	FVector ViewStart;
+	FRotator ViewRot;
+	PC->GetPlayerViewPoint(ViewStart, ViewRot);
+
+	bTraceInFlight = true;
+
+	// Only the interaction trace is needed while the view stays where the aim direction was computed from.
+	if (bHasCachedAim
+		&& (FVector::DistSquared(ViewStart, CachedViewLocation) <= FMath::Square(LyraInteractionTrace::CameraTraceReuseDistance))
+		&& (ViewRot.GetManhattanDistance(CachedViewRotation) <= LyraInteractionTrace::CameraTraceReuseAngle))
+	{
+		TraceScheduler->NotifyCameraTraceSkipped();
+		RequestInteractionTrace(AvatarActor);
+		return;
+	}
+
+	const FVector TraceStart = StartLocation.GetTargetingTransform().GetLocation();
+	const FVector ViewDir = ViewRot.Vector();
+	FVector ViewEnd = ViewStart + (ViewDir * InteractionScanRange);
+
+	ClipCameraRayToAbilityRange(ViewStart, ViewDir, TraceStart, InteractionScanRange, ViewEnd);
+
+	TraceScheduler->RequestLineTrace(ViewStart, ViewEnd, TraceProfile.Name, MakeQueryParams(AvatarActor),
+		FLyraInteractionTraceComplete::CreateUObject(this, &ThisClass::HandleCameraTraceCompleted, ViewStart, ViewRot, ViewEnd));
+}
+
+void UAbilityTask_WaitForInteractableTargets_SingleLineTrace::HandleCameraTraceCompleted(const FHitResult& HitResult, FVector ViewLocation, FRotator ViewRotation, FVector ViewEnd)
+{
+	AActor* AvatarActor = Ability ? Ability->GetCurrentActorInfo()->AvatarActor.Get() : nullptr;
+	if (!AvatarActor || IsFinished())
+	{
+		bTraceInFlight = false;
+		return;
+	}
+
+	// Keep the aim as a direction, the trace start follows the avatar while the camera trace is being reused.
+	const FVector TraceStart = StartLocation.GetTargetingTransform().GetLocation();
+	const FVector TraceEnd = ComputeAimTraceEnd(HitResult, ViewRotation.Vector(), ViewEnd, TraceStart, InteractionScanRange);
+
+	bHasCachedAim = true;
+	CachedViewLocation = ViewLocation;
+	CachedViewRotation = ViewRotation;
+	CachedAimDir = (TraceEnd - TraceStart).GetSafeNormal();
+
+	RequestInteractionTrace(AvatarActor);
+}
+
+void UAbilityTask_WaitForInteractableTargets_SingleLineTrace::RequestInteractionTrace(AActor* AvatarActor)
+{
+	ULyraInteractionTraceScheduler* TraceScheduler = GetWorld()->GetSubsystem<ULyraInteractionTraceScheduler>();
+	check(TraceScheduler);
+
+	const FVector TraceStart = StartLocation.GetTargetingTransform().GetLocation();
+	const FVector TraceEnd = TraceStart + (CachedAimDir * InteractionScanRange);
+
+	TraceScheduler->RequestLineTrace(TraceStart, TraceEnd, TraceProfile.Name, MakeQueryParams(AvatarActor),
+		FLyraInteractionTraceComplete::CreateUObject(this, &ThisClass::HandleInteractionTraceCompleted));
+}
+
+void UAbilityTask_WaitForInteractableTargets_SingleLineTrace::HandleInteractionTraceCompleted(const FHitResult& HitResult)
+{
+	bTraceInFlight = false;
+
+	if (IsFinished())
+	{
+		return;
+	}
+
+	TArray<TScriptInterface<IInteractableTarget>> InteractableTargets;
+	UInteractionStatics::AppendInteractableTargetsFromHitResult(HitResult, InteractableTargets);
+
+	UpdateInteractableOptions(InteractionQuery, InteractableTargets);
+
+	ShowDebugTrace(HitResult, HitResult.TraceStart, HitResult.TraceEnd);
+}
+
+void UAbilityTask_WaitForInteractableTargets_SingleLineTrace::PerformTraceBlocking(AActor* AvatarActor)
+{
+	UWorld* World = GetWorld();
+
+	FCollisionQueryParams Params = MakeQueryParams(AvatarActor);
 
 	FVector TraceStart = StartLocation.GetTargetingTransform().GetLocation();
 	FVector TraceEnd;
@@ -73,9 +202,16 @@ void UAbilityTask_WaitForInteractableTargets_SingleLineTrace::PerformTrace()
 
 	UpdateInteractableOptions(InteractionQuery, InteractableTargets);
 
+	ShowDebugTrace(OutHitResult, TraceStart, TraceEnd);
+}
+
+void UAbilityTask_WaitForInteractableTargets_SingleLineTrace::ShowDebugTrace(const FHitResult& OutHitResult, const FVector& TraceStart, const FVector& TraceEnd) const
+{
 #if ENABLE_DRAW_DEBUG
 	if (bShowDebug)
 	{
+		UWorld* World = GetWorld();
+
 		FColor DebugColor = OutHitResult.bBlockingHit ? FColor::Red : FColor::Green;
 		if (OutHitResult.bBlockingHit)
 		{
@@ -89,4 +225,3 @@ void UAbilityTask_WaitForInteractableTargets_SingleLineTrace::PerformTrace()
 	}
 #endif // ENABLE_DRAW_DEBUG
 }
-
@@ -29,6 +29,19 @@ private:
 
 	void PerformTrace();
 
+	FCollisionQueryParams MakeQueryParams(AActor* AvatarActor) const;
+
+	/** Queues the interaction trace along the cached aim direction with the scheduler */
+	void RequestInteractionTrace(AActor* AvatarActor);
+
+	void HandleCameraTraceCompleted(const FHitResult& HitResult, FVector ViewLocation, FRotator ViewRotation, FVector ViewEnd);
+	void HandleInteractionTraceCompleted(const FHitResult& HitResult);
+
+	/** Runs the camera and interaction traces synchronously (Lyra.Interaction.AsyncTraces 0) */
+	void PerformTraceBlocking(AActor* AvatarActor);
+
+	void ShowDebugTrace(const FHitResult& OutHitResult, const FVector& TraceStart, const FVector& TraceEnd) const;
+
 	UPROPERTY()
 	FInteractionQuery InteractionQuery;
 
@@ -40,4 +53,13 @@ private:
 	bool bShowDebug = false;
 
 	FTimerHandle TimerHandle;
+
+	/** Set while a scan waits for trace results, further scans are skipped */
+	bool bTraceInFlight = false;
+
+	/** View the aim direction was last computed from, the camera trace is skipped while the view stays close to it */
+	bool bHasCachedAim = false;
+	FVector CachedViewLocation = FVector::ZeroVector;
+	FRotator CachedViewRotation = FRotator::ZeroRotator;
+	FVector CachedAimDir = FVector::ForwardVector;
 };
@@ -62,6 +62,7 @@ public class LyraGame : ModuleRules
 				"RHI",
 				"Projects",
 				"Gauntlet",
+				"Json",
 				"UMG",
 				"CommonUI",
 				"CommonInput",
@@ -0,0 +1,330 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraPerformanceCapture.h"
+
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "LyraLogChannels.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+namespace LyraPerformanceCapture
+{
+	// Number of frames gathered on the game thread before they are handed off to the writer
+	static constexpr int32 FramesPerBatch = 120;
+
+	// Appends a value column, JSON has no representation for NaN or infinity so those are written as null
+	static void AppendValue(FStringBuilderBase& Line, double Value, ELyraPerformanceCaptureFormat Format)
+	{
+		if ((Format == ELyraPerformanceCaptureFormat::JSON) && !FMath::IsFinite(Value))
+		{
+			Line << TEXT("null");
+		}
+		else
+		{
+			Line.Appendf(TEXT("%.6g"), Value);
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// FLyraPerformanceCapture
+
+FLyraPerformanceCapture::FLyraPerformanceCapture(const FString& InFilename, ELyraPerformanceCaptureFormat InFormat, double InHitchThreshold)
+	: Filename(InFilename)
+	, Format(InFormat)
+	, HitchThreshold(InHitchThreshold)
+	, WritePipe(TEXT("LyraPerformanceCapture"))
+{
+	StartTime = FPlatformTime::Seconds();
+	PendingSamples.Reserve(LyraPerformanceCapture::FramesPerBatch);
+
+	for (int32 StatIndex = 0; StatIndex < LyraNumSampledPerformanceStats; ++StatIndex)
+	{
+		const ELyraDisplayablePerformanceStat Stat = (ELyraDisplayablePerformanceStat)StatIndex;
+		const bool bIsFrameTime = (Stat >= ELyraDisplayablePerformanceStat::FrameTime) && (Stat <= ELyraDisplayablePerformanceStat::FrameTime_GPU);
+
+		// Keep every sample so the summary covers the whole run
+		Histograms[StatIndex].Initialize(0, bIsFrameTime ? HitchThreshold : 0.0, FLyraPerformanceStatHistogram::GetValueRange(Stat));
+	}
+	ServerTickHistogram.Initialize(0, HitchThreshold, FLyraPerformanceStatHistogram::SecondsRange);
+	NetOutBytesHistogram.Initialize(0, 0.0, FLyraPerformanceStatHistogram::BytesPerSecondRange);
+
+	WritePipe.Launch(UE_SOURCE_LOCATION, [this]() { WriteHeader(); });
+
+	UE_LOG(LogLyra, Log, TEXT("Performance capture started, writing to %s"), *Filename);
+}
+
+FLyraPerformanceCapture::~FLyraPerformanceCapture()
+{
+	Finish();
+}
+
+TSharedPtr<FLyraPerformanceCapture> FLyraPerformanceCapture::CreateFromCommandLine(double HitchThreshold)
+{
+	FString CaptureFilename;
+	if (!FParse::Value(FCommandLine::Get(), TEXT("LyraPerfCapture="), CaptureFilename))
+	{
+		if (!FParse::Param(FCommandLine::Get(), TEXT("LyraPerfCapture")))
+		{
+			return nullptr;
+		}
+
+		CaptureFilename = FPaths::ProfilingDir() / TEXT("PerfCapture") / FString::Printf(TEXT("PerfCapture-%s.csv"), *FDateTime::Now().ToString());
+	}
+
+	if (FPaths::IsRelative(CaptureFilename))
+	{
+		CaptureFilename = FPaths::ProfilingDir() / TEXT("PerfCapture") / CaptureFilename;
+	}
+
+	const ELyraPerformanceCaptureFormat CaptureFormat = FPaths::GetExtension(CaptureFilename).Equals(TEXT("json"), ESearchCase::IgnoreCase) ? ELyraPerformanceCaptureFormat::JSON : ELyraPerformanceCaptureFormat::CSV;
+
+	return MakeShared<FLyraPerformanceCapture>(CaptureFilename, CaptureFormat, HitchThreshold);
+}
+
+void FLyraPerformanceCapture::AddFrame(const FLyraPerformanceStatCache& Cache, UWorld* World)
+{
+	check(IsInGameThread());
+
+	if (bFinished)
+	{
+		return;
+	}
+
+	FLyraPerformanceCaptureSample& Sample = PendingSamples.AddDefaulted_GetRef();
+	Sample.FrameNumber = GFrameCounter;
+	Sample.TimeSeconds = FPlatformTime::Seconds() - StartTime;
+
+	for (int32 StatIndex = 0; StatIndex < LyraNumSampledPerformanceStats; ++StatIndex)
+	{
+		Sample.Stats[StatIndex] = Cache.GetCachedStat((ELyraDisplayablePerformanceStat)StatIndex);
+	}
+
+	if (World != nullptr)
+	{
+		if (World->GetNetMode() == NM_Client)
+		{
+			const double ServerFPS = Sample.Stats[(int32)ELyraDisplayablePerformanceStat::ServerFPS];
+			Sample.ServerTickTime = (ServerFPS > 0.0) ? (1.0 / ServerFPS) : 0.0;
+		}
+		else
+		{
+			Sample.ServerTickTime = Sample.Stats[(int32)ELyraDisplayablePerformanceStat::FrameTime_GameThread];
+		}
+
+		if (UNetDriver* NetDriver = World->GetNetDriver())
+		{
+			Sample.NetNumConnections = NetDriver->ClientConnections.Num() + ((NetDriver->ServerConnection != nullptr) ? 1 : 0);
+			Sample.NetInBytesPerSecond = NetDriver->InBytesPerSecond;
+			Sample.NetOutBytesPerSecond = NetDriver->OutBytesPerSecond;
+			Sample.NetInPacketsPerSecond = NetDriver->InPacketsPerSecond;
+			Sample.NetOutPacketsPerSecond = NetDriver->OutPacketsPerSecond;
+		}
+	}
+
+	if (PendingSamples.Num() >= LyraPerformanceCapture::FramesPerBatch)
+	{
+		FlushPendingSamples();
+	}
+}
+
+void FLyraPerformanceCapture::FlushPendingSamples()
+{
+	if (PendingSamples.Num() > 0)
+	{
+		WritePipe.Launch(UE_SOURCE_LOCATION, [this, Samples = MoveTemp(PendingSamples)]() { WriteSamples(Samples); });
+
+		PendingSamples.Reset();
+		PendingSamples.Reserve(LyraPerformanceCapture::FramesPerBatch);
+	}
+}
+
+void FLyraPerformanceCapture::Finish()
+{
+	if (bFinished)
+	{
+		return;
+	}
+	bFinished = true;
+
+	FlushPendingSamples();
+	WritePipe.Launch(UE_SOURCE_LOCATION, [this]() { WriteSummary(); });
+	WritePipe.WaitUntilEmpty();
+
+	UE_LOG(LogLyra, Log, TEXT("Performance capture finished, wrote %lld frames to %s"), NumSamplesWritten, *Filename);
+}
+
+const TCHAR* FLyraPerformanceCapture::GetColumnName(int32 StatIndex)
+{
+	static const TArray<FString> ColumnNames = []()
+	{
+		TArray<FString> Result;
+		for (int32 Index = 0; Index < LyraNumSampledPerformanceStats; ++Index)
+		{
+			Result.Add(StaticEnum<ELyraDisplayablePerformanceStat>()->GetNameStringByValue(Index));
+		}
+		return Result;
+	}();
+
+	return *ColumnNames[StatIndex];
+}
+
+void FLyraPerformanceCapture::WriteLine(const FString& Line)
+{
+	if (Writer.IsValid())
+	{
+		FTCHARToUTF8 UTF8Line(*Line);
+		Writer->Serialize(const_cast<ANSICHAR*>(UTF8Line.Get()), UTF8Line.Length());
+		Writer->Serialize(const_cast<ANSICHAR*>(LINE_TERMINATOR_ANSI), FCStringAnsi::Strlen(LINE_TERMINATOR_ANSI));
+	}
+}
+
+void FLyraPerformanceCapture::WriteHeader()
+{
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Filename), true);
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*Filename));
+
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogLyra, Error, TEXT("Failed to open performance capture file %s"), *Filename);
+		return;
+	}
+
+	TArray<FString> Columns = { TEXT("Frame"), TEXT("Time") };
+	for (int32 StatIndex = 0; StatIndex < LyraNumSampledPerformanceStats; ++StatIndex)
+	{
+		Columns.Add(GetColumnName(StatIndex));
+	}
+	Columns.Append({ TEXT("ServerTickTime"), TEXT("NetConnections"), TEXT("NetInBytesPerSecond"), TEXT("NetOutBytesPerSecond"), TEXT("NetInPacketsPerSecond"), TEXT("NetOutPacketsPerSecond") });
+
+	if (Format == ELyraPerformanceCaptureFormat::CSV)
+	{
+		WriteLine(FString::Join(Columns, TEXT(",")));
+	}
+	else
+	{
+		WriteLine(FString::Printf(TEXT("{\"columns\":[\"%s\"],"), *FString::Join(Columns, TEXT("\",\""))));
+		WriteLine(TEXT("\"frames\":["));
+	}
+}
+
+void FLyraPerformanceCapture::WriteSamples(const TArray<FLyraPerformanceCaptureSample>& Samples)
+{
+	TStringBuilder<1024> Line;
+
+	for (const FLyraPerformanceCaptureSample& Sample : Samples)
+	{
+		for (int32 StatIndex = 0; StatIndex < LyraNumSampledPerformanceStats; ++StatIndex)
+		{
+			Histograms[StatIndex].AddSample(Sample.Stats[StatIndex]);
+		}
+		ServerTickHistogram.AddSample(Sample.ServerTickTime);
+		NetOutBytesHistogram.AddSample(Sample.NetOutBytesPerSecond);
+
+		if (!Writer.IsValid())
+		{
+			continue;
+		}
+
+		Line.Reset();
+		if (Format == ELyraPerformanceCaptureFormat::JSON)
+		{
+			Line << (bWroteAnySample ? TEXT(",[") : TEXT("["));
+		}
+
+		Line.Appendf(TEXT("%llu,%.4f"), Sample.FrameNumber, Sample.TimeSeconds);
+		for (int32 StatIndex = 0; StatIndex < LyraNumSampledPerformanceStats; ++StatIndex)
+		{
+			Line << TEXT(",");
+			LyraPerformanceCapture::AppendValue(Line, Sample.Stats[StatIndex], Format);
+		}
+		Line << TEXT(",");
+		LyraPerformanceCapture::AppendValue(Line, Sample.ServerTickTime, Format);
+		Line.Appendf(TEXT(",%d,%d,%d,%d,%d"), Sample.NetNumConnections, Sample.NetInBytesPerSecond, Sample.NetOutBytesPerSecond, Sample.NetInPacketsPerSecond, Sample.NetOutPacketsPerSecond);
+
+		if (Format == ELyraPerformanceCaptureFormat::JSON)
+		{
+			Line << TEXT("]");
+		}
+
+		WriteLine(Line.ToString());
+		bWroteAnySample = true;
+		++NumSamplesWritten;
+	}
+}
+
+void FLyraPerformanceCapture::WriteSummary()
+{
+	struct FSummaryRow
+	{
+		FString Name;
+		const FLyraPerformanceStatHistogram* Histogram;
+	};
+
+	TArray<FSummaryRow> Rows;
+	for (int32 StatIndex = 0; StatIndex < LyraNumSampledPerformanceStats; ++StatIndex)
+	{
+		Rows.Add({ GetColumnName(StatIndex), &Histograms[StatIndex] });
+	}
+	Rows.Add({ TEXT("ServerTickTime"), &ServerTickHistogram });
+	Rows.Add({ TEXT("NetOutBytesPerSecond"), &NetOutBytesHistogram });
+
+	UE_LOG(LogLyra, Log, TEXT("Performance capture summary (%lld frames, hitch threshold %.1f ms):"), NumSamplesWritten, HitchThreshold * 1000.0);
+
+	TArray<FString> SummaryLines;
+	for (const FSummaryRow& Row : Rows)
+	{
+		const double P50 = Row.Histogram->GetPercentile(50.0);
+		const double P95 = Row.Histogram->GetPercentile(95.0);
+		const double P99 = Row.Histogram->GetPercentile(99.0);
+		const double Max = Row.Histogram->GetPercentile(100.0);
+		const int32 Hitches = Row.Histogram->GetHitchCount();
+
+		UE_LOG(LogLyra, Log, TEXT("  %-24s P50=%.6g P95=%.6g P99=%.6g Max=%.6g Hitches=%d"), *Row.Name, P50, P95, P99, Max, Hitches);
+
+		if (Format == ELyraPerformanceCaptureFormat::CSV)
+		{
+			SummaryLines.Add(FString::Printf(TEXT("%s,%d,%.6g,%.6g,%.6g,%.6g,%d"), *Row.Name, Row.Histogram->GetNumSamples(), P50, P95, P99, Max, Hitches));
+		}
+		else
+		{
+			TStringBuilder<256> SummaryLine;
+			SummaryLine.Appendf(TEXT("\"%s\":{\"samples\":%d,\"p50\":"), *Row.Name, Row.Histogram->GetNumSamples());
+			LyraPerformanceCapture::AppendValue(SummaryLine, P50, Format);
+			SummaryLine << TEXT(",\"p95\":");
+			LyraPerformanceCapture::AppendValue(SummaryLine, P95, Format);
+			SummaryLine << TEXT(",\"p99\":");
+			LyraPerformanceCapture::AppendValue(SummaryLine, P99, Format);
+			SummaryLine << TEXT(",\"max\":");
+			LyraPerformanceCapture::AppendValue(SummaryLine, Max, Format);
+			SummaryLine.Appendf(TEXT(",\"hitches\":%d}"), Hitches);
+			SummaryLines.Add(SummaryLine.ToString());
+		}
+	}
+
+	if (Format == ELyraPerformanceCaptureFormat::JSON)
+	{
+		// Close the frames array and append the summary to the same document
+		WriteLine(FString::Printf(TEXT("],\"hitchThreshold\":%.6g,\"summary\":{%s}}"), HitchThreshold, *FString::Join(SummaryLines, TEXT(","))));
+		Writer.Reset();
+	}
+	else
+	{
+		Writer.Reset();
+
+		// CSV rows must all have the same columns, so the summary goes in a file next to the capture
+		const FString SummaryFilename = FPaths::GetPath(Filename) / (FPaths::GetBaseFilename(Filename) + TEXT(".summary.csv"));
+		Writer.Reset(IFileManager::Get().CreateFileWriter(*SummaryFilename));
+		WriteLine(TEXT("Stat,Samples,P50,P95,P99,Max,Hitches"));
+		for (const FString& SummaryLine : SummaryLines)
+		{
+			WriteLine(SummaryLine);
+		}
+		Writer.Reset();
+	}
+}
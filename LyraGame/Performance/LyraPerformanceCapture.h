@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Performance/LyraPerformanceStatSubsystem.h"
+#include "Tasks/Pipe.h"
+
+class FArchive;
+class UWorld;
+struct FLyraPerformanceStatCache;
+
+//////////////////////////////////////////////////////////////////////
+
+// One captured frame
+struct FLyraPerformanceCaptureSample
+{
+	uint64 FrameNumber = 0;
+	double TimeSeconds = 0.0;
+
+	// Value of every sampled ELyraDisplayablePerformanceStat
+	double Stats[LyraNumSampledPerformanceStats] = {};
+
+	// Game thread time on the server (measured locally on a server, derived from the replicated server FPS on a client)
+	double ServerTickTime = 0.0;
+
+	// Totals across the world's net driver (all client connections on a server, the server connection on a client)
+	int32 NetNumConnections = 0;
+	int32 NetInBytesPerSecond = 0;
+	int32 NetOutBytesPerSecond = 0;
+	int32 NetInPacketsPerSecond = 0;
+	int32 NetOutPacketsPerSecond = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+enum class ELyraPerformanceCaptureFormat : uint8
+{
+	CSV,
+	JSON
+};
+
+/**
+ * FLyraPerformanceCapture
+ *
+ * Streams every frame seen by ULyraPerformanceStatSubsystem to a CSV or JSON file, for automated soak tests
+ * on dedicated servers and -nullrhi clients. Samples are gathered on the game thread and handed off in batches
+ * to a task pipe, which formats and writes them and accumulates whole-run histograms for the summary written
+ * when the capture finishes.
+ *
+ * Enabled with -LyraPerfCapture (default file in the profiling dir) or -LyraPerfCapture=Path.csv|Path.json.
+ */
+class FLyraPerformanceCapture
+{
+public:
+	FLyraPerformanceCapture(const FString& InFilename, ELyraPerformanceCaptureFormat InFormat, double InHitchThreshold);
+	~FLyraPerformanceCapture();
+
+	// Creates a capture if one was requested on the command line
+	static TSharedPtr<FLyraPerformanceCapture> CreateFromCommandLine(double HitchThreshold);
+
+	// Records a frame (game thread only)
+	void AddFrame(const FLyraPerformanceStatCache& Cache, UWorld* World);
+
+	// Flushes everything, writes the percentile and hitch summary and closes the file
+	void Finish();
+
+	const FString& GetFilename() const { return Filename; }
+
+private:
+	void FlushPendingSamples();
+
+	// Only called from tasks on WritePipe
+	void WriteHeader();
+	void WriteSamples(const TArray<FLyraPerformanceCaptureSample>& Samples);
+	void WriteSummary();
+	void WriteLine(const FString& Line);
+
+	static const TCHAR* GetColumnName(int32 StatIndex);
+
+private:
+	FString Filename;
+	ELyraPerformanceCaptureFormat Format;
+	double HitchThreshold;
+	double StartTime = 0.0;
+	bool bFinished = false;
+
+	// Game thread side: samples waiting to be handed to the writer
+	TArray<FLyraPerformanceCaptureSample> PendingSamples;
+
+	// Writer side: everything below is only touched by tasks launched on WritePipe
+	UE::Tasks::FPipe WritePipe;
+	TUniquePtr<FArchive> Writer;
+	bool bWroteAnySample = false;
+	int64 NumSamplesWritten = 0;
+	FLyraPerformanceStatHistogram Histograms[LyraNumSampledPerformanceStats];
+	FLyraPerformanceStatHistogram ServerTickHistogram;
+	FLyraPerformanceStatHistogram NetOutBytesHistogram;
+};
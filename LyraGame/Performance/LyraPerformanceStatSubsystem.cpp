@@ -8,17 +8,232 @@
 #include "Engine/World.h"
 #include "GameFramework/PlayerState.h"
 #include "GameModes/LyraGameState.h"
-#include "Performance/LyraPerformanceStatTypes.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+#include "Performance/LyraPerformanceCapture.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraPerformanceStatSubsystem)
 
 class FSubsystemCollectionBase;
 
+namespace LyraPerformanceStatCvars
+{
+	static int32 HistogramWindowFrames = 3600;
+	static FAutoConsoleVariableRef CVarHistogramWindowFrames(
+		TEXT("Lyra.PerfStats.HistogramWindowFrames"),
+		HistogramWindowFrames,
+		TEXT("Number of frames kept in the rolling performance stat histograms (applied when the histograms are reset)."),
+		ECVF_Default);
+
+	static float HitchThresholdMs = 60.0f;
+	static FAutoConsoleVariableRef CVarHitchThresholdMs(
+		TEXT("Lyra.PerfStats.HitchThresholdMs"),
+		HitchThresholdMs,
+		TEXT("Frame, game, render or GPU time (in ms) above which a frame counts as a hitch (applied when the histograms are reset)."),
+		ECVF_Default);
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdDumpPercentiles(
+		TEXT("Lyra.PerfStats.DumpPercentiles"),
+		TEXT("Prints p50/p95/p99/max and hitch counts for every performance stat over the rolling histogram window. Pass 'reset' to clear the histograms afterwards."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UGameInstance* GameInstance = (World != nullptr) ? World->GetGameInstance() : nullptr)
+			{
+				if (ULyraPerformanceStatSubsystem* Subsystem = GameInstance->GetSubsystem<ULyraPerformanceStatSubsystem>())
+				{
+					Subsystem->DumpPercentiles(*GLog);
+
+					if ((Args.Num() > 0) && (Args[0] == TEXT("reset")))
+					{
+						Subsystem->ResetStatHistograms();
+					}
+				}
+			}
+		}));
+
+	// Maps a histogram-derived stat to the sampled stat it is derived from
+	static ELyraDisplayablePerformanceStat GetSourceStat(ELyraDisplayablePerformanceStat Stat)
+	{
+		switch (Stat)
+		{
+		case ELyraDisplayablePerformanceStat::FrameTime_P50:
+		case ELyraDisplayablePerformanceStat::FrameTime_P95:
+		case ELyraDisplayablePerformanceStat::FrameTime_P99:
+		case ELyraDisplayablePerformanceStat::FrameTime_HitchCount:
+			return ELyraDisplayablePerformanceStat::FrameTime;
+		case ELyraDisplayablePerformanceStat::FrameTime_GameThread_P50:
+		case ELyraDisplayablePerformanceStat::FrameTime_GameThread_P95:
+		case ELyraDisplayablePerformanceStat::FrameTime_GameThread_P99:
+		case ELyraDisplayablePerformanceStat::FrameTime_GameThread_HitchCount:
+			return ELyraDisplayablePerformanceStat::FrameTime_GameThread;
+		case ELyraDisplayablePerformanceStat::FrameTime_RenderThread_P50:
+		case ELyraDisplayablePerformanceStat::FrameTime_RenderThread_P95:
+		case ELyraDisplayablePerformanceStat::FrameTime_RenderThread_P99:
+		case ELyraDisplayablePerformanceStat::FrameTime_RenderThread_HitchCount:
+			return ELyraDisplayablePerformanceStat::FrameTime_RenderThread;
+		case ELyraDisplayablePerformanceStat::FrameTime_GPU_P50:
+		case ELyraDisplayablePerformanceStat::FrameTime_GPU_P95:
+		case ELyraDisplayablePerformanceStat::FrameTime_GPU_P99:
+		case ELyraDisplayablePerformanceStat::FrameTime_GPU_HitchCount:
+			return ELyraDisplayablePerformanceStat::FrameTime_GPU;
+		default:
+			break;
+		}
+
+		return Stat;
+	}
+
+	static bool IsFrameTimeStat(ELyraDisplayablePerformanceStat Stat)
+	{
+		return (Stat == ELyraDisplayablePerformanceStat::FrameTime)
+			|| (Stat == ELyraDisplayablePerformanceStat::FrameTime_GameThread)
+			|| (Stat == ELyraDisplayablePerformanceStat::FrameTime_RenderThread)
+			|| (Stat == ELyraDisplayablePerformanceStat::FrameTime_RHIThread)
+			|| (Stat == ELyraDisplayablePerformanceStat::FrameTime_GPU);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// FLyraPerformanceStatHistogram
+
+FLyraPerformanceStatHistogram::FValueRange FLyraPerformanceStatHistogram::GetValueRange(ELyraDisplayablePerformanceStat Stat)
+{
+	switch (Stat)
+	{
+	case ELyraDisplayablePerformanceStat::ClientFPS:
+	case ELyraDisplayablePerformanceStat::ServerFPS:
+		return { 1.0e-2, 1.0e5 };
+	case ELyraDisplayablePerformanceStat::Ping:
+		return { 1.0e-3, 1.0e6 };
+	case ELyraDisplayablePerformanceStat::PacketLoss_Incoming:
+	case ELyraDisplayablePerformanceStat::PacketLoss_Outgoing:
+		return { 1.0e-4, 1.0e3 };
+	case ELyraDisplayablePerformanceStat::PacketRate_Incoming:
+	case ELyraDisplayablePerformanceStat::PacketRate_Outgoing:
+	case ELyraDisplayablePerformanceStat::PacketSize_Incoming:
+	case ELyraDisplayablePerformanceStat::PacketSize_Outgoing:
+		return { 1.0e-2, 1.0e8 };
+	default:
+		return SecondsRange;
+	}
+}
+
+void FLyraPerformanceStatHistogram::Initialize(int32 InWindowSize, double InHitchThreshold, const FValueRange& InValueRange)
+{
+	WindowSize = FMath::Max(InWindowSize, 0);
+	Window.Empty(WindowSize);
+	Window.SetNumZeroed(WindowSize);
+	HitchThreshold = InHitchThreshold;
+
+	// Bucket 0 holds everything below the range, the others split it evenly in log space
+	MinTrackedValue = FMath::Max(InValueRange.MinValue, UE_SMALL_NUMBER);
+	const double MaxTrackedValue = FMath::Max(InValueRange.MaxValue, MinTrackedValue * 2.0);
+	LogBucketGrowth = FMath::Loge(MaxTrackedValue / MinTrackedValue) / (NumBuckets - 1);
+	InvLogBucketGrowth = 1.0 / LogBucketGrowth;
+
+	Reset();
+}
+
+void FLyraPerformanceStatHistogram::Reset()
+{
+	for (std::atomic<uint32>& Count : BucketCounts)
+	{
+		Count.store(0, std::memory_order_relaxed);
+	}
+	NumSamples.store(0, std::memory_order_relaxed);
+	HitchCount.store(0, std::memory_order_relaxed);
+	WindowHead = 0;
+}
+
+void FLyraPerformanceStatHistogram::AddSample(double Value)
+{
+	// Bucket and hitch tests must see exactly the value that is stored in the window, or evicting it later could
+	// decrement a different bucket than the one that was incremented
+	const float SampleValue = (float)Value;
+	const bool bTrackHitches = (HitchThreshold > 0.0);
+
+	// Evict the oldest sample once the window is full
+	const int32 CurrentNumSamples = NumSamples.load(std::memory_order_relaxed);
+	if ((WindowSize > 0) && (CurrentNumSamples == WindowSize))
+	{
+		const float OldValue = Window[WindowHead];
+		BucketCounts[ValueToBucket(OldValue)].fetch_sub(1, std::memory_order_relaxed);
+		if (bTrackHitches && (OldValue > HitchThreshold))
+		{
+			HitchCount.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+	else
+	{
+		NumSamples.store(CurrentNumSamples + 1, std::memory_order_relaxed);
+	}
+
+	if (WindowSize > 0)
+	{
+		Window[WindowHead] = SampleValue;
+		WindowHead = (WindowHead + 1) % WindowSize;
+	}
+
+	BucketCounts[ValueToBucket(SampleValue)].fetch_add(1, std::memory_order_relaxed);
+	if (bTrackHitches && (SampleValue > HitchThreshold))
+	{
+		HitchCount.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+double FLyraPerformanceStatHistogram::GetPercentile(double Percentile) const
+{
+	const int32 CurrentNumSamples = NumSamples.load(std::memory_order_relaxed);
+	if (CurrentNumSamples == 0)
+	{
+		return 0.0;
+	}
+
+	// Nearest-rank percentile
+	const uint32 TargetRank = (uint32)FMath::Clamp(FMath::CeilToInt(FMath::Clamp(Percentile, 0.0, 100.0) * 0.01 * CurrentNumSamples), 1, CurrentNumSamples);
+
+	uint32 RunningCount = 0;
+	int32 LastNonEmptyBucket = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		const uint32 Count = BucketCounts[Bucket].load(std::memory_order_relaxed);
+		if (Count > 0)
+		{
+			LastNonEmptyBucket = Bucket;
+			RunningCount += Count;
+			if (RunningCount >= TargetRank)
+			{
+				return BucketToValue(Bucket);
+			}
+		}
+	}
+
+	// Only reachable if the buckets were modified while we were reading them
+	return BucketToValue(LastNonEmptyBucket);
+}
+
+int32 FLyraPerformanceStatHistogram::ValueToBucket(double Value) const
+{
+	if (Value < MinTrackedValue)
+	{
+		return 0;
+	}
+
+	return FMath::Clamp(1 + FMath::FloorToInt(FMath::Loge(Value / MinTrackedValue) * InvLogBucketGrowth), 1, NumBuckets - 1);
+}
+
+double FLyraPerformanceStatHistogram::BucketToValue(int32 Bucket) const
+{
+	// Report the geometric center of the bucket
+	return (Bucket == 0) ? 0.0 : MinTrackedValue * FMath::Exp(LogBucketGrowth * ((double)Bucket - 0.5));
+}
+
 //////////////////////////////////////////////////////////////////////
 // FLyraPerformanceStatCache
 
 void FLyraPerformanceStatCache::StartCharting()
 {
+	ResetHistograms();
 }
 
 void FLyraPerformanceStatCache::ProcessFrame(const FFrameData& FrameData)
@@ -33,7 +248,8 @@ void FLyraPerformanceStatCache::ProcessFrame(const FFrameData& FrameData)
 	CachedPacketSizeIncoming = 0.0f;
 	CachedPacketSizeOutgoing = 0.0f;
 
-	if (UWorld* World = MySubsystem->GetGameInstance()->GetWorld())
+	UWorld* World = MySubsystem->GetGameInstance()->GetWorld();
+	if (World)
 	{
 		if (const ALyraGameState* GameState = World->GetGameState<ALyraGameState>())
 		{
@@ -62,6 +278,16 @@ void FLyraPerformanceStatCache::ProcessFrame(const FFrameData& FrameData)
 			}
 		}
 	}
+
+	for (int32 StatIndex = 0; StatIndex < LyraNumSampledPerformanceStats; ++StatIndex)
+	{
+		Histograms[StatIndex].AddSample(GetSampledStat((ELyraDisplayablePerformanceStat)StatIndex));
+	}
+
+	if (Capture.IsValid())
+	{
+		Capture->AddFrame(*this, World);
+	}
 }
 
 void FLyraPerformanceStatCache::StopCharting()
@@ -70,7 +296,38 @@ void FLyraPerformanceStatCache::StopCharting()
 
 double FLyraPerformanceStatCache::GetCachedStat(ELyraDisplayablePerformanceStat Stat) const
 {
-	static_assert((int32)ELyraDisplayablePerformanceStat::Count == 15, "Need to update this function to deal with new performance stats");
+	static_assert((int32)ELyraDisplayablePerformanceStat::Count == 31, "Need to update this function to deal with new performance stats");
+	switch (Stat)
+	{
+	case ELyraDisplayablePerformanceStat::FrameTime_P50:
+	case ELyraDisplayablePerformanceStat::FrameTime_GameThread_P50:
+	case ELyraDisplayablePerformanceStat::FrameTime_RenderThread_P50:
+	case ELyraDisplayablePerformanceStat::FrameTime_GPU_P50:
+		return GetStatPercentile(LyraPerformanceStatCvars::GetSourceStat(Stat), 50.0);
+	case ELyraDisplayablePerformanceStat::FrameTime_P95:
+	case ELyraDisplayablePerformanceStat::FrameTime_GameThread_P95:
+	case ELyraDisplayablePerformanceStat::FrameTime_RenderThread_P95:
+	case ELyraDisplayablePerformanceStat::FrameTime_GPU_P95:
+		return GetStatPercentile(LyraPerformanceStatCvars::GetSourceStat(Stat), 95.0);
+	case ELyraDisplayablePerformanceStat::FrameTime_P99:
+	case ELyraDisplayablePerformanceStat::FrameTime_GameThread_P99:
+	case ELyraDisplayablePerformanceStat::FrameTime_RenderThread_P99:
+	case ELyraDisplayablePerformanceStat::FrameTime_GPU_P99:
+		return GetStatPercentile(LyraPerformanceStatCvars::GetSourceStat(Stat), 99.0);
+	case ELyraDisplayablePerformanceStat::FrameTime_HitchCount:
+	case ELyraDisplayablePerformanceStat::FrameTime_GameThread_HitchCount:
+	case ELyraDisplayablePerformanceStat::FrameTime_RenderThread_HitchCount:
+	case ELyraDisplayablePerformanceStat::FrameTime_GPU_HitchCount:
+		return GetStatHitchCount(LyraPerformanceStatCvars::GetSourceStat(Stat));
+	default:
+		break;
+	}
+
+	return GetSampledStat(Stat);
+}
+
+double FLyraPerformanceStatCache::GetSampledStat(ELyraDisplayablePerformanceStat Stat) const
+{
 	switch (Stat)
 	{
 	case ELyraDisplayablePerformanceStat::ClientFPS:
@@ -103,17 +360,72 @@ double FLyraPerformanceStatCache::GetCachedStat(ELyraDisplayablePerformanceStat
 		return CachedPacketSizeIncoming;
 	case ELyraDisplayablePerformanceStat::PacketSize_Outgoing:
 		return CachedPacketSizeOutgoing;
+	default:
+		break;
 	}
 
 	return 0.0f;
 }
 
+double FLyraPerformanceStatCache::GetStatPercentile(ELyraDisplayablePerformanceStat Stat, double Percentile) const
+{
+	const int32 StatIndex = (int32)LyraPerformanceStatCvars::GetSourceStat(Stat);
+	return (StatIndex < LyraNumSampledPerformanceStats) ? Histograms[StatIndex].GetPercentile(Percentile) : 0.0;
+}
+
+int32 FLyraPerformanceStatCache::GetStatHitchCount(ELyraDisplayablePerformanceStat Stat) const
+{
+	const int32 StatIndex = (int32)LyraPerformanceStatCvars::GetSourceStat(Stat);
+	return (StatIndex < LyraNumSampledPerformanceStats) ? Histograms[StatIndex].GetHitchCount() : 0;
+}
+
+void FLyraPerformanceStatCache::ResetHistograms()
+{
+	const int32 WindowSize = FMath::Max(LyraPerformanceStatCvars::HistogramWindowFrames, 1);
+	const double HitchThresholdSeconds = LyraPerformanceStatCvars::HitchThresholdMs * 0.001;
+
+	for (int32 StatIndex = 0; StatIndex < LyraNumSampledPerformanceStats; ++StatIndex)
+	{
+		const bool bIsFrameTime = LyraPerformanceStatCvars::IsFrameTimeStat((ELyraDisplayablePerformanceStat)StatIndex);
+		Histograms[StatIndex].Initialize(WindowSize, bIsFrameTime ? HitchThresholdSeconds : 0.0, FLyraPerformanceStatHistogram::GetValueRange((ELyraDisplayablePerformanceStat)StatIndex));
+	}
+}
+
+void FLyraPerformanceStatCache::DumpPercentiles(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Performance stat percentiles (window: %d frames, hitch threshold: %.1f ms)"), LyraPerformanceStatCvars::HistogramWindowFrames, LyraPerformanceStatCvars::HitchThresholdMs);
+	Ar.Logf(TEXT("  %-24s %8s %12s %12s %12s %12s %8s"), TEXT("Stat"), TEXT("Samples"), TEXT("P50"), TEXT("P95"), TEXT("P99"), TEXT("Max"), TEXT("Hitches"));
+
+	for (int32 StatIndex = 0; StatIndex < LyraNumSampledPerformanceStats; ++StatIndex)
+	{
+		const ELyraDisplayablePerformanceStat Stat = (ELyraDisplayablePerformanceStat)StatIndex;
+		const FLyraPerformanceStatHistogram& Histogram = Histograms[StatIndex];
+
+		// Frame times are tracked in seconds but are much easier to read in milliseconds
+		const double Scale = LyraPerformanceStatCvars::IsFrameTimeStat(Stat) ? 1000.0 : 1.0;
+
+		Ar.Logf(TEXT("  %-24s %8d %12.3f %12.3f %12.3f %12.3f %8d"),
+			*StaticEnum<ELyraDisplayablePerformanceStat>()->GetNameStringByValue(StatIndex),
+			Histogram.GetNumSamples(),
+			Histogram.GetPercentile(50.0) * Scale,
+			Histogram.GetPercentile(95.0) * Scale,
+			Histogram.GetPercentile(99.0) * Scale,
+			Histogram.GetPercentile(100.0) * Scale,
+			Histogram.GetHitchCount());
+	}
+}
+
 //////////////////////////////////////////////////////////////////////
 // ULyraPerformanceStatSubsystem
 
 void ULyraPerformanceStatSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Tracker = MakeShared<FLyraPerformanceStatCache>(this);
+	Tracker->ResetHistograms();
+
+	Capture = FLyraPerformanceCapture::CreateFromCommandLine(LyraPerformanceStatCvars::HitchThresholdMs * 0.001);
+	Tracker->SetCapture(Capture);
+
 	GEngine->AddPerformanceDataConsumer(Tracker);
 }
 
@@ -121,6 +433,12 @@ void ULyraPerformanceStatSubsystem::Deinitialize()
 {
 	GEngine->RemovePerformanceDataConsumer(Tracker);
 	Tracker.Reset();
+
+	if (Capture.IsValid())
+	{
+		Capture->Finish();
+		Capture.Reset();
+	}
 }
 
 double ULyraPerformanceStatSubsystem::GetCachedStat(ELyraDisplayablePerformanceStat Stat) const
@@ -128,3 +446,23 @@ double ULyraPerformanceStatSubsystem::GetCachedStat(ELyraDisplayablePerformanceS
 	return Tracker->GetCachedStat(Stat);
 }
 
+
+double ULyraPerformanceStatSubsystem::GetStatPercentile(ELyraDisplayablePerformanceStat Stat, float Percentile) const
+{
+	return Tracker->GetStatPercentile(Stat, Percentile);
+}
+
+int32 ULyraPerformanceStatSubsystem::GetStatHitchCount(ELyraDisplayablePerformanceStat Stat) const
+{
+	return Tracker->GetStatHitchCount(Stat);
+}
+
+void ULyraPerformanceStatSubsystem::ResetStatHistograms()
+{
+	Tracker->ResetHistograms();
+}
+
+void ULyraPerformanceStatSubsystem::DumpPercentiles(FOutputDevice& Ar) const
+{
+	Tracker->DumpPercentiles(Ar);
+}
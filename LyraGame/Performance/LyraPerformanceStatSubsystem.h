@@ -3,12 +3,15 @@
 #pragma once
 
 #include "ChartCreation.h"
+#include "Performance/LyraPerformanceStatTypes.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 
-#include "LyraPerformanceStatSubsystem.generated.h"
+#include <atomic>
 
-enum class ELyraDisplayablePerformanceStat : uint8;
+#include "LyraPerformanceStatSubsystem.generated.h"
 
+class FLyraPerformanceCapture;
+class FOutputDevice;
 class FSubsystemCollectionBase;
 class ULyraPerformanceStatSubsystem;
 class UObject;
@@ -16,6 +19,66 @@ struct FFrame;
 
 //////////////////////////////////////////////////////////////////////
 
+// Rolling histogram of the last N samples of a single stat, using logarithmic buckets spread over the value range
+// of the stat (~1% relative error for a range of 8 orders of magnitude).
+// Samples are added from a single thread (the game thread, via ProcessFrame); the bucket counts are atomic so
+// percentiles and hitch counts can be queried from any thread without taking a lock.
+struct FLyraPerformanceStatHistogram
+{
+public:
+	static constexpr int32 NumBuckets = 1200;
+
+	// Values a stat is expected to take, in its own unit. Anything below MinValue (including zero) lands in the first
+	// bucket, anything above MaxValue in the last one.
+	struct FValueRange
+	{
+		double MinValue = 1.0e-6;
+		double MaxValue = 1.0e3;
+	};
+
+	// Returns the value range of a sampled stat (seconds, Hz, ms, percent, packets or bytes)
+	static FValueRange GetValueRange(ELyraDisplayablePerformanceStat Stat);
+
+	static constexpr FValueRange SecondsRange = { 1.0e-6, 1.0e3 };
+	static constexpr FValueRange BytesPerSecondRange = { 1.0, 1.0e12 };
+
+	// A window size of 0 keeps every sample instead of a sliding window (e.g., for whole-run summaries)
+	void Initialize(int32 InWindowSize, double InHitchThreshold, const FValueRange& InValueRange = SecondsRange);
+	void Reset();
+
+	void AddSample(double Value);
+
+	// Returns the value at the given percentile (0-100) of the samples currently in the window
+	double GetPercentile(double Percentile) const;
+
+	// Returns the number of samples in the window above the hitch threshold (0 if there is no threshold)
+	int32 GetHitchCount() const { return HitchCount.load(std::memory_order_relaxed); }
+
+	int32 GetNumSamples() const { return NumSamples.load(std::memory_order_relaxed); }
+
+private:
+	int32 ValueToBucket(double Value) const;
+	double BucketToValue(int32 Bucket) const;
+
+	std::atomic<uint32> BucketCounts[NumBuckets] = {};
+	std::atomic<int32> NumSamples = 0;
+	std::atomic<int32> HitchCount = 0;
+
+	// Ring buffer of the raw samples in the window, so the oldest one can be removed from its bucket
+	TArray<float> Window;
+	int32 WindowSize = 0;
+	int32 WindowHead = 0;
+
+	double HitchThreshold = 0.0;
+
+	// Lower bound of the first tracked bucket, and the log of the ratio between consecutive bucket bounds
+	double MinTrackedValue = SecondsRange.MinValue;
+	double LogBucketGrowth = 1.0;
+	double InvLogBucketGrowth = 1.0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
 // Observer which caches the stats for the previous frame
 struct FLyraPerformanceStatCache : public IPerformanceDataConsumer
 {
@@ -33,7 +96,18 @@ public:
 
 	double GetCachedStat(ELyraDisplayablePerformanceStat Stat) const;
 
+	void SetCapture(TSharedPtr<FLyraPerformanceCapture> InCapture) { Capture = InCapture; }
+
+	double GetStatPercentile(ELyraDisplayablePerformanceStat Stat, double Percentile) const;
+	int32 GetStatHitchCount(ELyraDisplayablePerformanceStat Stat) const;
+
+	void ResetHistograms();
+	void DumpPercentiles(FOutputDevice& Ar) const;
+
 protected:
+	// Returns the value of a stat that is sampled every frame (i.e., not derived from a histogram)
+	double GetSampledStat(ELyraDisplayablePerformanceStat Stat) const;
+
 	IPerformanceDataConsumer::FFrameData CachedData;
 	ULyraPerformanceStatSubsystem* MySubsystem;
 
@@ -45,6 +119,12 @@ protected:
 	float CachedPacketRateOutgoing = 0.0f;
 	float CachedPacketSizeIncoming = 0.0f;
 	float CachedPacketSizeOutgoing = 0.0f;
+
+	// One rolling histogram for every stat that is sampled each frame
+	FLyraPerformanceStatHistogram Histograms[LyraNumSampledPerformanceStats];
+
+	// Headless capture that every processed frame is streamed to, if one is running
+	TSharedPtr<FLyraPerformanceCapture> Capture;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -59,6 +139,21 @@ public:
 	UFUNCTION(BlueprintCallable)
 	double GetCachedStat(ELyraDisplayablePerformanceStat Stat) const;
 
+	// Returns the value at the given percentile (0-100) of a stat over the rolling histogram window
+	UFUNCTION(BlueprintCallable)
+	double GetStatPercentile(ELyraDisplayablePerformanceStat Stat, float Percentile) const;
+
+	// Returns the number of frames over the hitch threshold for a frame time stat over the rolling histogram window
+	UFUNCTION(BlueprintCallable)
+	int32 GetStatHitchCount(ELyraDisplayablePerformanceStat Stat) const;
+
+	// Clears the rolling histograms, e.g., when a soak test moves on to a new phase
+	UFUNCTION(BlueprintCallable)
+	void ResetStatHistograms();
+
+	// Writes p50/p95/p99/max and hitch counts of every sampled stat to the output device
+	void DumpPercentiles(FOutputDevice& Ar) const;
+
 	//~USubsystem interface
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
@@ -66,4 +161,7 @@ public:
 
 protected:
 	TSharedPtr<FLyraPerformanceStatCache> Tracker;
+
+	// Started from the command line with -LyraPerfCapture[=File.csv|File.json]
+	TSharedPtr<FLyraPerformanceCapture> Capture;
 };
@@ -77,10 +77,33 @@ enum class ELyraDisplayablePerformanceStat : uint8
 	// The avg. size (in bytes) of packets sent
 	PacketSize_Outgoing,
 
+	// Rolling percentiles of the frame time stats above over the histogram window (in seconds, see Lyra.PerfStats.HistogramWindowFrames)
+	FrameTime_P50,
+	FrameTime_P95,
+	FrameTime_P99,
+	FrameTime_GameThread_P50,
+	FrameTime_GameThread_P95,
+	FrameTime_GameThread_P99,
+	FrameTime_RenderThread_P50,
+	FrameTime_RenderThread_P95,
+	FrameTime_RenderThread_P99,
+	FrameTime_GPU_P50,
+	FrameTime_GPU_P95,
+	FrameTime_GPU_P99,
+
+	// Number of frames in the histogram window over the hitch threshold (see Lyra.PerfStats.HitchThresholdMs)
+	FrameTime_HitchCount,
+	FrameTime_GameThread_HitchCount,
+	FrameTime_RenderThread_HitchCount,
+	FrameTime_GPU_HitchCount,
+
 	// New stats should go above here
 	Count UMETA(Hidden)
 };
 
 ENUM_RANGE_BY_COUNT(ELyraDisplayablePerformanceStat, ELyraDisplayablePerformanceStat::Count);
 
+// The stats that are sampled directly every frame; everything after these is derived from their rolling histograms
+static constexpr int32 LyraNumSampledPerformanceStats = (int32)ELyraDisplayablePerformanceStat::PacketSize_Outgoing + 1;
+
 //////////////////////////////////////////////////////////////////////
@@ -14,7 +14,6 @@
 #include "AbilitySystem/LyraAbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
 #include "Character/LyraHealthComponent.h"
-#include "Character/LyraManaComponent.h"
 #include "Character/LyraPawnExtensionComponent.h"
 #include "System/LyraSystemStatics.h"
 #include "Development/LyraDeveloperSettings.h"
@@ -449,12 +448,6 @@ void ULyraCheatManager::DamageSelfDestruct()
 				if (ULyraHealthComponent* HealthComponent = ULyraHealthComponent::FindHealthComponent(LyraPC->GetPawn()))
 				{
 					HealthComponent->DamageSelfDestruct();
-
-					// Doing this to the other attributes just for visuals.
-					if(ULyraManaComponent* ManaComponent = ULyraManaComponent::FindManaComponent(LyraPC->GetPawn()))
-					{
-						ManaComponent->DamageSelfDestruct();
-					}
 				}
 			}
 		}
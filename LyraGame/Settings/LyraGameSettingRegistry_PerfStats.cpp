@@ -16,7 +16,7 @@ void ULyraGameSettingRegistry::AddPerformanceStatPage(UGameSettingCollection* Pe
 {
 	//----------------------------------------------------------------------------------
 	{
-		static_assert((int32)ELyraDisplayablePerformanceStat::Count == 15, "Consider updating this function to deal with new performance stats");
+		static_assert((int32)ELyraDisplayablePerformanceStat::Count == 31, "Consider updating this function to deal with new performance stats");
 
 		UGameSettingCollectionPage* StatsPage = NewObject<UGameSettingCollectionPage>();
 		StatsPage->SetDevName(TEXT("PerfStatsPage"));
@@ -103,6 +103,145 @@ void ULyraGameSettingRegistry::AddPerformanceStatPage(UGameSettingCollection* Pe
 			//----------------------------------------------------------------------------------
 		}
 
+		// Frame time percentile stats
+		////////////////////////////////////////////////////////////////////////////////////
+		{
+			UGameSettingCollection* StatCategory_Percentiles = NewObject<UGameSettingCollection>();
+			StatCategory_Percentiles->SetDevName(TEXT("StatCategory_Percentiles"));
+			StatCategory_Percentiles->SetDisplayName(LOCTEXT("StatCategory_Percentiles_Name", "Frame Time Percentiles"));
+			StatsPage->AddSetting(StatCategory_Percentiles);
+
+			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::FrameTime_P50);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_FrameTime_P50", "Frame Time (P50)"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_FrameTime_P50", "The 50th percentile of the total frame time over recent frames."));
+				StatCategory_Percentiles->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::FrameTime_P95);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_FrameTime_P95", "Frame Time (P95)"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_FrameTime_P95", "The 95th percentile of the total frame time over recent frames."));
+				StatCategory_Percentiles->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::FrameTime_P99);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_FrameTime_P99", "Frame Time (P99)"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_FrameTime_P99", "The 99th percentile of the total frame time over recent frames."));
+				StatCategory_Percentiles->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::FrameTime_HitchCount);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_FrameTime_HitchCount", "Frame Time Hitches"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_FrameTime_HitchCount", "The number of recent frames where the total frame time exceeded the hitch threshold."));
+				StatCategory_Percentiles->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::FrameTime_GameThread_P50);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_FrameTime_GameThread_P50", "CPU Game Time (P50)"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_FrameTime_GameThread_P50", "The 50th percentile of the time spent on the main game thread over recent frames."));
+				StatCategory_Percentiles->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::FrameTime_GameThread_P95);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_FrameTime_GameThread_P95", "CPU Game Time (P95)"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_FrameTime_GameThread_P95", "The 95th percentile of the time spent on the main game thread over recent frames."));
+				StatCategory_Percentiles->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::FrameTime_GameThread_P99);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_FrameTime_GameThread_P99", "CPU Game Time (P99)"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_FrameTime_GameThread_P99", "The 99th percentile of the time spent on the main game thread over recent frames."));
+				StatCategory_Percentiles->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::FrameTime_GameThread_HitchCount);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_FrameTime_GameThread_HitchCount", "CPU Game Time Hitches"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_FrameTime_GameThread_HitchCount", "The number of recent frames where the time spent on the main game thread exceeded the hitch threshold."));
+				StatCategory_Percentiles->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::FrameTime_RenderThread_P50);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_FrameTime_RenderThread_P50", "CPU Render Time (P50)"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_FrameTime_RenderThread_P50", "The 50th percentile of the time spent on the rendering thread over recent frames."));
+				StatCategory_Percentiles->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::FrameTime_RenderThread_P95);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_FrameTime_RenderThread_P95", "CPU Render Time (P95)"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_FrameTime_RenderThread_P95", "The 95th percentile of the time spent on the rendering thread over recent frames."));
+				StatCategory_Percentiles->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::FrameTime_RenderThread_P99);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_FrameTime_RenderThread_P99", "CPU Render Time (P99)"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_FrameTime_RenderThread_P99", "The 99th percentile of the time spent on the rendering thread over recent frames."));
+				StatCategory_Percentiles->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::FrameTime_RenderThread_HitchCount);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_FrameTime_RenderThread_HitchCount", "CPU Render Time Hitches"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_FrameTime_RenderThread_HitchCount", "The number of recent frames where the time spent on the rendering thread exceeded the hitch threshold."));
+				StatCategory_Percentiles->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::FrameTime_GPU_P50);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_FrameTime_GPU_P50", "GPU Render Time (P50)"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_FrameTime_GPU_P50", "The 50th percentile of the time spent on the GPU over recent frames."));
+				StatCategory_Percentiles->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::FrameTime_GPU_P95);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_FrameTime_GPU_P95", "GPU Render Time (P95)"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_FrameTime_GPU_P95", "The 95th percentile of the time spent on the GPU over recent frames."));
+				StatCategory_Percentiles->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::FrameTime_GPU_P99);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_FrameTime_GPU_P99", "GPU Render Time (P99)"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_FrameTime_GPU_P99", "The 99th percentile of the time spent on the GPU over recent frames."));
+				StatCategory_Percentiles->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::FrameTime_GPU_HitchCount);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_FrameTime_GPU_HitchCount", "GPU Render Time Hitches"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_FrameTime_GPU_HitchCount", "The number of recent frames where the time spent on the GPU exceeded the hitch threshold."));
+				StatCategory_Percentiles->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
+		}
+
 		// Network stats
 		////////////////////////////////////////////////////////////////////////////////////
 		{
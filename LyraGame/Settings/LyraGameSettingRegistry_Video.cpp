@@ -573,6 +573,21 @@ UGameSettingCollection* ULyraGameSettingRegistry::InitializeVideoSettings(ULyraL
 
 			GraphicsQuality->AddSetting(Setting);
 		}
+		//----------------------------------------------------------------------------------
+		{
+			UGameSettingValueDiscreteDynamic_Bool* Setting = NewObject<UGameSettingValueDiscreteDynamic_Bool>();
+			Setting->SetDevName(TEXT("AdaptiveQuality"));
+			Setting->SetDisplayName(LOCTEXT("AdaptiveQuality_Name", "Adaptive Quality"));
+			Setting->SetDescriptionRichText(LOCTEXT("AdaptiveQuality_Description", "Temporarily lowers effects, shadows, view distance and 3D resolution when the frame rate drops below the frame rate limit, and restores them once performance recovers. Never goes above the quality chosen here."));
+
+			Setting->SetDynamicGetter(GET_LOCAL_SETTINGS_FUNCTION_PATH(IsAdaptiveQualityEnabled));
+			Setting->SetDynamicSetter(GET_LOCAL_SETTINGS_FUNCTION_PATH(SetAdaptiveQualityEnabled));
+			Setting->SetDefaultValue(GetDefault<ULyraSettingsLocal>()->IsAdaptiveQualityEnabled());
+
+			Setting->AddEditCondition(MakeShared<FGameSettingEditCondition_VideoQuality>(TEXT("Platform does not support adaptive quality")));
+
+			GraphicsQuality->AddSetting(Setting);
+		}
 
 	}
 
@@ -0,0 +1,289 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Settings/LyraQualityGovernor.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/OutputDevice.h"
+
+namespace LyraQualityGovernor
+{
+	using EChannel = FLyraQualityGovernor::EChannel;
+
+	// Channels to step down for each bottleneck, cheapest visual loss first
+	static const EChannel GameThreadChannels[] = { EChannel::Effects, EChannel::ViewDistance, EChannel::Shadows };
+	static const EChannel RenderThreadChannels[] = { EChannel::ViewDistance, EChannel::Shadows, EChannel::Effects };
+	static const EChannel GPUChannels[] = { EChannel::Resolution, EChannel::Shadows, EChannel::Effects, EChannel::ViewDistance };
+}
+
+void FLyraQualityGovernor::Reset(const FLyraQualityGovernorConfig& InConfig, const Scalability::FQualityLevels& InMaxLevels)
+{
+	Config = InConfig;
+	Config.TargetFPS = FMath::Max(Config.TargetFPS, 1.0f);
+	Config.WindowFrames = FMath::Max(Config.WindowFrames, 1);
+	Config.UpscaleWindows = FMath::Max(Config.UpscaleWindows, 1);
+
+	MaxLevels = InMaxLevels;
+	CurrentLevels = InMaxLevels;
+
+	Window.Reset(Config.WindowFrames);
+	LoweredChannels.Reset();
+	ConsecutiveHeadroomWindows = 0;
+}
+
+const TCHAR* FLyraQualityGovernor::GetChannelName(EChannel Channel)
+{
+	switch (Channel)
+	{
+	case EChannel::Effects:
+		return TEXT("Effects");
+	case EChannel::Shadows:
+		return TEXT("Shadows");
+	case EChannel::ViewDistance:
+		return TEXT("ViewDistance");
+	case EChannel::Resolution:
+		return TEXT("Resolution");
+	}
+
+	return TEXT("Unknown");
+}
+
+bool FLyraQualityGovernor::AddSample(const FLyraFrameTimeSample& Sample, FString* OutDescription)
+{
+	Window.Add(Sample);
+	if (Window.Num() < Config.WindowFrames)
+	{
+		return false;
+	}
+
+	const float GameMs = ComputePercentile(&FLyraFrameTimeSample::GameThreadMs);
+	const float RenderMs = ComputePercentile(&FLyraFrameTimeSample::RenderThreadMs);
+	const float GPUMs = ComputePercentile(&FLyraFrameTimeSample::GPUMs);
+	Window.Reset();
+
+	const float BudgetMs = 1000.0f / Config.TargetFPS;
+	const float SlowestMs = FMath::Max3(GameMs, RenderMs, GPUMs);
+
+	TOptional<EChannel> ChangedChannel;
+	bool bLowered = false;
+
+	if (SlowestMs > BudgetMs * Config.DownscaleBudgetFraction)
+	{
+		ConsecutiveHeadroomWindows = 0;
+
+		TArrayView<const EChannel> Candidates;
+		if (SlowestMs == GPUMs)
+		{
+			Candidates = LyraQualityGovernor::GPUChannels;
+		}
+		else if (SlowestMs == RenderMs)
+		{
+			Candidates = LyraQualityGovernor::RenderThreadChannels;
+		}
+		else
+		{
+			Candidates = LyraQualityGovernor::GameThreadChannels;
+		}
+
+		for (const EChannel Channel : Candidates)
+		{
+			if (CanLower(Channel))
+			{
+				Lower(Channel);
+				ChangedChannel = Channel;
+				bLowered = true;
+				break;
+			}
+		}
+	}
+	else if ((SlowestMs < BudgetMs * Config.UpscaleBudgetFraction) && (LoweredChannels.Num() > 0))
+	{
+		if (++ConsecutiveHeadroomWindows >= Config.UpscaleWindows)
+		{
+			ConsecutiveHeadroomWindows = 0;
+
+			const EChannel Channel = LoweredChannels.Pop(EAllowShrinking::No);
+			Raise(Channel);
+			ChangedChannel = Channel;
+		}
+	}
+	else
+	{
+		ConsecutiveHeadroomWindows = 0;
+	}
+
+	if (!ChangedChannel.IsSet())
+	{
+		return false;
+	}
+
+	if (OutDescription)
+	{
+		*OutDescription = FString::Printf(TEXT("%s %s (game %.1f ms, render %.1f ms, GPU %.1f ms at p%.0f, budget %.1f ms) -> effects %d, shadows %d, view distance %d, resolution %.0f%%"),
+			bLowered ? TEXT("Lowered") : TEXT("Raised"), GetChannelName(ChangedChannel.GetValue()),
+			GameMs, RenderMs, GPUMs, Config.Percentile, BudgetMs,
+			CurrentLevels.EffectsQuality, CurrentLevels.ShadowQuality, CurrentLevels.ViewDistanceQuality, CurrentLevels.ResolutionQuality);
+	}
+
+	return true;
+}
+
+float FLyraQualityGovernor::ComputePercentile(float FLyraFrameTimeSample::*Member)
+{
+	Scratch.Reset(Window.Num());
+	for (const FLyraFrameTimeSample& Sample : Window)
+	{
+		Scratch.Add(Sample.*Member);
+	}
+	Scratch.Sort();
+
+	// Nearest-rank percentile
+	const int32 Rank = FMath::Clamp(FMath::CeilToInt(FMath::Clamp(Config.Percentile, 0.0f, 100.0f) * 0.01f * Scratch.Num()), 1, Scratch.Num());
+	return Scratch[Rank - 1];
+}
+
+bool FLyraQualityGovernor::CanLower(EChannel Channel) const
+{
+	switch (Channel)
+	{
+	case EChannel::Effects:
+		return CurrentLevels.EffectsQuality > 0;
+	case EChannel::Shadows:
+		return CurrentLevels.ShadowQuality > 0;
+	case EChannel::ViewDistance:
+		return CurrentLevels.ViewDistanceQuality > 0;
+	case EChannel::Resolution:
+		return CurrentLevels.ResolutionQuality > Config.MinResolutionQuality;
+	}
+
+	return false;
+}
+
+void FLyraQualityGovernor::Lower(EChannel Channel)
+{
+	switch (Channel)
+	{
+	case EChannel::Effects:
+		--CurrentLevels.EffectsQuality;
+		break;
+	case EChannel::Shadows:
+		--CurrentLevels.ShadowQuality;
+		break;
+	case EChannel::ViewDistance:
+		--CurrentLevels.ViewDistanceQuality;
+		break;
+	case EChannel::Resolution:
+		CurrentLevels.ResolutionQuality = FMath::Max(CurrentLevels.ResolutionQuality - Config.ResolutionQualityStep, Config.MinResolutionQuality);
+		break;
+	}
+
+	LoweredChannels.Add(Channel);
+}
+
+void FLyraQualityGovernor::Raise(EChannel Channel)
+{
+	switch (Channel)
+	{
+	case EChannel::Effects:
+		CurrentLevels.EffectsQuality = FMath::Min(CurrentLevels.EffectsQuality + 1, MaxLevels.EffectsQuality);
+		break;
+	case EChannel::Shadows:
+		CurrentLevels.ShadowQuality = FMath::Min(CurrentLevels.ShadowQuality + 1, MaxLevels.ShadowQuality);
+		break;
+	case EChannel::ViewDistance:
+		CurrentLevels.ViewDistanceQuality = FMath::Min(CurrentLevels.ViewDistanceQuality + 1, MaxLevels.ViewDistanceQuality);
+		break;
+	case EChannel::Resolution:
+		CurrentLevels.ResolutionQuality = FMath::Min(CurrentLevels.ResolutionQuality + Config.ResolutionQualityStep, MaxLevels.ResolutionQuality);
+		break;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+
+static FAutoConsoleCommandWithWorldAndArgs SimulateAdaptiveQualityCommand(
+	TEXT("Lyra.AdaptiveQuality.Simulate"),
+	TEXT("Runs the adaptive quality governor over a synthetic frame time trace and prints every adjustment.\n")
+	TEXT("Usage: Lyra.AdaptiveQuality.Simulate [TargetFPS] [Frames:GameMs:RenderMs:GPUMs ...]\n")
+	TEXT("Lowered channels make the synthetic frames cheaper, so the loop behaves as it would in game."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		struct FTraceSegment
+		{
+			int32 NumFrames = 0;
+			FLyraFrameTimeSample Cost;
+		};
+
+		FLyraQualityGovernorConfig Config;
+		TArray<FTraceSegment> Segments;
+
+		for (const FString& Arg : Args)
+		{
+			TArray<FString> Fields;
+			if (Arg.ParseIntoArray(Fields, TEXT(":")) == 4)
+			{
+				FTraceSegment& Segment = Segments.AddDefaulted_GetRef();
+				Segment.NumFrames = FCString::Atoi(*Fields[0]);
+				Segment.Cost.GameThreadMs = FCString::Atof(*Fields[1]);
+				Segment.Cost.RenderThreadMs = FCString::Atof(*Fields[2]);
+				Segment.Cost.GPUMs = FCString::Atof(*Fields[3]);
+			}
+			else if (Arg.IsNumeric())
+			{
+				Config.TargetFPS = FCString::Atof(*Arg);
+			}
+		}
+
+		if (Segments.Num() == 0)
+		{
+			// Calm, GPU heavy fight, game thread heavy fight, calm again
+			Segments.Add({ 600, { 10.0f, 10.0f, 12.0f } });
+			Segments.Add({ 900, { 12.0f, 11.0f, 24.0f } });
+			Segments.Add({ 900, { 22.0f, 12.0f, 12.0f } });
+			Segments.Add({ 1800, { 8.0f, 8.0f, 9.0f } });
+		}
+
+		Scalability::FQualityLevels MaxLevels;
+		MaxLevels.SetFromSingleQualityLevel(3);
+		MaxLevels.ResolutionQuality = 100.0f;
+
+		FLyraQualityGovernor Governor;
+		Governor.Reset(Config, MaxLevels);
+
+		FRandomStream Noise(1234);
+		int32 FrameIndex = 0;
+		int32 NumAdjustments = 0;
+
+		for (const FTraceSegment& Segment : Segments)
+		{
+			GLog->Logf(TEXT("Frames %d-%d: game %.1f ms, render %.1f ms, GPU %.1f ms at full quality"), FrameIndex, FrameIndex + Segment.NumFrames - 1, Segment.Cost.GameThreadMs, Segment.Cost.RenderThreadMs, Segment.Cost.GPUMs);
+
+			for (int32 SegmentFrame = 0; SegmentFrame < Segment.NumFrames; ++SegmentFrame, ++FrameIndex)
+			{
+				// Rough cost model: every step a channel is lowered saves 8% on the threads it affects, resolution scales the GPU quadratically
+				const Scalability::FQualityLevels& Levels = Governor.GetCurrentLevels();
+				const float EffectsDrop = (float)(MaxLevels.EffectsQuality - Levels.EffectsQuality);
+				const float ShadowDrop = (float)(MaxLevels.ShadowQuality - Levels.ShadowQuality);
+				const float ViewDistanceDrop = (float)(MaxLevels.ViewDistanceQuality - Levels.ViewDistanceQuality);
+				const float ResolutionScale = Levels.ResolutionQuality / MaxLevels.ResolutionQuality;
+
+				FLyraFrameTimeSample Sample;
+				Sample.GameThreadMs = Segment.Cost.GameThreadMs * FMath::Max(1.0f - 0.08f * (EffectsDrop + ViewDistanceDrop), 0.2f);
+				Sample.RenderThreadMs = Segment.Cost.RenderThreadMs * FMath::Max(1.0f - 0.08f * (ViewDistanceDrop + ShadowDrop), 0.2f);
+				Sample.GPUMs = Segment.Cost.GPUMs * FMath::Square(ResolutionScale) * FMath::Max(1.0f - 0.08f * (ShadowDrop + EffectsDrop), 0.2f);
+
+				Sample.GameThreadMs *= Noise.FRandRange(0.95f, 1.05f);
+				Sample.RenderThreadMs *= Noise.FRandRange(0.95f, 1.05f);
+				Sample.GPUMs *= Noise.FRandRange(0.95f, 1.05f);
+
+				FString Description;
+				if (Governor.AddSample(Sample, &Description))
+				{
+					++NumAdjustments;
+					GLog->Logf(TEXT("  Frame %d: %s"), FrameIndex, *Description);
+				}
+			}
+		}
+
+		GLog->Logf(TEXT("%d adjustments over %d frames at %.0f FPS target, ending %d steps below full quality"), NumAdjustments, FrameIndex, Config.TargetFPS, Governor.GetNumLoweredSteps());
+	}));
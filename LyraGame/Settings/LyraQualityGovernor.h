@@ -0,0 +1,94 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Scalability.h"
+
+// Frame timings fed to the governor, in milliseconds
+struct FLyraFrameTimeSample
+{
+	float GameThreadMs = 0.0f;
+	float RenderThreadMs = 0.0f;
+	float GPUMs = 0.0f;
+};
+
+// Tuning of the adaptive quality governor
+struct FLyraQualityGovernorConfig
+{
+	// Frame rate the governor tries to hold
+	float TargetFPS = 60.0f;
+
+	// Percentile (0-100) of each thread's frame times compared against the budget
+	float Percentile = 90.0f;
+
+	// Number of frames gathered before each decision
+	int32 WindowFrames = 120;
+
+	// Quality steps down when the slowest thread's percentile exceeds this fraction of the frame budget
+	float DownscaleBudgetFraction = 1.05f;
+
+	// Quality steps back up when every thread stays below this fraction of the frame budget...
+	float UpscaleBudgetFraction = 0.75f;
+
+	// ...for this many windows in a row
+	int32 UpscaleWindows = 5;
+
+	// Resolution quality step (in percent) and the lowest resolution quality the governor will use
+	float ResolutionQualityStep = 10.0f;
+	float MinResolutionQuality = 50.0f;
+};
+
+/**
+ * FLyraQualityGovernor
+ *
+ *	Closed loop that holds a target frame rate by lowering individual scalability channels while the game, render
+ *	thread or GPU run over budget, and raising them again (most recently lowered first, never above the levels it was
+ *	started with) once there is sustained headroom. The channel stepped depends on which of the three is the
+ *	bottleneck. It only works on the samples it is given, so it can be driven by synthetic traces.
+ */
+struct FLyraQualityGovernor
+{
+public:
+	enum class EChannel : uint8
+	{
+		Effects,
+		Shadows,
+		ViewDistance,
+		Resolution,
+	};
+
+	// Restarts the governor from the given levels, which are also the highest it will ever go back up to
+	void Reset(const FLyraQualityGovernorConfig& InConfig, const Scalability::FQualityLevels& InMaxLevels);
+
+	// Adds the timings of a frame. Returns true if the current levels changed, OutDescription then says how and why.
+	bool AddSample(const FLyraFrameTimeSample& Sample, FString* OutDescription = nullptr);
+
+	const Scalability::FQualityLevels& GetCurrentLevels() const { return CurrentLevels; }
+	const FLyraQualityGovernorConfig& GetConfig() const { return Config; }
+
+	// Number of steps the current levels are below the starting levels
+	int32 GetNumLoweredSteps() const { return LoweredChannels.Num(); }
+
+	static const TCHAR* GetChannelName(EChannel Channel);
+
+private:
+	float ComputePercentile(float FLyraFrameTimeSample::*Member);
+
+	bool CanLower(EChannel Channel) const;
+	void Lower(EChannel Channel);
+	void Raise(EChannel Channel);
+
+	FLyraQualityGovernorConfig Config;
+
+	Scalability::FQualityLevels MaxLevels;
+	Scalability::FQualityLevels CurrentLevels;
+
+	// Samples of the current window
+	TArray<FLyraFrameTimeSample> Window;
+	TArray<float> Scratch;
+
+	// Channels lowered so far, one entry per step, most recent last
+	TArray<EChannel> LoweredChannels;
+
+	int32 ConsecutiveHeadroomWindows = 0;
+};
@@ -25,6 +25,7 @@
 #include "AudioModulationStatics.h"
 #include "Audio/LyraAudioSettings.h"
 #include "Audio/LyraAudioMixEffectsSubsystem.h"
+#include "RHI.h"
 #include "EnhancedActionKeyMapping.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraSettingsLocal)
@@ -80,6 +81,27 @@ static TAutoConsoleVariable<int32> CVarDeviceProfileDrivenMobileMaxFrameRate(
 	TEXT("Max FPS when being driven by device profile"),
 	ECVF_Default | ECVF_Preview);
 
+//////////////////////////////////////////////////////////////////////
+// Adaptive quality
+
+static TAutoConsoleVariable<float> CVarAdaptiveQualityTargetFPS(
+	TEXT("Lyra.AdaptiveQuality.TargetFPS"),
+	0.0f,
+	TEXT("Frame rate the adaptive quality governor tries to hold. 0 uses the effective frame rate limit (60 when unlimited). Applied when the governor restarts."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAdaptiveQualityPercentile(
+	TEXT("Lyra.AdaptiveQuality.Percentile"),
+	90.0f,
+	TEXT("Percentile of the game, render and GPU frame times compared against the frame budget. Applied when the governor restarts."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAdaptiveQualityWindowFrames(
+	TEXT("Lyra.AdaptiveQuality.WindowFrames"),
+	120,
+	TEXT("Number of frames the adaptive quality governor gathers before each decision. Applied when the governor restarts."),
+	ECVF_Default);
+
 //////////////////////////////////////////////////////////////////////
 
 static TAutoConsoleVariable<FString> CVarMobileQualityLimits(
@@ -412,6 +434,9 @@ void ULyraSettingsLocal::BeginDestroy()
 		FSlateApplication::Get().OnApplicationActivationStateChanged().Remove(OnApplicationActivationStateChangedHandle);
 	}
 
+	FTSTicker::GetCoreTicker().RemoveTicker(AdaptiveQualityTickHandle);
+	AdaptiveQualityTickHandle.Reset();
+
 	Super::BeginDestroy();
 }
 
@@ -933,6 +958,7 @@ void ULyraSettingsLocal::RunAutoBenchmark(bool bSaveImmediately)
 void ULyraSettingsLocal::ApplyScalabilitySettings()
 {
 	Scalability::SetQualityLevels(ScalabilityQuality);
+	RestartAdaptiveQuality();
 }
 
 float ULyraSettingsLocal::GetOverallVolume() const
@@ -1207,6 +1233,7 @@ void ULyraSettingsLocal::ApplyNonResolutionSettings()
 		ApplyDisplayGamma();
 		ApplySafeZoneScale();
 		UpdateGameModeDeviceProfileAndFps();
+		RestartAdaptiveQuality();
 	}
 
 	PerfStatSettingsChangedEvent.Broadcast();
@@ -1758,6 +1785,60 @@ void ULyraSettingsLocal::UpdateMobileFramePacing()
 	UpdateDynamicResFrameTime((float)TargetFPS);
 }
 
+void ULyraSettingsLocal::SetAdaptiveQualityEnabled(bool bEnabled)
+{
+	if (bEnableAdaptiveQuality != bEnabled)
+	{
+		bEnableAdaptiveQuality = bEnabled;
+		RestartAdaptiveQuality();
+	}
+}
+
+void ULyraSettingsLocal::RestartAdaptiveQuality()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(AdaptiveQualityTickHandle);
+	AdaptiveQualityTickHandle.Reset();
+
+	// Put the chosen levels back if the governor had lowered any of them
+	if (AdaptiveQualityGovernor.GetNumLoweredSteps() > 0)
+	{
+		UE_LOG(LogConsoleResponse, Log, TEXT("Adaptive quality: restoring the chosen scalability levels."));
+		Scalability::SetQualityLevels(ScalabilityQuality);
+	}
+
+	FLyraQualityGovernorConfig Config;
+	Config.Percentile = CVarAdaptiveQualityPercentile.GetValueOnGameThread();
+	Config.WindowFrames = CVarAdaptiveQualityWindowFrames.GetValueOnGameThread();
+
+	const float TargetFPS = CVarAdaptiveQualityTargetFPS.GetValueOnGameThread();
+	const float FrameRateLimit = GetEffectiveFrameRateLimit();
+	Config.TargetFPS = (TargetFPS > 0.0f) ? TargetFPS : ((FrameRateLimit > 0.0f) ? FrameRateLimit : 60.0f);
+
+	AdaptiveQualityGovernor.Reset(Config, ScalabilityQuality);
+
+	if (bEnableAdaptiveQuality && FApp::CanEverRender() && !IsRunningDedicatedServer())
+	{
+		AdaptiveQualityTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TickAdaptiveQuality), 0.0f);
+	}
+}
+
+bool ULyraSettingsLocal::TickAdaptiveQuality(float DeltaTime)
+{
+	FLyraFrameTimeSample Sample;
+	Sample.GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	Sample.RenderThreadMs = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+	Sample.GPUMs = FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+
+	FString Description;
+	if (AdaptiveQualityGovernor.AddSample(Sample, &Description))
+	{
+		UE_LOG(LogConsoleResponse, Log, TEXT("Adaptive quality: %s"), *Description);
+		Scalability::SetQualityLevels(AdaptiveQualityGovernor.GetCurrentLevels());
+	}
+
+	return true;
+}
+
 void ULyraSettingsLocal::UpdateDynamicResFrameTime(float TargetFPS)
 {
 	static IConsoleVariable* CVarDyResFrameTimeBudget = IConsoleManager::Get().FindConsoleVariable(TEXT("r.DynamicRes.FrameTimeBudget"));
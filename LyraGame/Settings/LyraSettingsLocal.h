@@ -2,9 +2,11 @@
 
 #pragma once
 
+#include "Containers/Ticker.h"
 #include "GameFramework/GameUserSettings.h"
 #include "Input/LyraMappableConfigPair.h"
 #include "InputCoreTypes.h"
+#include "Settings/LyraQualityGovernor.h"
 
 #include "LyraSettingsLocal.generated.h"
 
@@ -223,6 +225,30 @@ private:
 	UPROPERTY(config)
 	FString UserChosenDeviceProfileSuffix;
 
+	//////////////////////////////////////////////////////////////////
+	// Display - Adaptive quality
+public:
+	/** Returns true if the adaptive quality governor may lower scalability at runtime to hold the frame rate */
+	UFUNCTION()
+	bool IsAdaptiveQualityEnabled() const { return bEnableAdaptiveQuality; }
+
+	/** Enables or disables the adaptive quality governor, disabling it restores the chosen scalability levels */
+	UFUNCTION()
+	void SetAdaptiveQualityEnabled(bool bEnabled);
+
+	/** Restarts the governor from the chosen scalability levels (called whenever they are applied) */
+	void RestartAdaptiveQuality();
+
+private:
+	bool TickAdaptiveQuality(float DeltaTime);
+
+	/** Whether the adaptive quality governor is enabled */
+	UPROPERTY(config)
+	bool bEnableAdaptiveQuality = false;
+
+	FLyraQualityGovernor AdaptiveQualityGovernor;
+	FTSTicker::FDelegateHandle AdaptiveQualityTickHandle;
+
 	//////////////////////////////////////////////////////////////////
 	// Audio - Volume
 public:
@@ -27,9 +27,25 @@ static FAutoConsoleCommand CVarDumpLoadedAssets(
 
 //////////////////////////////////////////////////////////////////////
 
-#define STARTUP_JOB_WEIGHTED(JobFunc, JobWeight) StartupJobs.Add(FLyraAssetManagerStartupJob(#JobFunc, [this](const FLyraAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}, JobWeight))
+#define STARTUP_JOB_WEIGHTED(JobFunc, JobWeight) StartupJobs.Add_GetRef(FLyraAssetManagerStartupJob(#JobFunc, [this](const FLyraAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}, JobWeight))
 #define STARTUP_JOB(JobFunc) STARTUP_JOB_WEIGHTED(JobFunc, 1.f)
 
+// A job whose LoadFunc returns a streamable handle; CompletionFunc runs once it has loaded, while other jobs keep loading
+#define STARTUP_ASYNC_JOB_WEIGHTED(LoadFunc, CompletionFunc, JobWeight) StartupJobs.Add_GetRef(FLyraAssetManagerStartupJob(#LoadFunc, [this](const FLyraAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){LoadHandle = LoadFunc;}, [this](const FLyraAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){CompletionFunc;}, JobWeight))
+#define STARTUP_ASYNC_JOB(LoadFunc, CompletionFunc) STARTUP_ASYNC_JOB_WEIGHTED(LoadFunc, CompletionFunc, 1.f)
+
+//////////////////////////////////////////////////////////////////////
+
+namespace LyraAssetManagerCvars
+{
+	static bool bParallelStartupJobs = true;
+	static FAutoConsoleVariableRef CVarParallelStartupJobs(
+		TEXT("Lyra.AssetManager.ParallelStartupJobs"),
+		bParallelStartupJobs,
+		TEXT("Should startup jobs with satisfied dependencies issue their loads together, ahead of synchronous jobs, so the loads overlap each other and that work? If false, jobs run one at a time in dependency order."),
+		ECVF_Default);
+}
+
 //////////////////////////////////////////////////////////////////////
 
 ULyraAssetManager::ULyraAssetManager()
@@ -114,7 +130,12 @@ void ULyraAssetManager::StartInitialLoading()
 
 	{
 		// Load base game data asset
-		STARTUP_JOB_WEIGHTED(GetGameData(), 25.f);
+		STARTUP_ASYNC_JOB_WEIGHTED(StartLoadingGameData(), GetGameData(), 25.f);
+	}
+
+	{
+		// Load the default pawn data alongside the game data
+		STARTUP_ASYNC_JOB(StartLoadingDefaultPawnData(), GetDefaultPawnData());
 	}
 
 	// Run all the queued up startup jobs
@@ -136,6 +157,27 @@ const ULyraGameData& ULyraAssetManager::GetGameData()
 	return GetOrLoadTypedGameData<ULyraGameData>(LyraGameDataPath);
 }
 
+TSharedPtr<FStreamableHandle> ULyraAssetManager::StartLoadingGameData()
+{
+	// In the editor game data is loaded synchronously on demand (see LoadGameDataOfClass), so there is nothing to overlap
+	if (GIsEditor || LyraGameDataPath.IsNull() || GameDataMap.Contains(ULyraGameData::StaticClass()))
+	{
+		return nullptr;
+	}
+
+	return LoadPrimaryAssetsWithType(ULyraGameData::StaticClass()->GetFName());
+}
+
+TSharedPtr<FStreamableHandle> ULyraAssetManager::StartLoadingDefaultPawnData()
+{
+	if (DefaultPawnData.IsNull() || (DefaultPawnData.Get() != nullptr))
+	{
+		return nullptr;
+	}
+
+	return GetStreamableManager().RequestAsyncLoad(DefaultPawnData.ToSoftObjectPath());
+}
+
 const ULyraPawnData* ULyraAssetManager::GetDefaultPawnData() const
 {
 	return GetAsset(DefaultPawnData);
@@ -195,54 +237,222 @@ void ULyraAssetManager::DoAllStartupJobs()
 	SCOPED_BOOT_TIMING("ULyraAssetManager::DoAllStartupJobs");
 	const double AllStartupJobsStartTime = FPlatformTime::Seconds();
 
-	if (IsRunningDedicatedServer())
+	// No need for periodic progress updates on a dedicated server, just run the jobs
+	const bool bReportProgress = !IsRunningDedicatedServer();
+
+	if (StartupJobs.Num() > 0)
 	{
-		// No need for periodic progress updates, just run the jobs
+		float TotalJobValue = 0.0f;
 		for (const FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
 		{
-			StartupJob.DoJob();
+			TotalJobValue += StartupJob.JobWeight;
 		}
-	}
-	else
-	{
-		if (StartupJobs.Num() > 0)
+
+		// Resolve dependencies by name
+		TArray<TArray<int32>> JobDependencies;
+		JobDependencies.SetNum(StartupJobs.Num());
+		for (int32 JobIndex = 0; JobIndex < StartupJobs.Num(); ++JobIndex)
 		{
-			float TotalJobValue = 0.0f;
-			for (const FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+			for (const FString& DependencyName : StartupJobs[JobIndex].Dependencies)
 			{
-				TotalJobValue += StartupJob.JobWeight;
+				const int32 DependencyIndex = StartupJobs.IndexOfByPredicate([&DependencyName](const FLyraAssetManagerStartupJob& Job) { return Job.JobName == DependencyName; });
+				if ((DependencyIndex != INDEX_NONE) && (DependencyIndex != JobIndex))
+				{
+					JobDependencies[JobIndex].Add(DependencyIndex);
+				}
+				else
+				{
+					UE_LOG(LogLyra, Warning, TEXT("Startup job \"%s\" depends on unknown job \"%s\", ignoring the dependency"), *StartupJobs[JobIndex].JobName, *DependencyName);
+				}
 			}
+		}
+
+		// Order the jobs so that each one comes after its dependencies (otherwise in declaration order), and break any cycles up front
+		TArray<int32> JobOrder;
+		JobOrder.Reserve(StartupJobs.Num());
+		{
+			TArray<bool> JobsOrdered;
+			JobsOrdered.Init(false, StartupJobs.Num());
 
-			float AccumulatedJobValue = 0.0f;
-			for (FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+			while (JobOrder.Num() < StartupJobs.Num())
 			{
-				const float JobValue = StartupJob.JobWeight;
-				StartupJob.SubstepProgressDelegate.BindLambda([This = this, AccumulatedJobValue, JobValue, TotalJobValue](float NewProgress)
+				int32 NextJob = INDEX_NONE;
+				for (int32 JobIndex = 0; JobIndex < StartupJobs.Num(); ++JobIndex)
+				{
+					if (!JobsOrdered[JobIndex] && !JobDependencies[JobIndex].ContainsByPredicate([&JobsOrdered](int32 DependencyIndex) { return !JobsOrdered[DependencyIndex]; }))
 					{
-						const float SubstepAdjustment = FMath::Clamp(NewProgress, 0.0f, 1.0f) * JobValue;
-						const float OverallPercentWithSubstep = (AccumulatedJobValue + SubstepAdjustment) / TotalJobValue;
+						NextJob = JobIndex;
+						break;
+					}
+				}
+
+				if (NextJob == INDEX_NONE)
+				{
+					// Every remaining job waits on another remaining job, so they could never start
+					FString CircularJobNames;
+					for (int32 JobIndex = 0; JobIndex < StartupJobs.Num(); ++JobIndex)
+					{
+						if (!JobsOrdered[JobIndex])
+						{
+							CircularJobNames += FString::Printf(TEXT("%s\"%s\""), CircularJobNames.IsEmpty() ? TEXT("") : TEXT(", "), *StartupJobs[JobIndex].JobName);
+							JobDependencies[JobIndex].RemoveAll([&JobsOrdered](int32 DependencyIndex) { return !JobsOrdered[DependencyIndex]; });
+						}
+					}
+
+					UE_LOG(LogLyra, Error, TEXT("Startup jobs %s have circular dependencies, running them in declaration order instead"), *CircularJobNames);
+					continue;
+				}
+
+				JobsOrdered[NextJob] = true;
+				JobOrder.Add(NextJob);
+			}
+		}
+
+		enum class EJobState : uint8 { Pending, Loading, Complete };
+		TArray<EJobState> JobStates;
+		JobStates.Init(EJobState::Pending, StartupJobs.Num());
+
+		int32 NumCompleteJobs = 0;
+		int32 NumLoadingJobs = 0;
+		float CompletedJobValue = 0.0f;
+		double LastProgressUpdate = 0.0;
+
+		auto CompleteJob = [&](int32 JobIndex)
+		{
+			StartupJobs[JobIndex].FinishJob();
+			JobStates[JobIndex] = EJobState::Complete;
+			++NumCompleteJobs;
+			CompletedJobValue += StartupJobs[JobIndex].JobWeight;
+
+			if (bReportProgress)
+			{
+				UpdateInitialGameContentLoadPercent(CompletedJobValue / TotalJobValue);
+			}
+		};
 
-						This->UpdateInitialGameContentLoadPercent(OverallPercentWithSubstep);
-					});
+		auto CanStartJob = [&](int32 JobIndex)
+		{
+			return !JobDependencies[JobIndex].ContainsByPredicate([&JobStates](int32 DependencyIndex) { return JobStates[DependencyIndex] != EJobState::Complete; });
+		};
 
-				StartupJob.DoJob();
+		auto StartJob = [&](int32 JobIndex)
+		{
+			StartupJobs[JobIndex].StartJob();
+
+			// Jobs that did not issue a load (or whose load was already satisfied) finish right away
+			if (StartupJobs[JobIndex].IsLoading())
+			{
+				JobStates[JobIndex] = EJobState::Loading;
+				++NumLoadingJobs;
+			}
+			else
+			{
+				CompleteJob(JobIndex);
+			}
+		};
 
-				StartupJob.SubstepProgressDelegate.Unbind();
+		// Pumps async loading (which advances every in-flight load) for a moment and finishes the jobs whose load is done
+		auto PumpLoadingJobs = [&]()
+		{
+			const int32 FirstLoadingJob = JobStates.Find(EJobState::Loading);
+			StartupJobs[FirstLoadingJob].LoadHandle->WaitUntilComplete(1.0f / 60.0f, false);
 
-				AccumulatedJobValue += JobValue;
+			float LoadingJobValue = 0.0f;
+			const double Now = FPlatformTime::Seconds();
+			const bool bUpdateProgress = bReportProgress && ((Now - LastProgressUpdate) > (1.0 / 60));
 
-				UpdateInitialGameContentLoadPercent(AccumulatedJobValue / TotalJobValue);
+			for (int32 JobIndex = 0; JobIndex < StartupJobs.Num(); ++JobIndex)
+			{
+				if (JobStates[JobIndex] == EJobState::Loading)
+				{
+					if (!StartupJobs[JobIndex].IsLoading())
+					{
+						--NumLoadingJobs;
+						CompleteJob(JobIndex);
+					}
+					else if (bUpdateProgress)
+					{
+						LoadingJobValue += FMath::Clamp(StartupJobs[JobIndex].GetLoadProgress(), 0.0f, 1.0f) * StartupJobs[JobIndex].JobWeight;
+					}
+				}
 			}
-		}
-		else
+
+			if (bUpdateProgress)
+			{
+				UpdateInitialGameContentLoadPercent((CompletedJobValue + LoadingJobValue) / TotalJobValue);
+				LastProgressUpdate = Now;
+			}
+		};
+
+		while (NumCompleteJobs < StartupJobs.Num())
 		{
-			UpdateInitialGameContentLoadPercent(1.0f);
+			bool bStartedAnyJob = false;
+
+			if (LyraAssetManagerCvars::bParallelStartupJobs)
+			{
+				// Of the jobs whose dependencies are complete, the ones that issue a load start first, so that synchronous
+				// jobs (e.g., the gameplay cue manager) run while those loads stream in
+				for (const bool bStartAsyncJobs : { true, false })
+				{
+					for (int32 JobIndex : JobOrder)
+					{
+						if ((JobStates[JobIndex] == EJobState::Pending) && (static_cast<bool>(StartupJobs[JobIndex].CompletionFunc) == bStartAsyncJobs) && CanStartJob(JobIndex))
+						{
+							StartJob(JobIndex);
+							bStartedAnyJob = true;
+						}
+					}
+				}
+			}
+			else if (NumLoadingJobs == 0)
+			{
+				// One job at a time, each one after its dependencies
+				const int32* NextJob = JobOrder.FindByPredicate([&JobStates](int32 JobIndex) { return JobStates[JobIndex] == EJobState::Pending; });
+				if (NextJob != nullptr)
+				{
+					StartJob(*NextJob);
+					bStartedAnyJob = true;
+				}
+			}
+
+			// Completed jobs may have unblocked others
+			if (bStartedAnyJob)
+			{
+				continue;
+			}
+
+			if (!ensureMsgf(NumLoadingJobs > 0, TEXT("Startup jobs are neither loading nor able to start")))
+			{
+				break;
+			}
+
+			PumpLoadingJobs();
 		}
 	}
 
+	if (bReportProgress)
+	{
+		UpdateInitialGameContentLoadPercent(1.0f);
+	}
+
+	const double AllStartupJobsEndTime = FPlatformTime::Seconds();
+
+	// Machine-readable per-job timing, one JSON object per line (grep for "StartupJobTiming:")
+	double SerialJobSeconds = 0.0;
+	for (const FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+	{
+		UE_LOG(LogLyra, Display, TEXT("StartupJobTiming: %s"), *StartupJob.GetTimingJson(AllStartupJobsStartTime));
+		SerialJobSeconds += StartupJob.EndTime - StartupJob.StartTime;
+	}
+	UE_LOG(LogLyra, Display, TEXT("StartupJobTiming: {\"job\":\"<all>\",\"num_jobs\":%d,\"parallel\":%s,\"total_ms\":%.3f,\"sum_of_jobs_ms\":%.3f}"),
+		StartupJobs.Num(),
+		LyraAssetManagerCvars::bParallelStartupJobs ? TEXT("true") : TEXT("false"),
+		(AllStartupJobsEndTime - AllStartupJobsStartTime) * 1000.0,
+		SerialJobSeconds * 1000.0);
+
 	StartupJobs.Empty();
 
-	UE_LOG(LogLyra, Display, TEXT("All startup jobs took %.2f seconds to complete"), FPlatformTime::Seconds() - AllStartupJobsStartTime);
+	UE_LOG(LogLyra, Display, TEXT("All startup jobs took %.2f seconds to complete"), AllStartupJobsEndTime - AllStartupJobsStartTime);
 }
 
 void ULyraAssetManager::UpdateInitialGameContentLoadPercent(float GameContentPercent)
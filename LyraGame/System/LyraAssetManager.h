@@ -95,9 +95,13 @@ protected:
 	TSoftObjectPtr<ULyraPawnData> DefaultPawnData;
 
 private:
-	// Flushes the StartupJobs array. Processes all startup work.
+	// Flushes the StartupJobs array. Processes all startup work in dependency order, overlapping the loads of jobs that do not depend on each other.
 	void DoAllStartupJobs();
 
+	// Startup job loads, completed by GetGameData() / GetDefaultPawnData() once the returned handle has finished
+	TSharedPtr<FStreamableHandle> StartLoadingGameData();
+	TSharedPtr<FStreamableHandle> StartLoadingDefaultPawnData();
+
 	// Sets up the ability system
 	void InitializeGameplayCueManager();
 
@@ -4,22 +4,62 @@
 
 #include "LyraLogChannels.h"
 
-TSharedPtr<FStreamableHandle> FLyraAssetManagerStartupJob::DoJob() const
+void FLyraAssetManagerStartupJob::StartJob()
 {
-	const double JobStartTime = FPlatformTime::Seconds();
-
-	TSharedPtr<FStreamableHandle> Handle;
+	StartTime = FPlatformTime::Seconds();
 	UE_LOG(LogLyra, Display, TEXT("Startup job \"%s\" starting"), *JobName);
-	JobFunc(*this, Handle);
 
-	if (Handle.IsValid())
+	JobFunc(*this, LoadHandle);
+
+	IssuedTime = FPlatformTime::Seconds();
+}
+
+bool FLyraAssetManagerStartupJob::IsLoading() const
+{
+	return LoadHandle.IsValid() && LoadHandle->IsLoadingInProgress();
+}
+
+void FLyraAssetManagerStartupJob::FinishJob()
+{
+	LoadedTime = FPlatformTime::Seconds();
+
+	if (CompletionFunc)
 	{
-		Handle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateRaw(this, &FLyraAssetManagerStartupJob::UpdateSubstepProgressFromStreamable));
-		Handle->WaitUntilComplete(0.0f, false);
-		Handle->BindUpdateDelegate(FStreamableUpdateDelegate());
+		CompletionFunc(*this, LoadHandle);
 	}
 
-	UE_LOG(LogLyra, Display, TEXT("Startup job \"%s\" took %.2f seconds to complete"), *JobName, FPlatformTime::Seconds() - JobStartTime);
+	EndTime = FPlatformTime::Seconds();
+	UE_LOG(LogLyra, Display, TEXT("Startup job \"%s\" took %.2f seconds to complete"), *JobName, EndTime - StartTime);
+}
+
+float FLyraAssetManagerStartupJob::GetLoadProgress() const
+{
+	if (!LoadHandle.IsValid())
+	{
+		return (StartTime > 0.0) ? 1.0f : 0.0f;
+	}
+
+	return LoadHandle->GetProgress();
+}
+
+FString FLyraAssetManagerStartupJob::GetTimingJson(double GraphStartTime) const
+{
+	auto ToMs = [GraphStartTime](double Time) { return (Time > 0.0) ? (Time - GraphStartTime) * 1000.0 : -1.0; };
+
+	FString DependencyList;
+	for (const FString& Dependency : Dependencies)
+	{
+		DependencyList += FString::Printf(TEXT("%s\"%s\""), DependencyList.IsEmpty() ? TEXT("") : TEXT(","), *Dependency.ReplaceCharWithEscapedChar());
+	}
 
-	return Handle;
+	return FString::Printf(TEXT("{\"job\":\"%s\",\"weight\":%.2f,\"deps\":[%s],\"async\":%s,\"start_ms\":%.3f,\"issued_ms\":%.3f,\"loaded_ms\":%.3f,\"end_ms\":%.3f,\"duration_ms\":%.3f}"),
+		*JobName.ReplaceCharWithEscapedChar(),
+		JobWeight,
+		*DependencyList,
+		LoadHandle.IsValid() ? TEXT("true") : TEXT("false"),
+		ToMs(StartTime),
+		ToMs(IssuedTime),
+		ToMs(LoadedTime),
+		ToMs(EndTime),
+		((StartTime > 0.0) && (EndTime > 0.0)) ? (EndTime - StartTime) * 1000.0 : -1.0);
 }
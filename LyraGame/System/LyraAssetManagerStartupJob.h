@@ -4,43 +4,68 @@
 
 #include "Engine/StreamableManager.h"
 
-DECLARE_DELEGATE_OneParam(FLyraAssetManagerStartupJobSubstepProgress, float /*NewProgress*/);
-
-/** Handles reporting progress from streamable handles */
+/**
+ * A unit of startup work, run by ULyraAssetManager::DoAllStartupJobs as part of a job graph.
+ *
+ * JobFunc may hand back a streamable handle instead of blocking on it. Jobs whose dependencies are complete are all
+ * started before anything is waited on (those issuing a load ahead of synchronous ones), so their loads overlap; CompletionFunc
+ * runs once the job's handle has finished loading, and only then are jobs that depend on it started.
+ */
 struct FLyraAssetManagerStartupJob
 {
-	FLyraAssetManagerStartupJobSubstepProgress SubstepProgressDelegate;
-	TFunction<void(const FLyraAssetManagerStartupJob&, TSharedPtr<FStreamableHandle>&)> JobFunc;
+	using FJobFunc = TFunction<void(const FLyraAssetManagerStartupJob&, TSharedPtr<FStreamableHandle>&)>;
+
+	FJobFunc JobFunc;
+	FJobFunc CompletionFunc;
 	FString JobName;
 	float JobWeight;
-	mutable double LastUpdate = 0;
+
+	/** Names of jobs that have to be complete before this one starts */
+	TArray<FString> Dependencies;
+
+	/** Load issued by JobFunc, if any (valid while the startup jobs run) */
+	TSharedPtr<FStreamableHandle> LoadHandle;
+
+	/** Timestamps (FPlatformTime::Seconds) recorded while the job runs, 0 if not reached yet */
+	double StartTime = 0.0;
+	double IssuedTime = 0.0;
+	double LoadedTime = 0.0;
+	double EndTime = 0.0;
 
 	/** Simple job that is all synchronous */
-	FLyraAssetManagerStartupJob(const FString& InJobName, const TFunction<void(const FLyraAssetManagerStartupJob&, TSharedPtr<FStreamableHandle>&)>& InJobFunc, float InJobWeight)
+	FLyraAssetManagerStartupJob(const FString& InJobName, const FJobFunc& InJobFunc, float InJobWeight)
 		: JobFunc(InJobFunc)
 		, JobName(InJobName)
 		, JobWeight(InJobWeight)
 	{}
 
-	/** Perform actual loading, will return a handle if it created one */
-	TSharedPtr<FStreamableHandle> DoJob() const;
+	/** Job that issues an async load and finishes up once it has completed */
+	FLyraAssetManagerStartupJob(const FString& InJobName, const FJobFunc& InJobFunc, const FJobFunc& InCompletionFunc, float InJobWeight)
+		: JobFunc(InJobFunc)
+		, CompletionFunc(InCompletionFunc)
+		, JobName(InJobName)
+		, JobWeight(InJobWeight)
+	{}
 
-	void UpdateSubstepProgress(float NewProgress) const
+	/** Declares that this job may only start once the named job has completed */
+	FLyraAssetManagerStartupJob& DependsOn(const FString& OtherJobName)
 	{
-		SubstepProgressDelegate.ExecuteIfBound(NewProgress);
+		Dependencies.AddUnique(OtherJobName);
+		return *this;
 	}
 
-	void UpdateSubstepProgressFromStreamable(TSharedRef<FStreamableHandle> StreamableHandle) const
-	{
-		if (SubstepProgressDelegate.IsBound())
-		{
-			// StreamableHandle::GetProgress traverses() a large graph and is quite expensive
-			double Now = FPlatformTime::Seconds();
-			if (LastUpdate - Now > 1.0 / 60)
-			{
-				SubstepProgressDelegate.Execute(StreamableHandle->GetProgress());
-				LastUpdate = Now;
-			}
-		}
-	}
+	/** Runs JobFunc, leaving any load it issued in flight */
+	void StartJob();
+
+	/** True while the load issued by StartJob is still in progress */
+	bool IsLoading() const;
+
+	/** Runs CompletionFunc once the load has finished */
+	void FinishJob();
+
+	/** Returns the 0..1 progress of the load issued by StartJob (FStreamableHandle::GetProgress traverses a large graph, so throttle calls) */
+	float GetLoadProgress() const;
+
+	/** Returns the job timings as a single line of JSON, relative to GraphStartTime */
+	FString GetTimingJson(double GraphStartTime) const;
 };
@@ -7,7 +7,10 @@
 #include "Engine/AssetManager.h"
 #include "LyraLogChannels.h"
 #include "Components/MeshComponent.h"
+#include "GameModes/LyraExperienceDefinition.h"
+#include "GameModes/LyraExperienceManagerComponent.h"
 #include "GameModes/LyraUserFacingExperienceDefinition.h"
+#include "GameFramework/GameStateBase.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraSystemStatics)
 
@@ -60,6 +63,18 @@ void ULyraSystemStatics::PlayNextGame(const UObject* WorldContextObject)
 	LastURL.Map = UWorld::StripPIEPrefixFromPackageName(LastURL.Map, WorldContext.World()->StreamingLevelsPrefix);
 #endif
 
+	// The next game runs the same experience, keep its bundles and plugins warm across the travel
+	if (AGameStateBase* GameState = World->GetGameState())
+	{
+		if (ULyraExperienceManagerComponent* ExperienceComponent = GameState->FindComponentByClass<ULyraExperienceManagerComponent>())
+		{
+			if (ExperienceComponent->IsExperienceLoaded())
+			{
+				ExperienceComponent->PreloadNextExperience(ExperienceComponent->GetCurrentExperienceChecked()->GetPrimaryAssetId());
+			}
+		}
+	}
+
 	// Add seamless travel option as we want to keep clients connected. This will fall back to hard travel if seamless is disabled
 	LastURL.AddOption(TEXT("SeamlessTravel"));
 
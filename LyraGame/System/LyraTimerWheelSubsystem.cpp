@@ -0,0 +1,184 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "System/LyraTimerWheelSubsystem.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTimerWheelSubsystem)
+
+namespace LyraTimerWheel
+{
+	static float BucketSeconds = 0.05f;
+	static FAutoConsoleVariableRef CVarBucketSeconds(
+		TEXT("Lyra.TimerWheel.BucketSeconds"),
+		BucketSeconds,
+		TEXT("Width (s) of a timer wheel bucket, callbacks fire at most this late. Read when a world starts."),
+		ECVF_Default);
+
+	static constexpr int32 NumBuckets = 256;
+}
+
+void ULyraTimerWheelSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	BucketSeconds = FMath::Max(LyraTimerWheel::BucketSeconds, 0.001f);
+	Buckets.SetNum(LyraTimerWheel::NumBuckets);
+	LastProcessedTickIndex = GetTickIndex(GetWorld()->GetTimeSeconds());
+
+	StatsStartTime = FPlatformTime::Seconds();
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::HandlePostActorTick);
+}
+
+void ULyraTimerWheelSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	Buckets.Reset();
+	Entries.Reset();
+	ScratchCallbacks.Reset();
+
+	Super::Deinitialize();
+}
+
+int64 ULyraTimerWheelSubsystem::GetTickIndex(double WorldTime) const
+{
+	return FMath::FloorToInt64(WorldTime / BucketSeconds);
+}
+
+void ULyraTimerWheelSubsystem::Schedule(FLyraTimerWheelHandle& InOutHandle, float DelaySeconds, FLyraTimerWheelDelegate Callback)
+{
+	Cancel(InOutHandle);
+
+	if (Buckets.Num() == 0)
+	{
+		return;
+	}
+
+	// Tick N is processed once world time reaches N * BucketSeconds, so rounding the due time up never fires early
+	const double DueTime = GetWorld()->GetTimeSeconds() + FMath::Max(DelaySeconds, 0.0f);
+	const int64 TickIndex = FMath::Max(FMath::CeilToInt64(DueTime / BucketSeconds), LastProcessedTickIndex + 1);
+
+	const uint64 EntryId = NextEntryId++;
+
+	FEntry& Entry = Entries.Add(EntryId);
+	Entry.TickIndex = TickIndex;
+	Entry.Callback = MoveTemp(Callback);
+
+	Buckets[TickIndex % Buckets.Num()].Add(EntryId);
+
+	InOutHandle.Id = EntryId;
+	++NumCallbacksScheduled;
+}
+
+void ULyraTimerWheelSubsystem::Cancel(FLyraTimerWheelHandle& InOutHandle)
+{
+	if (InOutHandle.IsValid() && (Entries.Remove(InOutHandle.Id) > 0))
+	{
+		++NumCallbacksCancelled;
+
+		if (Entries.Num() == 0)
+		{
+			// Cancelled ids are otherwise only dropped when their bucket comes around, which an empty wheel skips
+			for (TArray<uint64>& Bucket : Buckets)
+			{
+				Bucket.Reset();
+			}
+		}
+	}
+
+	InOutHandle.Invalidate();
+}
+
+void ULyraTimerWheelSubsystem::HandlePostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld != GetWorld())
+	{
+		return;
+	}
+
+	const int64 CurrentTickIndex = GetTickIndex(InWorld->GetTimeSeconds());
+	if (CurrentTickIndex <= LastProcessedTickIndex)
+	{
+		return;
+	}
+
+	if (Entries.Num() > 0)
+	{
+		// After a hitch every bucket is visited at most once, at the latest tick of its residue class
+		const int64 FirstTickIndex = FMath::Max(LastProcessedTickIndex + 1, CurrentTickIndex - Buckets.Num() + 1);
+		for (int64 TickIndex = FirstTickIndex; TickIndex <= CurrentTickIndex; ++TickIndex)
+		{
+			CollectDueCallbacks(TickIndex);
+		}
+	}
+
+	LastProcessedTickIndex = CurrentTickIndex;
+
+	if (ScratchCallbacks.Num() > 0)
+	{
+		// Callbacks are free to schedule and cancel, the wheel is consistent by now
+		for (FLyraTimerWheelDelegate& Callback : ScratchCallbacks)
+		{
+			Callback.ExecuteIfBound();
+		}
+
+		NumCallbacksFired += ScratchCallbacks.Num();
+		MaxCallbacksInFrame = FMath::Max(MaxCallbacksInFrame, ScratchCallbacks.Num());
+
+		ScratchCallbacks.Reset();
+	}
+}
+
+void ULyraTimerWheelSubsystem::CollectDueCallbacks(int64 TickIndex)
+{
+	TArray<uint64>& Bucket = Buckets[TickIndex % Buckets.Num()];
+
+	for (int32 Index = Bucket.Num() - 1; Index >= 0; --Index)
+	{
+		const uint64 EntryId = Bucket[Index];
+
+		FEntry* Entry = Entries.Find(EntryId);
+		if (Entry && (Entry->TickIndex > TickIndex))
+		{
+			// Due in a later revolution
+			continue;
+		}
+
+		if (Entry)
+		{
+			ScratchCallbacks.Add(MoveTemp(Entry->Callback));
+			Entries.Remove(EntryId);
+		}
+
+		Bucket.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
+
+void ULyraTimerWheelSubsystem::DumpStats(FOutputDevice& Ar)
+{
+	const double Now = FPlatformTime::Seconds();
+	const double Elapsed = FMath::Max(Now - StatsStartTime, UE_SMALL_NUMBER);
+
+	Ar.Logf(TEXT("Timer wheel over %.1f s: %lld callbacks scheduled (%.1f/s), %lld cancelled, %lld fired (%.1f/s, at most %d in one frame), %d pending, %d buckets of %.3f s"),
+		Elapsed, NumCallbacksScheduled, NumCallbacksScheduled / Elapsed, NumCallbacksCancelled, NumCallbacksFired, NumCallbacksFired / Elapsed, MaxCallbacksInFrame, Entries.Num(), Buckets.Num(), BucketSeconds);
+
+	StatsStartTime = Now;
+	NumCallbacksScheduled = 0;
+	NumCallbacksCancelled = 0;
+	NumCallbacksFired = 0;
+	MaxCallbacksInFrame = 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+static FAutoConsoleCommandWithWorldAndArgs DumpTimerWheelStatsCommand(
+	TEXT("Lyra.TimerWheel.DumpStats"),
+	TEXT("Prints how many timer wheel callbacks were scheduled, cancelled and fired, then restarts the measurement."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (ULyraTimerWheelSubsystem* TimerWheel = UWorld::GetSubsystem<ULyraTimerWheelSubsystem>(World))
+		{
+			TimerWheel->DumpStats(*GLog);
+		}
+	}));
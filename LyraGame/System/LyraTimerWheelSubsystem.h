@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+
+#include "LyraTimerWheelSubsystem.generated.h"
+
+class FOutputDevice;
+
+DECLARE_DELEGATE(FLyraTimerWheelDelegate);
+
+// Identifies a callback scheduled on the timer wheel, invalid once it has fired or been cancelled
+struct FLyraTimerWheelHandle
+{
+	bool IsValid() const { return Id != 0; }
+	void Invalidate() { Id = 0; }
+
+private:
+	friend class ULyraTimerWheelSubsystem;
+
+	uint64 Id = 0;
+};
+
+/**
+ * ULyraTimerWheelSubsystem
+ *
+ *	Shared timer for the many actors of a world that only need a coarse delayed callback (e.g. weapon spawner cooldowns
+ *	and overlap re-checks). Callbacks are hashed by their due time into a ring of fixed-width buckets that is advanced
+ *	once per frame after all actors have ticked, so scheduling and cancelling are O(1) and a frame without due callbacks
+ *	only costs a bucket index comparison. Callbacks never fire early and at most one bucket late.
+ *
+ *	Like FTimerManager it runs on world time, so it follows pause and time dilation.
+ */
+UCLASS()
+class ULyraTimerWheelSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	// Schedules Callback to be executed (if still bound) once DelaySeconds of world time have passed, replacing whatever InOutHandle referred to.
+	void Schedule(FLyraTimerWheelHandle& InOutHandle, float DelaySeconds, FLyraTimerWheelDelegate Callback);
+
+	// Cancels the callback if it has not fired yet and invalidates the handle.
+	void Cancel(FLyraTimerWheelHandle& InOutHandle);
+
+	bool IsScheduled(const FLyraTimerWheelHandle& Handle) const { return Handle.IsValid() && Entries.Contains(Handle.Id); }
+
+	int32 GetNumScheduled() const { return Entries.Num(); }
+
+	// Prints the callbacks scheduled and fired since the last call, then restarts the measurement.
+	void DumpStats(FOutputDevice& Ar);
+
+private:
+
+	int64 GetTickIndex(double WorldTime) const;
+
+	void HandlePostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	// Moves the due callbacks of the bucket visited at TickIndex to ScratchCallbacks.
+	void CollectDueCallbacks(int64 TickIndex);
+
+private:
+
+	struct FEntry
+	{
+		int64 TickIndex = 0;
+		FLyraTimerWheelDelegate Callback;
+	};
+
+	// Width of a bucket in seconds, fixed for the lifetime of the world.
+	double BucketSeconds = 0.05;
+
+	// Ring of buckets, each holding the ids of the entries due in a tick of its residue class. Ids of cancelled entries are dropped lazily.
+	TArray<TArray<uint64>> Buckets;
+
+	TMap<uint64, FEntry> Entries;
+
+	// Last tick whose bucket has been processed.
+	int64 LastProcessedTickIndex = 0;
+
+	uint64 NextEntryId = 1;
+
+	TArray<FLyraTimerWheelDelegate> ScratchCallbacks;
+
+	FDelegateHandle PostActorTickHandle;
+
+	// Stats since StatsStartTime
+	double StatsStartTime = 0.0;
+	int64 NumCallbacksScheduled = 0;
+	int64 NumCallbacksCancelled = 0;
+	int64 NumCallbacksFired = 0;
+	int32 MaxCallbacksInFrame = 0;
+};
@@ -0,0 +1,161 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Settings/LyraQualityGovernor.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LyraQualityGovernorTests
+{
+	// 50 FPS gives a 20 ms budget: stepping down above 21 ms, counting headroom below 15 ms
+	static FLyraQualityGovernorConfig MakeConfig()
+	{
+		FLyraQualityGovernorConfig Config;
+		Config.TargetFPS = 50.0f;
+		Config.WindowFrames = 10;
+		return Config;
+	}
+
+	static Scalability::FQualityLevels MakeMaxLevels()
+	{
+		Scalability::FQualityLevels MaxLevels;
+		MaxLevels.SetFromSingleQualityLevel(3);
+		MaxLevels.ResolutionQuality = 100.0f;
+		return MaxLevels;
+	}
+
+	static FLyraFrameTimeSample MakeGPUBoundSample(float GPUMs)
+	{
+		FLyraFrameTimeSample Sample;
+		Sample.GameThreadMs = 8.0f;
+		Sample.RenderThreadMs = 8.0f;
+		Sample.GPUMs = GPUMs;
+		return Sample;
+	}
+
+	// Feeds one full window of the same sample, returns true if the governor changed the levels
+	static bool AddWindow(FLyraQualityGovernor& Governor, const FLyraFrameTimeSample& Sample)
+	{
+		bool bChanged = false;
+		for (int32 FrameIndex = 0; FrameIndex < Governor.GetConfig().WindowFrames; ++FrameIndex)
+		{
+			bChanged |= Governor.AddSample(Sample);
+		}
+		return bChanged;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraQualityGovernorStepDownTest, "Lyra.AdaptiveQuality.Governor.StepDown", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraQualityGovernorStepDownTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraQualityGovernorTests;
+
+	FLyraQualityGovernor Governor;
+	Governor.Reset(MakeConfig(), MakeMaxLevels());
+
+	// Over budget but within the 1.05 tolerance
+	TestFalse(TEXT("No change at 20.9 ms"), AddWindow(Governor, MakeGPUBoundSample(20.9f)));
+	TestEqual(TEXT("Nothing lowered at 20.9 ms"), Governor.GetNumLoweredSteps(), 0);
+
+	// Just past it, the GPU is the bottleneck so resolution goes first
+	TestTrue(TEXT("Steps down at 21.1 ms"), AddWindow(Governor, MakeGPUBoundSample(21.1f)));
+	TestEqual(TEXT("One step lowered"), Governor.GetNumLoweredSteps(), 1);
+	TestEqual(TEXT("Resolution lowered by one step"), Governor.GetCurrentLevels().ResolutionQuality, 90.0f);
+	TestEqual(TEXT("Shadows untouched"), Governor.GetCurrentLevels().ShadowQuality, 3);
+
+	// A single slow frame in a window does not move the 90th percentile
+	FLyraQualityGovernor SpikeGovernor;
+	SpikeGovernor.Reset(MakeConfig(), MakeMaxLevels());
+	SpikeGovernor.AddSample(MakeGPUBoundSample(40.0f));
+	bool bChanged = false;
+	for (int32 FrameIndex = 1; FrameIndex < SpikeGovernor.GetConfig().WindowFrames; ++FrameIndex)
+	{
+		bChanged |= SpikeGovernor.AddSample(MakeGPUBoundSample(16.0f));
+	}
+	TestFalse(TEXT("A single spike does not step down"), bChanged);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraQualityGovernorStepUpTest, "Lyra.AdaptiveQuality.Governor.StepUp", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraQualityGovernorStepUpTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraQualityGovernorTests;
+
+	FLyraQualityGovernor Governor;
+	Governor.Reset(MakeConfig(), MakeMaxLevels());
+
+	TestTrue(TEXT("Steps down at 25 ms"), AddWindow(Governor, MakeGPUBoundSample(25.0f)));
+	TestEqual(TEXT("One step lowered"), Governor.GetNumLoweredSteps(), 1);
+
+	// Headroom (below 0.75 of the budget) has to last UpscaleWindows windows in a row
+	for (int32 WindowIndex = 1; WindowIndex < Governor.GetConfig().UpscaleWindows; ++WindowIndex)
+	{
+		TestFalse(FString::Printf(TEXT("No step up after %d headroom windows"), WindowIndex), AddWindow(Governor, MakeGPUBoundSample(14.0f)));
+	}
+
+	// A window between the thresholds restarts the count
+	TestFalse(TEXT("No step up at 17 ms"), AddWindow(Governor, MakeGPUBoundSample(17.0f)));
+	for (int32 WindowIndex = 1; WindowIndex < Governor.GetConfig().UpscaleWindows; ++WindowIndex)
+	{
+		TestFalse(FString::Printf(TEXT("No step up after %d headroom windows following a busy one"), WindowIndex), AddWindow(Governor, MakeGPUBoundSample(14.0f)));
+	}
+	TestEqual(TEXT("Still one step lowered"), Governor.GetNumLoweredSteps(), 1);
+
+	TestTrue(TEXT("Steps up after the last headroom window"), AddWindow(Governor, MakeGPUBoundSample(14.0f)));
+	TestEqual(TEXT("Nothing lowered anymore"), Governor.GetNumLoweredSteps(), 0);
+	TestEqual(TEXT("Resolution back to its starting level"), Governor.GetCurrentLevels().ResolutionQuality, 100.0f);
+
+	// Never above the starting levels
+	for (int32 WindowIndex = 0; WindowIndex < Governor.GetConfig().UpscaleWindows * 2; ++WindowIndex)
+	{
+		TestFalse(TEXT("No step up past the starting levels"), AddWindow(Governor, MakeGPUBoundSample(5.0f)));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraQualityGovernorNoOscillationTest, "Lyra.AdaptiveQuality.Governor.NoOscillation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraQualityGovernorNoOscillationTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraQualityGovernorTests;
+
+	FLyraQualityGovernor Governor;
+	Governor.Reset(MakeConfig(), MakeMaxLevels());
+
+	// GPU cost scales with the square of the resolution: 24 ms at 100% is over the 21 ms limit, 19.4 ms at 90% sits
+	// between the thresholds, so the governor should step down once and then hold, noise included.
+	FRandomStream Noise(1234);
+	int32 NumLowered = 0;
+	int32 NumRaised = 0;
+
+	for (int32 FrameIndex = 0; FrameIndex < 5000; ++FrameIndex)
+	{
+		const float ResolutionScale = Governor.GetCurrentLevels().ResolutionQuality / 100.0f;
+		const int32 LoweredBefore = Governor.GetNumLoweredSteps();
+
+		if (Governor.AddSample(MakeGPUBoundSample(24.0f * FMath::Square(ResolutionScale) * Noise.FRandRange(0.97f, 1.03f))))
+		{
+			if (Governor.GetNumLoweredSteps() > LoweredBefore)
+			{
+				++NumLowered;
+			}
+			else
+			{
+				++NumRaised;
+			}
+		}
+	}
+
+	TestEqual(TEXT("Stepped down once"), NumLowered, 1);
+	TestEqual(TEXT("Never stepped back up"), NumRaised, 0);
+	TestEqual(TEXT("Holds at 90% resolution"), Governor.GetCurrentLevels().ResolutionQuality, 90.0f);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,586 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+
+#include "Tests/LyraTestControllerBenchmark.h"
+
+#include "AIController.h"
+#include "AbilitySystem/LyraAbilitySet.h"
+#include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Character/LyraHealthComponent.h"
+#include "Dom/JsonObject.h"
+#include "Enemies/LyraEnemySpawner.h"
+#include "Engine/GameInstance.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameModes/LyraBotCreationComponent.h"
+#include "GameModes/LyraExperienceManagerComponent.h"
+#include "HAL/PlatformMemory.h"
+#include "LyraLogChannels.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Messages/LyraVerbMessage.h"
+#include "Misc/Paths.h"
+#include "NativeGameplayTags.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Teams/LyraTeamSubsystem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestControllerBenchmark)
+
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Lyra_Damage_Message);
+
+namespace LyraBenchmark
+{
+	// How often combatants re-pick their target and re-check line of sight
+	static constexpr double EngageIntervalSeconds = 0.5;
+}
+
+void ULyraTestControllerBenchmark::OnInit()
+{
+	Super::OnInit();
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("LyraBenchBots="), NumBots);
+	FParse::Value(CommandLine, TEXT("LyraBenchEnemies="), NumEnemies);
+	FParse::Value(CommandLine, TEXT("LyraBenchWarmup="), WarmupSeconds);
+	FParse::Value(CommandLine, TEXT("LyraBenchDuration="), DurationSeconds);
+	FParse::Value(CommandLine, TEXT("LyraBenchTimeout="), TimeoutSeconds);
+	FParse::Value(CommandLine, TEXT("LyraBenchTolerance="), Tolerance);
+	FParse::Value(CommandLine, TEXT("LyraBenchBaseline="), BaselineFilename);
+	FParse::Value(CommandLine, TEXT("LyraBenchOutput="), OutputFilename);
+	FParse::Value(CommandLine, TEXT("LyraBenchEngageRange="), EngageRange);
+	bWriteBaseline = FParse::Param(CommandLine, TEXT("LyraBenchWriteBaseline"));
+
+	// Same parameter ALyraGameMode uses to pick the experience
+	FParse::Value(CommandLine, TEXT("Experience="), ExperienceName);
+
+	if (OutputFilename.IsEmpty())
+	{
+		OutputFilename = FPaths::ProfilingDir() / TEXT("Benchmark") / (ExperienceName.IsEmpty() ? FString(TEXT("Default")) : ExperienceName) + TEXT(".json");
+	}
+
+	FString FireTagName = TEXT("InputTag.Weapon.Fire");
+	FParse::Value(CommandLine, TEXT("LyraBenchFireTag="), FireTagName);
+	FireInputTag = FGameplayTag::RequestGameplayTag(FName(*FireTagName), /*ErrorIfNotFound=*/ false);
+	if (!FireInputTag.IsValid())
+	{
+		UE_LOG(LogLyra, Warning, TEXT("LyraBenchmark: Unknown fire input tag '%s', combatants will only close in on each other"), *FireTagName);
+	}
+
+	bCanRender = FApp::CanEverRender() && !IsRunningDedicatedServer();
+
+	FrameTimeHistogram.Initialize(0, 0.0);
+	GameThreadHistogram.Initialize(0, 0.0);
+	RenderThreadHistogram.Initialize(0, 0.0);
+	GPUHistogram.Initialize(0, 0.0);
+	ServerTickHistogram.Initialize(0, 0.0);
+
+	SetPhase(EBenchmarkPhase::WaitingForExperience);
+
+	UE_LOG(LogLyra, Display, TEXT("LyraBenchmark: Experience=%s Bots=%d Enemies=%d Warmup=%.0fs Duration=%.0fs Render=%d"),
+		*ExperienceName, NumBots, NumEnemies, WarmupSeconds, DurationSeconds, bCanRender ? 1 : 0);
+}
+
+void ULyraTestControllerBenchmark::OnPostMapChange(UWorld* World)
+{
+	Super::OnPostMapChange(World);
+
+	// A map change mid-benchmark invalidates everything we spawned and measured
+	if (Phase != EBenchmarkPhase::WaitingForExperience && Phase != EBenchmarkPhase::Finished)
+	{
+		UE_LOG(LogLyra, Error, TEXT("LyraBenchmark: Map changed during the benchmark"));
+		StopCombatants();
+		SetPhase(EBenchmarkPhase::Finished);
+		EndTest(1);
+	}
+}
+
+void ULyraTestControllerBenchmark::SetPhase(EBenchmarkPhase NewPhase)
+{
+	Phase = NewPhase;
+	PhaseStartTime = FPlatformTime::Seconds();
+}
+
+void ULyraTestControllerBenchmark::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	const double TimeInPhase = FPlatformTime::Seconds() - PhaseStartTime;
+
+	switch (Phase)
+	{
+	case EBenchmarkPhase::WaitingForExperience:
+		{
+			UWorld* World = GetWorld();
+			AGameStateBase* GameState = (World != nullptr) ? World->GetGameState() : nullptr;
+			ULyraExperienceManagerComponent* ExperienceComponent = (GameState != nullptr) ? GameState->FindComponentByClass<ULyraExperienceManagerComponent>() : nullptr;
+
+			if ((ExperienceComponent != nullptr) && ExperienceComponent->IsExperienceLoaded())
+			{
+				const ULyraExperienceDefinition* Experience = ExperienceComponent->GetCurrentExperienceChecked();
+				if (!ExperienceName.IsEmpty() && !GetNameSafe(Experience).Contains(ExperienceName))
+				{
+					// Still on the default/front-end experience, wait for the requested one
+					break;
+				}
+
+				SpawnCombatants();
+				SetPhase(EBenchmarkPhase::Warmup);
+			}
+			else if (TimeInPhase > TimeoutSeconds)
+			{
+				UE_LOG(LogLyra, Error, TEXT("LyraBenchmark: Timed out after %.0fs waiting for experience '%s' to load"), TimeInPhase, *ExperienceName);
+				SetPhase(EBenchmarkPhase::Finished);
+				EndTest(1);
+			}
+		}
+		break;
+
+	case EBenchmarkPhase::Warmup:
+		EngageCombatants();
+		ProcessCombatantInput(TimeDelta);
+		if (TimeInPhase >= WarmupSeconds)
+		{
+			UE_LOG(LogLyra, Display, TEXT("LyraBenchmark: Warmup done, measuring for %.0fs"), DurationSeconds);
+			NextMemorySampleTime = 0.0;
+			SetPhase(EBenchmarkPhase::Measuring);
+		}
+		break;
+
+	case EBenchmarkPhase::Measuring:
+		EngageCombatants();
+		ProcessCombatantInput(TimeDelta);
+		SampleFrame();
+		if (TimeInPhase >= DurationSeconds)
+		{
+			FinishBenchmark();
+		}
+		break;
+
+	case EBenchmarkPhase::Finished:
+		break;
+	}
+}
+
+void ULyraTestControllerBenchmark::SpawnCombatants()
+{
+	UWorld* World = GetWorld();
+
+#if WITH_SERVER_CODE
+	if (World->GetNetMode() != NM_Client)
+	{
+		if (ULyraBotCreationComponent* BotComponent = World->GetGameState()->FindComponentByClass<ULyraBotCreationComponent>())
+		{
+			for (int32 Index = 0; Index < NumBots; ++Index)
+			{
+				BotComponent->Cheat_AddBot();
+			}
+			NumBotsSpawned = NumBots;
+		}
+		else if (NumBots > 0)
+		{
+			UE_LOG(LogLyra, Warning, TEXT("LyraBenchmark: Experience has no ULyraBotCreationComponent, no bots were spawned"));
+		}
+
+		TArray<ALyraEnemySpawner*> EnemySpawners;
+		for (TActorIterator<ALyraEnemySpawner> It(World); It; ++It)
+		{
+			EnemySpawners.Add(*It);
+		}
+
+		if (EnemySpawners.Num() > 0)
+		{
+			// Spread the enemies evenly across the spawners in the level
+			for (int32 SpawnerIndex = 0; SpawnerIndex < EnemySpawners.Num(); ++SpawnerIndex)
+			{
+				const int32 NumForSpawner = (NumEnemies / EnemySpawners.Num()) + ((SpawnerIndex < (NumEnemies % EnemySpawners.Num())) ? 1 : 0);
+				NumEnemiesSpawned += EnemySpawners[SpawnerIndex]->SpawnEnemies(NumForSpawner);
+			}
+
+			if (NumEnemiesSpawned < NumEnemies)
+			{
+				UE_LOG(LogLyra, Warning, TEXT("LyraBenchmark: Only %d of %d enemies could be spawned"), NumEnemiesSpawned, NumEnemies);
+			}
+		}
+		else if (NumEnemies > 0)
+		{
+			UE_LOG(LogLyra, Warning, TEXT("LyraBenchmark: Level has no ALyraEnemySpawner, no enemies were spawned"));
+		}
+
+		// Damage is only applied and reported on the server
+		DamageListenerHandle = UGameplayMessageSubsystem::Get(World).RegisterListener(TAG_Lyra_Damage_Message, this, &ThisClass::OnDamageMessage);
+		bDrivingCombat = true;
+	}
+#endif
+
+	UE_LOG(LogLyra, Display, TEXT("LyraBenchmark: Spawned %d bots and %d enemies, warming up for %.0fs"), NumBotsSpawned, NumEnemiesSpawned, WarmupSeconds);
+}
+
+void ULyraTestControllerBenchmark::EngageCombatants()
+{
+	UWorld* World = GetWorld();
+	if ((World == nullptr) || (World->GetNetMode() == NM_Client))
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now < NextEngageTime)
+	{
+		return;
+	}
+	NextEngageTime = Now + LyraBenchmark::EngageIntervalSeconds;
+
+	ULyraTeamSubsystem* TeamSubsystem = World->GetSubsystem<ULyraTeamSubsystem>();
+	if (TeamSubsystem == nullptr)
+	{
+		return;
+	}
+
+	TArray<APawn*> LivingPawns;
+	for (TActorIterator<APawn> It(World); It; ++It)
+	{
+		const ULyraHealthComponent* HealthComponent = ULyraHealthComponent::FindHealthComponent(*It);
+		if ((HealthComponent != nullptr) && !HealthComponent->IsDeadOrDying())
+		{
+			LivingPawns.Add(*It);
+		}
+	}
+
+	// Bots and enemies alike, each goes after the closest pawn of another team
+	for (TActorIterator<AAIController> It(World); It; ++It)
+	{
+		AAIController* AIController = *It;
+		APawn* Pawn = AIController->GetPawn();
+		if ((Pawn == nullptr) || !LivingPawns.Contains(Pawn))
+		{
+			EngageTarget(AIController, nullptr);
+			continue;
+		}
+
+		APawn* Target = nullptr;
+		double TargetDistSquared = TNumericLimits<double>::Max();
+		for (APawn* OtherPawn : LivingPawns)
+		{
+			const double DistSquared = FVector::DistSquared(Pawn->GetActorLocation(), OtherPawn->GetActorLocation());
+			if ((DistSquared < TargetDistSquared) && (TeamSubsystem->CompareTeams(Pawn, OtherPawn) == ELyraTeamComparison::DifferentTeams))
+			{
+				Target = OtherPawn;
+				TargetDistSquared = DistSquared;
+			}
+		}
+
+		EngageTarget(AIController, Target);
+	}
+}
+
+void ULyraTestControllerBenchmark::EngageTarget(AAIController* AIController, APawn* Target)
+{
+	APawn* Pawn = AIController->GetPawn();
+	ULyraAbilitySystemComponent* LyraASC = Cast<ULyraAbilitySystemComponent>(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Pawn));
+
+	bool bShouldFire = false;
+	if ((Pawn != nullptr) && (Target != nullptr))
+	{
+		AIController->SetFocus(Target, EAIFocusPriority::Gameplay);
+
+		const double Distance = FVector::Dist(Pawn->GetActorLocation(), Target->GetActorLocation());
+		if (Distance > EngageRange)
+		{
+			AIController->MoveToActor(Target, EngageRange * 0.5f);
+		}
+
+		bShouldFire = (Distance <= EngageRange) && AIController->LineOfSightTo(Target);
+	}
+	else
+	{
+		AIController->ClearFocus(EAIFocusPriority::Gameplay);
+	}
+
+	if ((LyraASC == nullptr) || !FireInputTag.IsValid())
+	{
+		return;
+	}
+
+	const bool bFiring = FiringAbilitySystems.Contains(LyraASC);
+	if (bShouldFire && !bFiring)
+	{
+		LyraASC->AbilityInputTagPressed(FireInputTag);
+		FiringAbilitySystems.Add(LyraASC);
+	}
+	else if (!bShouldFire && bFiring)
+	{
+		LyraASC->AbilityInputTagReleased(FireInputTag);
+		LyraASC->ProcessAbilityInput(0.0f, false);
+		FiringAbilitySystems.Remove(LyraASC);
+	}
+}
+
+void ULyraTestControllerBenchmark::ProcessCombatantInput(float TimeDelta)
+{
+	// AI controllers have no input component, so held input is processed here the way ALyraPlayerController::PostProcessInput does
+	for (int32 Index = FiringAbilitySystems.Num() - 1; Index >= 0; --Index)
+	{
+		if (ULyraAbilitySystemComponent* LyraASC = FiringAbilitySystems[Index].Get())
+		{
+			LyraASC->ProcessAbilityInput(TimeDelta, false);
+		}
+		else
+		{
+			FiringAbilitySystems.RemoveAtSwap(Index);
+		}
+	}
+}
+
+void ULyraTestControllerBenchmark::StopCombatants()
+{
+	for (const TWeakObjectPtr<ULyraAbilitySystemComponent>& FiringASC : FiringAbilitySystems)
+	{
+		if (ULyraAbilitySystemComponent* LyraASC = FiringASC.Get())
+		{
+			LyraASC->AbilityInputTagReleased(FireInputTag);
+			LyraASC->ProcessAbilityInput(0.0f, false);
+		}
+	}
+	FiringAbilitySystems.Reset();
+
+	DamageListenerHandle.Unregister();
+}
+
+void ULyraTestControllerBenchmark::OnDamageMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload)
+{
+	if (Phase == EBenchmarkPhase::Measuring)
+	{
+		++NumDamageEvents;
+	}
+}
+
+void ULyraTestControllerBenchmark::SampleFrame()
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	if (ULyraPerformanceStatSubsystem* StatSubsystem = World->GetGameInstance()->GetSubsystem<ULyraPerformanceStatSubsystem>())
+	{
+		FrameTimeHistogram.AddSample(StatSubsystem->GetCachedStat(ELyraDisplayablePerformanceStat::FrameTime));
+		GameThreadHistogram.AddSample(StatSubsystem->GetCachedStat(ELyraDisplayablePerformanceStat::FrameTime_GameThread));
+
+		if (bCanRender)
+		{
+			RenderThreadHistogram.AddSample(StatSubsystem->GetCachedStat(ELyraDisplayablePerformanceStat::FrameTime_RenderThread));
+			GPUHistogram.AddSample(StatSubsystem->GetCachedStat(ELyraDisplayablePerformanceStat::FrameTime_GPU));
+		}
+
+		if (World->GetNetMode() == NM_Client)
+		{
+			const double ServerFPS = StatSubsystem->GetCachedStat(ELyraDisplayablePerformanceStat::ServerFPS);
+			if (ServerFPS > 0.0)
+			{
+				ServerTickHistogram.AddSample(1.0 / ServerFPS);
+			}
+		}
+		else
+		{
+			ServerTickHistogram.AddSample(StatSubsystem->GetCachedStat(ELyraDisplayablePerformanceStat::FrameTime_GameThread));
+		}
+	}
+
+	if (UNetDriver* NetDriver = World->GetNetDriver())
+	{
+		auto SampleConnection = [this](const UNetConnection* Connection)
+		{
+			if (Connection != nullptr)
+			{
+				NetInBytesPerConnectionSum += Connection->InBytesPerSecond;
+				NetOutBytesPerConnectionSum += Connection->OutBytesPerSecond;
+				MaxNetInBytesPerConnection = FMath::Max(MaxNetInBytesPerConnection, Connection->InBytesPerSecond);
+				MaxNetOutBytesPerConnection = FMath::Max(MaxNetOutBytesPerConnection, Connection->OutBytesPerSecond);
+				++NumNetConnectionSamples;
+			}
+		};
+
+		SampleConnection(NetDriver->ServerConnection);
+		for (const UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			SampleConnection(Connection);
+		}
+	}
+
+	// Querying memory stats isn't free, so only do it a few times a second
+	const double Now = FPlatformTime::Seconds();
+	if (Now >= NextMemorySampleTime)
+	{
+		NextMemorySampleTime = Now + 0.25;
+		MaxUsedPhysicalMemory = FMath::Max<uint64>(MaxUsedPhysicalMemory, FPlatformMemory::GetStats().UsedPhysical);
+	}
+
+	++NumMeasuredFrames;
+}
+
+TSharedRef<FJsonObject> ULyraTestControllerBenchmark::BuildResults() const
+{
+	TSharedRef<FJsonObject> Metrics = MakeShared<FJsonObject>();
+
+	auto AddPercentiles = [&Metrics](const FString& Name, const FLyraPerformanceStatHistogram& Histogram)
+	{
+		if (Histogram.GetNumSamples() > 0)
+		{
+			// Reported in milliseconds
+			Metrics->SetNumberField(Name + TEXT(".P50"), Histogram.GetPercentile(50.0) * 1000.0);
+			Metrics->SetNumberField(Name + TEXT(".P95"), Histogram.GetPercentile(95.0) * 1000.0);
+			Metrics->SetNumberField(Name + TEXT(".P99"), Histogram.GetPercentile(99.0) * 1000.0);
+		}
+	};
+
+	AddPercentiles(TEXT("FrameTime"), FrameTimeHistogram);
+	AddPercentiles(TEXT("GameThread"), GameThreadHistogram);
+	AddPercentiles(TEXT("ServerTickTime"), ServerTickHistogram);
+	if (bCanRender)
+	{
+		AddPercentiles(TEXT("RenderThread"), RenderThreadHistogram);
+		AddPercentiles(TEXT("GPU"), GPUHistogram);
+	}
+
+	if (NumNetConnectionSamples > 0)
+	{
+		Metrics->SetNumberField(TEXT("Net.InBytesPerConnection.Avg"), NetInBytesPerConnectionSum / NumNetConnectionSamples);
+		Metrics->SetNumberField(TEXT("Net.OutBytesPerConnection.Avg"), NetOutBytesPerConnectionSum / NumNetConnectionSamples);
+		Metrics->SetNumberField(TEXT("Net.InBytesPerConnection.Max"), MaxNetInBytesPerConnection);
+		Metrics->SetNumberField(TEXT("Net.OutBytesPerConnection.Max"), MaxNetOutBytesPerConnection);
+	}
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	Metrics->SetNumberField(TEXT("Memory.UsedPhysicalMB.Max"), (double)MaxUsedPhysicalMemory / (1024.0 * 1024.0));
+	Metrics->SetNumberField(TEXT("Memory.PeakUsedPhysicalMB"), (double)MemoryStats.PeakUsedPhysical / (1024.0 * 1024.0));
+
+	// Ability system footprint of every spawned pawn, and what it cost to grant their ability sets
+	FLyraAbilitySystemMemoryReport AbilitySystemReport;
+	ULyraAbilitySystemComponent::GatherMemoryReport(GetWorld(), AbilitySystemReport);
+	if (AbilitySystemReport.NumAbilitySystems > 0)
+	{
+		const double NumAbilitySystems = AbilitySystemReport.NumAbilitySystems;
+		Metrics->SetNumberField(TEXT("AbilitySystem.SpecsPerASC"), AbilitySystemReport.NumAbilitySpecs / NumAbilitySystems);
+		Metrics->SetNumberField(TEXT("AbilitySystem.LazyAbilitiesPerASC"), AbilitySystemReport.NumLazyAbilities / NumAbilitySystems);
+		Metrics->SetNumberField(TEXT("AbilitySystem.EstimatedKBPerASC"), AbilitySystemReport.EstimatedBytes / 1024.0 / NumAbilitySystems);
+	}
+
+	const FLyraAbilitySetGrantStats& GrantStats = ULyraAbilitySet::GetGrantStats();
+	if (GrantStats.NumSetsGiven > 0)
+	{
+		// Reported in microseconds
+		Metrics->SetNumberField(TEXT("AbilitySystem.GiveAbilitySetUs.Avg"), GrantStats.GiveTimeSeconds * 1000000.0 / GrantStats.NumSetsGiven);
+		Metrics->SetNumberField(TEXT("AbilitySystem.GiveAbilitySetUs.Max"), GrantStats.MaxGiveTimeSeconds * 1000000.0);
+	}
+
+	TSharedRef<FJsonObject> Results = MakeShared<FJsonObject>();
+	Results->SetStringField(TEXT("Experience"), ExperienceName);
+	Results->SetNumberField(TEXT("Bots"), NumBotsSpawned);
+	Results->SetNumberField(TEXT("Enemies"), NumEnemiesSpawned);
+	Results->SetNumberField(TEXT("DurationSeconds"), DurationSeconds);
+	Results->SetNumberField(TEXT("Frames"), (double)NumMeasuredFrames);
+	Results->SetNumberField(TEXT("DamageEvents"), (double)NumDamageEvents);
+	Results->SetBoolField(TEXT("Rendering"), bCanRender);
+	Results->SetObjectField(TEXT("Metrics"), Metrics);
+	return Results;
+}
+
+bool ULyraTestControllerBenchmark::CompareAgainstBaseline(const FJsonObject& Results) const
+{
+	if (BaselineFilename.IsEmpty())
+	{
+		return true;
+	}
+
+	FString BaselineString;
+	if (!FFileHelper::LoadFileToString(BaselineString, *BaselineFilename))
+	{
+		// A run that was asked to compare must not pass without anything to compare against
+		UE_LOG(LogLyra, Error, TEXT("LyraBenchmark: No baseline found at %s, run with -LyraBenchWriteBaseline to create it"), *BaselineFilename);
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Baseline;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineString), Baseline) || !Baseline.IsValid())
+	{
+		UE_LOG(LogLyra, Error, TEXT("LyraBenchmark: Failed to parse baseline %s"), *BaselineFilename);
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* BaselineMetrics = nullptr;
+	const TSharedPtr<FJsonObject>* ResultMetrics = nullptr;
+	if (!Baseline->TryGetObjectField(TEXT("Metrics"), BaselineMetrics) || !Results.TryGetObjectField(TEXT("Metrics"), ResultMetrics))
+	{
+		UE_LOG(LogLyra, Error, TEXT("LyraBenchmark: Baseline %s has no Metrics object"), *BaselineFilename);
+		return false;
+	}
+
+	bool bPassed = true;
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& BaselinePair : (*BaselineMetrics)->Values)
+	{
+		double ResultValue = 0.0;
+		if (!(*ResultMetrics)->TryGetNumberField(BaselinePair.Key, ResultValue))
+		{
+			// Not measured in this configuration (e.g., GPU time with -nullrhi)
+			continue;
+		}
+
+		const double BaselineValue = BaselinePair.Value->AsNumber();
+		const double AllowedValue = BaselineValue * (1.0 + Tolerance);
+		if (ResultValue > AllowedValue)
+		{
+			UE_LOG(LogLyra, Error, TEXT("LyraBenchmark: REGRESSION %s = %.3f (baseline %.3f, allowed %.3f)"), *BaselinePair.Key, ResultValue, BaselineValue, AllowedValue);
+			bPassed = false;
+		}
+		else
+		{
+			UE_LOG(LogLyra, Display, TEXT("LyraBenchmark: %s = %.3f (baseline %.3f)"), *BaselinePair.Key, ResultValue, BaselineValue);
+		}
+	}
+
+	return bPassed;
+}
+
+void ULyraTestControllerBenchmark::FinishBenchmark()
+{
+	StopCombatants();
+	SetPhase(EBenchmarkPhase::Finished);
+
+	const TSharedRef<FJsonObject> Results = BuildResults();
+
+	FString ResultsString;
+	FJsonSerializer::Serialize(Results, TJsonWriterFactory<>::Create(&ResultsString));
+
+	if (FFileHelper::SaveStringToFile(ResultsString, *OutputFilename))
+	{
+		UE_LOG(LogLyra, Display, TEXT("LyraBenchmark: Wrote results for %lld frames to %s"), NumMeasuredFrames, *OutputFilename);
+	}
+	else
+	{
+		UE_LOG(LogLyra, Error, TEXT("LyraBenchmark: Failed to write results to %s"), *OutputFilename);
+	}
+
+	if (bWriteBaseline && !BaselineFilename.IsEmpty())
+	{
+		FFileHelper::SaveStringToFile(ResultsString, *BaselineFilename);
+		UE_LOG(LogLyra, Display, TEXT("LyraBenchmark: Wrote new baseline to %s"), *BaselineFilename);
+		EndTest(0);
+		return;
+	}
+
+	// Without any damage the capture measured idle pawns, not combat
+	const bool bHadCombat = (NumDamageEvents > 0) || !bDrivingCombat || ((NumBotsSpawned + NumEnemiesSpawned) == 0);
+	if (!bHadCombat)
+	{
+		UE_LOG(LogLyra, Error, TEXT("LyraBenchmark: No damage was dealt while measuring, the combatants never engaged"));
+	}
+
+	const bool bPassed = (NumMeasuredFrames > 0) && bHadCombat && CompareAgainstBaseline(*Results);
+	EndTest(bPassed ? 0 : 1);
+}
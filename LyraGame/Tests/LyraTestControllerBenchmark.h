@@ -0,0 +1,131 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+
+#pragma once
+
+#include "GameFramework/GameplayMessageSubsystem.h"
+#include "GauntletTestController.h"
+#include "Performance/LyraPerformanceStatSubsystem.h"
+
+#include "LyraTestControllerBenchmark.generated.h"
+
+class AAIController;
+class FJsonObject;
+class ULyraAbilitySystemComponent;
+class UObject;
+struct FLyraVerbMessage;
+
+/**
+ * ULyraTestControllerBenchmark
+ *
+ * Headless performance benchmark. Waits for the experience given with -Experience= to load, spawns bots through
+ * ULyraBotCreationComponent and enemies through every ALyraEnemySpawner in the level, makes them fight for a fixed
+ * duration and records frame time percentiles, net bytes per connection and memory high-water. The results are
+ * written to a JSON file and compared against a stored baseline; the test fails if any metric regressed.
+ *
+ * Combat does not depend on the behavior trees finding each other: every AI controller is pointed at its nearest
+ * hostile pawn, walks into range and holds the fire input while it has line of sight. The test fails if no damage
+ * was dealt while measuring, since such a capture says nothing about combat cost.
+ *
+ * Works with -nullrhi and on dedicated servers (render and GPU metrics are skipped when nothing is rendered).
+ *
+ * Command line:
+ *   -gauntlet=LyraTestControllerBenchmark -Experience=<ExperienceName>
+ *   -LyraBenchBots=<N>            Bots to add (default 8)
+ *   -LyraBenchEnemies=<N>         Enemies to add, spread across enemy spawners (default 32)
+ *   -LyraBenchWarmup=<Seconds>    Time after spawning before measurement starts (default 10)
+ *   -LyraBenchDuration=<Seconds>  Measurement time (default 60)
+ *   -LyraBenchTimeout=<Seconds>   Max time to wait for the experience to load (default 300)
+ *   -LyraBenchFireTag=<Tag>       Input tag pressed to fire while a target is in sight (default InputTag.Weapon.Fire)
+ *   -LyraBenchEngageRange=<cm>    Distance combatants close to before firing (default 2000)
+ *   -LyraBenchBaseline=<File>     Baseline JSON to compare against (metric name -> max allowed value)
+ *   -LyraBenchTolerance=<Ratio>   Allowed regression over the baseline (default 0.1 = 10%)
+ *   -LyraBenchOutput=<File>       Where to write results (default <ProfilingDir>/Benchmark/<Experience>.json)
+ *   -LyraBenchWriteBaseline       Also write the results as a new baseline to -LyraBenchBaseline
+ */
+UCLASS()
+class ULyraTestControllerBenchmark : public UGauntletTestController
+{
+	GENERATED_BODY()
+
+protected:
+	//~UGauntletTestController interface
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override;
+	virtual void OnTick(float TimeDelta) override;
+	//~End of UGauntletTestController interface
+
+private:
+	enum class EBenchmarkPhase : uint8
+	{
+		WaitingForExperience,
+		Warmup,
+		Measuring,
+		Finished
+	};
+
+	void SetPhase(EBenchmarkPhase NewPhase);
+
+	void SpawnCombatants();
+	void EngageCombatants();
+	void EngageTarget(AAIController* AIController, APawn* Target);
+	void ProcessCombatantInput(float TimeDelta);
+	void StopCombatants();
+	void OnDamageMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload);
+	void SampleFrame();
+	void FinishBenchmark();
+
+	TSharedRef<FJsonObject> BuildResults() const;
+	bool CompareAgainstBaseline(const FJsonObject& Results) const;
+
+private:
+	EBenchmarkPhase Phase = EBenchmarkPhase::WaitingForExperience;
+	double PhaseStartTime = 0.0;
+
+	int32 NumBots = 8;
+	int32 NumEnemies = 32;
+	float WarmupSeconds = 10.0f;
+	float DurationSeconds = 60.0f;
+	float TimeoutSeconds = 300.0f;
+	float Tolerance = 0.1f;
+	float EngageRange = 2000.0f;
+	FGameplayTag FireInputTag;
+	FString ExperienceName;
+	FString BaselineFilename;
+	FString OutputFilename;
+	bool bWriteBaseline = false;
+
+	// Whether this process renders anything (false with -nullrhi or on a dedicated server)
+	bool bCanRender = true;
+
+	// Whole-run histograms (no sliding window) of the measured frames
+	FLyraPerformanceStatHistogram FrameTimeHistogram;
+	FLyraPerformanceStatHistogram GameThreadHistogram;
+	FLyraPerformanceStatHistogram RenderThreadHistogram;
+	FLyraPerformanceStatHistogram GPUHistogram;
+	FLyraPerformanceStatHistogram ServerTickHistogram;
+
+	int64 NumMeasuredFrames = 0;
+
+	// Per-connection net traffic, averaged over every connection and measured frame
+	double NetInBytesPerConnectionSum = 0.0;
+	double NetOutBytesPerConnectionSum = 0.0;
+	int64 NumNetConnectionSamples = 0;
+	int32 MaxNetInBytesPerConnection = 0;
+	int32 MaxNetOutBytesPerConnection = 0;
+
+	double NextMemorySampleTime = 0.0;
+	uint64 MaxUsedPhysicalMemory = 0;
+
+	int32 NumBotsSpawned = 0;
+	int32 NumEnemiesSpawned = 0;
+
+	// Ability systems currently holding the fire input, their input is processed every tick like a player controller would
+	TArray<TWeakObjectPtr<ULyraAbilitySystemComponent>> FiringAbilitySystems;
+	double NextEngageTime = 0.0;
+
+	// Set once the server side has spawned combatants and started counting their damage
+	bool bDrivingCombat = false;
+
+	FGameplayMessageListenerHandle DamageListenerHandle;
+	int64 NumDamageEvents = 0;
+};
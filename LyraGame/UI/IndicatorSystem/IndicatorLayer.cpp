@@ -34,6 +34,7 @@ TSharedRef<SWidget> UIndicatorLayer::RebuildWidget()
 		if (ensureMsgf(LocalPlayer, TEXT("Attempting to rebuild a UActorCanvas without a valid LocalPlayer!")))
 		{
 			MyActorCanvas = SNew(SActorCanvas, FLocalPlayerContext(LocalPlayer), &ArrowBrush);
+			MyActorCanvas->SetRetainedMode(bRetainedMode);
 			return MyActorCanvas.ToSharedRef();
 		}
 	}
@@ -20,6 +20,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Appearance)
 	FSlateBrush ArrowBrush;
 
+	/**
+	 * Keep the sorted indicator list and each indicator's arrangement between frames, only re-arranging the
+	 * indicators whose position, visibility or depth changed. Disable to re-arrange every indicator every frame.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Performance)
+	bool bRetainedMode = true;
+
 protected:
 	// UWidget interface
 	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
@@ -257,7 +257,7 @@ EActiveTimerReturnType SActorCanvas::UpdateCanvas(double InCurrentTime, float In
 				{
 					// Only dirty the screen position if we can actually show this indicator.
 					CurChild.SetScreenPosition(FVector2D(ScreenPositionWithDepth));
-					CurChild.SetDepth(ScreenPositionWithDepth.X);
+					CurChild.SetDepth(ScreenPositionWithDepth.Z);
 				}
 
 				CurChild.SetPriority(Indicator->GetPriority());
@@ -308,183 +308,257 @@ void SActorCanvas::SetShowAnyIndicators(bool bIndicators)
 	}
 }
 
-void SActorCanvas::OnArrangeChildren(const FGeometry& AllottedGeometry, FArrangedChildren& ArrangedChildren) const
+void SActorCanvas::SetRetainedMode(bool bInRetainedMode)
 {
-	QUICK_SCOPE_CYCLE_COUNTER(STAT_SActorCanvas_OnArrangeChildren);
-
-	NextArrowIndex = 0;
+	if (bRetainedMode != bInRetainedMode)
+	{
+		bRetainedMode = bInRetainedMode;
+		bSortedSlotsInvalid = true;
+		Invalidate(EInvalidateWidget::Paint);
+	}
+}
 
-	//Make sure we have a player. If we don't, we can't project anything
-	if (bShowAnyIndicators)
+void SActorCanvas::UpdateSortedSlots() const
+{
+	const auto SortPredicate = [](const SActorCanvas::FSlot& A, const SActorCanvas::FSlot& B)
 	{
-		const FVector2D ArrowWidgetSize = ActorCanvasArrowBrush->GetImageSize();
-		const FIntPoint FixedPadding = FIntPoint(10.0f, 10.0f) + FIntPoint(ArrowWidgetSize.X, ArrowWidgetSize.Y);
-		const FVector Center = FVector(AllottedGeometry.Size * 0.5f, 0.0f);
+		return A.GetPriority() == B.GetPriority() ? A.GetDepth() > B.GetDepth() : A.GetPriority() < B.GetPriority();
+	};
 
-		// Sort the children
-		TArray<const SActorCanvas::FSlot*> SortedSlots;
+	if (!bRetainedMode || bSortedSlotsInvalid || SortedSlots.Num() != CanvasChildren.Num())
+	{
+		SortedSlots.Reset(CanvasChildren.Num());
 		for (int32 ChildIndex = 0; ChildIndex < CanvasChildren.Num(); ++ChildIndex)
 		{
-			SortedSlots.Add(&CanvasChildren[ChildIndex]);
+			const SActorCanvas::FSlot& Slot = CanvasChildren[ChildIndex];
+			Slot.bSortKeyChanged = false;
+			SortedSlots.Add(&Slot);
 		}
 
-		SortedSlots.StableSort([](const SActorCanvas::FSlot& A, const SActorCanvas::FSlot& B)
-		{
-			return A.GetPriority() == B.GetPriority() ? A.GetDepth() > B.GetDepth() : A.GetPriority() < B.GetPriority();
-		});
+		SortedSlots.StableSort(SortPredicate);
+		bSortedSlotsInvalid = false;
+		return;
+	}
 
-		// Go through all the sorted children
-		for (int32 ChildIndex = 0; ChildIndex < SortedSlots.Num(); ++ChildIndex)
-		{
-			//grab a child
-			const SActorCanvas::FSlot& CurChild = *SortedSlots[ChildIndex];
-			const UIndicatorDescriptor* Indicator = CurChild.Indicator;
+	bool bAnySortKeyChanged = false;
+	for (const SActorCanvas::FSlot* Slot : SortedSlots)
+	{
+		bAnySortKeyChanged |= Slot->bSortKeyChanged;
+		Slot->bSortKeyChanged = false;
+	}
 
-			// Skip this indicator if it's invalid or has an invalid world position
-			if (!ArrangedChildren.Accepts(CurChild.GetWidget()->GetVisibility()))
+	if (bAnySortKeyChanged)
+	{
+		// The previous order is almost always nearly sorted (only a few indicators changed depth), so a stable
+		// insertion sort over the retained order is close to linear, unlike re-sorting from scratch.
+		for (int32 SortIndex = 1; SortIndex < SortedSlots.Num(); ++SortIndex)
+		{
+			const SActorCanvas::FSlot* SlotToInsert = SortedSlots[SortIndex];
+			int32 InsertIndex = SortIndex;
+			while (InsertIndex > 0 && SortPredicate(*SlotToInsert, *SortedSlots[InsertIndex - 1]))
 			{
-				CurChild.SetWasIndicatorClamped(false);
-				continue;
+				SortedSlots[InsertIndex] = SortedSlots[InsertIndex - 1];
+				--InsertIndex;
 			}
+			SortedSlots[InsertIndex] = SlotToInsert;
+		}
+	}
+}
 
-			FVector2D ScreenPosition = CurChild.GetScreenPosition();
-			const bool bInFrontOfCamera = CurChild.GetInFrontOfCamera();
+void SActorCanvas::ArrangeSlot(const FSlot& CurChild, const FVector2D& AllottedSize, const FVector2D& ArrowWidgetSize) const
+{
+	const UIndicatorDescriptor* Indicator = CurChild.Indicator;
 
-			// Don't bother if we can't project the position and the indicator doesn't want to be clamped
-			const bool bShouldClamp = Indicator->GetClampToScreen();
+	const FIntPoint FixedPadding = FIntPoint(10.0f, 10.0f) + FIntPoint(ArrowWidgetSize.X, ArrowWidgetSize.Y);
+	const FVector Center = FVector(AllottedSize * 0.5f, 0.0f);
 
-			//get the offset and final size of the slot
-			FVector2D SlotSize, SlotOffset, SlotPaddingMin, SlotPaddingMax;
-			GetOffsetAndSize(Indicator, SlotSize, SlotOffset, SlotPaddingMin, SlotPaddingMax);
+	FVector2D ScreenPosition = CurChild.GetScreenPosition();
+	const bool bInFrontOfCamera = CurChild.GetInFrontOfCamera();
 
-			bool bWasIndicatorClamped = false;
+	// Don't bother if we can't project the position and the indicator doesn't want to be clamped
+	const bool bShouldClamp = Indicator->GetClampToScreen();
 
-			// If we don't have to clamp this thing, we can skip a lot of work
-			if (bShouldClamp)
-			{
-				//figure out if we clamped to any edge of the screen
-				EArrowDirection::Type ClampDir = EArrowDirection::MAX;
+	//get the offset and final size of the slot
+	FVector2D SlotSize, SlotOffset, SlotPaddingMin, SlotPaddingMax;
+	GetOffsetAndSize(Indicator, SlotSize, SlotOffset, SlotPaddingMin, SlotPaddingMax);
 
-				// Determine the size of inner screen rect to clamp within
-				const FIntPoint RectMin = FIntPoint(SlotPaddingMin.X, SlotPaddingMin.Y) + FixedPadding;
-				const FIntPoint RectMax = FIntPoint(AllottedGeometry.Size.X - SlotPaddingMax.X, AllottedGeometry.Size.Y - SlotPaddingMax.Y) - FixedPadding;
-				const FIntRect ClampRect(RectMin, RectMax);
+	//figure out if we clamped to any edge of the screen
+	EArrowDirection::Type ClampDir = EArrowDirection::MAX;
 
-				// Make sure the screen position is within the clamp rect
-				if (!ClampRect.Contains(FIntPoint(ScreenPosition.X, ScreenPosition.Y)))
-				{
-					const FPlane Planes[] =
-					{
-						FPlane(FVector(1.0f, 0.0f, 0.0f), ClampRect.Min.X),	// Left
-						FPlane(FVector(0.0f, 1.0f, 0.0f), ClampRect.Min.Y),	// Top
-						FPlane(FVector(-1.0f, 0.0f, 0.0f), -ClampRect.Max.X),	// Right
-						FPlane(FVector(0.0f, -1.0f, 0.0f), -ClampRect.Max.Y)	// Bottom
-					};
+	// If we don't have to clamp this thing, we can skip a lot of work
+	if (bShouldClamp)
+	{
+		// Determine the size of inner screen rect to clamp within
+		const FIntPoint RectMin = FIntPoint(SlotPaddingMin.X, SlotPaddingMin.Y) + FixedPadding;
+		const FIntPoint RectMax = FIntPoint(AllottedSize.X - SlotPaddingMax.X, AllottedSize.Y - SlotPaddingMax.Y) - FixedPadding;
+		const FIntRect ClampRect(RectMin, RectMax);
 
-					for (int32 i = 0; i < EArrowDirection::MAX; ++i)
-					{
-						FVector NewPoint;
-						if (FMath::SegmentPlaneIntersection(Center, FVector(ScreenPosition, 0.0f), Planes[i], NewPoint))
-						{
-							ClampDir = (EArrowDirection::Type)i;
-							ScreenPosition = FVector2D(NewPoint);
-						}
-					}
+		// Make sure the screen position is within the clamp rect
+		if (!ClampRect.Contains(FIntPoint(ScreenPosition.X, ScreenPosition.Y)))
+		{
+			const FPlane Planes[] =
+			{
+				FPlane(FVector(1.0f, 0.0f, 0.0f), ClampRect.Min.X),	// Left
+				FPlane(FVector(0.0f, 1.0f, 0.0f), ClampRect.Min.Y),	// Top
+				FPlane(FVector(-1.0f, 0.0f, 0.0f), -ClampRect.Max.X),	// Right
+				FPlane(FVector(0.0f, -1.0f, 0.0f), -ClampRect.Max.Y)	// Bottom
+			};
+
+			for (int32 i = 0; i < EArrowDirection::MAX; ++i)
+			{
+				FVector NewPoint;
+				if (FMath::SegmentPlaneIntersection(Center, FVector(ScreenPosition, 0.0f), Planes[i], NewPoint))
+				{
+					ClampDir = (EArrowDirection::Type)i;
+					ScreenPosition = FVector2D(NewPoint);
 				}
-				else if (!bInFrontOfCamera)
+			}
+		}
+		else if (!bInFrontOfCamera)
+		{
+			const float ScreenXNorm = ScreenPosition.X / (RectMax.X - RectMin.X);
+			const float ScreenYNorm = ScreenPosition.Y / (RectMax.Y - RectMin.Y);
+			//we need to pin this thing to the side of the screen
+			if (ScreenXNorm < ScreenYNorm)
+			{
+				if (ScreenXNorm < (-ScreenYNorm + 1.0f))
 				{
-					const float ScreenXNorm = ScreenPosition.X / (RectMax.X - RectMin.X);
-					const float ScreenYNorm = ScreenPosition.Y / (RectMax.Y - RectMin.Y);
-					//we need to pin this thing to the side of the screen
-					if (ScreenXNorm < ScreenYNorm)
-					{
-						if (ScreenXNorm < (-ScreenYNorm + 1.0f))
-						{
-							ClampDir = EArrowDirection::Left;
-							ScreenPosition.X = ClampRect.Min.X;
-						}
-						else
-						{
-							ClampDir = EArrowDirection::Bottom;
-							ScreenPosition.Y = ClampRect.Max.Y;
-						}
-					}
-					else
-					{
-						if (ScreenXNorm < (-ScreenYNorm + 1.0f))
-						{
-							ClampDir = EArrowDirection::Top;
-							ScreenPosition.Y = ClampRect.Min.Y;
-						}
-						else
-						{
-							ClampDir = EArrowDirection::Right;
-							ScreenPosition.X = ClampRect.Max.X;
-						}
-					}
+					ClampDir = EArrowDirection::Left;
+					ScreenPosition.X = ClampRect.Min.X;
 				}
+				else
+				{
+					ClampDir = EArrowDirection::Bottom;
+					ScreenPosition.Y = ClampRect.Max.Y;
+				}
+			}
+			else
+			{
+				if (ScreenXNorm < (-ScreenYNorm + 1.0f))
+				{
+					ClampDir = EArrowDirection::Top;
+					ScreenPosition.Y = ClampRect.Min.Y;
+				}
+				else
+				{
+					ClampDir = EArrowDirection::Right;
+					ScreenPosition.X = ClampRect.Max.X;
+				}
+			}
+		}
+	}
 
-				bWasIndicatorClamped = (ClampDir != EArrowDirection::MAX);
+	const bool bWasIndicatorClamped = (ClampDir != EArrowDirection::MAX);
+	CurChild.SetWasIndicatorClamped(bWasIndicatorClamped);
 
-				// should we show an arrow
-				if (Indicator->GetShowClampToScreenArrow() &&
-					bWasIndicatorClamped &&
-					ArrowChildren.IsValidIndex(NextArrowIndex))
-				{
-					const FVector2D ArrowOffsetDirection = ArrowOffsets[ClampDir];
-					const float ArrowRotation = ArrowRotations[ClampDir];
+	// should we show an arrow
+	CurChild.CachedArrowDirection = EArrowDirection::MAX;
+	if (Indicator->GetShowClampToScreenArrow() && bWasIndicatorClamped)
+	{
+		const FVector2D ArrowOffsetDirection = ArrowOffsets[ClampDir];
 
-					//grab an arrow widget
-					TSharedRef<SActorCanvasArrowWidget> ArrowWidgetToUse = StaticCastSharedRef<SActorCanvasArrowWidget>(ArrowChildren.GetChildAt(NextArrowIndex));
-					NextArrowIndex++;
+		//figure out the magnitude of the offset
+		const FVector2D OffsetMagnitude = (SlotSize + ArrowWidgetSize) * 0.5f;
 
-					//set the rotation of the arrow
-					ArrowWidgetToUse->SetRotation(ArrowRotation);
+		//used to center the arrow on the position
+		const FVector2D ArrowCenteringOffset = -(ArrowWidgetSize * 0.5f);
 
-					//figure out the magnitude of the offset
-					const FVector2D OffsetMagnitude = (SlotSize + ArrowWidgetSize) * 0.5f;
+		FVector2D ArrowAlignmentOffset = FVector2D::ZeroVector;
+		switch (Indicator->VAlignment)
+		{
+		case VAlign_Top:
+			ArrowAlignmentOffset = SlotSize * FVector2D(0.0f, 0.5f);
+			break;
+		case VAlign_Bottom:
+			ArrowAlignmentOffset = SlotSize * FVector2D(0.0f, -0.5f);
+			break;
+		}
 
-					//used to center the arrow on the position
-					const FVector2D ArrowCenteringOffset = -(ArrowWidgetSize * 0.5f);
+		//figure out the offset for the arrow
+		const FVector2D WidgetOffset = (OffsetMagnitude * ArrowOffsetDirection);
 
-					FVector2D ArrowAlignmentOffset = FVector2D::ZeroVector;
-					switch (Indicator->VAlignment)
-					{
-					case VAlign_Top:
-						ArrowAlignmentOffset = SlotSize * FVector2D(0.0f, 0.5f);
-						break;
-					case VAlign_Bottom:
-						ArrowAlignmentOffset = SlotSize * FVector2D(0.0f, -0.5f);
-						break;
-					}
+		const FVector2D FinalOffset = (WidgetOffset + ArrowAlignmentOffset + ArrowCenteringOffset);
+
+		//get the final position
+		CurChild.CachedArrowDirection = ClampDir;
+		CurChild.CachedArrowPosition = (ScreenPosition + FinalOffset);
+	}
+
+	CurChild.CachedArrangedPosition = ScreenPosition + SlotOffset;
+	CurChild.CachedArrangedSize = SlotSize;
+	CurChild.bNeedsArrange = false;
+}
+
+void SActorCanvas::OnArrangeChildren(const FGeometry& AllottedGeometry, FArrangedChildren& ArrangedChildren) const
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SActorCanvas_OnArrangeChildren);
 
-					//figure out the offset for the arrow
-					const FVector2D WidgetOffset = (OffsetMagnitude * ArrowOffsetDirection);
+	NextArrowIndex = 0;
 
-					const FVector2D FinalOffset = (WidgetOffset + ArrowAlignmentOffset + ArrowCenteringOffset);
+	//Make sure we have a player. If we don't, we can't project anything
+	if (bShowAnyIndicators)
+	{
+		const FVector2D ArrowWidgetSize = ActorCanvasArrowBrush->GetImageSize();
 
-					//get the final position
-					const FVector2D FinalPosition = (ScreenPosition + FinalOffset);
+		// A resized canvas moves every clamp rect, so nothing retained from the last arrange is still valid.
+		const bool bCanvasResized = !LastArrangedSize.Equals(AllottedGeometry.Size);
+		LastArrangedSize = AllottedGeometry.Size;
 
-					ArrowWidgetToUse->SetVisibility(EVisibility::HitTestInvisible);
+		// Sort the children
+		UpdateSortedSlots();
 
-					// Inject the arrow on top of the indicator
-					ArrangedChildren.AddWidget(AllottedGeometry.MakeChild(
-						ArrowWidgetToUse,			// The child widget being arranged
-						FinalPosition,				// Child's local position (i.e. position within parent)
-						ArrowWidgetSize,			// Child's size
-						1.f							// Child's scale
-					));
-				}
+		// Go through all the sorted children
+		for (int32 ChildIndex = 0; ChildIndex < SortedSlots.Num(); ++ChildIndex)
+		{
+			//grab a child
+			const SActorCanvas::FSlot& CurChild = *SortedSlots[ChildIndex];
+			const UIndicatorDescriptor* Indicator = CurChild.Indicator;
+
+			// Skip this indicator if it's invalid or has an invalid world position
+			if (!ArrangedChildren.Accepts(CurChild.GetWidget()->GetVisibility()))
+			{
+				CurChild.SetWasIndicatorClamped(false);
+				CurChild.bNeedsArrange = true;
+				continue;
 			}
 
-			CurChild.SetWasIndicatorClamped(bWasIndicatorClamped);
+			// Only re-arrange the slot if it changed since the last arrange. The desired size and alignment are not
+			// tracked by the slot itself, so compare them against what we arranged with last time.
+			const TSharedPtr<SWidget> CanvasHost = Indicator->CanvasHost.Pin();
+			const FVector2D DesiredSize = CanvasHost.IsValid() ? CanvasHost->GetDesiredSize() : FVector2D::ZeroVector;
+			const uint8 LayoutKey = (uint8)Indicator->GetHAlign() | ((uint8)Indicator->GetVAlign() << 2) | ((uint8)Indicator->GetClampToScreen() << 4) | ((uint8)Indicator->GetShowClampToScreenArrow() << 5);
+
+			if (!bRetainedMode || bCanvasResized || CurChild.bNeedsArrange || CurChild.CachedLayoutKey != LayoutKey || !CurChild.CachedDesiredSize.Equals(DesiredSize))
+			{
+				CurChild.CachedLayoutKey = LayoutKey;
+				CurChild.CachedDesiredSize = DesiredSize;
+				ArrangeSlot(CurChild, AllottedGeometry.Size, ArrowWidgetSize);
+			}
+
+			if (CurChild.CachedArrowDirection != EArrowDirection::MAX && ArrowChildren.IsValidIndex(NextArrowIndex))
+			{
+				//grab an arrow widget
+				TSharedRef<SActorCanvasArrowWidget> ArrowWidgetToUse = StaticCastSharedRef<SActorCanvasArrowWidget>(ArrowChildren.GetChildAt(NextArrowIndex));
+				NextArrowIndex++;
+
+				//set the rotation of the arrow
+				ArrowWidgetToUse->SetRotation(ArrowRotations[CurChild.CachedArrowDirection]);
+				ArrowWidgetToUse->SetVisibility(EVisibility::HitTestInvisible);
+
+				// Inject the arrow on top of the indicator
+				ArrangedChildren.AddWidget(AllottedGeometry.MakeChild(
+					ArrowWidgetToUse,					// The child widget being arranged
+					CurChild.CachedArrowPosition,		// Child's local position (i.e. position within parent)
+					ArrowWidgetSize,					// Child's size
+					1.f									// Child's scale
+				));
+			}
 
 			// Add the information about this child to the output list (ArrangedChildren)
 			ArrangedChildren.AddWidget(AllottedGeometry.MakeChild(
 				CurChild.GetWidget(),
-				ScreenPosition + SlotOffset,
-				SlotSize,
+				CurChild.CachedArrangedPosition,
+				CurChild.CachedArrangedSize,
 				1.f
 			));
 		}
@@ -631,6 +705,7 @@ SActorCanvas::FScopedWidgetSlotArguments SActorCanvas::AddActorSlot(UIndicatorDe
 		{
 			if (TSharedPtr<SActorCanvas> Canvas = WeakCanvas.Pin())
 			{
+				Canvas->bSortedSlotsInvalid = true;
 				Canvas->UpdateActiveTimer();
 			}
 		}};
@@ -643,6 +718,7 @@ int32 SActorCanvas::RemoveActorSlot(const TSharedRef<SWidget>& SlotWidget)
 		if ( SlotWidget == CanvasChildren[SlotIdx].GetWidget() )
 		{
 			CanvasChildren.RemoveAt(SlotIdx);
+			bSortedSlotsInvalid = true;
 
 			UpdateActiveTimer();
 
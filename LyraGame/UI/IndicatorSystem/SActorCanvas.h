@@ -38,6 +38,8 @@ public:
 			, bDirty(true)
 			, bWasIndicatorClamped(false)
 			, bWasIndicatorClampedStatusChanged(false)
+			, bNeedsArrange(true)
+			, bSortKeyChanged(true)
 		{
 		}
 
@@ -51,7 +53,7 @@ public:
 			if (bIsIndicatorVisible != bVisible)
 			{
 				bIsIndicatorVisible = bVisible;
-				bDirty = true;
+				MarkDirty(false);
 			}
 
 			RefreshVisibility();
@@ -63,7 +65,7 @@ public:
 			if (ScreenPosition != InScreenPosition)
 			{
 				ScreenPosition = InScreenPosition;
-				bDirty = true;
+				MarkDirty(false);
 			}
 		}
 
@@ -73,7 +75,7 @@ public:
 			if (Depth != InDepth)
 			{
 				Depth = InDepth;
-				bDirty = true;
+				MarkDirty(true);
 			}
 		}
 
@@ -83,7 +85,7 @@ public:
 			if (Priority != InPriority)
 			{
 				Priority = InPriority;
-				bDirty = true;
+				MarkDirty(true);
 			}
 		}
 
@@ -93,7 +95,7 @@ public:
 			if (bInFrontOfCamera != bInFront)
 			{
 				bInFrontOfCamera = bInFront;
-				bDirty = true;
+				MarkDirty(false);
 			}
 
 			RefreshVisibility();
@@ -105,7 +107,7 @@ public:
 			if (bHasValidScreenPosition != bValidScreenPosition)
 			{
 				bHasValidScreenPosition = bValidScreenPosition;
-				bDirty = true;
+				MarkDirty(false);
 			}
 
 			RefreshVisibility();
@@ -135,6 +137,13 @@ public:
 		}
 
 	private:
+		void MarkDirty(bool bAffectsSortOrder)
+		{
+			bDirty = true;
+			bNeedsArrange = true;
+			bSortKeyChanged |= bAffectsSortOrder;
+		}
+
 		void RefreshVisibility()
 		{
 			const bool bIsVisible = bIsIndicatorVisible && bHasValidScreenPosition;
@@ -159,6 +168,19 @@ public:
 		mutable uint8 bWasIndicatorClamped : 1;
 		mutable uint8 bWasIndicatorClampedStatusChanged : 1;
 
+		/**
+		 * Retained arrangement state. A slot is only re-arranged when it was marked dirty since the last arrange,
+		 * or when something it depends on (canvas size, desired size, alignment) changed.
+		 */
+		mutable uint8 bNeedsArrange : 1;
+		mutable uint8 bSortKeyChanged : 1;
+		mutable uint8 CachedLayoutKey = 0;
+		mutable uint8 CachedArrowDirection = 0;
+		mutable FVector2D CachedArrangedPosition = FVector2D::ZeroVector;
+		mutable FVector2D CachedArrangedSize = FVector2D::ZeroVector;
+		mutable FVector2D CachedDesiredSize = FVector2D::ZeroVector;
+		mutable FVector2D CachedArrowPosition = FVector2D::ZeroVector;
+
 		friend class SActorCanvas;
 	};
 
@@ -198,6 +220,13 @@ public:
 
 	void SetDrawElementsInOrder(bool bInDrawElementsInOrder) { bDrawElementsInOrder = bInDrawElementsInOrder; }
 
+	/**
+	 * In retained mode the canvas keeps its sorted slot list and per-slot arrangement between frames, and only
+	 * re-sorts / re-arranges the slots whose position, visibility or depth changed since the last frame.
+	 */
+	void SetRetainedMode(bool bInRetainedMode);
+	bool IsRetainedMode() const { return bRetainedMode; }
+
 	virtual FString GetReferencerName() const override;
 	virtual void AddReferencedObjects( FReferenceCollector& Collector ) override;
 	
@@ -224,6 +253,12 @@ private:
 
 	void UpdateActiveTimer();
 
+	/** Rebuilds or incrementally re-sorts SortedSlots, depending on what changed since the last arrange. */
+	void UpdateSortedSlots() const;
+
+	/** Computes the arranged position, size and clamp arrow of a single slot into its retained cache. */
+	void ArrangeSlot(const FSlot& CurChild, const FVector2D& AllottedSize, const FVector2D& ArrowWidgetSize) const;
+
 private:
 	TArray<TObjectPtr<UIndicatorDescriptor>> AllIndicators;
 	TArray<UIndicatorDescriptor*> InactiveIndicators;
@@ -248,6 +283,18 @@ private:
 
 	bool bShowAnyIndicators = false;
 
+	/** See SetRetainedMode */
+	bool bRetainedMode = true;
+
+	/** Slots sorted by priority then depth, retained between arranges */
+	mutable TArray<const FSlot*> SortedSlots;
+
+	/** Set when slots are added or removed, forcing SortedSlots to be rebuilt from CanvasChildren */
+	mutable bool bSortedSlotsInvalid = true;
+
+	/** Size of the geometry we last arranged against; a change invalidates every slot's retained arrangement */
+	mutable FVector2D LastArrangedSize = FVector2D::ZeroVector;
+
 	mutable TOptional<FGeometry> OptionalPaintGeometry;
 
 	TSharedPtr<FActiveTimerHandle> TickHandle;
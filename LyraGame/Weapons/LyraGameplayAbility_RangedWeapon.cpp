@@ -518,7 +518,7 @@ void ULyraGameplayAbility_RangedWeapon::OnTargetDataReadyCallback(const FGamepla
 							}
 						}
 
-						WeaponStateComponent->ClientConfirmTargetData(LocalTargetDataHandle.UniqueId, bIsTargetDataValid, HitReplaces);
+						WeaponStateComponent->ConfirmShot(LocalTargetDataHandle.UniqueId, bIsTargetDataValid, HitReplaces);
 					}
 
 				}
@@ -570,7 +570,7 @@ void ULyraGameplayAbility_RangedWeapon::StartRangedWeaponTargeting()
 
 	// Fill out the target data from the hit results
 	FGameplayAbilityTargetDataHandle TargetData;
-	TargetData.UniqueId = WeaponStateComponent ? WeaponStateComponent->GetUnconfirmedServerSideHitMarkerCount() : 0;
+	TargetData.UniqueId = WeaponStateComponent ? WeaponStateComponent->AllocateShotIndex() : 0;
 
 	if (FoundHits.Num() > 0)
 	{
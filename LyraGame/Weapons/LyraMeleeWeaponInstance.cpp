@@ -6,11 +6,69 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "NativeGameplayTags.h"
 #include "AbilitySystem/Abilities/LyraGameplayAbility_Death.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Physics/PhysicalMaterialWithTags.h"
+#include "UObject/ObjectKey.h"
 
 UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_MeleeWeaponHit, "GameplayEvent.Montage.Hit")
 
+namespace LyraMeleeWeapon
+{
+	// Socket names of the weapon meshes equipped so far. Weapons are equipped far more often than there are weapon
+	// meshes, and GetAllSocketNames builds a new array every time. Emptied when a world is cleaned up, so meshes that
+	// were unloaded with it do not keep an entry.
+	static TMap<FObjectKey, TArray<FName>> SocketNamesByMesh;
+	static FDelegateHandle WorldCleanupHandle;
+
+	static const UObject* GetSocketSource(const UPrimitiveComponent* PrimitiveComponent)
+	{
+#if WITH_EDITOR
+		// Sockets can be edited while playing in the editor.
+		return nullptr;
+#else
+		if (const UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(PrimitiveComponent))
+		{
+			return StaticMeshComponent->GetStaticMesh();
+		}
+		if (const USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(PrimitiveComponent))
+		{
+			return SkeletalMeshComponent->GetSkeletalMeshAsset();
+		}
+		return nullptr;
+#endif
+	}
+
+	// Returns the cached socket names of the component's mesh, or fills and returns UncachedSocketNames when the mesh can't be cached.
+	static const TArray<FName>& GetSocketNames(const UPrimitiveComponent* PrimitiveComponent, TArray<FName>& UncachedSocketNames)
+	{
+		const UObject* SocketSource = GetSocketSource(PrimitiveComponent);
+		if (SocketSource == nullptr)
+		{
+			UncachedSocketNames = PrimitiveComponent->GetAllSocketNames();
+			return UncachedSocketNames;
+		}
+
+		const FObjectKey SourceKey(SocketSource);
+		if (const TArray<FName>* CachedSocketNames = SocketNamesByMesh.Find(SourceKey))
+		{
+			return *CachedSocketNames;
+		}
+
+		if (!WorldCleanupHandle.IsValid())
+		{
+			WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddLambda([](UWorld* World, bool bSessionEnded, bool bCleanupResources)
+			{
+				SocketNamesByMesh.Empty();
+			});
+		}
+
+		return SocketNamesByMesh.Add(SourceKey, PrimitiveComponent->GetAllSocketNames());
+	}
+}
+
 FVector FLyraCollidingComponent::GetSocketLocation(const FName& SocketName) const
 {
 	if( SocketName.IsNone() )
@@ -47,23 +105,23 @@ void ULyraMeleeWeaponInstance::OnEquipped()
 {
 	Super::OnEquipped();
 
+	TArray<FName> UncachedSocketNames;
+
 	for (const AActor* SpawnedActor : GetSpawnedActors())
 	{
-		TArray<FName> SocketNames;
-
 		// Look for components that may have sockets
 		UPrimitiveComponent* PrimitiveComponent = SpawnedActor->FindComponentByClass<UPrimitiveComponent>();
 
 		if (PrimitiveComponent)
 		{
-			// Get all socket names from PrimitiveComponent
-			SocketNames = PrimitiveComponent->GetAllSocketNames();
-		}
+			// Get all socket names from PrimitiveComponent (cached per mesh)
+			const TArray<FName>& SocketNames = LyraMeleeWeapon::GetSocketNames(PrimitiveComponent, UncachedSocketNames);
 
-		if (SocketNames.Num() > 0)
-		{
-			// Add the colliding component with its sockets to ActiveCollidingComponents
-			ActiveCollidingComponents.Add(FLyraCollidingComponent(PrimitiveComponent, SocketNames));
+			if (SocketNames.Num() > 0)
+			{
+				// Add the colliding component with its sockets to ActiveCollidingComponents
+				ActiveCollidingComponents.Add(FLyraCollidingComponent(PrimitiveComponent, SocketNames));
+			}
 		}
 	}
 
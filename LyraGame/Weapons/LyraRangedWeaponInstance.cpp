@@ -2,9 +2,11 @@
 
 #include "LyraRangedWeaponInstance.h"
 #include "NativeGameplayTags.h"
+#include "Engine/World.h"
 #include "GameFramework/Pawn.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Camera/LyraCameraComponent.h"
+#include "HAL/IConsoleManager.h"
 #include "Physics/PhysicalMaterialWithTags.h"
 #include "Weapons/LyraWeaponInstance.h"
 
@@ -12,6 +14,52 @@
 
 UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Lyra_Weapon_SteadyAimingCamera, "Lyra.Weapon.SteadyAimingCamera");
 
+namespace LyraRangedWeapon
+{
+	static bool bUseBakedCurves = true;
+	static FAutoConsoleVariableRef CVarUseBakedCurves(
+		TEXT("Lyra.Weapon.UseBakedSpreadCurves"),
+		bUseBakedCurves,
+		TEXT("If true, ranged weapons evaluate their heat and spread curves from lookup tables baked when the weapon is created or edited."),
+		ECVF_Default);
+
+	static int32 BakedCurveSamples = 64;
+	static FAutoConsoleVariableRef CVarBakedCurveSamples(
+		TEXT("Lyra.Weapon.BakedSpreadCurveSamples"),
+		BakedCurveSamples,
+		TEXT("Number of samples in the baked heat and spread curves of a ranged weapon. Read when a weapon is created or edited."),
+		ECVF_Default);
+
+	static bool bSettledEarlyOut = true;
+	static FAutoConsoleVariableRef CVarSettledEarlyOut(
+		TEXT("Lyra.Weapon.SettledSpreadEarlyOut"),
+		bSettledEarlyOut,
+		TEXT("If true, ranged weapons skip their spread update once the heat has cooled down to its minimum, and their multiplier update while the multipliers sit at their targets."),
+		ECVF_Default);
+}
+
+void FLyraBakedCurve::Bake(const FRichCurve& Curve, float InMinTime, float InMaxTime, int32 NumSamples)
+{
+	Samples.Reset();
+	MinTime = InMinTime;
+	InvStep = 0.0f;
+
+	if ((Curve.GetNumKeys() < 2) || (InMaxTime <= InMinTime) || (NumSamples < 2))
+	{
+		Samples.Add(Curve.Eval(InMinTime));
+		return;
+	}
+
+	const float Step = (InMaxTime - InMinTime) / static_cast<float>(NumSamples - 1);
+	InvStep = 1.0f / Step;
+
+	Samples.Reserve(NumSamples);
+	for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+	{
+		Samples.Add(Curve.Eval(InMinTime + Step * static_cast<float>(SampleIndex)));
+	}
+}
+
 ULyraRangedWeaponInstance::ULyraRangedWeaponInstance(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -19,10 +67,20 @@ ULyraRangedWeaponInstance::ULyraRangedWeaponInstance(const FObjectInitializer& O
 	HeatToCoolDownPerSecondCurve.EditorCurveData.AddKey(0.0f, 2.0f);
 }
 
+void ULyraRangedWeaponInstance::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// Instances are created from their class defaults at runtime, the tables are not properties so they are not copied along
+	BakeCurves();
+}
+
 void ULyraRangedWeaponInstance::PostLoad()
 {
 	Super::PostLoad();
 
+	BakeCurves();
+
 #if WITH_EDITOR
 	UpdateDebugVisualization();
 #endif
@@ -32,6 +90,7 @@ void ULyraRangedWeaponInstance::PostLoad()
 void ULyraRangedWeaponInstance::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
+	BakeCurves();
 	UpdateDebugVisualization();
 }
 
@@ -56,13 +115,18 @@ void ULyraRangedWeaponInstance::OnEquipped()
 	CurrentHeat = (MinHeatRange + MaxHeatRange) * 0.5f;
 
 	// Derive spread
-	CurrentSpreadAngle = HeatToSpreadCurve.GetRichCurveConst()->Eval(CurrentHeat);
+	CurrentSpreadAngle = EvalHeatCurve(HeatToSpreadCurve, BakedHeatToSpreadCurve, CurrentHeat);
 
 	// Default the multipliers to 1x
 	CurrentSpreadAngleMultiplier = 1.0f;
 	StandingStillMultiplier = 1.0f;
 	JumpFallMultiplier = 1.0f;
 	CrouchingMultiplier = 1.0f;
+	AimingMultiplier = 1.0f;
+
+	bSpreadSettled = false;
+	bMultipliersSettled = false;
+	CachedCameraComponent.Reset();
 }
 
 void ULyraRangedWeaponInstance::OnUnequipped()
@@ -76,18 +140,57 @@ void ULyraRangedWeaponInstance::Tick(float DeltaSeconds)
 	APawn* Pawn = GetPawn();
 	check(Pawn != nullptr);
 	
+	const bool bWasSettled = bSpreadSettled && bMultipliersSettled;
+
 	const bool bMinSpread = UpdateSpread(DeltaSeconds);
 	const bool bMinMultipliers = UpdateMultipliers(DeltaSeconds);
 
 	bHasFirstShotAccuracy = bAllowFirstShotAccuracy && bMinMultipliers && bMinSpread;
 
 #if WITH_EDITOR
-	UpdateDebugVisualization();
+	if (!bWasSettled || !bSpreadSettled || !bMultipliersSettled)
+	{
+		UpdateDebugVisualization();
+	}
 #endif
 }
 
+void ULyraRangedWeaponInstance::BakeCurves()
+{
+	bCurvesBaked = false;
+
+	ComputeHeatRange(/*out*/ BakedMinHeat, /*out*/ BakedMaxHeat);
+	ComputeSpreadRange(/*out*/ BakedMinSpread, /*out*/ BakedMaxSpread);
+
+	// Every curve is sampled over the full heat range so the tables include each curve's own extrapolation
+	const int32 NumSamples = FMath::Clamp(LyraRangedWeapon::BakedCurveSamples, 2, 4096);
+	BakedHeatToSpreadCurve.Bake(*HeatToSpreadCurve.GetRichCurveConst(), BakedMinHeat, BakedMaxHeat, NumSamples);
+	BakedHeatToHeatPerShotCurve.Bake(*HeatToHeatPerShotCurve.GetRichCurveConst(), BakedMinHeat, BakedMaxHeat, NumSamples);
+	BakedHeatToCoolDownPerSecondCurve.Bake(*HeatToCoolDownPerSecondCurve.GetRichCurveConst(), BakedMinHeat, BakedMaxHeat, NumSamples);
+
+	bCurvesBaked = true;
+	bSpreadSettled = false;
+}
+
+float ULyraRangedWeaponInstance::EvalHeatCurve(const FRuntimeFloatCurve& Curve, const FLyraBakedCurve& BakedCurve, float Heat) const
+{
+	if (LyraRangedWeapon::bUseBakedCurves && BakedCurve.IsBaked())
+	{
+		return BakedCurve.Eval(Heat);
+	}
+
+	return Curve.GetRichCurveConst()->Eval(Heat);
+}
+
 void ULyraRangedWeaponInstance::ComputeHeatRange(float& MinHeat, float& MaxHeat)
 {
+	if (bCurvesBaked && LyraRangedWeapon::bUseBakedCurves)
+	{
+		MinHeat = BakedMinHeat;
+		MaxHeat = BakedMaxHeat;
+		return;
+	}
+
 	float Min1;
 	float Max1;
 	HeatToHeatPerShotCurve.GetRichCurveConst()->GetTimeRange(/*out*/ Min1, /*out*/ Max1);
@@ -106,17 +209,25 @@ void ULyraRangedWeaponInstance::ComputeHeatRange(float& MinHeat, float& MaxHeat)
 
 void ULyraRangedWeaponInstance::ComputeSpreadRange(float& MinSpread, float& MaxSpread)
 {
+	if (bCurvesBaked && LyraRangedWeapon::bUseBakedCurves)
+	{
+		MinSpread = BakedMinSpread;
+		MaxSpread = BakedMaxSpread;
+		return;
+	}
+
 	HeatToSpreadCurve.GetRichCurveConst()->GetValueRange(/*out*/ MinSpread, /*out*/ MaxSpread);
 }
 
 void ULyraRangedWeaponInstance::AddSpread()
 {
 	// Sample the heat up curve
-	const float HeatPerShot = HeatToHeatPerShotCurve.GetRichCurveConst()->Eval(CurrentHeat);
+	const float HeatPerShot = EvalHeatCurve(HeatToHeatPerShotCurve, BakedHeatToHeatPerShotCurve, CurrentHeat);
 	CurrentHeat = ClampHeat(CurrentHeat + HeatPerShot);
 
 	// Map the heat to the spread angle
-	CurrentSpreadAngle = HeatToSpreadCurve.GetRichCurveConst()->Eval(CurrentHeat);
+	CurrentSpreadAngle = EvalHeatCurve(HeatToSpreadCurve, BakedHeatToSpreadCurve, CurrentHeat);
+	bSpreadSettled = false;
 
 #if WITH_EDITOR
 	UpdateDebugVisualization();
@@ -153,20 +264,38 @@ float ULyraRangedWeaponInstance::GetWeaponBaseDamage() const
 
 bool ULyraRangedWeaponInstance::UpdateSpread(float DeltaSeconds)
 {
+	if (bSpreadSettled && LyraRangedWeapon::bSettledEarlyOut)
+	{
+		return bSettledAtMinSpread;
+	}
+
 	const float TimeSinceFired = GetWorld()->TimeSince(LastFireTime);
 
+	float MinHeat;
+	float MaxHeat;
+	ComputeHeatRange(/*out*/ MinHeat, /*out*/ MaxHeat);
+
+	bool bHeatAtMin = false;
 	if (TimeSinceFired > SpreadRecoveryCooldownDelay)
 	{
-		const float CooldownRate = HeatToCoolDownPerSecondCurve.GetRichCurveConst()->Eval(CurrentHeat);
-		CurrentHeat = ClampHeat(CurrentHeat - (CooldownRate * DeltaSeconds));
-		CurrentSpreadAngle = HeatToSpreadCurve.GetRichCurveConst()->Eval(CurrentHeat);
+		const float CooldownRate = EvalHeatCurve(HeatToCoolDownPerSecondCurve, BakedHeatToCoolDownPerSecondCurve, CurrentHeat);
+		CurrentHeat = FMath::Clamp(CurrentHeat - (CooldownRate * DeltaSeconds), MinHeat, MaxHeat);
+		CurrentSpreadAngle = EvalHeatCurve(HeatToSpreadCurve, BakedHeatToSpreadCurve, CurrentHeat);
+
+		// Further cooldowns would clamp to the same heat, until a shot adds some
+		bHeatAtMin = (CooldownRate > 0.0f) && (CurrentHeat <= MinHeat);
 	}
 	
 	float MinSpread;
 	float MaxSpread;
 	ComputeSpreadRange(/*out*/ MinSpread, /*out*/ MaxSpread);
 
-	return FMath::IsNearlyEqual(CurrentSpreadAngle, MinSpread, KINDA_SMALL_NUMBER);
+	const bool bMinSpread = FMath::IsNearlyEqual(CurrentSpreadAngle, MinSpread, KINDA_SMALL_NUMBER);
+
+	bSpreadSettled = bHeatAtMin;
+	bSettledAtMinSpread = bMinSpread;
+
+	return bMinSpread;
 }
 
 bool ULyraRangedWeaponInstance::UpdateMultipliers(float DeltaSeconds)
@@ -183,24 +312,25 @@ bool ULyraRangedWeaponInstance::UpdateMultipliers(float DeltaSeconds)
 		/*InputRange=*/ FVector2D(StandingStillSpeedThreshold, StandingStillSpeedThreshold + StandingStillToMovingSpeedRange),
 		/*OutputRange=*/ FVector2D(SpreadAngleMultiplier_StandingStill, 1.0f),
 		/*Alpha=*/ PawnSpeed);
-	StandingStillMultiplier = FMath::FInterpTo(StandingStillMultiplier, MovementTargetValue, DeltaSeconds, TransitionRate_StandingStill);
-	const bool bStandingStillMultiplierAtMin = FMath::IsNearlyEqual(StandingStillMultiplier, SpreadAngleMultiplier_StandingStill, SpreadAngleMultiplier_StandingStill*0.1f);
 
 	// See if we are crouching, and if so, smoothly apply the bonus
 	const bool bIsCrouching = (CharMovementComp != nullptr) && CharMovementComp->IsCrouching();
 	const float CrouchingTargetValue = bIsCrouching ? SpreadAngleMultiplier_Crouching : 1.0f;
-	CrouchingMultiplier = FMath::FInterpTo(CrouchingMultiplier, CrouchingTargetValue, DeltaSeconds, TransitionRate_Crouching);
-	const bool bCrouchingMultiplierAtTarget = FMath::IsNearlyEqual(CrouchingMultiplier, CrouchingTargetValue, MultiplierNearlyEqualThreshold);
 
 	// See if we are in the air (jumping/falling), and if so, smoothly apply the penalty
 	const bool bIsJumpingOrFalling = (CharMovementComp != nullptr) && CharMovementComp->IsFalling();
 	const float JumpFallTargetValue = bIsJumpingOrFalling ? SpreadAngleMultiplier_JumpingOrFalling : 1.0f;
-	JumpFallMultiplier = FMath::FInterpTo(JumpFallMultiplier, JumpFallTargetValue, DeltaSeconds, TransitionRate_JumpingOrFalling);
-	const bool bJumpFallMultiplerIs1 = FMath::IsNearlyEqual(JumpFallMultiplier, 1.0f, MultiplierNearlyEqualThreshold);
 
 	// Determine if we are aiming down sights, and apply the bonus based on how far into the camera transition we are
+	const ULyraCameraComponent* CameraComponent = CachedCameraComponent.Get();
+	if (CameraComponent == nullptr)
+	{
+		CameraComponent = ULyraCameraComponent::FindCameraComponent(Pawn);
+		CachedCameraComponent = CameraComponent;
+	}
+
 	float AimingAlpha = 0.0f;
-	if (const ULyraCameraComponent* CameraComponent = ULyraCameraComponent::FindCameraComponent(Pawn))
+	if (CameraComponent != nullptr)
 	{
 		float TopCameraWeight;
 		FGameplayTag TopCameraTag;
@@ -208,10 +338,28 @@ bool ULyraRangedWeaponInstance::UpdateMultipliers(float DeltaSeconds)
 
 		AimingAlpha = (TopCameraTag == TAG_Lyra_Weapon_SteadyAimingCamera) ? TopCameraWeight : 0.0f;
 	}
-	const float AimingMultiplier = FMath::GetMappedRangeValueClamped(
+	const float AimingTargetValue = FMath::GetMappedRangeValueClamped(
 		/*InputRange=*/ FVector2D(0.0f, 1.0f),
 		/*OutputRange=*/ FVector2D(1.0f, SpreadAngleMultiplier_Aiming),
 		/*Alpha=*/ AimingAlpha);
+
+	// Interpolating towards the values we already hold would not change anything
+	const bool bAtTargets = (StandingStillMultiplier == MovementTargetValue) && (CrouchingMultiplier == CrouchingTargetValue) && (JumpFallMultiplier == JumpFallTargetValue) && (AimingMultiplier == AimingTargetValue);
+	if (bMultipliersSettled && bAtTargets && LyraRangedWeapon::bSettledEarlyOut)
+	{
+		return bSettledAtMinMultipliers;
+	}
+
+	StandingStillMultiplier = FMath::FInterpTo(StandingStillMultiplier, MovementTargetValue, DeltaSeconds, TransitionRate_StandingStill);
+	const bool bStandingStillMultiplierAtMin = FMath::IsNearlyEqual(StandingStillMultiplier, SpreadAngleMultiplier_StandingStill, SpreadAngleMultiplier_StandingStill*0.1f);
+
+	CrouchingMultiplier = FMath::FInterpTo(CrouchingMultiplier, CrouchingTargetValue, DeltaSeconds, TransitionRate_Crouching);
+	const bool bCrouchingMultiplierAtTarget = FMath::IsNearlyEqual(CrouchingMultiplier, CrouchingTargetValue, MultiplierNearlyEqualThreshold);
+
+	JumpFallMultiplier = FMath::FInterpTo(JumpFallMultiplier, JumpFallTargetValue, DeltaSeconds, TransitionRate_JumpingOrFalling);
+	const bool bJumpFallMultiplerIs1 = FMath::IsNearlyEqual(JumpFallMultiplier, 1.0f, MultiplierNearlyEqualThreshold);
+
+	AimingMultiplier = AimingTargetValue;
 	const bool bAimingMultiplierAtTarget = FMath::IsNearlyEqual(AimingMultiplier, SpreadAngleMultiplier_Aiming, KINDA_SMALL_NUMBER);
 
 	// Combine all the multipliers
@@ -219,6 +367,121 @@ bool ULyraRangedWeaponInstance::UpdateMultipliers(float DeltaSeconds)
 	CurrentSpreadAngleMultiplier = CombinedMultiplier;
 
 	// need to handle these spread multipliers indicating we are not at min spread
-	return bStandingStillMultiplierAtMin && bCrouchingMultiplierAtTarget && bJumpFallMultiplerIs1 && bAimingMultiplierAtTarget;
+	const bool bMinMultipliers = bStandingStillMultiplierAtMin && bCrouchingMultiplierAtTarget && bJumpFallMultiplerIs1 && bAimingMultiplierAtTarget;
+
+	// FInterpTo snaps to the target once close enough, so this is reached after a finite number of updates
+	bMultipliersSettled = (StandingStillMultiplier == MovementTargetValue) && (CrouchingMultiplier == CrouchingTargetValue) && (JumpFallMultiplier == JumpFallTargetValue);
+	bSettledAtMinMultipliers = bMinMultipliers;
+
+	return bMinMultipliers;
 }
 
+void ULyraRangedWeaponInstance::BenchmarkTick(UWorld* World, int32 NumWeapons, int32 NumFrames, FOutputDevice& Ar)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags |= RF_Transient;
+
+	TArray<APawn*> Bots;
+	TArray<ULyraRangedWeaponInstance*> Weapons;
+	for (int32 WeaponIndex = 0; WeaponIndex < NumWeapons; ++WeaponIndex)
+	{
+		APawn* Bot = World->SpawnActor<APawn>(APawn::StaticClass(), FTransform::Identity, SpawnParams);
+		if (!Bot)
+		{
+			continue;
+		}
+
+		// Roughly the shape of the rifle's curves: spread grows faster as the weapon heats up, and cools down slower
+		ULyraRangedWeaponInstance* Weapon = NewObject<ULyraRangedWeaponInstance>(Bot);
+		Weapon->HeatToSpreadCurve.EditorCurveData.AddKey(0.0f, 0.5f);
+		Weapon->HeatToSpreadCurve.EditorCurveData.AddKey(5.0f, 2.0f);
+		Weapon->HeatToSpreadCurve.EditorCurveData.AddKey(10.0f, 6.0f);
+		Weapon->HeatToCoolDownPerSecondCurve.EditorCurveData.AddKey(10.0f, 1.0f);
+		Weapon->BakeCurves();
+
+		Bots.Add(Bot);
+		Weapons.Add(Weapon);
+	}
+
+	// Each bot fires a five shot burst every four seconds, at 30 Hz
+	const float DeltaSeconds = 1.0f / 30.0f;
+	auto ShouldFire = [](int32 FrameIndex, int32 WeaponIndex)
+	{
+		return (((FrameIndex + WeaponIndex * 13) % 120) < 15) && ((FrameIndex % 3) == 0);
+	};
+
+	int64 NumSettledTicks = 0;
+	auto TimeTicks = [&](bool bUseBakedCurves, bool bSettledEarlyOut)
+	{
+		const bool bWasUsingBakedCurves = LyraRangedWeapon::bUseBakedCurves;
+		const bool bWasSettledEarlyOut = LyraRangedWeapon::bSettledEarlyOut;
+		LyraRangedWeapon::bUseBakedCurves = bUseBakedCurves;
+		LyraRangedWeapon::bSettledEarlyOut = bSettledEarlyOut;
+
+		for (ULyraRangedWeaponInstance* Weapon : Weapons)
+		{
+			Weapon->OnEquipped();
+		}
+
+		NumSettledTicks = 0;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 FrameIndex = 0; FrameIndex < NumFrames; ++FrameIndex)
+		{
+			for (int32 WeaponIndex = 0; WeaponIndex < Weapons.Num(); ++WeaponIndex)
+			{
+				ULyraRangedWeaponInstance* Weapon = Weapons[WeaponIndex];
+				if (ShouldFire(FrameIndex, WeaponIndex))
+				{
+					Weapon->AddSpread();
+				}
+
+				Weapon->Tick(DeltaSeconds);
+
+				NumSettledTicks += (Weapon->bSpreadSettled && Weapon->bMultipliersSettled) ? 1 : 0;
+			}
+		}
+		const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		for (ULyraRangedWeaponInstance* Weapon : Weapons)
+		{
+			Weapon->OnUnequipped();
+		}
+
+		LyraRangedWeapon::bUseBakedCurves = bWasUsingBakedCurves;
+		LyraRangedWeapon::bSettledEarlyOut = bWasSettledEarlyOut;
+		return ElapsedSeconds;
+	};
+
+	const double RichCurveSeconds = TimeTicks(false, false);
+	const double BakedCurveSeconds = TimeTicks(true, false);
+	const double EarlyOutSeconds = TimeTicks(true, true);
+
+	const double TotalTicks = FMath::Max(static_cast<double>(Weapons.Num()) * NumFrames, 1.0);
+	Ar.Logf(TEXT("Ranged weapon tick, %d armed bots over %d frames (%.1f%% of the ticks settled):"), Weapons.Num(), NumFrames, NumSettledTicks * 100.0 / TotalTicks);
+	Ar.Logf(TEXT("  Rich curves:             %.3f us per frame"), RichCurveSeconds * 1000000.0 / NumFrames);
+	Ar.Logf(TEXT("  Baked curves:            %.3f us per frame (%.1fx)"), BakedCurveSeconds * 1000000.0 / NumFrames, RichCurveSeconds / FMath::Max(BakedCurveSeconds, UE_SMALL_NUMBER));
+	Ar.Logf(TEXT("  Baked curves, early-out: %.3f us per frame (%.1fx)"), EarlyOutSeconds * 1000000.0 / NumFrames, RichCurveSeconds / FMath::Max(EarlyOutSeconds, UE_SMALL_NUMBER));
+
+	for (APawn* Bot : Bots)
+	{
+		Bot->Destroy();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkRangedWeaponTickCommand(
+	TEXT("Lyra.Weapon.BenchmarkSpreadTick"),
+	TEXT("Usage: Lyra.Weapon.BenchmarkSpreadTick [NumBots=100] [NumFrames=3000]. Equips a ranged weapon on each of NumBots temporary pawns that fire a burst every few seconds, and prints the per-frame cost of their spread updates with the rich curves, the baked curves and the settled early-out."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		const int32 NumWeapons = (Args.Num() > 0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100;
+		const int32 NumFrames = (Args.Num() > 1) ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 3000;
+
+		ULyraRangedWeaponInstance::BenchmarkTick(World, NumWeapons, NumFrames, *GLog);
+	}));
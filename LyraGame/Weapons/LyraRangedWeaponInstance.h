@@ -9,7 +9,43 @@
 
 #include "LyraRangedWeaponInstance.generated.h"
 
+class FOutputDevice;
+class ULyraCameraComponent;
 class UPhysicalMaterial;
+class UWorld;
+
+/**
+ * FLyraBakedCurve
+ *
+ *	Rich curve sampled at a fixed step over a range, evaluated with a clamped table lookup and linear interpolation
+ *	instead of a key search and cubic evaluation. Curves with fewer than two keys are stored as a single exact value.
+ */
+struct FLyraBakedCurve
+{
+	void Bake(const FRichCurve& Curve, float InMinTime, float InMaxTime, int32 NumSamples);
+
+	void Reset() { Samples.Reset(); }
+
+	bool IsBaked() const { return Samples.Num() > 0; }
+
+	float Eval(float Time) const
+	{
+		const int32 LastIndex = Samples.Num() - 1;
+		if (LastIndex == 0)
+		{
+			return Samples[0];
+		}
+
+		const float Position = FMath::Clamp((Time - MinTime) * InvStep, 0.0f, static_cast<float>(LastIndex));
+		const int32 Index = FMath::Min(FMath::FloorToInt32(Position), LastIndex - 1);
+		return FMath::Lerp(Samples[Index], Samples[Index + 1], Position - static_cast<float>(Index));
+	}
+
+private:
+	float MinTime = 0.0f;
+	float InvStep = 0.0f;
+	TArray<float> Samples;
+};
 
 /**
  * ULyraRangedWeaponInstance
@@ -24,6 +60,7 @@ class ULyraRangedWeaponInstance : public ULyraWeaponInstance, public ILyraAbilit
 public:
 	ULyraRangedWeaponInstance(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
+	virtual void PostInitProperties() override;
 	virtual void PostLoad() override;
 
 #if WITH_EDITOR
@@ -214,9 +251,35 @@ private:
 	// The current crouching multiplier
 	float CrouchingMultiplier = 1.0f;
 
+	// The current aiming multiplier
+	float AimingMultiplier = 1.0f;
+
+	// Heat curves sampled over the heat range, and the ranges themselves, rebuilt by BakeCurves
+	FLyraBakedCurve BakedHeatToSpreadCurve;
+	FLyraBakedCurve BakedHeatToHeatPerShotCurve;
+	FLyraBakedCurve BakedHeatToCoolDownPerSecondCurve;
+	float BakedMinHeat = 0.0f;
+	float BakedMaxHeat = 0.0f;
+	float BakedMinSpread = 0.0f;
+	float BakedMaxSpread = 0.0f;
+	bool bCurvesBaked = false;
+
+	// Set once the heat has cooled down to its minimum, only firing can raise it again
+	bool bSpreadSettled = false;
+	bool bSettledAtMinSpread = false;
+
+	// Set once every multiplier has reached its target, they stay put until the pawn's movement or aim changes
+	bool bMultipliersSettled = false;
+	bool bSettledAtMinMultipliers = false;
+
+	TWeakObjectPtr<const ULyraCameraComponent> CachedCameraComponent;
+
 public:
 	void Tick(float DeltaSeconds);
 
+	// Times the spread updates of NumWeapons weapons held by idle or firing bots over NumFrames frames, with the rich curves, the baked curves and the settled early-out
+	static void BenchmarkTick(UWorld* World, int32 NumWeapons, int32 NumFrames, FOutputDevice& Ar);
+
 	//~ULyraEquipmentInstance interface
 	virtual void OnEquipped();
 	virtual void OnUnequipped();
@@ -231,6 +294,11 @@ public:
 	//~End of ILyraAbilitySourceInterface interface
 
 private:
+	// Samples the heat curves into lookup tables over the heat range
+	void BakeCurves();
+
+	float EvalHeatCurve(const FRuntimeFloatCurve& Curve, const FLyraBakedCurve& BakedCurve, float Heat) const;
+
 	void ComputeSpreadRange(float& MinSpread, float& MaxSpread);
 	void ComputeHeatRange(float& MinHeat, float& MaxHeat);
 
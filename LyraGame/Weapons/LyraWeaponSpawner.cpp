@@ -9,6 +9,8 @@
 #include "Engine/World.h"
 #include "Equipment/LyraPickupDefinition.h"
 #include "GameFramework/Pawn.h"
+#include "GameFramework/RotatingMovementComponent.h"
+#include "HAL/IConsoleManager.h"
 #include "Inventory/InventoryFragment_SetStats.h"
 #include "Kismet/GameplayStatics.h"
 #include "LyraLogChannels.h"
@@ -24,6 +26,16 @@ class UNiagaraSystem;
 class USoundBase;
 struct FHitResult;
 
+namespace LyraWeaponSpawner
+{
+	static bool bEventDriven = true;
+	static FAutoConsoleVariableRef CVarEventDriven(
+		TEXT("Lyra.WeaponSpawner.EventDriven"),
+		bEventDriven,
+		TEXT("If true, weapon spawners spin their weapon with a rotating movement component instead of the actor tick and schedule their cooldowns and overlap checks on the world's timer wheel. Read when a spawner begins play."),
+		ECVF_Default);
+}
+
 // Sets default values
 ALyraWeaponSpawner::ALyraWeaponSpawner()
 {
@@ -40,9 +52,16 @@ ALyraWeaponSpawner::ALyraWeaponSpawner()
 	WeaponMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("WeaponMesh"));
 	WeaponMesh->SetupAttachment(RootComponent);
 
+	WeaponMeshRotation = CreateDefaultSubobject<URotatingMovementComponent>(TEXT("WeaponMeshRotation"));
+	WeaponMeshRotation->SetUpdatedComponent(WeaponMesh);
+	WeaponMeshRotation->bAutoRegisterUpdatedComponent = false;
+	WeaponMeshRotation->bUpdateOnlyIfRendered = true;
+	WeaponMeshRotation->SetAutoActivate(false);
+
 	WeaponMeshRotationSpeed = 40.0f;
 	CoolDownTime = 30.0f;
 	CheckExistingOverlapDelay = 0.25f;
+	bUpdateCoolDownPercentageEveryFrame = false;
 	bIsWeaponAvailable = true;
 	bReplicates = true;
 }
@@ -63,15 +82,17 @@ void ALyraWeaponSpawner::BeginPlay()
 			UE_LOG(LogLyra, Error, TEXT("'%s' does not have a valid weapon definition! Make sure to set this data on the instance!"), *GetNameSafe(this));	
 		}
 	}
+
+	bEventDriven = LyraWeaponSpawner::bEventDriven;
+	if (bEventDriven)
+	{
+		UpdateEventDrivenState();
+	}
 }
 
 void ALyraWeaponSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if (UWorld* World = GetWorld())
-	{
-		World->GetTimerManager().ClearTimer(CoolDownTimerHandle);
-		World->GetTimerManager().ClearTimer(CheckOverlapsDelayTimerHandle);
-	}
+	CancelScheduledCallbacks();
 	
 	Super::EndPlay(EndPlayReason);
 }
@@ -81,6 +102,13 @@ void ALyraWeaponSpawner::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	if (bEventDriven)
+	{
+		//The weapon is spun by WeaponMeshRotation, the tick only runs for bUpdateCoolDownPercentageEveryFrame
+		CoolDownPercentage = GetCoolDownPercentage();
+		return;
+	}
+
 	//Update the CoolDownPercentage property to drive respawn time indicators
 	UWorld* World = GetWorld();
 	if (World->GetTimerManager().IsTimerActive(CoolDownTimerHandle))
@@ -145,7 +173,15 @@ void ALyraWeaponSpawner::StartCoolDown()
 {
 	if (UWorld* World = GetWorld())
 	{
-		World->GetTimerManager().SetTimer(CoolDownTimerHandle, this, &ALyraWeaponSpawner::OnCoolDownTimerComplete, CoolDownTime);
+		CoolDownStartTime = World->GetTimeSeconds();
+		ScheduleCallback(CoolDownTimerHandle, CoolDownWheelHandle, CoolDownTime, &ALyraWeaponSpawner::OnCoolDownTimerComplete);
+	}
+
+	UpdateCoolDownMaterialParameters();
+
+	if (bEventDriven)
+	{
+		UpdateEventDrivenState();
 	}
 }
 
@@ -156,6 +192,11 @@ void ALyraWeaponSpawner::ResetCoolDown()
 	if (World)
 	{
 		World->GetTimerManager().ClearTimer(CoolDownTimerHandle);
+
+		if (ULyraTimerWheelSubsystem* TimerWheel = World->GetSubsystem<ULyraTimerWheelSubsystem>())
+		{
+			TimerWheel->Cancel(CoolDownWheelHandle);
+		}
 	}
 
 	if (GetLocalRole() == ROLE_Authority)
@@ -166,11 +207,110 @@ void ALyraWeaponSpawner::ResetCoolDown()
 
 		if (World)
 		{
-			World->GetTimerManager().SetTimer(CheckOverlapsDelayTimerHandle, this, &ALyraWeaponSpawner::CheckForExistingOverlaps, CheckExistingOverlapDelay);
+			ScheduleCallback(CheckOverlapsDelayTimerHandle, CheckOverlapsWheelHandle, CheckExistingOverlapDelay, &ALyraWeaponSpawner::CheckForExistingOverlaps);
 		}
 	}
 
+	CoolDownStartTime = -1.0;
 	CoolDownPercentage = 0.0f;
+
+	UpdateCoolDownMaterialParameters();
+
+	if (bEventDriven)
+	{
+		UpdateEventDrivenState();
+	}
+}
+
+float ALyraWeaponSpawner::GetCoolDownPercentage() const
+{
+	const UWorld* World = GetWorld();
+	if (!World || (CoolDownStartTime < 0.0))
+	{
+		return 0.0f;
+	}
+
+	if (CoolDownTime <= 0.0f)
+	{
+		return 1.0f;
+	}
+
+	return FMath::Clamp(static_cast<float>((World->GetTimeSeconds() - CoolDownStartTime) / CoolDownTime), 0.0f, 1.0f);
+}
+
+bool ALyraWeaponSpawner::ShouldTickEventDriven() const
+{
+	//Everything the tick does is cosmetic
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		return false;
+	}
+
+	return (CoolDownStartTime >= 0.0) && bUpdateCoolDownPercentageEveryFrame;
+}
+
+void ALyraWeaponSpawner::UpdateEventDrivenState()
+{
+	SetActorTickEnabled(ShouldTickEventDriven());
+
+	const bool bSpinWeapon = (GetNetMode() != NM_DedicatedServer) && bIsWeaponAvailable && (WeaponMeshRotationSpeed != 0.0f);
+	if (bSpinWeapon)
+	{
+		WeaponMeshRotation->RotationRate = FRotator(0.0f, WeaponMeshRotationSpeed, 0.0f);
+	}
+	WeaponMeshRotation->SetActive(bSpinWeapon);
+}
+
+void ALyraWeaponSpawner::UpdateCoolDownMaterialParameters()
+{
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	if (!CoolDownStartTimeMaterialParameter.IsNone())
+	{
+		PadMesh->SetScalarParameterValueOnMaterials(CoolDownStartTimeMaterialParameter, static_cast<float>(CoolDownStartTime));
+	}
+
+	if (!CoolDownDurationMaterialParameter.IsNone())
+	{
+		PadMesh->SetScalarParameterValueOnMaterials(CoolDownDurationMaterialParameter, (CoolDownStartTime >= 0.0) ? CoolDownTime : 0.0f);
+	}
+}
+
+void ALyraWeaponSpawner::ScheduleCallback(FTimerHandle& TimerHandle, FLyraTimerWheelHandle& WheelHandle, float Delay, void (ALyraWeaponSpawner::*Callback)())
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	ULyraTimerWheelSubsystem* TimerWheel = bEventDriven ? World->GetSubsystem<ULyraTimerWheelSubsystem>() : nullptr;
+	if (TimerWheel)
+	{
+		TimerWheel->Schedule(WheelHandle, Delay, FLyraTimerWheelDelegate::CreateUObject(this, Callback));
+	}
+	else
+	{
+		World->GetTimerManager().SetTimer(TimerHandle, this, Callback, Delay);
+	}
+}
+
+void ALyraWeaponSpawner::CancelScheduledCallbacks()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(CoolDownTimerHandle);
+		World->GetTimerManager().ClearTimer(CheckOverlapsDelayTimerHandle);
+
+		if (ULyraTimerWheelSubsystem* TimerWheel = World->GetSubsystem<ULyraTimerWheelSubsystem>())
+		{
+			TimerWheel->Cancel(CoolDownWheelHandle);
+			TimerWheel->Cancel(CheckOverlapsWheelHandle);
+		}
+	}
 }
 
 void ALyraWeaponSpawner::OnCoolDownTimerComplete()
@@ -225,6 +365,11 @@ void ALyraWeaponSpawner::OnRep_WeaponAvailability()
 	{
 		PlayRespawnEffects();
 		SetWeaponPickupVisibility(true);
+
+		if (bEventDriven)
+		{
+			UpdateEventDrivenState();
+		}
 	}
 	else
 	{
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "GameFramework/Actor.h"
+#include "System/LyraTimerWheelSubsystem.h"
 
 #include "LyraWeaponSpawner.generated.h"
 
@@ -14,6 +15,7 @@ class ULyraInventoryItemDefinition;
 class ULyraWeaponPickupDefinition;
 class UObject;
 class UPrimitiveComponent;
+class URotatingMovementComponent;
 class UStaticMeshComponent;
 struct FFrame;
 struct FGameplayTag;
@@ -55,10 +57,21 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Lyra|WeaponPickup")
 	float CheckExistingOverlapDelay;
 
-	//Used to drive weapon respawn time indicators 0-1
-	UPROPERTY(BlueprintReadOnly, Transient, Category = "Lyra|WeaponPickup")
+	//Used to drive weapon respawn time indicators 0-1. Blueprints reading it go through GetCoolDownPercentage, the field itself is only updated every frame in event-driven mode if bUpdateCoolDownPercentageEveryFrame is set.
+	UPROPERTY(BlueprintGetter = GetCoolDownPercentage, Transient, Category = "Lyra|WeaponPickup")
 	float CoolDownPercentage;
 
+	//In event-driven mode (Lyra.WeaponSpawner.EventDriven), keep ticking during the cooldown to update the CoolDownPercentage field for native code that reads it directly. Blueprints and materials don't need it.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Lyra|WeaponPickup")
+	bool bUpdateCoolDownPercentageEveryFrame;
+
+	//Scalar parameters set on the pad mesh's materials when a cooldown starts and ends: the world time it started at, and its duration (0 when not cooling down). Progress can then be computed in the material from its Time input. Unset names are skipped.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Lyra|WeaponPickup")
+	FName CoolDownStartTimeMaterialParameter;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Lyra|WeaponPickup")
+	FName CoolDownDurationMaterialParameter;
+
 public:
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Lyra|WeaponPickup")
@@ -70,6 +83,10 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Lyra|WeaponPickup")
 	TObjectPtr<UStaticMeshComponent> WeaponMesh;
 
+	//Spins the weapon mesh in event-driven mode, only while the weapon is available and the mesh is rendered
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Lyra|WeaponPickup")
+	TObjectPtr<URotatingMovementComponent> WeaponMeshRotation;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Lyra|WeaponPickup")
 	float WeaponMeshRotationSpeed;
 
@@ -77,6 +94,10 @@ public:
 
 	FTimerHandle CheckOverlapsDelayTimerHandle;
 
+	//Returns the cooldown progress 0-1 computed from the time the cooldown started, or 0 if the weapon is not cooling down
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Lyra|WeaponPickup")
+	float GetCoolDownPercentage() const;
+
 	UFUNCTION()
 	void OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepHitResult);
 
@@ -111,4 +132,27 @@ public:
 	/** Searches an item definition type for a matching stat and returns the value, or 0 if not found */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Lyra|WeaponPickup")
 	static int32 GetDefaultStatFromItemDef(const TSubclassOf<ULyraInventoryItemDefinition> WeaponItemClass, FGameplayTag StatTag);
+
+private:
+	bool ShouldTickEventDriven() const;
+
+	//Enables the actor tick only while the cooldown percentage has to be updated, and the weapon rotation only while it is available
+	void UpdateEventDrivenState();
+
+	void UpdateCoolDownMaterialParameters();
+
+	//Schedules the cooldown completion or overlap check on the world's timer wheel, or on the timer manager in tick mode
+	void ScheduleCallback(FTimerHandle& TimerHandle, FLyraTimerWheelHandle& WheelHandle, float Delay, void (ALyraWeaponSpawner::*Callback)());
+
+	void CancelScheduledCallbacks();
+
+	//Set in BeginPlay from Lyra.WeaponSpawner.EventDriven
+	bool bEventDriven = false;
+
+	//World time the current cooldown started at, negative when not cooling down
+	double CoolDownStartTime = -1.0;
+
+	FLyraTimerWheelHandle CoolDownWheelHandle;
+
+	FLyraTimerWheelHandle CheckOverlapsWheelHandle;
 };
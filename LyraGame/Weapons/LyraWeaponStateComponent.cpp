@@ -6,6 +6,7 @@
 #include "Equipment/LyraEquipmentManagerComponent.h"
 #include "GameFramework/Pawn.h"
 #include "GameplayEffectTypes.h"
+#include "HAL/IConsoleManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "NativeGameplayTags.h"
 #include "Physics/PhysicalMaterialWithTags.h"
@@ -16,6 +17,35 @@
 
 UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Gameplay_Zone, "Gameplay.Zone");
 
+namespace LyraWeaponState
+{
+	static bool bBatchHitConfirmations = true;
+	static FAutoConsoleVariableRef CVarBatchHitConfirmations(
+		TEXT("Lyra.Weapon.BatchHitConfirmations"),
+		bBatchHitConfirmations,
+		TEXT("If true, the server confirms the hit markers of all shots fired since the owner's last net update with a single RPC instead of one RPC per shot."),
+		ECVF_Default);
+
+	// Number of shots a single batched confirmation can cover
+	static constexpr int32 MaxShotsPerConfirmation = 32;
+
+	// Rough per-RPC cost on top of the parameters (function handle, bunch header), only used for the stats
+	static constexpr int32 EstimatedRPCOverheadBytes = 4;
+
+	// Server-wide confirmation stats since StatsStartTime
+	static double StatsStartTime = FPlatformTime::Seconds();
+	static int64 NumShotsConfirmed = 0;
+	static int64 NumConfirmRPCsSent = 0;
+	static int64 NumConfirmBytesSent = 0;
+	static int64 NumPerShotBytesEstimate = 0;
+
+	static int32 EstimatePerShotConfirmationBytes(int32 NumHitReplaces)
+	{
+		// uint16 id, bool, array count and one byte per replaced hit
+		return EstimatedRPCOverheadBytes + 2 + 1 + 1 + NumHitReplaces;
+	}
+}
+
 ULyraWeaponStateComponent::ULyraWeaponStateComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -29,6 +59,16 @@ void ULyraWeaponStateComponent::TickComponent(float DeltaTime, enum ELevelTick T
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	if (PendingConfirmedMask != 0)
+	{
+		const AActor* Owner = GetOwner();
+		const double FlushInterval = (Owner && (Owner->NetUpdateFrequency > 0.0f)) ? (1.0 / Owner->NetUpdateFrequency) : 0.0;
+		if (GetWorld()->GetTimeSeconds() - LastConfirmFlushTime >= FlushInterval)
+		{
+			FlushShotConfirmations();
+		}
+	}
+
 	if (APawn* Pawn = GetPawn<APawn>())
 	{
 		if (ULyraEquipmentManagerComponent* EquipmentManager = Pawn->FindComponentByClass<ULyraEquipmentManagerComponent>())
@@ -65,44 +105,168 @@ bool ULyraWeaponStateComponent::ShouldUpdateDamageInstigatedTime(const FGameplay
 
 void ULyraWeaponStateComponent::ClientConfirmTargetData_Implementation(uint16 UniqueId, bool bSuccess, const TArray<uint8>& HitReplaces)
 {
-	for (int i = 0; i < UnconfirmedServerSideHitMarkers.Num(); i++)
+	if (UnconfirmedServerSideHitMarkers.Num() == 0)
+	{
+		return;
+	}
+
+	FLyraServerSideHitMarkerBatch& Batch = UnconfirmedServerSideHitMarkers[UniqueId % UnconfirmedHitMarkerCapacity];
+	if (Batch.bUnconfirmed && (Batch.UniqueId == (uint8)UniqueId))
+	{
+		ConfirmHitMarkerBatch(Batch, bSuccess, [&HitReplaces](int32 HitIndex) { return HitReplaces.Contains(HitIndex); });
+	}
+}
+
+void ULyraWeaponStateComponent::ClientConfirmShots_Implementation(uint8 BaseShotIndex, uint32 ConfirmedMask, uint32 SuccessMask, const TArray<uint8>& HitReplaces)
+{
+	if (UnconfirmedServerSideHitMarkers.Num() == 0)
 	{
-		FLyraServerSideHitMarkerBatch& Batch = UnconfirmedServerSideHitMarkers[i];
-		if (Batch.UniqueId == UniqueId)
+		return;
+	}
+
+	for (int32 ShotOffset = 0; ShotOffset < LyraWeaponState::MaxShotsPerConfirmation; ++ShotOffset)
+	{
+		if ((ConfirmedMask & (1u << ShotOffset)) == 0)
 		{
-			if (bSuccess && (HitReplaces.Num() != Batch.Markers.Num()))
-			{
-				UWorld* World = GetWorld();
-				bool bFoundShowAsSuccessHit = false;
+			continue;
+		}
 
-				int32 HitLocationIndex = 0;
-				for (const FLyraScreenSpaceHitLocation& Entry : Batch.Markers)
+		const uint8 ShotIndex = (uint8)(BaseShotIndex + ShotOffset);
+		FLyraServerSideHitMarkerBatch& Batch = UnconfirmedServerSideHitMarkers[ShotIndex % UnconfirmedHitMarkerCapacity];
+		if (Batch.bUnconfirmed && (Batch.UniqueId == ShotIndex))
+		{
+			const bool bSuccess = (SuccessMask & (1u << ShotOffset)) != 0;
+			ConfirmHitMarkerBatch(Batch, bSuccess, [&HitReplaces, ShotOffset](int32 HitIndex)
+			{
+				for (int32 PairIndex = 0; PairIndex + 1 < HitReplaces.Num(); PairIndex += 2)
 				{
-					if (!HitReplaces.Contains(HitLocationIndex) && Entry.bShowAsSuccess)
+					if ((HitReplaces[PairIndex] == ShotOffset) && (HitReplaces[PairIndex + 1] == HitIndex))
 					{
-						// Only need to do this once
-						if (!bFoundShowAsSuccessHit)
-						{
-							ActuallyUpdateDamageInstigatedTime();
-						}
+						return true;
+					}
+				}
+				return false;
+			});
+		}
+	}
+}
 
-						bFoundShowAsSuccessHit = true;
+void ULyraWeaponStateComponent::ConfirmHitMarkerBatch(FLyraServerSideHitMarkerBatch& Batch, bool bSuccess, TFunctionRef<bool(int32 /*HitIndex*/)> IsHitReplaced)
+{
+	if (bSuccess)
+	{
+		bool bFoundShowAsSuccessHit = false;
 
-						LastWeaponDamageScreenLocations.Add(Entry);
-					}
-					++HitLocationIndex;
+		int32 HitLocationIndex = 0;
+		for (const FLyraScreenSpaceHitLocation& Entry : Batch.Markers)
+		{
+			if (Entry.bShowAsSuccess && !IsHitReplaced(HitLocationIndex))
+			{
+				// Only need to do this once
+				if (!bFoundShowAsSuccessHit)
+				{
+					ActuallyUpdateDamageInstigatedTime();
 				}
-			}
 
-			UnconfirmedServerSideHitMarkers.RemoveAt(i);
-			break;
+				bFoundShowAsSuccessHit = true;
+
+				LastWeaponDamageScreenLocations.Add(Entry);
+			}
+			++HitLocationIndex;
 		}
 	}
+
+	Batch.bUnconfirmed = false;
+	Batch.Markers.Reset();
+	--NumUnconfirmedServerSideHitMarkers;
+}
+
+void ULyraWeaponStateComponent::ConfirmShot(uint8 ShotIndex, bool bSuccess, const TArray<uint8>& HitReplaces)
+{
+	using namespace LyraWeaponState;
+
+	// The owning client is on this machine, no need to go through the network
+	const APlayerController* PC = GetController<APlayerController>();
+	if (PC && PC->IsLocalController())
+	{
+		ClientConfirmTargetData_Implementation(ShotIndex, bSuccess, HitReplaces);
+		return;
+	}
+
+	++NumShotsConfirmed;
+	NumPerShotBytesEstimate += EstimatePerShotConfirmationBytes(HitReplaces.Num());
+
+	if (!bBatchHitConfirmations)
+	{
+		ClientConfirmTargetData(ShotIndex, bSuccess, HitReplaces);
+
+		++NumConfirmRPCsSent;
+		NumConfirmBytesSent += EstimatePerShotConfirmationBytes(HitReplaces.Num());
+		return;
+	}
+
+	// Shots arrive in order, a shot the pending masks cannot cover starts a new batch
+	uint8 ShotOffset = (uint8)(ShotIndex - PendingConfirmBaseShotIndex);
+	if ((PendingConfirmedMask != 0) && ((ShotOffset >= MaxShotsPerConfirmation) || (PendingConfirmedMask & (1u << ShotOffset))))
+	{
+		FlushShotConfirmations();
+	}
+
+	if (PendingConfirmedMask == 0)
+	{
+		PendingConfirmBaseShotIndex = ShotIndex;
+		ShotOffset = 0;
+	}
+
+	PendingConfirmedMask |= (1u << ShotOffset);
+	if (bSuccess)
+	{
+		PendingSuccessMask |= (1u << ShotOffset);
+	}
+
+	for (const uint8 HitIndex : HitReplaces)
+	{
+		PendingHitReplaces.Add(ShotOffset);
+		PendingHitReplaces.Add(HitIndex);
+	}
+}
+
+void ULyraWeaponStateComponent::FlushShotConfirmations()
+{
+	using namespace LyraWeaponState;
+
+	if (PendingConfirmedMask != 0)
+	{
+		ClientConfirmShots(PendingConfirmBaseShotIndex, PendingConfirmedMask, PendingSuccessMask, PendingHitReplaces);
+
+		// uint8 base, two uint32 masks, array count and the replaced hit pairs
+		++NumConfirmRPCsSent;
+		NumConfirmBytesSent += EstimatedRPCOverheadBytes + 1 + 4 + 4 + 1 + PendingHitReplaces.Num();
+	}
+
+	PendingConfirmedMask = 0;
+	PendingSuccessMask = 0;
+	PendingHitReplaces.Reset();
+	LastConfirmFlushTime = GetWorld()->GetTimeSeconds();
 }
 
 void ULyraWeaponStateComponent::AddUnconfirmedServerSideHitMarkers(const FGameplayAbilityTargetDataHandle& InTargetData, const TArray<FHitResult>& FoundHits)
 {
-	FLyraServerSideHitMarkerBatch& NewUnconfirmedHitMarker = UnconfirmedServerSideHitMarkers.Emplace_GetRef(InTargetData.UniqueId);
+	if (UnconfirmedServerSideHitMarkers.Num() == 0)
+	{
+		UnconfirmedServerSideHitMarkers.SetNum(UnconfirmedHitMarkerCapacity);
+	}
+
+	// Reuse the slot of the shot fired UnconfirmedHitMarkerCapacity shots ago, if it was never confirmed it never will be
+	FLyraServerSideHitMarkerBatch& NewUnconfirmedHitMarker = UnconfirmedServerSideHitMarkers[InTargetData.UniqueId % UnconfirmedHitMarkerCapacity];
+	if (!NewUnconfirmedHitMarker.bUnconfirmed)
+	{
+		++NumUnconfirmedServerSideHitMarkers;
+	}
+
+	NewUnconfirmedHitMarker.Markers.Reset();
+	NewUnconfirmedHitMarker.UniqueId = InTargetData.UniqueId;
+	NewUnconfirmedHitMarker.bUnconfirmed = true;
 
 	if (APlayerController* OwnerPC = GetController<APlayerController>())
 	{
@@ -158,3 +322,25 @@ double ULyraWeaponStateComponent::GetTimeSinceLastHitNotification() const
 	return World->TimeSince(LastWeaponDamageInstigatedTime);
 }
 
+//////////////////////////////////////////////////////////////////////
+
+static FAutoConsoleCommandWithWorldAndArgs DumpHitConfirmStatsCommand(
+	TEXT("Lyra.Weapon.DumpHitConfirmStats"),
+	TEXT("Prints how many hit marker confirmation RPCs the server sent and the bytes saved compared to one RPC per shot, then restarts the measurement."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		using namespace LyraWeaponState;
+
+		const double Now = FPlatformTime::Seconds();
+		const double Elapsed = FMath::Max(Now - StatsStartTime, UE_SMALL_NUMBER);
+
+		GLog->Logf(TEXT("Hit confirmations over %.1f s: %lld shots confirmed with %lld RPCs (%.1f/s, %lld saved), ~%lld bytes sent vs ~%lld bytes with one RPC per shot (%lld saved)"),
+			Elapsed, NumShotsConfirmed, NumConfirmRPCsSent, NumConfirmRPCsSent / Elapsed, NumShotsConfirmed - NumConfirmRPCsSent,
+			NumConfirmBytesSent, NumPerShotBytesEstimate, NumPerShotBytesEstimate - NumConfirmBytesSent);
+
+		StatsStartTime = Now;
+		NumShotsConfirmed = 0;
+		NumConfirmRPCsSent = 0;
+		NumConfirmBytesSent = 0;
+		NumPerShotBytesEstimate = 0;
+	}));
@@ -34,6 +34,9 @@ struct FLyraServerSideHitMarkerBatch
 	TArray<FLyraScreenSpaceHitLocation> Markers;
 
 	uint8 UniqueId = 0;
+
+	/** Set while the batch waits for the server's confirmation */
+	bool bUnconfirmed = false;
 };
 
 // Tracks weapon state and recent confirmed hit markers to display on screen
@@ -51,6 +54,19 @@ public:
 	UFUNCTION(Client, Reliable)
 	void ClientConfirmTargetData(uint16 UniqueId, bool bSuccess, const TArray<uint8>& HitReplaces);
 
+	/**
+	 * Confirms up to 32 shots at once: bit N of the masks is shot BaseShotIndex + N.
+	 * HitReplaces holds (shot offset, hit index) pairs for the hits the server replaced.
+	 */
+	UFUNCTION(Client, Reliable)
+	void ClientConfirmShots(uint8 BaseShotIndex, uint32 ConfirmedMask, uint32 SuccessMask, const TArray<uint8>& HitReplaces);
+
+	/** Server: queues the confirmation of a shot, sent to the owning client with the others at the next flush */
+	void ConfirmShot(uint8 ShotIndex, bool bSuccess, const TArray<uint8>& HitReplaces);
+
+	/** Client: returns the rolling index to use as the target data UniqueId of the next shot */
+	uint8 AllocateShotIndex() { return NextShotIndex++; }
+
 	void AddUnconfirmedServerSideHitMarkers(const FGameplayAbilityTargetDataHandle& InTargetData, const TArray<FHitResult>& FoundHits);
 
 	/** Updates this player's last damage instigated time */
@@ -67,7 +83,7 @@ public:
 
 	int32 GetUnconfirmedServerSideHitMarkerCount() const
 	{
-		return UnconfirmedServerSideHitMarkers.Num();
+		return NumUnconfirmedServerSideHitMarkers;
 	}
 
 protected:
@@ -80,6 +96,12 @@ protected:
 
 	void ActuallyUpdateDamageInstigatedTime();
 
+	/** Shows the confirmed markers of a batch and releases it */
+	void ConfirmHitMarkerBatch(FLyraServerSideHitMarkerBatch& Batch, bool bSuccess, TFunctionRef<bool(int32 /*HitIndex*/)> IsHitReplaced);
+
+	/** Server: sends the queued shot confirmations */
+	void FlushShotConfirmations();
+
 private:
 	/** Last time this controller instigated weapon damage */
 	double LastWeaponDamageInstigatedTime = 0.0;
@@ -87,6 +109,18 @@ private:
 	/** Screen-space locations of our most recently instigated weapon damage (the confirmed hits) */
 	TArray<FLyraScreenSpaceHitLocation> LastWeaponDamageScreenLocations;
 
-	/** The unconfirmed hits */
+	/** The unconfirmed hits, indexed by shot index modulo the capacity. A shot overwrites the one fired Capacity shots before it. */
+	static constexpr int32 UnconfirmedHitMarkerCapacity = 32;
 	TArray<FLyraServerSideHitMarkerBatch> UnconfirmedServerSideHitMarkers;
+	int32 NumUnconfirmedServerSideHitMarkers = 0;
+
+	/** Client: rolling index of the next shot */
+	uint8 NextShotIndex = 0;
+
+	/** Server: shot confirmations waiting for the next flush */
+	uint8 PendingConfirmBaseShotIndex = 0;
+	uint32 PendingConfirmedMask = 0;
+	uint32 PendingSuccessMask = 0;
+	TArray<uint8> PendingHitReplaces;
+	double LastConfirmFlushTime = 0.0;
 };